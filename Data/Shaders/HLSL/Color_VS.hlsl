@@ -18,20 +18,22 @@ cbuffer PerCameraBuffer : register(b0)
 
 cbuffer PerInstanceBuffer : register(b1)
 {
-    PerInstanceData gInstanceData[STANDARD_FORWARD_MAX_INSTANCED_BLOCK];
+    // Index of each instance in ObjectsBuffer, four per entry
+    uint4 gInstanceIndices[STANDARD_FORWARD_MAX_INSTANCED_BLOCK / 4];
 }
 
 cbuffer PerObjectBuffer : register(b2)
 {
-    matrix gMatWorld;
-    matrix gMatInvWorld;
-    matrix gMatWorldNoScale;
-    matrix gMatInvWorldNoScale;
-    matrix gMatPrevWorld;
-    uint   gLayer;
-    uint   gHasAnimation;
-    uint   gWriteVelocity;
-    uint   gCastLights;
+    uint   gObjectIdx;
+}
+
+// First instance of a draw is the object whose buffers are bound, the others come from the per instance buffer
+uint GetObjectIdx(uint instanceid)
+{
+    if(instanceid == 0)
+        return gObjectIdx;
+
+    return gInstanceIndices[instanceid / 4][instanceid % 4];
 }
 
 VS_OUTPUT main( VS_INPUT IN )
@@ -39,76 +41,40 @@ VS_OUTPUT main( VS_INPUT IN )
     VS_OUTPUT OUT = (VS_OUTPUT)0;
 
     float4x4 blendMatrix = (float4x4)0;
-    float4x4 prevBlendMatrix = (float4x4)0;
 
-    if(gHasAnimation)
-    {
+    PerInstanceData object = LoadObjectData(GetObjectIdx(IN.Instanceid));
+
+    if(object.gHasAnimation)
         blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
-        prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices);
-    }
 
-    if(IN.Instanceid == 0)
-    {
-        OUT.Position = float4(IN.Position, 1.0f);
-        if(gHasAnimation)
-            OUT.Position = mul(blendMatrix, OUT.Position);
-        OUT.Position = mul(gMatWorld, OUT.Position);
-        OUT.Position = mul(gMatViewProj, OUT.Position);
-
-        OUT.Normal = IN.Normal;
-        OUT.Tangent = IN.Tangent.xyz;
-        OUT.BiTangent = IN.BiTangent.xyz;
-
-        if(gHasAnimation)
-        {
-            OUT.Normal = mul(blendMatrix, float4(OUT.Normal, 0.0f)).xyz;
-            OUT.Tangent = mul(blendMatrix, float4(OUT.Tangent, 0.0f)).xyz;
-            OUT.BiTangent = mul(blendMatrix, float4(OUT.BiTangent, 0.0f)).xyz;
-        }
-
-        OUT.Normal = normalize(mul(gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
-        OUT.BiTangent = normalize(mul(gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
-
-        OUT.PositionWS = float4(IN.Position, 1.0f);
-        if(gHasAnimation)
-            OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
-        OUT.PositionWS = mul(gMatWorld, OUT.PositionWS);
-
-        OUT.ViewDirectionWS = normalize(OUT.PositionWS.xyz - gViewOrigin);
-        OUT.Color = IN.Color;
-    }
-    else
+    OUT.Position = float4(IN.Position, 1.0f);
+    if(object.gHasAnimation)
+        OUT.Position = mul(blendMatrix, OUT.Position);
+    OUT.Position = mul(object.gMatWorld, OUT.Position);
+    OUT.Position = mul(gMatViewProj, OUT.Position);
+
+    OUT.Normal = IN.Normal;
+    OUT.Tangent = IN.Tangent.xyz;
+    OUT.BiTangent = IN.BiTangent.xyz;
+
+    if(object.gHasAnimation)
     {
-        OUT.Position = float4(IN.Position, 1.0f);
-        if(gHasAnimation)
-            OUT.Position = mul(blendMatrix, OUT.Position);
-        OUT.Position = mul(gInstanceData[IN.Instanceid].gMatWorld, OUT.Position);
-        OUT.Position = mul(gMatViewProj, OUT.Position);
-
-        OUT.Normal = IN.Normal;
-        OUT.Tangent = IN.Tangent.xyz;
-        OUT.BiTangent = IN.BiTangent.xyz;
-
-        if(gHasAnimation)
-        {
-            OUT.Normal = mul(blendMatrix, float4(OUT.Normal, 0.0f)).xyz;
-            OUT.Tangent = mul(blendMatrix, float4(OUT.Tangent, 0.0f)).xyz;
-            OUT.BiTangent = mul(blendMatrix, float4(OUT.BiTangent, 0.0f)).xyz;
-        }
-
-        OUT.Normal = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
-        OUT.BiTangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
-
-        OUT.PositionWS = float4(IN.Position, 1.0f);
-        if(gHasAnimation)
-            OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
-        OUT.PositionWS = mul(gInstanceData[IN.Instanceid].gMatWorld, OUT.PositionWS);
-
-        OUT.ViewDirectionWS = normalize(OUT.PositionWS.xyz - gViewOrigin);
-        OUT.Color = IN.Color;
+        OUT.Normal = mul(blendMatrix, float4(OUT.Normal, 0.0f)).xyz;
+        OUT.Tangent = mul(blendMatrix, float4(OUT.Tangent, 0.0f)).xyz;
+        OUT.BiTangent = mul(blendMatrix, float4(OUT.BiTangent, 0.0f)).xyz;
     }
 
+    OUT.Normal = normalize(mul(object.gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
+    OUT.Tangent = normalize(mul(object.gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
+    OUT.BiTangent = normalize(mul(object.gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
+
+    OUT.PositionWS = float4(IN.Position, 1.0f);
+    if(object.gHasAnimation)
+        OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
+    OUT.PositionWS = mul(object.gMatWorld, OUT.PositionWS);
+
+    OUT.ViewDirectionWS = normalize(OUT.PositionWS.xyz - gViewOrigin);
+    OUT.Color = IN.Color;
+
     return OUT;
 }
@@ -115,7 +115,7 @@ PS_OUTPUT main( PS_INPUT IN )
         if(gUseEmissiveMap == 1)
             emissive = emissive * EmissiveMap.Sample(TextureSampler, texCoords).rgb;
 
-        LightingResult lit = ComputeLighting(IN.PositionWS.xyz, normalize(normal), castLight);
+        LightingResult lit = ComputeLighting(IN.PositionWS.xyz, normalize(normal), IN.Position.xy, castLight);
 
         if(gUseOcclusionMap == 1)
         {
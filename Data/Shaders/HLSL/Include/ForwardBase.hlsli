@@ -13,6 +13,35 @@ struct PerInstanceData
     uint   gCastLights;
 };
 
+// Per object data of all renderables, OBJECT_DATA_STRIDE float4 per object, indexed by renderer id
+#define OBJECT_DATA_STRIDE 21
+
+Buffer<float4> ObjectsBuffer;
+
+float4x4 LoadObjectMatrix(uint offset)
+{
+    return float4x4(ObjectsBuffer[offset + 0], ObjectsBuffer[offset + 1], ObjectsBuffer[offset + 2], ObjectsBuffer[offset + 3]);
+}
+
+PerInstanceData LoadObjectData(uint objectIdx)
+{
+    uint offset = objectIdx * OBJECT_DATA_STRIDE;
+    uint4 flags = asuint(ObjectsBuffer[offset + 20]);
+
+    PerInstanceData data;
+    data.gMatWorld = LoadObjectMatrix(offset + 0);
+    data.gMatInvWorld = LoadObjectMatrix(offset + 4);
+    data.gMatWorldNoScale = LoadObjectMatrix(offset + 8);
+    data.gMatInvWorldNoScale = LoadObjectMatrix(offset + 12);
+    data.gMatPrevWorld = LoadObjectMatrix(offset + 16);
+    data.gLayer = flags.x;
+    data.gHasAnimation = flags.y;
+    data.gWriteVelocity = flags.z;
+    data.gCastLights = flags.w;
+
+    return data;
+}
+
 struct VS_INPUT
 {
     float3 Position      : POSITION;
@@ -1,4 +1,5 @@
-#define MAX_LIGHTS 24
+#define LIGHT_DATA_STRIDE 5
+#define SHADOW_DATA_STRIDE 6
 
 #define DIRECTIONAL_LIGHT 0.0
 #define POINT_LIGHT 1.0
@@ -19,7 +20,18 @@ struct LightData
     float  BoundsRadius;
     float  LinearAttenuation;
     float  QuadraticAttenuation;
-    float2 Padding1;
+    float  ShadowIdx; // Negative if the light has no shadow
+    float  Padding1;
+};
+
+struct ShadowData
+{
+    float4x4 ViewProj;
+    float4 NDCToUV; // uv = ndc.xy * xy + zw
+    float  NormalOffset; // World space offset along the normal, per unit of distance to the light if perspective
+    uint   Layers; // 1 if the static layer has casters, 2 if the dynamic layer has
+    float  Perspective;
+    float  SplitDepth; // View depth up to which a cascade is used
 };
 
 struct LightingResult
@@ -78,9 +90,11 @@ cbuffer PerMaterialBuffer : register(b1)
 
 cbuffer PerLightsBuffer : register(b2)
 {
-    LightData gLights[MAX_LIGHTS];
-    uint      gLightsNumber;
-    float3    gPadding4;
+    int4   gLightGrid; // Number of clusters in x, y and z, tile size in pixels
+    float4 gLightGridSlicing; // slice = (log2 ? log2(depth) : depth) * x + y, z is 1 for log2
+    uint   gNumDirLights;
+    uint   gLightsNumber;
+    float2 gPadding4;
 }
 
 cbuffer PerFrameBuffer : register(b3)
@@ -94,6 +108,15 @@ cbuffer PerFrameBuffer : register(b3)
     float3 gPadding5;
 }
 
+cbuffer PerShadowsBuffer : register(b4)
+{
+    float4 gShadowAtlasSize; // Width, height, 1 / width, 1 / height
+    int    gCascadeOffset; // Index of the cascades of the first shadowed directional light in ShadowsBuffer
+    int    gNumCascades;
+    int    gShadowFilterQuality;
+    int    gShadowsEnabled;
+}
+
 SamplerState TextureSampler : register(s0);
 
 Texture2D DiffuseMap : register(t0);
@@ -108,6 +131,15 @@ Texture2D OcclusionMap : register(t8);
 TextureCube EnvironmentMap : register(t9);
 TextureCube IrradianceMap : register(t10);
 
+Buffer<float4> LightsBuffer; // LIGHT_DATA_STRIDE float4 per light, directional lights first
+Buffer<uint2> ClusterLightRanges; // Offset and number of the lights of each cluster in ClusterLightIndices
+Buffer<uint> ClusterLightIndices;
+
+Buffer<float4> ShadowsBuffer; // SHADOW_DATA_STRIDE float4 per shadow map, those of spot and radial lights first
+Texture2D ShadowAtlas; // Casters that can move
+Texture2D StaticShadowAtlas; // Casters that can't move
+SamplerComparisonState ShadowSampler;
+
 float3 ExpandNormal(float3 normal)
 {
     return normal * 2.0f - 1.0f;
@@ -296,9 +328,168 @@ LightingResult DoSpotLight( LightData light, float3 V, float3 P, float3 N )
     return result;
 }
 
+LightData LoadLight( uint index )
+{
+    uint offset = index * LIGHT_DATA_STRIDE;
+    float4 data0 = LightsBuffer[offset + 0];
+    float4 data1 = LightsBuffer[offset + 1];
+    float4 data2 = LightsBuffer[offset + 2];
+    float4 data3 = LightsBuffer[offset + 3];
+    float4 data4 = LightsBuffer[offset + 4];
+
+    LightData light;
+    light.Color = data0.xyz;
+    light.Type = data0.w;
+    light.Position = data1.xyz;
+    light.Intensity = data1.w;
+    light.Direction = data2.xyz;
+    light.AttenuationRadius = data2.w;
+    light.SpotAngles = data3.xyz;
+    light.BoundsRadius = data3.w;
+    light.LinearAttenuation = data4.x;
+    light.QuadraticAttenuation = data4.y;
+    light.ShadowIdx = data4.z;
+    light.Padding1 = data4.w;
+
+    return light;
+}
+
+ShadowData LoadShadow( uint index )
+{
+    uint offset = index * SHADOW_DATA_STRIDE;
+    float4 data5 = ShadowsBuffer[offset + 5];
+
+    ShadowData shadow;
+    shadow.ViewProj = float4x4(ShadowsBuffer[offset + 0], ShadowsBuffer[offset + 1], ShadowsBuffer[offset + 2],
+        ShadowsBuffer[offset + 3]);
+    shadow.NDCToUV = ShadowsBuffer[offset + 4];
+    shadow.NormalOffset = data5.x;
+    shadow.Layers = (uint)data5.y;
+    shadow.Perspective = data5.z;
+    shadow.SplitDepth = data5.w;
+
+    return shadow;
+}
+
+// Fraction of the light reaching a position, filtered over a square of gShadowFilterQuality / 2 texels around it
+// P : position vector in world space
+// N : surface normal
+float SampleShadowMap( ShadowData shadow, float3 P, float3 N )
+{
+    if(shadow.Layers == 0)
+        return 1.0f;
+
+    // Offset along the normal, by an amount proportional to the world size of a texel
+    float4 position = mul(shadow.ViewProj, float4(P, 1.0f));
+    float offset = shadow.NormalOffset * (shadow.Perspective > 0.0f ? position.w : 1.0f);
+    position = mul(shadow.ViewProj, float4(P + N * offset, 1.0f));
+
+    float3 ndc = position.xyz / position.w;
+    if(any(abs(ndc.xy) > 1.0f) || ndc.z > 1.0f)
+        return 1.0f;
+
+    // Samples are kept inside the area of the shadow map in the atlas
+    float2 uv = ndc.xy * shadow.NDCToUV.xy + shadow.NDCToUV.zw;
+    float2 uvMin = shadow.NDCToUV.zw - abs(shadow.NDCToUV.xy) + gShadowAtlasSize.zw * 0.5f;
+    float2 uvMax = shadow.NDCToUV.zw + abs(shadow.NDCToUV.xy) - gShadowAtlasSize.zw * 0.5f;
+
+    int radius = gShadowFilterQuality / 2;
+    float staticLight = 0.0f;
+    float dynamicLight = 0.0f;
+    float numSamples = 0.0f;
+
+    for( int y = -radius; y <= radius; ++y )
+    {
+        for( int x = -radius; x <= radius; ++x )
+        {
+            float2 sampleUV = clamp(uv + float2(x, y) * gShadowAtlasSize.zw, uvMin, uvMax);
+
+            // Layers without casters let all the light through
+            if(shadow.Layers & 1)
+                staticLight += StaticShadowAtlas.SampleCmpLevelZero(ShadowSampler, sampleUV, ndc.z);
+            else
+                staticLight += 1.0f;
+
+            if(shadow.Layers & 2)
+                dynamicLight += ShadowAtlas.SampleCmpLevelZero(ShadowSampler, sampleUV, ndc.z);
+            else
+                dynamicLight += 1.0f;
+
+            numSamples += 1.0f;
+        }
+    }
+
+    return min(staticLight, dynamicLight) / numSamples;
+}
+
+// Fraction of the light of a directional light reaching a position, from the cascade containing it
+// P : position vector in world space
+// N : surface normal
+float GetDirectionalShadow( LightData light, float3 P, float3 N )
+{
+    if(!gShadowsEnabled || light.ShadowIdx < 0.0f)
+        return 1.0f;
+
+    float depth = -mul(gMatView, float4(P, 1.0f)).z;
+    uint first = (uint)gCascadeOffset + (uint)light.ShadowIdx * (uint)gNumCascades;
+
+    for( int i = 0; i < gNumCascades; ++i )
+    {
+        ShadowData shadow = LoadShadow(first + i);
+        if(depth < shadow.SplitDepth)
+            return SampleShadowMap(shadow, P, N);
+    }
+
+    return 1.0f;
+}
+
+// Fraction of the light of a radial or spot light reaching a position
+// P : position vector in world space
+// N : surface normal
+float GetLocalShadow( LightData light, float3 P, float3 N )
+{
+    if(!gShadowsEnabled || light.ShadowIdx < 0.0f)
+        return 1.0f;
+
+    uint index = (uint)light.ShadowIdx;
+
+    // Radial lights have one shadow map per cube face, ordered +X, -X, +Y, -Y, +Z, -Z
+    if(light.Type == POINT_LIGHT)
+    {
+        float3 L = P - light.Position;
+        float3 a = abs(L);
+
+        if(a.x >= a.y && a.x >= a.z)
+            index += L.x >= 0.0f ? 0 : 1;
+        else if(a.y >= a.z)
+            index += L.y >= 0.0f ? 2 : 3;
+        else
+            index += L.z >= 0.0f ? 4 : 5;
+    }
+
+    return SampleShadowMap(LoadShadow(index), P, N);
+}
+
+// Index of the light grid cluster containing a pixel
+// pixel : SV_Position of the pixel
+// P : position vector in world space
+uint GetLightCluster( float2 pixel, float3 P )
+{
+    float depth = -mul(gMatView, float4(P, 1.0f)).z;
+    float slice = gLightGridSlicing.z > 0.0f ? log2(max(depth, 1e-5f)) : depth;
+    slice = slice * gLightGridSlicing.x + gLightGridSlicing.y;
+
+    uint3 cluster;
+    cluster.xy = min((uint2)pixel / (uint)gLightGrid.w, (uint2)gLightGrid.xy - 1);
+    cluster.z = (uint)clamp(slice, 0.0f, (float)(gLightGrid.z - 1));
+
+    return (cluster.z * gLightGrid.y + cluster.y) * gLightGrid.x + cluster.x;
+}
+
 // P : position vector in world space
 // N : normal
-LightingResult ComputeLighting( float3 P, float3 N, bool castLight )
+// pixel : SV_Position of the pixel, to find the lights of its cluster
+LightingResult ComputeLighting( float3 P, float3 N, float2 pixel, bool castLight )
 {
     LightingResult totalResult = { {0, 0, 0}, {0, 0, 0} };
 
@@ -306,17 +497,34 @@ LightingResult ComputeLighting( float3 P, float3 N, bool castLight )
     {
         float3 V = normalize( gViewOrigin - P );
 
-        [unroll]
-        for( uint i = 0; i < gLightsNumber; ++i )
+        for( uint i = 0; i < gNumDirLights; ++i )
+        {
+            LightData light = LoadLight(i);
+            LightingResult result = DoDirectionalLight( light, V, P, N );
+            float shadow = GetDirectionalShadow( light, P, N );
+
+            totalResult.Diffuse += result.Diffuse * shadow;
+            totalResult.Specular += result.Specular * shadow;
+        }
+
+        uint2 range = ClusterLightRanges[GetLightCluster(pixel, P)];
+
+        for( uint j = 0; j < range.y; ++j )
         {
+            LightData light = LoadLight(ClusterLightIndices[range.x + j]);
             LightingResult result = { {0, 0, 0}, {0, 0, 0} };
 
-            if(gLights[i].Type == DIRECTIONAL_LIGHT)
-                result = DoDirectionalLight( gLights[i], V, P, N );
-            else if(gLights[i].Type == POINT_LIGHT)
-                result = DoPointLight( gLights[i], V, P, N );
-            else if(gLights[i].Type == SPOT_LIGHT)
-                result = DoSpotLight( gLights[i], V, P, N );
+            if(light.Type == POINT_LIGHT)
+                result = DoPointLight( light, V, P, N );
+            else if(light.Type == SPOT_LIGHT)
+                result = DoSpotLight( light, V, P, N );
+
+            if(any(result.Diffuse + result.Specular > 0.0f))
+            {
+                float shadow = GetLocalShadow( light, P, N );
+                result.Diffuse *= shadow;
+                result.Specular *= shadow;
+            }
 
             totalResult.Diffuse += result.Diffuse;
             totalResult.Specular += result.Specular;
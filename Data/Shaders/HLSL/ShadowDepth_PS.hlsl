@@ -0,0 +1,9 @@
+struct PS_INPUT
+{
+    float4 Position : SV_POSITION;
+};
+
+// Only depth is written
+void main( PS_INPUT IN )
+{
+}
@@ -0,0 +1,39 @@
+#include "Include/Skinning.hlsli"
+
+cbuffer PerShadowBuffer : register(b0)
+{
+    matrix gMatViewProj;
+}
+
+cbuffer PerObjectBuffer : register(b1)
+{
+    matrix gMatWorld;
+    uint   gHasAnimation;
+}
+
+struct VS_INPUT
+{
+    float3 Position : POSITION;
+    float4 BlendWeights : BLENDWEIGHT;
+    uint4  BlendIndices : BLENDINDICES;
+};
+
+struct VS_OUTPUT
+{
+    float4 Position : SV_POSITION;
+};
+
+VS_OUTPUT main( VS_INPUT IN )
+{
+    VS_OUTPUT OUT = (VS_OUTPUT)0;
+
+    OUT.Position = float4(IN.Position, 1.0f);
+
+    if(gHasAnimation)
+        OUT.Position = mul(GetBlendMatrix(IN.BlendWeights, IN.BlendIndices), OUT.Position);
+
+    OUT.Position = mul(gMatWorld, OUT.Position);
+    OUT.Position = mul(gMatViewProj, OUT.Position);
+
+    return OUT;
+}
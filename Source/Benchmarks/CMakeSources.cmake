@@ -0,0 +1,22 @@
+set (TE_BENCHMARKS_INC_NOFILTER
+    "TeBenchmark.h"
+)
+
+set (TE_BENCHMARKS_SRC_NOFILTER
+    "Main.cpp"
+    "TeBenchmark.cpp"
+    "TeMathBenchmarks.cpp"
+    "TeImageBenchmarks.cpp"
+    "TeAllocatorBenchmarks.cpp"
+    "TeThreadingBenchmarks.cpp"
+    "TeAnimationBenchmarks.cpp"
+    "TeSceneBenchmarks.cpp"
+    "TeRenderBenchmarks.cpp"
+)
+
+source_group ("" FILES ${TE_BENCHMARKS_SRC_NOFILTER} ${TE_BENCHMARKS_INC_NOFILTER})
+
+set (TE_BENCHMARKS_SRC
+    ${TE_BENCHMARKS_INC_NOFILTER}
+    ${TE_BENCHMARKS_SRC_NOFILTER}
+)
@@ -0,0 +1,99 @@
+#include "TeBenchmark.h"
+#include "CoreUtility/TeCoreObjectManager.h"
+#include "Resources/TeResourceManager.h"
+#include "Animation/TeAnimationManager.h"
+#include "Scene/TeGameObjectManager.h"
+#include "Scene/TeSceneManager.h"
+#include "Threading/TeTaskScheduler.h"
+
+#include <iostream>
+#include <fstream>
+
+using namespace te;
+
+/**
+ * Headless benchmark runner. Only the modules required by the measured systems are started, so no window, render API
+ * or plugin is needed.
+ *
+ * Usage: TeBenchmarks [--list] [--filter=<text>] [--samples=<count>] [--min-sample-ms=<ms>] [--output=<file>]
+ *
+ * Progress is printed to stderr, the JSON report is written to stdout unless an output file is provided.
+ */
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    String outputPath;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const String arg = argv[i];
+        auto value = [&arg]() { return arg.substr(arg.find('=') + 1); };
+
+        if (arg == "--list")
+            listOnly = true;
+        else if (arg.rfind("--filter=", 0) == 0)
+            options.Filter = value();
+        else if (arg.rfind("--samples=", 0) == 0)
+            options.NumSamples = (UINT32)std::stoul(value().c_str());
+        else if (arg.rfind("--min-sample-ms=", 0) == 0)
+            options.MinSampleTimeMs = std::stod(value().c_str());
+        else if (arg.rfind("--output=", 0) == 0)
+            outputPath = value();
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    CoreObjectManager::StartUp();
+    ResourceManager::StartUp();
+    GameObjectManager::StartUp();
+    TaskScheduler::StartUp();
+    SceneManager::StartUp();
+    AnimationManager::StartUp();
+
+    int result = 0;
+    {
+        BenchmarkSuite suite;
+        RegisterMathBenchmarks(suite);
+        RegisterImageBenchmarks(suite);
+        RegisterAllocatorBenchmarks(suite);
+        RegisterThreadingBenchmarks(suite);
+        RegisterAnimationBenchmarks(suite);
+        RegisterSceneBenchmarks(suite);
+        RegisterRenderBenchmarks(suite);
+
+        if (listOnly)
+            suite.List();
+        else
+        {
+            suite.Run(options);
+
+            const String json = suite.ToJson();
+            if (outputPath.empty())
+                std::cout << json << std::endl;
+            else
+            {
+                std::ofstream file(outputPath.c_str());
+                if (file)
+                    file << json << std::endl;
+                else
+                {
+                    std::cerr << "Could not open output file: " << outputPath << std::endl;
+                    result = 1;
+                }
+            }
+        }
+    }
+
+    AnimationManager::ShutDown();
+    SceneManager::ShutDown();
+    TaskScheduler::ShutDown();
+    GameObjectManager::ShutDown();
+    ResourceManager::ShutDown();
+    CoreObjectManager::ShutDown();
+
+    return result;
+}
@@ -0,0 +1,103 @@
+#include "TeBenchmark.h"
+#include "Utility/TeFrameAllocator.h"
+#include "Utility/TePoolAllocator.h"
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 NUM_ALLOCATIONS = 4096;
+        const UINT32 POOL_ELEM_SIZE = 64;
+
+        typedef PoolAllocator<POOL_ELEM_SIZE> BenchmarkPool;
+
+        /** Element type for the global pool benchmark, the same size as the local pool elements. */
+        struct BenchmarkPoolElement
+        {
+            UINT8 Data[POOL_ELEM_SIZE];
+        };
+
+        /** Order in which allocations get freed, shuffled deterministically to defeat LIFO friendly allocators. */
+        Vector<UINT32> CreateShuffledOrder(UINT32 count)
+        {
+            Vector<UINT32> order(count);
+            for (UINT32 i = 0; i < count; i++)
+                order[i] = i;
+
+            UINT32 state = 0x9E3779B9;
+            for (UINT32 i = count - 1; i > 0; i--)
+            {
+                state = state * 1664525u + 1013904223u;
+                std::swap(order[i], order[state % (i + 1)]);
+            }
+
+            return order;
+        }
+    }
+
+    IMPLEMENT_GLOBAL_POOL(BenchmarkPoolElement, 512)
+
+    void RegisterAllocatorBenchmarks(BenchmarkSuite& suite)
+    {
+        auto pointers = te_shared_ptr_new<Vector<void*>>(NUM_ALLOCATIONS);
+        auto shuffled = te_shared_ptr_new<Vector<UINT32>>(CreateShuffledOrder(NUM_ALLOCATIONS));
+
+        suite.Add("Allocators", "GeneralAllocFree", NUM_ALLOCATIONS, [pointers]()
+        {
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                (*pointers)[i] = te_allocate(16 + (i % 8) * 16);
+
+            DoNotOptimize(pointers->data());
+
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                te_free((*pointers)[i]);
+        });
+
+        auto frameAlloc = te_shared_ptr_new<FrameAllocator>();
+        suite.Add("Allocators", "FrameAllocMarkClear", NUM_ALLOCATIONS, [frameAlloc, pointers]()
+        {
+            frameAlloc->MarkFrame();
+
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                (*pointers)[i] = frameAlloc->Allocate(16 + (i % 8) * 16);
+
+            DoNotOptimize(pointers->data());
+            frameAlloc->Clear();
+        });
+
+        auto pool = te_shared_ptr_new<BenchmarkPool>();
+        suite.Add("Allocators", "PoolAllocFreeLIFO", NUM_ALLOCATIONS, [pool, pointers]()
+        {
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                (*pointers)[i] = pool->Allocate();
+
+            DoNotOptimize(pointers->data());
+
+            for (UINT32 i = NUM_ALLOCATIONS; i > 0; i--)
+                pool->Free((*pointers)[i - 1]);
+        });
+
+        suite.Add("Allocators", "PoolAllocFreeShuffled", NUM_ALLOCATIONS, [pool, pointers, shuffled]()
+        {
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                (*pointers)[i] = pool->Allocate();
+
+            DoNotOptimize(pointers->data());
+
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                pool->Free((*pointers)[(*shuffled)[i]]);
+        });
+
+        // Thread safe global pool, as used by te_pool_new(), going through the per thread cache
+        suite.Add("Allocators", "GlobalPoolAllocFreeShuffled", NUM_ALLOCATIONS, [pointers, shuffled]()
+        {
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                (*pointers)[i] = te_pool_allocate<BenchmarkPoolElement>();
+
+            DoNotOptimize(pointers->data());
+
+            for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+                te_pool_free((BenchmarkPoolElement*)(*pointers)[(*shuffled)[i]]);
+        });
+    }
+}
@@ -0,0 +1,101 @@
+#include "TeBenchmark.h"
+#include "Animation/TeAnimation.h"
+#include "Animation/TeAnimationManager.h"
+#include "Animation/TeSkeleton.h"
+#include "Animation/TeAnimationClip.h"
+#include "Animation/TeAnimationCurve.h"
+#include "Math/TeMath.h"
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 NUM_BONES = 64;
+        const UINT32 NUM_INSTANCES = 128;
+        const UINT32 NUM_KEYFRAMES = 30;
+        const float CLIP_LENGTH = 1.0f;
+
+        /** Skeleton shaped like a binary tree, so both deep chains and siblings are exercised. */
+        SPtr<Skeleton> CreateSkeleton()
+        {
+            Vector<BONE_DESC> bones(NUM_BONES);
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+            {
+                bones[i].Name = "Bone" + ToString(i);
+                bones[i].Parent = i == 0 ? (UINT32)-1 : (i - 1) / 2;
+                bones[i].LocalTfrm.SetPosition(Vector3(0.0f, 0.5f, 0.0f));
+                bones[i].InvBindPose = Matrix4::TRS(Vector3(0.0f, -0.5f * (float)i, 0.0f), Quaternion::IDENTITY,
+                    Vector3::ONE);
+            }
+
+            return Skeleton::Create(bones.data(), NUM_BONES);
+        }
+
+        /** Clip animating position and rotation of every bone, like typical imported character animation. */
+        HAnimationClip CreateClip()
+        {
+            SPtr<AnimationCurves> curves = te_shared_ptr_new<AnimationCurves>();
+
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+            {
+                Vector<TKeyframe<Vector3>> positionKeys(NUM_KEYFRAMES);
+                Vector<TKeyframe<Quaternion>> rotationKeys(NUM_KEYFRAMES);
+
+                for (UINT32 j = 0; j < NUM_KEYFRAMES; j++)
+                {
+                    float t = j / (float)(NUM_KEYFRAMES - 1) * CLIP_LENGTH;
+                    float phase = t * Math::TWO_PI + (float)i;
+
+                    positionKeys[j].Value = Vector3(0.0f, 0.5f + 0.05f * Math::Sin(phase), 0.0f);
+                    positionKeys[j].TimeInSpline = t;
+
+                    rotationKeys[j].Value = Quaternion(Vector3::UNIT_Z, Radian(0.3f * Math::Sin(phase)));
+                    rotationKeys[j].TimeInSpline = t;
+                }
+
+                const String name = "Bone" + ToString(i);
+                curves->AddPositionCurve(name, TAnimationCurve<Vector3>(positionKeys));
+                curves->AddRotationCurve(name, TAnimationCurve<Quaternion>(rotationKeys));
+            }
+
+            return AnimationClip::Create(curves, false, (float)NUM_KEYFRAMES / CLIP_LENGTH);
+        }
+
+        /** Data shared by all animation benchmarks. */
+        struct AnimationBenchmarkData
+        {
+            SPtr<Skeleton> SkeletonPtr;
+            HAnimationClip Clip;
+            Vector<SPtr<Animation>> Animations;
+        };
+    }
+
+    void RegisterAnimationBenchmarks(BenchmarkSuite& suite)
+    {
+        auto data = te_shared_ptr_new<AnimationBenchmarkData>();
+        data->SkeletonPtr = CreateSkeleton();
+        data->Clip = CreateClip();
+
+        // Crowd of skinned characters sharing a clip, at different times. There is no camera, so culling is disabled.
+        for (UINT32 i = 0; i < NUM_INSTANCES; i++)
+        {
+            SPtr<Animation> animation = Animation::Create();
+            animation->SetSkeleton(data->SkeletonPtr);
+            animation->SetCulling(false);
+            animation->Play(data->Clip);
+
+            AnimationClipState state;
+            state.Time = (float)i / NUM_INSTANCES * CLIP_LENGTH;
+            animation->SetState(data->Clip, state);
+
+            data->Animations.push_back(animation);
+        }
+
+        // Work done by AnimationManager::Update() each frame animations are due for evaluation
+        suite.Add("Animation", "ManagerEvaluate", NUM_BONES * NUM_INSTANCES, [data]()
+        {
+            const EvaluatedAnimationData* animData = gAnimationManager().Evaluate(1.0f / 60.0f);
+            DoNotOptimize(animData->Transforms.data());
+        });
+    }
+}
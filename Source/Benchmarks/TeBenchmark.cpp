@@ -0,0 +1,131 @@
+#include "TeBenchmark.h"
+#include "Utility/TeTimer.h"
+#include "Threading/TeThreading.h"
+#include "Json/json.h"
+
+#include <iostream>
+
+namespace te
+{
+    void BenchmarkSuite::Add(const String& category, const String& name, UINT64 itemsPerIteration, BenchmarkFunc func)
+    {
+        _entries.push_back({ category, name, std::max<UINT64>(itemsPerIteration, 1), std::move(func) });
+    }
+
+    void BenchmarkSuite::Run(const BenchmarkOptions& options)
+    {
+        _results.clear();
+
+        for (auto& entry : _entries)
+        {
+            const String fullName = entry.Category + "/" + entry.Name;
+            if (!options.Filter.empty() && fullName.find(options.Filter) == String::npos)
+                continue;
+
+            std::cerr << fullName << "... " << std::flush;
+
+            BenchmarkResult result = Measure(entry, options);
+            std::cerr << result.MedianNs << " ns/iteration" << std::endl;
+
+            _results.push_back(result);
+        }
+    }
+
+    void BenchmarkSuite::List() const
+    {
+        for (auto& entry : _entries)
+            std::cout << entry.Category << "/" << entry.Name << std::endl;
+    }
+
+    BenchmarkResult BenchmarkSuite::Measure(const Entry& entry, const BenchmarkOptions& options) const
+    {
+        auto elapsedNs = [](const TimePoint& start)
+        {
+            return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        };
+
+        // Warm up caches and allocators, and estimate the cost of a single iteration at the same time
+        UINT64 warmupIterations = 0;
+        TimePoint start = Clock::now();
+        do
+        {
+            entry.Func();
+            warmupIterations++;
+        } while (elapsedNs(start) < options.WarmupTimeMs * 1000000.0);
+
+        const double estimatedNs = std::max(elapsedNs(start) / (double)warmupIterations, 1.0);
+        const UINT64 iterations = std::max<UINT64>((UINT64)(options.MinSampleTimeMs * 1000000.0 / estimatedNs), 1);
+        const UINT32 numSamples = std::max<UINT32>(options.NumSamples, 1);
+
+        Vector<double> samples(numSamples);
+        for (UINT32 i = 0; i < numSamples; i++)
+        {
+            start = Clock::now();
+            for (UINT64 j = 0; j < iterations; j++)
+                entry.Func();
+
+            samples[i] = elapsedNs(start) / (double)iterations;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        BenchmarkResult result;
+        result.Category = entry.Category;
+        result.Name = entry.Name;
+        result.ItemsPerIteration = entry.ItemsPerIteration;
+        result.IterationsPerSample = iterations;
+        result.NumSamples = numSamples;
+        result.MinNs = samples.front();
+        result.MaxNs = samples.back();
+        result.MedianNs = (numSamples % 2) ? samples[numSamples / 2]
+            : (samples[numSamples / 2 - 1] + samples[numSamples / 2]) * 0.5;
+
+        for (auto& sample : samples)
+            result.MeanNs += sample;
+        result.MeanNs /= (double)numSamples;
+
+        result.ItemsPerSecond = (double)entry.ItemsPerIteration * 1000000000.0 / std::max(result.MedianNs, 0.001);
+
+        return result;
+    }
+
+    String BenchmarkSuite::ToJson() const
+    {
+        nlohmann::json document;
+        document["version"] = TE_VERSION;
+        document["threads"] = TE_THREAD_HARDWARE_CONCURRENCY;
+
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        document["platform"] = "Win32";
+#else
+        document["platform"] = "Linux";
+#endif
+
+#if TE_DEBUG_MODE
+        document["configuration"] = "Debug";
+#else
+        document["configuration"] = "Release";
+#endif
+
+        nlohmann::json benchmarks = nlohmann::json::array();
+        for (auto& result : _results)
+        {
+            nlohmann::json entry;
+            entry["category"] = result.Category.c_str();
+            entry["name"] = result.Name.c_str();
+            entry["items_per_iteration"] = result.ItemsPerIteration;
+            entry["iterations_per_sample"] = result.IterationsPerSample;
+            entry["samples"] = result.NumSamples;
+            entry["min_ns"] = result.MinNs;
+            entry["median_ns"] = result.MedianNs;
+            entry["mean_ns"] = result.MeanNs;
+            entry["max_ns"] = result.MaxNs;
+            entry["items_per_second"] = result.ItemsPerSecond;
+
+            benchmarks.push_back(entry);
+        }
+
+        document["benchmarks"] = benchmarks;
+        return String(document.dump(4).c_str());
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+#if TE_COMPILER == TE_COMPILER_MSVC
+#   include <intrin.h>
+#endif
+
+namespace te
+{
+    /** Statistics gathered for a single benchmark. All timings are per iteration, in nanoseconds. */
+    struct BenchmarkResult
+    {
+        String Category;
+        String Name;
+        UINT64 ItemsPerIteration = 1; /**< Number of items (matrices, pixels, objects, ...) processed by one iteration. */
+        UINT64 IterationsPerSample = 0;
+        UINT32 NumSamples = 0;
+
+        double MinNs = 0.0;
+        double MedianNs = 0.0;
+        double MeanNs = 0.0;
+        double MaxNs = 0.0;
+        double ItemsPerSecond = 0.0; /**< Throughput computed from the median timing. */
+    };
+
+    /** Options controlling how benchmarks are run. */
+    struct BenchmarkOptions
+    {
+        String Filter; /**< Only benchmarks whose "Category/Name" contains this string are run. Empty runs all. */
+        UINT32 NumSamples = 10; /**< Number of timed samples taken for each benchmark. */
+        double MinSampleTimeMs = 20.0; /**< Iterations per sample are scaled so that a sample lasts at least this long. */
+        double WarmupTimeMs = 50.0; /**< Time spent running a benchmark before any sample is taken. */
+    };
+
+    /**
+     * Holds a set of benchmarks, runs them and reports results as JSON. Each benchmark is a function performing one
+     * iteration of the measured work. Setup should happen when the benchmark is registered (state is usually captured
+     * by the function) so only the work itself is timed.
+     */
+    class BenchmarkSuite
+    {
+    public:
+        typedef std::function<void()> BenchmarkFunc;
+
+        /**
+         * Registers a new benchmark.
+         *
+         * @param[in]	category			Group the benchmark belongs to (e.g. "Math").
+         * @param[in]	name				Name of the benchmark, unique within the category.
+         * @param[in]	itemsPerIteration	Number of items processed by one call to @p func, used to compute throughput.
+         * @param[in]	func				Function performing a single iteration of the benchmark.
+         */
+        void Add(const String& category, const String& name, UINT64 itemsPerIteration, BenchmarkFunc func);
+
+        /** Runs all registered benchmarks accepted by the filter of @p options, replacing any previous results. */
+        void Run(const BenchmarkOptions& options);
+
+        /** Prints "Category/Name" of every registered benchmark, one per line. */
+        void List() const;
+
+        /** Returns results of the last call to Run(). */
+        const Vector<BenchmarkResult>& GetResults() const { return _results; }
+
+        /** Serializes results of the last call to Run() to a JSON document. */
+        String ToJson() const;
+
+    private:
+        /** Registered benchmark. */
+        struct Entry
+        {
+            String Category;
+            String Name;
+            UINT64 ItemsPerIteration;
+            BenchmarkFunc Func;
+        };
+
+        /** Runs a single benchmark and gathers its statistics. */
+        BenchmarkResult Measure(const Entry& entry, const BenchmarkOptions& options) const;
+
+    private:
+        Vector<Entry> _entries;
+        Vector<BenchmarkResult> _results;
+    };
+
+    /**
+     * Prevents the compiler from optimizing away the computation of @p value when the result is otherwise unused by the
+     * benchmark.
+     */
+    template<class T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if TE_COMPILER == TE_COMPILER_MSVC
+        static const void* volatile sink;
+        sink = &value;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r"(&value) : "memory");
+#endif
+    }
+
+    void RegisterMathBenchmarks(BenchmarkSuite& suite);
+    void RegisterImageBenchmarks(BenchmarkSuite& suite);
+    void RegisterAllocatorBenchmarks(BenchmarkSuite& suite);
+    void RegisterThreadingBenchmarks(BenchmarkSuite& suite);
+    void RegisterAnimationBenchmarks(BenchmarkSuite& suite);
+    void RegisterSceneBenchmarks(BenchmarkSuite& suite);
+    void RegisterRenderBenchmarks(BenchmarkSuite& suite);
+}
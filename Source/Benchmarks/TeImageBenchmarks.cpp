@@ -0,0 +1,46 @@
+#include "TeBenchmark.h"
+#include "Image/TePixelData.h"
+#include "Image/TePixelUtil.h"
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 IMAGE_SIZE = 512;
+
+        /** Creates an image filled with a deterministic pattern. */
+        SPtr<PixelData> CreateImage(PixelFormat format)
+        {
+            SPtr<PixelData> image = PixelData::Create(IMAGE_SIZE, IMAGE_SIZE, 1, format);
+
+            UINT8* data = image->GetData();
+            const UINT32 size = image->GetSize();
+            for (UINT32 i = 0; i < size; i++)
+                data[i] = (UINT8)((i * 2654435761u) >> 24);
+
+            return image;
+        }
+
+        /** Registers a conversion from @p srcFormat to @p dstFormat of a IMAGE_SIZE x IMAGE_SIZE image. */
+        void AddConversion(BenchmarkSuite& suite, const String& name, PixelFormat srcFormat, PixelFormat dstFormat)
+        {
+            SPtr<PixelData> src = CreateImage(srcFormat);
+            SPtr<PixelData> dst = PixelData::Create(IMAGE_SIZE, IMAGE_SIZE, 1, dstFormat);
+
+            suite.Add("Image", name, IMAGE_SIZE * IMAGE_SIZE, [src, dst]()
+            {
+                PixelUtil::BulkPixelConversion(*src, *dst);
+                DoNotOptimize(dst->GetData());
+            });
+        }
+    }
+
+    void RegisterImageBenchmarks(BenchmarkSuite& suite)
+    {
+        AddConversion(suite, "BulkPixelConversion_RGBA8_RGBA8", PF_RGBA8, PF_RGBA8);
+        AddConversion(suite, "BulkPixelConversion_RGBA8_BGRA8", PF_RGBA8, PF_BGRA8);
+        AddConversion(suite, "BulkPixelConversion_RGB8_RGBA8", PF_RGB8, PF_RGBA8);
+        AddConversion(suite, "BulkPixelConversion_RGBA8_RGBA32F", PF_RGBA8, PF_RGBA32F);
+        AddConversion(suite, "BulkPixelConversion_RGBA32F_RGBA16F", PF_RGBA32F, PF_RGBA16F);
+    }
+}
@@ -0,0 +1,121 @@
+#include "TeBenchmark.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeConvexVolume.h"
+#include "Math/TeAABox.h"
+#include "Math/TeSphere.h"
+#include "Math/TeQuaternion.h"
+#include "Math/TeMath.h"
+#include "Math/TeSIMD.h"
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 NUM_MATRICES = 1024;
+        const UINT32 NUM_VOLUMES = 4096;
+
+        /** Deterministic set of TRS matrices, so results are comparable between runs. */
+        Vector<Matrix4> CreateMatrices(UINT32 count, UINT32 seed)
+        {
+            Vector<Matrix4> output(count);
+            for (UINT32 i = 0; i < count; i++)
+            {
+                float t = (float)(i + seed);
+                Vector3 position(Math::Sin(t) * 10.0f, Math::Cos(t * 0.7f) * 10.0f, t * 0.01f);
+                Quaternion rotation(Vector3::Normalize(Vector3(0.3f, 1.0f, 0.2f)), Radian(t * 0.1f));
+                Vector3 scale(1.0f + 0.1f * Math::Sin(t), 1.0f, 1.0f + 0.1f * Math::Cos(t));
+
+                output[i] = Matrix4::TRS(position, rotation, scale);
+            }
+
+            return output;
+        }
+
+        /** Camera frustum looking down the negative Z axis from the origin. */
+        ConvexVolume CreateFrustum()
+        {
+            Matrix4 proj = Matrix4::ProjectionPerspective(Degree(75.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+            return ConvexVolume(proj);
+        }
+
+        /** Boxes spread on a grid in front of and behind the camera, so roughly half of them get culled. */
+        Vector<AABox> CreateBoxes(UINT32 count)
+        {
+            Vector<AABox> output(count);
+            for (UINT32 i = 0; i < count; i++)
+            {
+                float x = (float)(i % 64) * 8.0f - 256.0f;
+                float z = (float)(i / 64) * 8.0f - 256.0f;
+                Vector3 center(x, Math::Sin((float)i) * 4.0f, z);
+
+                output[i] = AABox(center - Vector3(1.0f, 1.0f, 1.0f), center + Vector3(1.0f, 1.0f, 1.0f));
+            }
+
+            return output;
+        }
+    }
+
+    void RegisterMathBenchmarks(BenchmarkSuite& suite)
+    {
+        auto lhs = te_shared_ptr_new<Vector<Matrix4>>(CreateMatrices(NUM_MATRICES, 0));
+        auto rhs = te_shared_ptr_new<Vector<Matrix4>>(CreateMatrices(NUM_MATRICES, 1234));
+        auto output = te_shared_ptr_new<Vector<Matrix4>>(NUM_MATRICES);
+
+        suite.Add("Math", "Matrix4Multiply", NUM_MATRICES, [lhs, rhs, output]()
+        {
+            for (UINT32 i = 0; i < NUM_MATRICES; i++)
+                (*output)[i] = (*lhs)[i] * (*rhs)[i];
+
+            DoNotOptimize(output->data());
+        });
+
+        suite.Add("Math", "Matrix4MultiplySIMD", NUM_MATRICES, [lhs, rhs, output]()
+        {
+            for (UINT32 i = 0; i < NUM_MATRICES; i++)
+                SIMD::Multiply((*lhs)[i], (*rhs)[i], (*output)[i]);
+
+            DoNotOptimize(output->data());
+        });
+
+        suite.Add("Math", "Matrix4Inverse", NUM_MATRICES, [lhs, output]()
+        {
+            for (UINT32 i = 0; i < NUM_MATRICES; i++)
+                (*output)[i] = (*lhs)[i].Inverse();
+
+            DoNotOptimize(output->data());
+        });
+
+        suite.Add("Math", "Matrix4InverseAffine", NUM_MATRICES, [lhs, output]()
+        {
+            for (UINT32 i = 0; i < NUM_MATRICES; i++)
+                (*output)[i] = (*lhs)[i].InverseAffine();
+
+            DoNotOptimize(output->data());
+        });
+
+        auto frustum = te_shared_ptr_new<ConvexVolume>(CreateFrustum());
+        auto boxes = te_shared_ptr_new<Vector<AABox>>(CreateBoxes(NUM_VOLUMES));
+        auto spheres = te_shared_ptr_new<Vector<Sphere>>(NUM_VOLUMES);
+
+        for (UINT32 i = 0; i < NUM_VOLUMES; i++)
+            (*spheres)[i] = Sphere((*boxes)[i].GetCenter(), (*boxes)[i].GetRadius());
+
+        suite.Add("Math", "ConvexVolumeIntersectsAABox", NUM_VOLUMES, [frustum, boxes]()
+        {
+            UINT32 numVisible = 0;
+            for (auto& box : *boxes)
+                numVisible += frustum->Intersects(box) ? 1 : 0;
+
+            DoNotOptimize(numVisible);
+        });
+
+        suite.Add("Math", "ConvexVolumeIntersectsSphere", NUM_VOLUMES, [frustum, spheres]()
+        {
+            UINT32 numVisible = 0;
+            for (auto& sphere : *spheres)
+                numVisible += frustum->Intersects(sphere) ? 1 : 0;
+
+            DoNotOptimize(numVisible);
+        });
+    }
+}
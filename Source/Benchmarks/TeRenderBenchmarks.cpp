@@ -0,0 +1,63 @@
+#include "TeBenchmark.h"
+#include "Renderer/TeRendererCulling.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeMath.h"
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 GRID_SIZE = 32;
+        const UINT32 NUM_RENDERABLES = GRID_SIZE * GRID_SIZE * 16;
+        const float CULL_DISTANCE = 300.0f;
+
+        /** Synthetic scene: a large field of objects around the camera, on a few layers and with varying sizes. */
+        Vector<CullInfo> CreateScene()
+        {
+            Vector<CullInfo> output;
+            output.reserve(NUM_RENDERABLES);
+
+            for (UINT32 i = 0; i < NUM_RENDERABLES; i++)
+            {
+                float x = (float)(i % GRID_SIZE) * 20.0f - GRID_SIZE * 10.0f;
+                float z = (float)((i / GRID_SIZE) % GRID_SIZE) * 20.0f - GRID_SIZE * 10.0f;
+                float y = (float)(i / (GRID_SIZE * GRID_SIZE)) * 5.0f;
+                float extent = 0.5f + (float)(i % 7) * 0.5f;
+
+                Vector3 center(x, y, z);
+                AABox box(center - Vector3(extent, extent, extent), center + Vector3(extent, extent, extent));
+                Sphere sphere(center, box.GetRadius());
+
+                output.push_back(CullInfo(Bounds(box, sphere), (UINT64)1 << (i % 4), (i % 5) == 0 ? 0.5f : 1.0f));
+            }
+
+            return output;
+        }
+
+        /** Data shared by render benchmarks. */
+        struct RenderBenchmarkData
+        {
+            Vector<CullInfo> CullInfos;
+            Vector<RenderableVisibility> Visibility;
+            ConvexVolume Frustum;
+            Vector3 CameraPosition = Vector3::ZERO;
+        };
+    }
+
+    void RegisterRenderBenchmarks(BenchmarkSuite& suite)
+    {
+        auto data = te_shared_ptr_new<RenderBenchmarkData>();
+        data->CullInfos = CreateScene();
+        data->Frustum = ConvexVolume(Matrix4::ProjectionPerspective(Degree(75.0f), 16.0f / 9.0f, 0.1f, 1000.0f));
+
+        // Culling RendererView::DetermineVisible() runs for each view and each frame
+        suite.Add("Render", "FrustumCulling", data->CullInfos.size(), [data]()
+        {
+            data->Visibility.assign(data->CullInfos.size(), RenderableVisibility());
+            RendererCulling::CalculateVisibility(data->CullInfos, 0x7, data->Frustum, data->CameraPosition,
+                CULL_DISTANCE, data->Visibility);
+
+            DoNotOptimize(data->Visibility.data());
+        });
+    }
+}
@@ -0,0 +1,121 @@
+#include "TeBenchmark.h"
+#include "Scene/TeSceneObject.h"
+#include "Scene/TeGameObjectManager.h"
+#include "Scene/TeSceneManager.h"
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 BRANCHING = 16;
+        const UINT32 DEPTH = 3;
+        const UINT32 NUM_CREATED_OBJECTS = 1024;
+
+        /** Builds a hierarchy where each object has BRANCHING children, DEPTH levels deep. */
+        void CreateHierarchy(const HSceneObject& parent, UINT32 depth, Vector<HSceneObject>& objects,
+            Vector<HSceneObject>& leaves)
+        {
+            for (UINT32 i = 0; i < BRANCHING; i++)
+            {
+                HSceneObject child = SceneObject::Create("Child");
+                child->SetParent(parent, false);
+                child->SetPosition(Vector3((float)i, 1.0f, 0.0f));
+                child->SetRotation(Quaternion(Vector3::UNIT_Y, Radian(0.1f * (float)i)));
+
+                objects.push_back(child);
+
+                if (depth > 1)
+                    CreateHierarchy(child, depth - 1, objects, leaves);
+                else
+                    leaves.push_back(child);
+            }
+        }
+
+        /** Hierarchy shared by scene benchmarks. */
+        struct SceneBenchmarkData
+        {
+            ~SceneBenchmarkData()
+            {
+                if (!Root.IsDestroyed())
+                    Root->Destroy(true);
+            }
+
+            HSceneObject Root;
+            Vector<HSceneObject> Objects;
+            Vector<HSceneObject> Leaves;
+            Vector<UINT64> InstanceIds;
+            float Time = 0.0f;
+        };
+    }
+
+    void RegisterSceneBenchmarks(BenchmarkSuite& suite)
+    {
+        auto data = te_shared_ptr_new<SceneBenchmarkData>();
+        data->Root = SceneObject::Create("Root");
+        CreateHierarchy(data->Root, DEPTH, data->Objects, data->Leaves);
+
+        for (auto& object : data->Objects)
+            data->InstanceIds.push_back(object->GetInstanceId());
+
+        // Moving the root dirties every object below it, then world transforms get resolved lazily when queried
+        suite.Add("Scene", "TransformPropagation", data->Objects.size(), [data]()
+        {
+            gSceneManager().SetBatchedTransforms(false);
+
+            data->Time += 0.01f;
+            data->Root->SetPosition(Vector3(data->Time, 0.0f, 0.0f));
+
+            for (auto& leaf : data->Leaves)
+                DoNotOptimize(leaf->GetWorldMatrix());
+        });
+
+        // Same as above, with changes resolved by the scene transform system
+        suite.Add("Scene", "TransformPropagationBatched", data->Objects.size(), [data]()
+        {
+            gSceneManager().SetBatchedTransforms(true);
+
+            data->Time += 0.01f;
+            data->Root->SetPosition(Vector3(data->Time, 0.0f, 0.0f));
+            gSceneManager().UpdateTransforms();
+
+            for (auto& leaf : data->Leaves)
+                DoNotOptimize(leaf->GetWorldMatrix());
+        });
+
+        // Same, but only one leaf moves so only a single world transform has to be recomputed
+        suite.Add("Scene", "TransformSingleLeaf", 1, [data]()
+        {
+            gSceneManager().SetBatchedTransforms(false);
+
+            data->Time += 0.01f;
+
+            const HSceneObject& leaf = data->Leaves[data->Leaves.size() / 2];
+            leaf->SetPosition(Vector3(data->Time, 0.0f, 0.0f));
+            DoNotOptimize(leaf->GetWorldMatrix());
+        });
+
+        suite.Add("Scene", "HandleResolve", data->InstanceIds.size(), [data]()
+        {
+            GameObjectManager& manager = GameObjectManager::Instance();
+
+            UINT32 numFound = 0;
+            for (auto& id : data->InstanceIds)
+                numFound += manager.ObjectExists(id) ? 1 : 0;
+
+            DoNotOptimize(numFound);
+        });
+
+        // Prefab-like instantiation and teardown of a flat hierarchy
+        suite.Add("Scene", "CreateDestroyObjects", NUM_CREATED_OBJECTS, []()
+        {
+            HSceneObject root = SceneObject::Create("Root");
+            for (UINT32 i = 0; i < NUM_CREATED_OBJECTS - 1; i++)
+            {
+                HSceneObject child = SceneObject::Create("Child");
+                child->SetParent(root, false);
+            }
+
+            root->Destroy(true);
+        });
+    }
+}
@@ -0,0 +1,69 @@
+#include "TeBenchmark.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeQuaternion.h"
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 NUM_EMPTY_TASKS = 256;
+        const UINT32 NUM_WORK_TASKS = 64;
+        const UINT32 WORK_PER_TASK = 256;
+
+        /** Queues @p numTasks tasks running @p worker with the task index, and waits until all of them complete. */
+        void RunTasks(UINT32 numTasks, const std::function<void(UINT32)>& worker)
+        {
+            Vector<SPtr<Task>> tasks;
+            tasks.reserve(numTasks);
+
+            for (UINT32 i = 0; i < numTasks; i++)
+            {
+                SPtr<Task> task = Task::Create("Benchmark", [&worker, i]() { worker(i); });
+                gTaskScheduler().AddTask(task);
+
+                tasks.push_back(task);
+            }
+
+            for (auto& task : tasks)
+                task->Wait();
+        }
+    }
+
+    void RegisterThreadingBenchmarks(BenchmarkSuite& suite)
+    {
+        // Measures scheduling overhead only: queueing, dispatch to workers and completion
+        suite.Add("Threading", "TaskSchedulerEmptyTasks", NUM_EMPTY_TASKS, []()
+        {
+            RunTasks(NUM_EMPTY_TASKS, [](UINT32) { });
+        });
+
+        // Measures scaling of a coarse parallel workload, compare with the serial version
+        auto matrices = te_shared_ptr_new<Vector<Matrix4>>(NUM_WORK_TASKS * WORK_PER_TASK, Matrix4::IDENTITY);
+        auto work = [matrices](UINT32 taskIdx)
+        {
+            const Matrix4 step = Matrix4::TRS(Vector3(0.1f, 0.2f, 0.3f), Quaternion::IDENTITY, Vector3::ONE);
+
+            Matrix4* output = matrices->data() + taskIdx * WORK_PER_TASK;
+            for (UINT32 i = 0; i < WORK_PER_TASK; i++)
+            {
+                for (UINT32 j = 0; j < 16; j++)
+                    output[i] = output[i] * step;
+            }
+        };
+
+        suite.Add("Threading", "TaskSchedulerParallelWork", NUM_WORK_TASKS * WORK_PER_TASK, [work, matrices]()
+        {
+            RunTasks(NUM_WORK_TASKS, work);
+            DoNotOptimize(matrices->data());
+        });
+
+        suite.Add("Threading", "SerialWork", NUM_WORK_TASKS * WORK_PER_TASK, [work, matrices]()
+        {
+            for (UINT32 i = 0; i < NUM_WORK_TASKS; i++)
+                work(i);
+
+            DoNotOptimize(matrices->data());
+        });
+    }
+}
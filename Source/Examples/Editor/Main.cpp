@@ -41,6 +41,8 @@ int main()
     desc.WindowDesc.Title = "Editor";
     desc.WindowDesc.Vsync = false;
 
+    desc.HotReload = true;
+
     te::Application::StartUp(desc);
     te::Application::Instance().RunMainLoop();
     te::Application::ShutDown();
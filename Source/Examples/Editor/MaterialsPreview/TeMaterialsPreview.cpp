@@ -12,6 +12,8 @@
 #include "Importer/TeMeshImportOptions.h"
 #include "Importer/TeTextureImportOptions.h"
 #include "Manager/TeRendererManager.h"
+#include "CoreUtility/TeCoreObjectManager.h"
+#include "Utility/TeTime.h"
 #include "TeCoreApplication.h"
 
 namespace te
@@ -107,6 +109,9 @@ namespace te
         SPtr<Material> mat = material.lock();
         SPtr<Renderable> renderable = nullptr;
 
+        // Preview is rendered from the main thread, the frame in flight must be done with the render API
+        gCoreApplication().WaitUntilFrameRendered();
+
         _camera->NotifyNeedsRedraw();
         _camera->GetViewport()->SetTarget(preview.MatPreview->RenderTex);
 
@@ -132,6 +137,12 @@ namespace te
             _renderer->NotifyRenderableAdded(renderable.get());
         }
 
+        CoreObjectManager::Instance().FrameSync();
+
+        _perFrameData->Time = gTime().GetTime();
+        _perFrameData->TimeDelta = gTime().GetFrameDelta();
+        _perFrameData->FrameIdx = gTime().GetFrameIdx();
+
         _renderer->Update();
         _renderer->RenderAll(*_perFrameData.get());
 
@@ -21,6 +21,7 @@
 #include "Renderer/TeCamera.h"
 #include "Scene/TeSceneManager.h"
 #include "Scene/TeSceneObject.h"
+#include "Serialization/TeSceneFile.h"
 #include "Components/TeCCamera.h"
 #include "Components/TeCCameraUI.h"
 #include "Components/TeCCameraFlyer.h"
@@ -63,6 +64,7 @@
 #include "Physics/TePhysics.h"
 
 #include "Selection/TeEditorPicking.h"
+#include "Picking/TeRayPicking.h"
 #include "Selection/TeSelection.h"
 #include "Selection/TeHud.h"
 
@@ -116,6 +118,7 @@ namespace te
     Editor::Editor()
         : _editorBegun(false)
         , _pickingDirty(true)
+        , _rayPickingDirty(true)
         , _selectionDirty(true)
         , _hudDirty(true)
         , _physicsDirty(true)
@@ -145,6 +148,7 @@ namespace te
         InitializeViewportCamera();
 
         _picking = te_unique_ptr_new<EditorPicking>();
+        _rayPicking = te_unique_ptr_new<RayPicking>();
         _selection = te_unique_ptr_new<Selection>();
         _hud = te_unique_ptr_new<Hud>();
 
@@ -243,17 +247,33 @@ namespace te
 
         if (!ImGuizmo::IsUsing())
         {
-            if (_pickingDirty)
+            SPtr<GameObject> gameObject;
+
+            // GPU picking renders the scene and reads it back, stalling the pipeline, it's only used if asked for
+            if (_settings.GpuPicking)
             {
-                RendererUtility::RenderTextureData viewportData =
-                    static_cast<WidgetViewport*>(&*_settings.WViewport)->GetRenderTextureData();
-                Picking::RenderParam pickingData(viewportData.Width, viewportData.Height);
+                if (_pickingDirty)
+                {
+                    RendererUtility::RenderTextureData viewportData =
+                        static_cast<WidgetViewport*>(&*_settings.WViewport)->GetRenderTextureData();
+                    Picking::RenderParam pickingData(viewportData.Width, viewportData.Height);
+
+                    _picking->ComputePicking(_previewViewportCamera, pickingData, _sceneSO);
+                    _pickingDirty = false;
+                }
 
-                _picking->ComputePicking(_previewViewportCamera, pickingData, _sceneSO);
-                _pickingDirty = false;
+                gameObject = _picking->GetGameObjectAt(x, y);
             }
+            else
+            {
+                if (_rayPickingDirty)
+                {
+                    _rayPicking->Build(_sceneSO, true);
+                    _rayPickingDirty = false;
+                }
 
-            SPtr<GameObject> gameObject = _picking->GetGameObjectAt(x, y);
+                gameObject = _rayPicking->GetGameObjectAt(_previewViewportCamera, Vector2I(x, y));
+            }
             if (gameObject)
             {
                 bool selectableSceneObject = (_selections.ClickedSceneObject && _selections.ClickedSceneObject->HasComponent(ComponentsWhichNeedGuizmo));
@@ -310,6 +330,7 @@ namespace te
     void Editor::MakePickingDirty()
     {
         _pickingDirty = true;
+        _rayPickingDirty = true;
     }
 
     void Editor::MakeHudDirty()
@@ -826,14 +847,40 @@ namespace te
 
     void Editor::Save()
     {
-        _settings.State = EditorState::Saved;
-        // TODO Save
+        if (_settings.FilePath.empty())
+            return;
+
+        // Root object is created by the editor, only its content is saved
+        if (SceneFile::Save(_settings.FilePath, _sceneSO, false))
+            _settings.State = EditorState::Saved;
+        else
+            TE_DEBUG("Cannot save scene file: " + _settings.FilePath);
     }
 
     void Editor::Open()
     {
+        if (_settings.FilePath.empty())
+            return;
+
+        SceneFile file;
+        if (!file.Open(_settings.FilePath))
+            return;
+
+        _selections.ClickedComponent = nullptr;
+        _selections.ClickedSceneObject = nullptr;
+        _selections.HoveredComponent = nullptr;
+        _selections.HoveredSceneObject = nullptr;
+        _selections.CopiedComponent = nullptr;
+        _selections.CopiedSceneObject = nullptr;
+
+        // Content of the file replaces the content of the current scene
+        while (_sceneSO->GetNumChildren() > 0)
+            _sceneSO->GetChild(0)->Destroy(true);
+
+        file.Instantiate(_sceneSO);
+
         _settings.State = EditorState::Saved;
-        // TODO Open
+        NeedsRedraw();
     }
 
     void Editor::Paste()
@@ -10,6 +10,7 @@
 namespace te
 {
     class Picking;
+    class RayPicking;
     class Selection;
     class Hud;
 
@@ -81,6 +82,8 @@ namespace te
 
             EditorState State = EditorState::Modified;
             String FilePath;
+
+            bool GpuPicking = false; /**< Picks in a render of the scene read back from the GPU instead of casting rays */
         };
 
     public:
@@ -242,10 +245,12 @@ namespace te
         // we can use an user created camera for viewport;
         HCamera _previewViewportCamera;
 
-        // I decided to use GPU Picking for 3D viewport selection handle
-        // After NeedRedraws() or 3D viewport resize, we need to put this to true in order to force picking render
+        // CPU ray picking handles renderables and HUD elements, GPU picking is only used if EditorSettings::GpuPicking is set
+        // After NeedRedraws() or 3D viewport resize, we need to put this to true in order to force picking update
         UPtr<Picking> _picking;
+        UPtr<RayPicking> _rayPicking;
         bool _pickingDirty;
+        bool _rayPickingDirty; // Ray picking is only built again when needed, after picking got dirty
 
         // Current selected renderables, cameras and lights will be higglighted
         UPtr<Selection> _selection;
@@ -315,7 +315,7 @@ namespace te
                 meshImportOptions->ScaleSystemUnit = _fileBrowser.Data.MeshParam.ScaleSystemUnit;
                 meshImportOptions->ScaleFactor = _fileBrowser.Data.MeshParam.ScaleFactor;
                 meshImportOptions->ImportCollisionShape = _fileBrowser.Data.MeshParam.ImportCollisionShape;
-                meshImportOptions->CpuCached = false;
+                meshImportOptions->CpuCached = true; // Lets RayPicking test triangles
 
                 SPtr<MultiResource> resources = EditorResManager::Instance().LoadAll(_fileBrowser.Data.SelectedPath, meshImportOptions, true);
                 if (!resources->Empty())
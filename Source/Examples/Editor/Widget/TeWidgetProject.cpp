@@ -46,12 +46,15 @@ namespace te
         : Widget(WidgetType::Project)
         , _selections(gEditor().GetSelectionData())
         , _expandToSelection(false)
-        , _expandDragToSelection(false)
-        , _expandedToSelection(false)
         , _handleSelectionWindowSwitch(false)
+        , _rowsDirty(true)
+        , _rowsHierarchyVersion(0)
+        , _rowsRootId(0)
+        , _scrollToRow(-1)
     { 
         _title = PROJECT_TITLE;
         _flags |= ImGuiWindowFlags_HorizontalScrollbar;
+        _filterInput[0] = '\0';
     }
 
     WidgetProject::~WidgetProject()
@@ -87,71 +90,89 @@ namespace te
     void WidgetProject::ShowTree(HSceneObject& sceneObject)
     {
         OnTreeBegin();
-        ShowSceneObjectTree(sceneObject, true);
+        ShowFilter();
 
-        // If we have been expanding to show an entity and no more expansions are taking place, we reached it.
-        // So, we stop expanding and we bring it into view.
-        if (_expandToSelection && !_expandedToSelection)
+        ExpandToSelection(sceneObject);
+        UpdateRows(sceneObject);
+
+        const float rowHeight = ImGui::GetFrameHeightWithSpacing();
+        const float indentSpacing = ImGui::GetStyle().IndentSpacing;
+
+        if (_scrollToRow >= 0)
         {
-            ImGui::ScrollToBringRectIntoView(_window, _selectedSceneObjectRect);
+            const float rowY = ImGui::GetCursorPosY() + _scrollToRow * rowHeight;
+            const float scrollY = ImGui::GetScrollY();
+            const float windowHeight = ImGui::GetWindowHeight();
+
+            if (rowY < scrollY || rowY + rowHeight > scrollY + windowHeight)
+                ImGui::SetScrollY(rowY - windowHeight * 0.5f);
+
+            _scrollToRow = -1;
+        }
+
+        ImGuiListClipper clipper;
+        clipper.Begin((int)_rows.size(), rowHeight);
+
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+            {
+                TreeRow& row = _rows[i];
 
-            // If we had a drag event manage during previous showtree, we want to keep expandToSelection 
-            // value to expand selection to the new dragged position object
-            if (!_expandDragToSelection)
-                _expandToSelection = false;
+                // Objects destroyed this frame are still in the rows until the next update
+                if (row.SceneObject.IsDestroyed(true) || (!row.Component.Empty() && row.Component.IsDestroyed(true)))
+                {
+                    ImGui::Dummy(ImVec2(0.0f, ImGui::GetFrameHeight()));
+                    continue;
+                }
+
+                if (row.Depth > 0)
+                    ImGui::Indent(row.Depth * indentSpacing);
+
+                if (row.Component.Empty())
+                    ShowSceneObjectRow(row);
+                else
+                    ShowComponentRow(row);
 
-            _expandDragToSelection = false;
+                if (row.Depth > 0)
+                    ImGui::Unindent(row.Depth * indentSpacing);
+            }
         }
 
         OnTreeEnd();
     }
 
-    void WidgetProject::ShowSceneObjectTree(HSceneObject& sceneObject, bool expand)
+    void WidgetProject::ShowFilter()
+    {
+        ImGui::PushItemWidth(-1.0f);
+        if (ImGui::InputTextWithHint("##ProjectFilter", ICON_FA_SEARCH "  Filter", _filterInput, sizeof(_filterInput)))
+        {
+            _filter = _filterInput;
+            ToLowerCase(_filter);
+            _rowsDirty = true;
+        }
+        ImGui::PopItemWidth();
+    }
+
+    void WidgetProject::ShowSceneObjectRow(TreeRow& row)
     {
+        HSceneObject& sceneObject = row.SceneObject;
         UINT64 sceneObjectId = sceneObject->GetInstanceId();
-        auto children = sceneObject->GetChildren();
-        auto components = sceneObject->GetComponents();
-        _expandedToSelection = false;
 
         // Flags
         ImGuiTreeNodeFlags nodeFlags =
             ImGuiTreeNodeFlags_AllowItemOverlap |
             ImGuiTreeNodeFlags_SpanAvailWidth |
-            ImGuiTreeNodeFlags_Framed;
-
-        // Should we expand this node ?
-        if (expand) 
-            nodeFlags |= ImGuiTreeNodeFlags_DefaultOpen;
+            ImGuiTreeNodeFlags_Framed |
+            ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
         // Flag - Is expandable (has children) ?
-        nodeFlags |= (children.size() || components.size()) ?
+        nodeFlags |= (row.Expandable) ?
             ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick : ImGuiTreeNodeFlags_Leaf;
 
         // Flag - Is selected?
-        if (_selections.ClickedSceneObject)
-        {
-            nodeFlags |= (_selections.ClickedSceneObject->GetUUID() == sceneObject->GetUUID()) ? ImGuiTreeNodeFlags_Selected : nodeFlags;
-
-            if (_expandToSelection)
-            {
-                // If the selected sceneObject is a descendant of the current one, start expanding (this can happen if an object is selected in the viewport)
-                if (_selections.ClickedSceneObject->IsDescendantOf(sceneObject))
-                {
-                    ImGui::SetNextItemOpen(true);
-                    _expandedToSelection = true;
-                }
-            }
-        }
-
-        if (_selections.ClickedComponent && _expandToSelection)
-        {
-            // If the selected sceneObject is a descendant of the current one, start expanding (this can happen if an object is selected in the viewport)
-            if (_selections.ClickedComponent->IsDescendantOf(sceneObject))
-            {
-                ImGui::SetNextItemOpen(true);
-                _expandedToSelection = true;
-            }
-        }
+        if (_selections.ClickedSceneObject && _selections.ClickedSceneObject->GetUUID() == sceneObject->GetUUID())
+            nodeFlags |= ImGuiTreeNodeFlags_Selected;
 
         // Title
         String active = (sceneObject->GetActive()) ? ICON_FA_EYE : ICON_FA_EYE_SLASH;
@@ -160,17 +181,30 @@ namespace te
         if (_selections.ClickedSceneObject == sceneObject.GetInternalPtr())
             nodeTitle += String("  ") + ICON_FA_CARET_RIGHT;
 
-        if (components.size() == 0 && children.size() == 0)
+        if (!row.Expandable)
             nodeTitle = "          " + nodeTitle;
 
+        // Open state is kept by the widget, as rows of closed nodes don't exist. While filtering, everything is opened.
+        const bool isFiltering = !_filter.empty();
+        const bool isOpened = isFiltering || _openedSceneObjects.find(sceneObjectId) != _openedSceneObjects.end();
+
+        if (row.Expandable)
+            ImGui::SetNextItemOpen(isOpened);
+
         ImGui::PushID((int)sceneObjectId);
         {
             const bool isNodeOpened = ImGui::TreeNodeEx(
                 reinterpret_cast<void*>(static_cast<intptr_t>(sceneObjectId)), nodeFlags, nodeTitle.c_str());
 
-            // Keep a copy of the selected item's rect so that we can scroll to bring it into view
-            if ((nodeFlags & ImGuiTreeNodeFlags_Selected) && _expandToSelection)
-                _selectedSceneObjectRect = _window->DC.LastItemRect;
+            if (row.Expandable && !isFiltering && isNodeOpened != isOpened)
+            {
+                if (isNodeOpened)
+                    _openedSceneObjects.insert(sceneObjectId);
+                else
+                    _openedSceneObjects.erase(sceneObjectId);
+
+                _rowsDirty = true;
+            }
 
             // Manually detect some useful states
             if (ImGui::IsItemHovered(ImGuiHoveredFlags_RectOnly))
@@ -178,80 +212,242 @@ namespace te
 
             // Handle drag and drop
             HandleDragAndDrop(sceneObject);
+        }
+        ImGui::PopID();
+    }
 
-            // Recursively show all child nodes
-            if (isNodeOpened)
-            {
-                if (components.size() > 0)
-                    ShowComponentsTree(sceneObject);
+    void WidgetProject::ShowComponentRow(TreeRow& row)
+    {
+        HComponent& component = row.Component;
+        UINT64 componentId = component->GetInstanceId();
 
-                for (auto& child : children)
-                    ShowSceneObjectTree(child);
+        ImGuiTreeNodeFlags componentFlags =
+            ImGuiTreeNodeFlags_AllowItemOverlap |
+            ImGuiTreeNodeFlags_SpanAvailWidth |
+            ImGuiTreeNodeFlags_Framed |
+            ImGuiTreeNodeFlags_Bullet |
+            ImGuiTreeNodeFlags_Leaf |
+            ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
-                ImGui::TreePop();
-            }
+        // Flag - Is selected?
+        if (_selections.ClickedComponent && _selections.ClickedComponent->GetUUID() == component->GetUUID())
+            componentFlags |= ImGuiTreeNodeFlags_Selected;
+
+        String componentIcon = GetComponentIcon(component);
+        if (_selections.ClickedComponent == component.GetInternalPtr())
+            componentIcon += String("  ") + ICON_FA_CARET_RIGHT;
+
+        ImGui::PushID((int)componentId);
+        {
+            ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<intptr_t>(componentId)), componentFlags, componentIcon.c_str());
+
+            // Manually detect some useful states
+            if (ImGui::IsItemHovered(ImGuiHoveredFlags_RectOnly))
+                _selections.HoveredComponent = component.GetInternalPtr();
+
+            // Handle drag and drop
+            HandleDragAndDrop(component);
         }
         ImGui::PopID();
     }
 
-    void WidgetProject::ShowComponentsTree(HSceneObject& sceneObject)
+    void WidgetProject::UpdateRows(const HSceneObject& root)
+    {
+        const UINT64 hierarchyVersion = gSceneManager().GetHierarchyVersion();
+        const bool rootChanged = root.GetInstanceId() != _rowsRootId;
+        const bool hierarchyChanged = rootChanged || hierarchyVersion != _rowsHierarchyVersion;
+
+        if (!hierarchyChanged && !_rowsDirty)
+            return;
+
+        // The root is opened when first shown
+        if (rootChanged)
+            _openedSceneObjects.insert(root.GetInstanceId());
+
+        _rows.clear();
+
+        if (_filter.empty())
+        {
+            AddRows(root, 0);
+        }
+        else
+        {
+            UpdateFilterMatches(root, hierarchyChanged);
+            AddFilteredRows(root, 0);
+        }
+
+        _rowsHierarchyVersion = hierarchyVersion;
+        _rowsRootId = root.GetInstanceId();
+        _rowsDirty = false;
+    }
+
+    void WidgetProject::AddRows(const HSceneObject& sceneObject, UINT32 depth)
     {
-        auto components = sceneObject->GetComponents();
-        _expandedToSelection = false;
+        const Vector<HSceneObject>& children = sceneObject->GetChildren();
+        const Vector<HComponent>& components = sceneObject->GetComponents();
+
+        TreeRow row;
+        row.SceneObject = sceneObject;
+        row.Depth = depth;
+        row.Expandable = !children.empty() || !components.empty();
+        _rows.push_back(row);
+
+        if (!row.Expandable || _openedSceneObjects.find(sceneObject.GetInstanceId()) == _openedSceneObjects.end())
+            return;
 
         for (auto& component : components)
         {
-            UINT64 componentId = component->GetInstanceId();
-            ImGuiTreeNodeFlags componentFlags =
-                ImGuiTreeNodeFlags_AllowItemOverlap |
-                ImGuiTreeNodeFlags_SpanAvailWidth |
-                ImGuiTreeNodeFlags_Framed |
-                ImGuiTreeNodeFlags_Bullet |
-                ImGuiTreeNodeFlags_Leaf;
-
-            // Flag - Is selected?
-            if (_selections.ClickedComponent)
-            {
-                componentFlags |= (_selections.ClickedComponent->GetUUID() == component->GetUUID()) ? ImGuiTreeNodeFlags_Selected : componentFlags;
+            TreeRow componentRow;
+            componentRow.SceneObject = sceneObject;
+            componentRow.Component = component;
+            componentRow.Depth = depth + 1;
+            _rows.push_back(componentRow);
+        }
 
-                if (_expandToSelection)
-                {
-                    // If the selected component is a descendant of the current one, but not its direct child
-                    // start expanding (this can happen if an object is selected in the viewport)
-                    if (!_selections.ClickedComponent->IsChildOf(sceneObject) && _selections.ClickedComponent->IsDescendantOf(sceneObject))
-                    {
-                        //ImGui::SetNextItemOpen(true);
-                        _expandedToSelection = true;
-                    }
-                }
-            }
+        for (auto& child : children)
+            AddRows(child, depth + 1);
+    }
 
-            String componentIcon = GetComponentIcon(component);
-            if (_selections.ClickedComponent == component.GetInternalPtr())
-                componentIcon += String("  ") + ICON_FA_CARET_RIGHT;
+    void WidgetProject::AddFilteredRows(const HSceneObject& sceneObject, UINT32 depth)
+    {
+        if (_filterVisible.find(sceneObject.GetInstanceId()) == _filterVisible.end())
+            return;
 
-            ImGui::PushID((int)componentId);
-            {
-                const bool isNodeOpened = ImGui::TreeNodeEx(
-                    reinterpret_cast<void*>(static_cast<intptr_t>(componentId)), componentFlags, componentIcon.c_str());
+        const Vector<HSceneObject>& children = sceneObject->GetChildren();
+        const Vector<HComponent>& components = sceneObject->GetComponents();
 
-                // Keep a copy of the selected item's rect so that we can scroll to bring it into view
-                if ((componentFlags & ImGuiTreeNodeFlags_Selected) && _expandToSelection)
-                    _selectedSceneObjectRect = _window->DC.LastItemRect;
+        TreeRow row;
+        row.SceneObject = sceneObject;
+        row.Depth = depth;
+        row.Expandable = !children.empty() || !components.empty();
+        _rows.push_back(row);
 
-                // Manually detect some useful states
-                if (ImGui::IsItemHovered(ImGuiHoveredFlags_RectOnly))
-                {
-                    _selections.HoveredComponent = component.GetInternalPtr();
-                }
+        for (auto& component : components)
+        {
+            if (_filterVisible.find(component.GetInstanceId()) == _filterVisible.end())
+                continue;
+
+            TreeRow componentRow;
+            componentRow.SceneObject = sceneObject;
+            componentRow.Component = component;
+            componentRow.Depth = depth + 1;
+            _rows.push_back(componentRow);
+        }
+
+        for (auto& child : children)
+            AddFilteredRows(child, depth + 1);
+    }
+
+    void WidgetProject::UpdateFilterMatches(const HSceneObject& root, bool hierarchyChanged)
+    {
+        // A longer filter can only match a subset of what the previous one matched
+        const bool refine = !hierarchyChanged && !_searchedFilter.empty() &&
+            _filter.find(_searchedFilter) != String::npos;
+
+        if (refine)
+        {
+            auto sceneObjectsEnd = std::remove_if(_filterSceneObjects.begin(), _filterSceneObjects.end(),
+                [this](const HSceneObject& sceneObject) { return !MatchesFilter(sceneObject->GetName()); });
+            _filterSceneObjects.erase(sceneObjectsEnd, _filterSceneObjects.end());
+
+            auto componentsEnd = std::remove_if(_filterComponents.begin(), _filterComponents.end(),
+                [this](const HComponent& component) { return !MatchesFilter(component->GetName()); });
+            _filterComponents.erase(componentsEnd, _filterComponents.end());
+        }
+        else
+        {
+            _filterSceneObjects.clear();
+            _filterComponents.clear();
+            FindFilterMatches(root);
+        }
 
-                // Handle drag and drop
-                HandleDragAndDrop(component);
+        _searchedFilter = _filter;
 
-                if(isNodeOpened)
-                    ImGui::TreePop();
+        // Matches are shown with all their parents
+        _filterVisible.clear();
+
+        auto addWithParents = [this](HSceneObject sceneObject)
+        {
+            while (!sceneObject.Empty() && _filterVisible.insert(sceneObject.GetInstanceId()).second)
+                sceneObject = sceneObject->GetParent();
+        };
+
+        for (auto& sceneObject : _filterSceneObjects)
+            addWithParents(sceneObject);
+
+        for (auto& component : _filterComponents)
+        {
+            _filterVisible.insert(component.GetInstanceId());
+            addWithParents(component->GetSceneObject());
+        }
+    }
+
+    void WidgetProject::FindFilterMatches(const HSceneObject& sceneObject)
+    {
+        if (MatchesFilter(sceneObject->GetName()))
+            _filterSceneObjects.push_back(sceneObject);
+
+        for (auto& component : sceneObject->GetComponents())
+        {
+            if (MatchesFilter(component->GetName()))
+                _filterComponents.push_back(component);
+        }
+
+        for (auto& child : sceneObject->GetChildren())
+            FindFilterMatches(child);
+    }
+
+    bool WidgetProject::MatchesFilter(const String& name) const
+    {
+        String lowerName = name;
+        ToLowerCase(lowerName);
+
+        return lowerName.find(_filter) != String::npos;
+    }
+
+    void WidgetProject::ExpandToSelection(const HSceneObject& root)
+    {
+        if (!_expandToSelection)
+            return;
+
+        _expandToSelection = false;
+
+        UINT64 selectionId = 0;
+        HSceneObject parent;
+
+        if (_selections.ClickedComponent)
+        {
+            selectionId = _selections.ClickedComponent->GetInstanceId();
+            parent = _selections.ClickedComponent->GetSceneObject();
+        }
+        else if (_selections.ClickedSceneObject)
+        {
+            selectionId = _selections.ClickedSceneObject->GetInstanceId();
+            parent = _selections.ClickedSceneObject->GetParent();
+        }
+        else
+        {
+            return;
+        }
+
+        for (; !parent.Empty(); parent = parent->GetParent())
+        {
+            if (_openedSceneObjects.insert(parent.GetInstanceId()).second)
+                _rowsDirty = true;
+        }
+
+        UpdateRows(root);
+
+        for (UINT32 i = 0; i < (UINT32)_rows.size(); i++)
+        {
+            const TreeRow& row = _rows[i];
+            const UINT64 rowId = (row.Component.Empty()) ? row.SceneObject.GetInstanceId() : row.Component.GetInstanceId();
+
+            if (rowId == selectionId)
+            {
+                _scrollToRow = (INT32)i;
+                break;
             }
-            ImGui::PopID();
         }
     }
 
@@ -409,7 +605,6 @@ namespace te
                     _selections.ClickedComponent = nullptr;
 
                     _expandToSelection = true;
-                    _expandDragToSelection = true;
 
                     // ugly but best way to update all children
                     sceneObject->Move(Vector3::ZERO);
@@ -446,7 +641,6 @@ namespace te
                 }
 
                 _expandToSelection = true;
-                _expandDragToSelection = true;
 
                 // if we've moved an animation call RestoreInternal()
                 if (currentCO->GetCoreType() == TID_CAnimation)
@@ -46,6 +46,15 @@ namespace te
             DragPayloadType Type;
             UUID Uuid;
         };
+
+        /** Line of the hierarchy, for a scene object or one of its components. */
+        struct TreeRow
+        {
+            HSceneObject SceneObject;
+            HComponent Component; /**< Empty for scene object rows. */
+            UINT32 Depth = 0;
+            bool Expandable = false; /**< Scene object has children or components. */
+        };
     
     protected:
         void CreateDragPayload(const DragDropPayload& payload);
@@ -55,8 +64,29 @@ namespace te
 
     protected:
         void ShowTree(HSceneObject& sceneObject);
-        void ShowSceneObjectTree(HSceneObject& sceneObject, bool expand = false);
-        void ShowComponentsTree(HSceneObject& sceneObject);
+        void ShowFilter();
+        void ShowSceneObjectRow(TreeRow& row);
+        void ShowComponentRow(TreeRow& row);
+
+        /**
+         * The hierarchy is drawn from a flat list of rows, only rebuilt when objects or components are added, removed or
+         * moved (see SceneManager::GetHierarchyVersion()), when a node is opened or closed, or when the filter changes.
+         * Only rows in view are drawn.
+         */
+        void UpdateRows(const HSceneObject& root);
+        void AddRows(const HSceneObject& sceneObject, UINT32 depth);
+        void AddFilteredRows(const HSceneObject& sceneObject, UINT32 depth);
+
+        /**
+         * Finds the objects and components matching the filter. If the filter only got longer since the last search,
+         * and the hierarchy didn't change, only previous matches are tested again.
+         */
+        void UpdateFilterMatches(const HSceneObject& root, bool hierarchyChanged);
+        void FindFilterMatches(const HSceneObject& sceneObject);
+        bool MatchesFilter(const String& name) const;
+
+        /** Opens the parents of the selected object or component and scrolls to its row. */
+        void ExpandToSelection(const HSceneObject& root);
         void OnTreeBegin();
         void OnTreeEnd();
         void HandleClicking();
@@ -88,10 +118,21 @@ namespace te
     protected:
         Editor::SelectionData& _selections;
         bool _expandToSelection;
-        bool _expandDragToSelection;
-        bool _expandedToSelection;
         bool _handleSelectionWindowSwitch;
-        ImRect _selectedSceneObjectRect;
+
+        Vector<TreeRow> _rows;
+        bool _rowsDirty;
+        UINT64 _rowsHierarchyVersion;
+        UINT64 _rowsRootId;
+        UnorderedSet<UINT64> _openedSceneObjects;
+        INT32 _scrollToRow;
+
+        char _filterInput[256];
+        String _filter; /**< Lower case. */
+        String _searchedFilter; /**< Filter of the current matches. */
+        Vector<HSceneObject> _filterSceneObjects;
+        Vector<HComponent> _filterComponents;
+        UnorderedSet<UINT64> _filterVisible; /**< Matching objects, objects with matching components and their parents. */
 
         VirtualButton _deleteBtn;
         VirtualButton _copyBtn;
@@ -2413,6 +2413,17 @@ namespace te
         }
         ImGui::Separator();
 
+        // occluder
+        {
+            bool occluder = properties.Occluder;
+            if (ImGuiExt::RenderOptionBool(occluder, "##renderable_properties_occluder_option", "Occluder"))
+            {
+                hasChanged = true;
+                renderable->SetOccluder(occluder);
+            }
+        }
+        ImGui::Separator();
+
         // cull distance factor
         {
             float cullDistanceFactor = properties.CullDistanceFactor;
@@ -3040,7 +3051,7 @@ namespace te
             meshImportOptions->ScaleSystemUnit = _fileBrowser.Data.MeshParam.ScaleSystemUnit;
             meshImportOptions->ScaleFactor = _fileBrowser.Data.MeshParam.ScaleFactor;
             meshImportOptions->ImportCollisionShape = _fileBrowser.Data.MeshParam.ImportCollisionShape;
-            meshImportOptions->CpuCached = false;
+            meshImportOptions->CpuCached = true; // Lets RayPicking test triangles
 
             SPtr<MultiResource> resources = EditorResManager::Instance().LoadAll(_fileBrowser.Data.SelectedPath, meshImportOptions);
             if (!resources->Empty())
@@ -23,6 +23,20 @@ namespace te
     {
         const float width = ImGui::GetWindowContentRegionWidth() - 110.0f;
 
+        if (ImGui::CollapsingHeader("Editor", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            // GPU picking
+            {
+                bool gpuPicking = gEditor().GetSettings().GpuPicking;
+                if (ImGuiExt::RenderOptionBool(gpuPicking, "##settings_editor_gpu_picking", "GPU Picking"))
+                {
+                    gEditor().GetSettings().GpuPicking = gpuPicking;
+                    gEditor().MakePickingDirty();
+                }
+            }
+            ImGui::Separator();
+        }
+
         if (ImGui::CollapsingHeader("Physics", ImGuiTreeNodeFlags_DefaultOpen))
         {
             // Physic paused
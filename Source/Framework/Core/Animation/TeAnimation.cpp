@@ -204,7 +204,7 @@ namespace te
             UINT32 sceneObjectIdsSize = _numSceneObjects * sizeof(AnimatedSceneObjectInfo);
             UINT32 sceneObjectTransformsSize = numBoneMappedSOs * sizeof(Matrix4);
 
-            UINT8* data = (UINT8*)te_allocate(layersSize + clipsSize + boneMappingSize + genericCurveOutputSize + sceneObjectIdsSize + sceneObjectTransformsSize);
+            UINT8* data = (UINT8*)te_allocate<MemoryCategory::Animation>(layersSize + clipsSize + boneMappingSize + genericCurveOutputSize + sceneObjectIdsSize + sceneObjectTransformsSize);
 
             _layers = (AnimationStateLayer*)data;
             memcpy(_layers, tempLayers.data(), layersSize);
@@ -1042,7 +1042,7 @@ namespace te
 
     SPtr<Animation> Animation::Create()
     {
-        Animation* anim = new (te_allocate<Animation>()) Animation();
+        Animation* anim = new (te_allocate<Animation, MemoryCategory::Animation>()) Animation();
 
         SPtr<Animation> animPtr = te_core_ptr<Animation>(anim);
         animPtr->SetThisPtr(animPtr);
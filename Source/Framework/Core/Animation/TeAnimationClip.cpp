@@ -120,7 +120,7 @@ namespace te
 
     SPtr<AnimationClip> AnimationClip::CreateEmpty()
     {
-        AnimationClip* rawPtr = new (te_allocate<AnimationClip>()) AnimationClip();
+        AnimationClip* rawPtr = new (te_allocate<AnimationClip, MemoryCategory::Animation>()) AnimationClip();
 
         SPtr<AnimationClip> newClip = te_core_ptr<AnimationClip>(rawPtr);
         newClip->SetThisPtr(newClip);
@@ -131,7 +131,7 @@ namespace te
     SPtr<AnimationClip> AnimationClip::CreatePtr(const SPtr<AnimationCurves>& curves, bool isAdditive, float sampleRate,
         const SPtr<RootMotion>& rootMotion)
     {
-        AnimationClip* rawPtr = new (te_allocate<AnimationClip>()) AnimationClip(curves, isAdditive, sampleRate, rootMotion);
+        AnimationClip* rawPtr = new (te_allocate<AnimationClip, MemoryCategory::Animation>()) AnimationClip(curves, isAdditive, sampleRate, rootMotion);
 
         SPtr<AnimationClip> newClip = te_core_ptr<AnimationClip>(rawPtr);
         newClip->SetThisPtr(newClip);
@@ -61,7 +61,13 @@ namespace te
 
         float timeDelta = _animationTime - _lastAnimationUpdateTime;
         _lastAnimationUpdateTime = _animationTime;
-        _lastAnimationDeltaTime  = timeDelta;
+
+        return Evaluate(timeDelta);
+    }
+
+    const EvaluatedAnimationData* AnimationManager::Evaluate(float timeDelta)
+    {
+        _lastAnimationDeltaTime = timeDelta;
 
         // Update animation proxies from the latest data
         _proxies.clear();
@@ -66,6 +66,14 @@ namespace te
          */
         const EvaluatedAnimationData* Update();
 
+        /**
+         * Advances all animations by @p timeDelta and evaluates them, whatever the update rate. Called by Update() when
+         * animations are due for evaluation.
+         *
+         * @return	Evaluated animation data.
+         */
+        const EvaluatedAnimationData* Evaluate(float timeDelta);
+
         /**
          * Determines how often to evaluate animations. If rendering is not running at adequate framerate the animation
          * could end up being evaluated less times than specified here.
@@ -108,8 +116,9 @@ namespace te
         Vector<SPtr<AnimationProxy>> _proxies;
         Vector<ConvexVolume> _cullFrustums;
 
-        // If we change a mesh (so a skeleton, animData info might be deprecated, we must update them)
-        bool _animDataDirty = true;
+        // If we change a mesh (so a skeleton, animData info might be deprecated, we must update them). Also set by
+        // the renderer, which can run on the render thread
+        std::atomic<bool> _animDataDirty { true };
         EvaluatedAnimationData _animData;
     };
 
@@ -2,8 +2,7 @@
 
 #include "Animation/TeAnimationClip.h"
 #include "Utility/TeFrameAllocator.h"
-
-#include <functional>
+#include "Math/TeSIMD.h"
 
 namespace te
 { 
@@ -12,8 +11,8 @@ namespace te
     {
         const UINT32 overridesPerBone = individualOverride ? 3 : 1;
 
-        UINT32 elementSize = sizeof(Vector3) * 2 + sizeof(Quaternion) + sizeof(bool) * overridesPerBone;
-        UINT8* buffer = (UINT8*)te_allocate(elementSize * numBones);
+        UINT32 elementSize = sizeof(Vector3) * 2 + sizeof(Quaternion) + sizeof(bool) * (overridesPerBone + 1);
+        UINT8* buffer = (UINT8*)te_allocate<MemoryCategory::Animation>(elementSize * numBones);
 
         Positions = (Vector3*)buffer;
         buffer += sizeof(Vector3) * numBones;
@@ -25,12 +24,15 @@ namespace te
         buffer += sizeof(Vector3) * numBones;
 
         HasOverride = (bool*)buffer;
+        buffer += sizeof(bool) * overridesPerBone * numBones;
+
+        HasAnimCurve = (bool*)buffer;
     }
 
     LocalSkeletonPose::LocalSkeletonPose(UINT32 numPos, UINT32 numRot, UINT32 numScale)
     {
         UINT32 bufferSize = sizeof(Vector3) * numPos + sizeof(Quaternion) * numRot + sizeof(Vector3) * numScale;
-        UINT8* buffer = (UINT8*)te_allocate(bufferSize);
+        UINT8* buffer = (UINT8*)te_allocate<MemoryCategory::Animation>(bufferSize);
 
         Positions = (Vector3*)buffer;
         buffer += sizeof(Vector3) * numPos;
@@ -46,6 +48,7 @@ namespace te
         , Rotations{ std::exchange(other.Rotations, nullptr) }
         , Scales{ std::exchange(other.Scales, nullptr) }
         , HasOverride{ std::exchange(other.HasOverride, nullptr) }
+        , HasAnimCurve{ std::exchange(other.HasAnimCurve, nullptr) }
         , NumBones(std::exchange(other.NumBones, 0))
     { }
 
@@ -66,6 +69,7 @@ namespace te
             Rotations = std::exchange(other.Rotations, nullptr);
             Scales = std::exchange(other.Scales, nullptr);
             HasOverride = std::exchange(other.HasOverride, nullptr);
+            HasAnimCurve = std::exchange(other.HasAnimCurve, nullptr);
             NumBones = std::exchange(other.NumBones, 0);
         }
 
@@ -93,6 +97,8 @@ namespace te
             _bonesInfo[i].Name = bones[i].Name;
             _bonesInfo[i].Parent = bones[i].Parent;
         }
+
+        BuildHierarchyOrder();
     }
 
     Skeleton::~Skeleton()
@@ -105,6 +111,31 @@ namespace te
 
         if (_bonesInfo != nullptr)
             te_deleteN(_bonesInfo, _numBones);
+
+        if (_hierarchyOrder != nullptr)
+            te_free(_hierarchyOrder);
+    }
+
+    void Skeleton::BuildHierarchyOrder()
+    {
+        _hierarchyOrder = (UINT32*)te_allocate<MemoryCategory::Animation>(sizeof(UINT32) * _numBones);
+
+        // Depth of a bone is the number of parents it has, so sorting by it guarantees parents come first
+        Vector<UINT32> depths(_numBones, 0);
+        for (UINT32 i = 0; i < _numBones; i++)
+        {
+            _hierarchyOrder[i] = i;
+
+            UINT32 parentIdx = _bonesInfo[i].Parent;
+            while (parentIdx != (UINT32)-1 && parentIdx < _numBones && depths[i] < _numBones)
+            {
+                depths[i]++;
+                parentIdx = _bonesInfo[parentIdx].Parent;
+            }
+        }
+
+        std::stable_sort(_hierarchyOrder, _hierarchyOrder + _numBones,
+            [&depths](UINT32 a, UINT32 b) { return depths[a] < depths[b]; });
     }
 
     void Skeleton::GetPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask,
@@ -148,8 +179,8 @@ namespace te
             localPose.Scales[i] = Vector3::ONE;
         }
 
-        bool* hasAnimCurve = te_newN<bool>(_numBones);
-        te_zero_out(hasAnimCurve, _numBones);
+        bool* hasAnimCurve = localPose.HasAnimCurve;
+        memset(hasAnimCurve, 0, sizeof(bool) * _numBones);
 
         for (UINT32 i = 0; i < numLayers; i++)
         {
@@ -258,63 +289,112 @@ namespace te
             }
         }
 
-        // Calculate local pose matrices
-        UINT32 isGlobalBytes = sizeof(bool) * _numBones;
-        bool* isGlobal = (bool*)te_allocate(isGlobalBytes);
-        memset(isGlobal, 0, isGlobalBytes);
+        ComputeLocalMatrices(pose, localPose);
 
+        // Calculate model space poses. Bones are visited in hierarchy order so parents (and overrides, which are
+        // already in model space) are always resolved before their children.
         for (UINT32 i = 0; i < _numBones; i++)
         {
-            bool isAssigned = localPose.Rotations[i].w != 0.0f;
-            if (!isAssigned)
-                localPose.Rotations[i] = Quaternion::IDENTITY;
-            else
-                localPose.Rotations[i].Normalize();
+            UINT32 boneIdx = _hierarchyOrder[i];
+            if (localPose.HasOverride[boneIdx])
+                continue;
 
-            if (localPose.HasOverride[i])
-            {
-                isGlobal[i] = true;
+            UINT32 parentBoneIdx = _bonesInfo[boneIdx].Parent;
+            if (parentBoneIdx == (UINT32)-1)
                 continue;
-            }
 
-            pose[i] = Matrix4::TRS(localPose.Positions[i], localPose.Rotations[i], localPose.Scales[i]);
+            SIMD::Multiply(pose[parentBoneIdx], pose[boneIdx], pose[boneIdx]);
         }
 
-        // Calculate global poses
-        // Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-        // always come before children, we no isGlobal check is needed.
-        std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+        for (UINT32 i = 0; i < _numBones; i++)
+            SIMD::Multiply(pose[i], _invBindPoses[i], pose[i]);
+    }
+
+    void Skeleton::ComputeLocalMatrices(Matrix4* pose, LocalSkeletonPose& localPose) const
+    {
+        const SIMD::Float4 zero = SIMD::Zero();
+        const SIMD::Float4 one = SIMD::Splat(1.0f);
+        const SIMD::Float4 tolerance = SIMD::Splat(1e-04f * 1e-04f);
+
+        for (UINT32 i = 0; i < _numBones; i += 4)
         {
-            UINT32 parentBoneIdx = _bonesInfo[boneIdx].Parent;
-            if (parentBoneIdx == (UINT32)-1)
+            UINT32 count = std::min(4U, _numBones - i);
+
+            // Gather the local pose of 4 bones into SoA form, unused lanes get an identity transform
+            alignas(16) float lanes[10][4];
+            bool anyOverride = false;
+            for (UINT32 j = 0; j < 4; j++)
             {
-                isGlobal[boneIdx] = true;
-                return;
+                if (j < count)
+                {
+                    const Vector3& position = localPose.Positions[i + j];
+                    const Quaternion& rotation = localPose.Rotations[i + j];
+                    const Vector3& scale = localPose.Scales[i + j];
+
+                    lanes[0][j] = position.x; lanes[1][j] = position.y; lanes[2][j] = position.z;
+                    lanes[3][j] = rotation.x; lanes[4][j] = rotation.y; lanes[5][j] = rotation.z; lanes[6][j] = rotation.w;
+                    lanes[7][j] = scale.x; lanes[8][j] = scale.y; lanes[9][j] = scale.z;
+
+                    anyOverride |= localPose.HasOverride[i + j];
+                }
+                else
+                {
+                    lanes[0][j] = 0.0f; lanes[1][j] = 0.0f; lanes[2][j] = 0.0f;
+                    lanes[3][j] = 0.0f; lanes[4][j] = 0.0f; lanes[5][j] = 0.0f; lanes[6][j] = 1.0f;
+                    lanes[7][j] = 1.0f; lanes[8][j] = 1.0f; lanes[9][j] = 1.0f;
+                }
             }
 
-            if (!isGlobal[parentBoneIdx])
-                calcGlobal(parentBoneIdx);
+            SIMD::Float4 qx = SIMD::Load(lanes[3]);
+            SIMD::Float4 qy = SIMD::Load(lanes[4]);
+            SIMD::Float4 qz = SIMD::Load(lanes[5]);
+            SIMD::Float4 qw = SIMD::Load(lanes[6]);
 
-            pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-            isGlobal[boneIdx] = true;
-        };
+            // Rotations that were never assigned are left at zero and become identity, others get normalized
+            SIMD::Float4 lengthSqrd = SIMD::Mul(qx, qx);
+            lengthSqrd = SIMD::MulAdd(qy, qy, lengthSqrd);
+            lengthSqrd = SIMD::MulAdd(qz, qz, lengthSqrd);
+            lengthSqrd = SIMD::MulAdd(qw, qw, lengthSqrd);
 
-        for (UINT32 i = 0; i < _numBones; i++)
-        {
-            if (!isGlobal[i])
-                calcGlobal(i);
-        }
+            SIMD::Float4 length = SIMD::Sqrt(lengthSqrd);
+            SIMD::Float4 canNormalize = SIMD::Greater(length, tolerance);
+            SIMD::Float4 invLength = SIMD::Select(canNormalize, SIMD::Div(one, length), one);
+            SIMD::Float4 isAssigned = SIMD::NotEqual(qw, zero);
 
-        for (UINT32 i = 0; i < _numBones; i++)
-            pose[i] = pose[i] * _invBindPoses[i];
+            qx = SIMD::Select(isAssigned, SIMD::Mul(qx, invLength), zero);
+            qy = SIMD::Select(isAssigned, SIMD::Mul(qy, invLength), zero);
+            qz = SIMD::Select(isAssigned, SIMD::Mul(qz, invLength), zero);
+            qw = SIMD::Select(isAssigned, SIMD::Mul(qw, invLength), one);
+
+            SIMD::Store(lanes[3], qx);
+            SIMD::Store(lanes[4], qy);
+            SIMD::Store(lanes[5], qz);
+            SIMD::Store(lanes[6], qw);
+
+            for (UINT32 j = 0; j < count; j++)
+                localPose.Rotations[i + j] = Quaternion(lanes[6][j], lanes[3][j], lanes[4][j], lanes[5][j]);
+
+            // Overriden bones already contain their final transform and must not be touched
+            Matrix4 localMatrices[4];
+            Matrix4* output = anyOverride ? localMatrices : pose + i;
 
-        te_delete(isGlobal);
-        te_deleteN<bool>(hasAnimCurve, _numBones);
+            SIMD::TRS4(SIMD::Load(lanes[0]), SIMD::Load(lanes[1]), SIMD::Load(lanes[2]), qx, qy, qz, qw,
+                SIMD::Load(lanes[7]), SIMD::Load(lanes[8]), SIMD::Load(lanes[9]), output, count);
+
+            if (anyOverride)
+            {
+                for (UINT32 j = 0; j < count; j++)
+                {
+                    if (!localPose.HasOverride[i + j])
+                        pose[i + j] = localMatrices[j];
+                }
+            }
+        }
     }
 
     SPtr<Skeleton> Skeleton::Create(BONE_DESC* bones, UINT32 numBones)
     {
-        Skeleton* rawPtr = new (te_allocate<Skeleton>()) Skeleton(bones, numBones);
+        Skeleton* rawPtr = new (te_allocate<Skeleton, MemoryCategory::Animation>()) Skeleton(bones, numBones);
         SPtr<Skeleton> skeleton = te_core_ptr<Skeleton>(rawPtr);
         skeleton->SetThisPtr(skeleton);
 
@@ -351,7 +431,7 @@ namespace te
 
     SPtr<Skeleton> Skeleton::CreateEmpty()
     {
-        Skeleton* rawPtr = new (te_allocate<Skeleton>()) Skeleton();
+        Skeleton* rawPtr = new (te_allocate<Skeleton, MemoryCategory::Animation>()) Skeleton();
 
         SPtr<Skeleton> newSkeleton = te_core_ptr<Skeleton>(rawPtr);
         newSkeleton->SetThisPtr(newSkeleton);
@@ -85,6 +85,7 @@ namespace te
         Quaternion* Rotations = nullptr; /**< Local bone rotations at specific animation time. */
         Vector3* Scales = nullptr; /**< Local bone scales at specific animation time. */
         bool* HasOverride = nullptr; /**< True if the bone transform was overriden externally (local pose was ignored). */
+        bool* HasAnimCurve = nullptr; /**< Scratch used during pose evaluation, true if a bone was touched by a curve. */
         UINT32 NumBones = 0; /**< Number of bones in the pose. */
     };
 
@@ -171,9 +172,19 @@ namespace te
         Skeleton();
         Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+        /**
+         * Sorts bone indices so that parents always come before their children, allowing model space transforms to
+         * be calculated in a single linear pass.
+         */
+        void BuildHierarchyOrder();
+
+        /** Normalizes local rotations and converts the local pose to matrices, four bones at a time. */
+        void ComputeLocalMatrices(Matrix4* pose, LocalSkeletonPose& localPose) const;
+
         UINT32 _numBones = 0;
         Transform* _boneTransforms = nullptr;
         Matrix4* _invBindPoses = nullptr;
         SkeletonBoneInfo* _bonesInfo = nullptr;
+        UINT32* _hierarchyOrder = nullptr;
     };
 }
@@ -55,7 +55,27 @@ namespace te
         /** Returns a list of all available audio devices. */
         virtual const Vector<AudioDevice>& GetAllDevices() const = 0;
 
-        /** Called once per frame. Queues streaming audio requests. */
+        /**
+         * Determines how many audio sources can be played back by the device at once. When more sources are playing,
+         * those with the lowest priority and the quietest for the listeners are virtualized: their playback time still
+         * advances but nothing is decoded or mixed, until they get a voice back.
+         */
+        virtual void SetMaxVoices(UINT32 count) = 0;
+
+        /** @copydoc SetMaxVoices */
+        virtual UINT32 GetMaxVoices() const = 0;
+
+        /**
+         * Determines how much audio is decoded ahead of playback for each streaming source, in seconds. A longer
+         * look-ahead uses more memory but lets streams survive longer decoding stalls. Applies to streams started
+         * afterwards.
+         */
+        virtual void SetStreamingLookAhead(float seconds) = 0;
+
+        /** @copydoc SetStreamingLookAhead */
+        virtual float GetStreamingLookAhead() const = 0;
+
+        /** Called once per frame. Updates the playing sources. */
         virtual void Update();
 
     protected:
@@ -63,12 +63,14 @@ namespace te
         /**
          * Determines the priority of the audio source. If more audio sources are playing than supported by the hardware,
          * some might get disabled. By setting a higher priority the audio source is guaranteed to be disabled after sources
-         * with lower priority.
+         * with lower priority. Sources with the same priority are disabled from the quietest to the loudest.
+         *
+         * @see Audio::SetMaxVoices
          */
         virtual void SetPriority(INT32 priority);
 
         /** @copydoc SetPriority */
-        UINT32 GetPriority() const { return _priority; }
+        INT32 GetPriority() const { return _priority; }
 
         /**
          * Minimum distance at which audio attenuation starts. When the listener is closer to the source
@@ -73,6 +73,9 @@ set (TE_CORE_INC_RENDERER
     "Core/Renderer/TeRenderQueue.h"
     "Core/Renderer/TeRenderElement.h"
     "Core/Renderer/TeSkybox.h"
+    "Core/Renderer/TeIBLUtility.h"
+    "Core/Renderer/TeOcclusionBuffer.h"
+    "Core/Renderer/TeRendererCulling.h"
     "Core/Renderer/TeRendererUtility.h"
     "Core/Renderer/TeGpuResourcePool.h"
     "Core/Renderer/TeRendererMaterialManager.h"
@@ -91,6 +94,9 @@ set (TE_CORE_SRC_RENDERER
     "Core/Renderer/TeRenderQueue.cpp"
     "Core/Renderer/TeRenderElement.cpp"
     "Core/Renderer/TeSkybox.cpp"
+    "Core/Renderer/TeIBLUtility.cpp"
+    "Core/Renderer/TeOcclusionBuffer.cpp"
+    "Core/Renderer/TeRendererCulling.cpp"
     "Core/Renderer/TeRendererUtility.cpp"
     "Core/Renderer/TeGpuResourcePool.cpp"
     "Core/Renderer/TeRendererMaterialManager.cpp"
@@ -107,6 +113,7 @@ set (TE_CORE_INC_SCENE
     "Core/Scene/TeGameObjectHandle.h"
     "Core/Scene/TeGameObjectManager.h"
     "Core/Scene/TeSceneObject.h"
+    "Core/Scene/TeSceneTransformSystem.h"
 )
 set (TE_CORE_SRC_SCENE
     "Core/Scene/TeSceneActor.cpp"
@@ -117,6 +124,7 @@ set (TE_CORE_SRC_SCENE
     "Core/Scene/TeGameObjectHandle.cpp"
     "Core/Scene/TeGameObjectManager.cpp"
     "Core/Scene/TeSceneObject.cpp"
+    "Core/Scene/TeSceneTransformSystem.cpp"
 )
 
 set(TE_CORE_INC_PLATFORM
@@ -223,6 +231,8 @@ set (TE_CORE_SRC_IMPORTER
 set (TE_CORE_INC_IMAGE
     "Core/Image/TeTexture.h"
     "Core/Image/TeTextureManager.h"
+    "Core/Image/TeTextureStreaming.h"
+    "Core/Image/TeTextureAtlasLayout.h"
     "Core/Image/TePixelData.h"
     "Core/Image/TePixelUtil.h"
     "Core/Image/TePixelVolume.h"
@@ -231,6 +241,8 @@ set (TE_CORE_INC_IMAGE
 set (TE_CORE_SRC_IMAGE
     "Core/Image/TeTexture.cpp"
     "Core/Image/TeTextureManager.cpp"
+    "Core/Image/TeTextureStreaming.cpp"
+    "Core/Image/TeTextureAtlasLayout.cpp"
     "Core/Image/TePixelData.cpp"
     "Core/Image/TePixelUtil.cpp"
     "Core/Image/TeColor.cpp"
@@ -266,8 +278,10 @@ set (TE_CORE_SRC_MATERIAL
 
 set (TE_CORE_INC_SERIALIZATION
     "Core/Serialization/TeSerializable.h"
+    "Core/Serialization/TeSceneFile.h"
 )
 set (TE_CORE_SRC_SERIALIZATION
+    "Core/Serialization/TeSceneFile.cpp"
 )
 
 set (TE_CORE_INC_COMPONENTS
@@ -349,6 +363,7 @@ set (TE_CORE_INC_RESOURCE
     "Core/Resources/TeResourceHandle.h"
     "Core/Resources/TeGpuResourceData.h"
     "Core/Resources/TeBuiltinResources.h"
+    "Core/Resources/TeResourceHotReload.h"
 )
 set (TE_CORE_SRC_RESOURCE
     "Core/Resources/TeResource.cpp"
@@ -356,6 +371,7 @@ set (TE_CORE_SRC_RESOURCE
     "Core/Resources/TeResourceHandle.cpp"
     "Core/Resources/TeGpuResourceData.cpp"
     "Core/Resources/TeBuiltinResources.cpp"
+    "Core/Resources/TeResourceHotReload.cpp"
 )
 
 set (TE_CORE_INC_AUDIO
@@ -508,11 +524,13 @@ set (TE_CORE_INC_PICKING
     "Core/Picking/TePicking.h"
     "Core/Picking/TePickingMat.h"
     "Core/Picking/TePickingUtils.h"
+    "Core/Picking/TeRayPicking.h"
 )
 set (TE_CORE_SRC_PICKING
     "Core/Picking/TePicking.cpp"
     "Core/Picking/TePickingMat.cpp"
     "Core/Picking/TePickingUtils.cpp"
+    "Core/Picking/TeRayPicking.cpp"
 )
 
 if (WIN32)
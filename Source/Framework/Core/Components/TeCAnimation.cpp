@@ -16,6 +16,7 @@ namespace te
         SetName("Animation");
         SetNotifyFlags(TCF_Transform);
         SetFlag(Component::AlwaysRun, true);
+        SetUpdatePhase(ComponentUpdatePhase::Update);
     }
 
     CAnimation::CAnimation(const HSceneObject& parent)
@@ -24,6 +25,7 @@ namespace te
         SetName("Animation");
         SetNotifyFlags(TCF_Transform);
         SetFlag(Component::AlwaysRun, true);
+        SetUpdatePhase(ComponentUpdatePhase::Update);
     }
 
     CAnimation::~CAnimation()
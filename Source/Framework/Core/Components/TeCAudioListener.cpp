@@ -9,6 +9,7 @@ namespace te
         : Component(HSceneObject(), (UINT32)TID_CAudioListener)
     {
         SetName("AudioListener");
+        SetUpdatePhase(ComponentUpdatePhase::PostUpdate);
         SetNotifyFlags(TCF_Transform | TCF_Parent);
         SetFlag(Component::AlwaysRun, true);
     }
@@ -17,6 +18,7 @@ namespace te
         : Component(parent, (UINT32)TID_CAudioListener)
     {
         SetName("AudioListener");
+        SetUpdatePhase(ComponentUpdatePhase::PostUpdate);
         SetNotifyFlags(TCF_Transform | TCF_Parent);
         SetFlag(Component::AlwaysRun, true);
     }
@@ -59,6 +59,9 @@ namespace te
         /** @copydoc Component::OnDestroyed */
         void OnDestroyed() override;
 
+        /** @copydoc Component::CanBeSaved */
+        bool CanBeSaved() const override { return true; }
+
     protected:
         using Component::DestroyInternal;
 
@@ -10,6 +10,7 @@ namespace te
         : Component(HSceneObject(), (UINT32)TID_CAudioSource)
     {
         SetName("AudioSource");
+        SetUpdatePhase(ComponentUpdatePhase::PostUpdate);
         SetNotifyFlags(TCF_Parent | TCF_Transform);
         SetFlag(Component::AlwaysRun, true);
     }
@@ -18,6 +19,7 @@ namespace te
         : Component(parent, (UINT32)TID_CAudioSource)
     {
         SetName("AudioSource");
+        SetUpdatePhase(ComponentUpdatePhase::PostUpdate);
         SetNotifyFlags(TCF_Parent | TCF_Transform);
         SetFlag(Component::AlwaysRun, true);
     }
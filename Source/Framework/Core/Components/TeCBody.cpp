@@ -9,6 +9,7 @@ namespace te
         , _internal(nullptr)
     {
         SetName("Body");
+        SetUpdatePhase(ComponentUpdatePhase::Update);
         SetNotifyFlags(TCF_Parent | TCF_Transform);
         SetFlag(Component::AlwaysRun, true);
     }
@@ -18,6 +19,7 @@ namespace te
         , _internal(nullptr)
     {
         SetName("Body");
+        SetUpdatePhase(ComponentUpdatePhase::Update);
         SetNotifyFlags(TCF_Parent | TCF_Transform);
         SetFlag(Component::AlwaysRun, true);
     }
@@ -2,6 +2,7 @@
 
 #include "Scene/TeSceneObject.h"
 #include "Components/TeCAnimation.h"
+#include "Utility/TeDataStream.h"
 
 namespace te
 {
@@ -145,4 +146,22 @@ namespace te
 
         return false;
     }
+
+    void CBone::WriteProperties(DataStream& stream) const
+    {
+        const UINT32 nameLength = (UINT32)_boneName.size();
+
+        stream.Write(&nameLength, sizeof(nameLength));
+        stream.Write(_boneName.data(), nameLength);
+    }
+
+    void CBone::ReadProperties(DataStream& stream)
+    {
+        UINT32 nameLength = 0;
+        stream.Read(&nameLength, sizeof(nameLength));
+
+        // Bound to its animation when initialized
+        _boneName.resize(nameLength);
+        stream.Read(&_boneName[0], nameLength);
+    }
 }
@@ -1,6 +1,9 @@
 #include "Components/TeCCamera.h"
 #include "Scene/TeSceneManager.h"
 #include "Renderer/TeRenderer.h"
+#include "Renderer/TeViewport.h"
+#include "Renderer/TeRenderSettings.h"
+#include "Utility/TeDataStream.h"
 
 namespace te
 {
@@ -121,4 +124,172 @@ namespace te
 
         return false;
     }
+
+    namespace
+    {
+        /**
+         * Calls @p visit on each field of @p settings, in the order they are stored in scene files. Shared by reading
+         * and writing so both always agree on the layout.
+         */
+        template<class Settings, class Visitor>
+        void VisitRenderSettings(Settings& settings, Visitor visit)
+        {
+            visit(settings.EnableAutoExposure);
+            visit(settings.Tonemapping.Enabled);
+
+            visit(settings.AmbientOcclusion.Enabled);
+            visit(settings.AmbientOcclusion.Radius);
+            visit(settings.AmbientOcclusion.Bias);
+            visit(settings.AmbientOcclusion.FadeDistance);
+            visit(settings.AmbientOcclusion.FadeRange);
+            visit(settings.AmbientOcclusion.Intensity);
+            visit(settings.AmbientOcclusion.Power);
+            visit(settings.AmbientOcclusion.Quality);
+
+            visit(settings.ScreenSpaceReflections.Enabled);
+            visit(settings.ScreenSpaceReflections.Quality);
+            visit(settings.ScreenSpaceReflections.intensity);
+            visit(settings.ScreenSpaceReflections.MaxRoughness);
+
+            visit(settings.Bloom.Enabled);
+            visit(settings.Bloom.Intensity);
+            visit(settings.Bloom.Quality);
+
+            visit(settings.MotionBlur.Enabled);
+            visit(settings.MotionBlur.Domain);
+            visit(settings.MotionBlur.Filter);
+            visit(settings.MotionBlur.Quality);
+
+            visit(settings.DepthOfField.Enabled);
+            visit(settings.DepthOfField.FocalDistance);
+            visit(settings.DepthOfField.NearTransitionRange);
+            visit(settings.DepthOfField.FarTransitionRange);
+            visit(settings.DepthOfField.MaxBokehSize);
+            visit(settings.DepthOfField.AdaptiveColorThreshold);
+            visit(settings.DepthOfField.AdaptiveRadiusThreshold);
+            visit(settings.DepthOfField.ApertureSize);
+            visit(settings.DepthOfField.FocalLength);
+            visit(settings.DepthOfField.SensorSize);
+
+            visit(settings.TemporalAA.JitteredPositionCount);
+            visit(settings.TemporalAA.Sharpness);
+
+            visit(settings.ShadowSettings.DirectionalShadowDistance);
+            visit(settings.ShadowSettings.NumCascades);
+            visit(settings.ShadowSettings.CascadeDistributionExponent);
+            visit(settings.ShadowSettings.ShadowFilteringQuality);
+
+            visit(settings.OutputType);
+            visit(settings.AntialiasingAglorithm);
+            visit(settings.ExposureScale);
+            visit(settings.Gamma);
+            visit(settings.EnableHDR);
+            visit(settings.EnableLighting);
+            visit(settings.EnableShadows);
+            visit(settings.EnableDynamicEnvMapping);
+            visit(settings.OverlayOnly);
+            visit(settings.EnableSkybox);
+            visit(settings.Contrast);
+            visit(settings.Brightness);
+            visit(settings.CullDistance);
+            visit(settings.SceneLightColor);
+            visit(settings.UseGlobalIllumination);
+        }
+    }
+
+    void CCamera::WriteProperties(DataStream& stream) const
+    {
+        // The render target isn't saved, it is provided by the application once the scene is loaded
+        const UINT32 projType = (UINT32)_internal->_projType;
+        const float horzFOV = _internal->_horzFOV.ValueDegrees();
+        const SPtr<Viewport>& viewport = _internal->_viewport;
+        const Rect2 area = viewport->GetArea();
+        const Color clearColor = viewport->GetClearColorValue();
+        const float clearDepth = viewport->GetClearDepthValue();
+        const UINT16 clearStencil = viewport->GetClearStencilValue();
+        const UINT32 clearFlags = viewport->GetClearFlags();
+
+        stream.Write(&projType, sizeof(projType));
+        stream.Write(&horzFOV, sizeof(horzFOV));
+        stream.Write(&_internal->_nearDist, sizeof(_internal->_nearDist));
+        stream.Write(&_internal->_farDist, sizeof(_internal->_farDist));
+        stream.Write(&_internal->_aspect, sizeof(_internal->_aspect));
+        stream.Write(&_internal->_orthoHeight, sizeof(_internal->_orthoHeight));
+        stream.Write(&_internal->_priority, sizeof(_internal->_priority));
+        stream.Write(&_internal->_main, sizeof(_internal->_main));
+        stream.Write(&_internal->_cameraFlags, sizeof(_internal->_cameraFlags));
+        stream.Write(&_internal->_MSAA, sizeof(_internal->_MSAA));
+        stream.Write(&_internal->_layers, sizeof(_internal->_layers));
+        stream.Write(&area, sizeof(area));
+        stream.Write(&clearColor, sizeof(clearColor));
+        stream.Write(&clearDepth, sizeof(clearDepth));
+        stream.Write(&clearStencil, sizeof(clearStencil));
+        stream.Write(&clearFlags, sizeof(clearFlags));
+
+        VisitRenderSettings(*_internal->_renderSettings, [&stream](const auto& value)
+        {
+            stream.Write(&value, sizeof(value));
+        });
+    }
+
+    void CCamera::ReadProperties(DataStream& stream)
+    {
+        UINT32 projType = 0;
+        float horzFOV = 0.0f;
+        float nearDist = 0.0f;
+        float farDist = 0.0f;
+        float aspect = 0.0f;
+        float orthoHeight = 0.0f;
+        INT32 priority = 0;
+        bool main = false;
+        UINT32 cameraFlags = 0;
+        UINT32 MSAA = 1;
+        UINT64 layers = 0;
+        Rect2 area;
+        Color clearColor;
+        float clearDepth = 0.0f;
+        UINT16 clearStencil = 0;
+        UINT32 clearFlags = 0;
+        RenderSettings renderSettings;
+
+        stream.Read(&projType, sizeof(projType));
+        stream.Read(&horzFOV, sizeof(horzFOV));
+        stream.Read(&nearDist, sizeof(nearDist));
+        stream.Read(&farDist, sizeof(farDist));
+        stream.Read(&aspect, sizeof(aspect));
+        stream.Read(&orthoHeight, sizeof(orthoHeight));
+        stream.Read(&priority, sizeof(priority));
+        stream.Read(&main, sizeof(main));
+        stream.Read(&cameraFlags, sizeof(cameraFlags));
+        stream.Read(&MSAA, sizeof(MSAA));
+        stream.Read(&layers, sizeof(layers));
+        stream.Read(&area, sizeof(area));
+        stream.Read(&clearColor, sizeof(clearColor));
+        stream.Read(&clearDepth, sizeof(clearDepth));
+        stream.Read(&clearStencil, sizeof(clearStencil));
+        stream.Read(&clearFlags, sizeof(clearFlags));
+
+        VisitRenderSettings(renderSettings, [&stream](auto& value)
+        {
+            stream.Read(&value, sizeof(value));
+        });
+
+        _internal->SetProjectionType((ProjectionType)projType);
+        _internal->SetHorzFOV(Degree(horzFOV));
+        _internal->SetNearClipDistance(nearDist);
+        _internal->SetFarClipDistance(farDist);
+        _internal->SetAspectRatio(aspect);
+        _internal->SetOrthoWindowHeight(orthoHeight);
+        _internal->SetPriority(priority);
+        _internal->SetMain(main);
+        _internal->SetFlags(cameraFlags);
+        _internal->SetMSAACount(MSAA);
+        _internal->SetLayers(layers);
+        _internal->SetRenderSettings(renderSettings);
+
+        const SPtr<Viewport>& viewport = _internal->_viewport;
+        viewport->SetArea(area);
+        viewport->SetClearValues(clearColor, clearDepth, clearStencil);
+        viewport->SetClearFlags(clearFlags);
+    }
 }
@@ -21,6 +21,7 @@ namespace te
         : Component(HSceneObject(), TID_CCameraFlyer)
     {
         SetName("CCameraFlyer");
+        SetUpdatePhase(ComponentUpdatePhase::PreUpdate);
         SetFlag(Component::AlwaysRun, true);
     }
 
@@ -28,6 +29,7 @@ namespace te
         : Component(parent, TID_CCameraFlyer)
     {
         SetName("CCameraFlyer");
+        SetUpdatePhase(ComponentUpdatePhase::PreUpdate);
         SetFlag(Component::AlwaysRun, true);
 
         // Get handles for key bindings. Actual keys attached to these bindings will be registered during app start-up.
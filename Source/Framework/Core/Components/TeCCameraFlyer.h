@@ -35,6 +35,9 @@ namespace te
         CCameraFlyer();
         CCameraFlyer(const HSceneObject& parent);
 
+        /** @copydoc Component::CanBeSaved */
+        bool CanBeSaved() const override { return true; }
+
     private:
         float _currentSpeed = 0.0f; /**< Current speed of the camera. */
 
@@ -11,6 +11,7 @@
 #include "Utility/TeTime.h"
 #include "Input/TeInput.h"
 #include "Gui/TeGuiAPI.h"
+#include "Utility/TeDataStream.h"
 
 namespace te
 {
@@ -44,6 +45,7 @@ namespace te
         , _lastHideCursorState(false)
     {
         SetName("CCameraUI");
+        SetUpdatePhase(ComponentUpdatePhase::PreUpdate);
         SetFlag(Component::AlwaysRun, true);
     }
 
@@ -59,6 +61,7 @@ namespace te
         , _lastHideCursorState(false)
     {
         SetName("CCameraUI");
+        SetUpdatePhase(ComponentUpdatePhase::PreUpdate);
         SetFlag(Component::AlwaysRun, true);
 
         _rotateBtn = VirtualButton(ROTATE_BINDING);
@@ -294,4 +297,22 @@ namespace te
 
         return false;
     }
+
+    void CCameraUI::WriteProperties(DataStream& stream) const
+    {
+        stream.Write(&_target, sizeof(_target));
+        stream.Write(&_inputEnabled, sizeof(_inputEnabled));
+        stream.Write(&_zoomingEnabled, sizeof(_zoomingEnabled));
+    }
+
+    void CCameraUI::ReadProperties(DataStream& stream)
+    {
+        stream.Read(&_target, sizeof(_target));
+        stream.Read(&_inputEnabled, sizeof(_inputEnabled));
+        stream.Read(&_zoomingEnabled, sizeof(_zoomingEnabled));
+
+        // The transform of the scene object is restored before its components
+        InitDistanceToTarget();
+        InitLocalRotation();
+    }
 }
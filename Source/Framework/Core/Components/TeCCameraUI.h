@@ -66,6 +66,15 @@ namespace te
         void InitDistanceToTarget();
         void InitLocalRotation();
 
+        /** @copydoc Component::CanBeSaved */
+        bool CanBeSaved() const override { return true; }
+
+        /** @copydoc Component::WriteProperties */
+        void WriteProperties(DataStream& stream) const override;
+
+        /** @copydoc Component::ReadProperties */
+        void ReadProperties(DataStream& stream) override;
+
     protected:
         bool _cameraInitialized; // On first update, we get CCamera component from parent sceneObject
         bool _needsRedraw; // If something has been modified, we need to set that to true
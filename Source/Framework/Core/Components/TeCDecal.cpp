@@ -1,6 +1,9 @@
 #include "Components/TeCDecal.h"
 #include "Scene/TeSceneManager.h"
 #include "Renderer/TeRenderer.h"
+#include "Resources/TeResourceManager.h"
+#include "Material/TeMaterial.h"
+#include "Utility/TeDataStream.h"
 
 namespace te
 {
@@ -106,4 +109,43 @@ namespace te
 
         return false;
     }
+
+    void CDecal::WriteProperties(DataStream& stream) const
+    {
+        // Material is referenced by UUID, it must be loaded before the scene is
+        const UUID materialUUID = _internal->_material ? _internal->_material->GetUUID() : UUID::EMPTY;
+
+        stream.Write(&materialUUID, sizeof(materialUUID));
+        stream.Write(&_internal->_size, sizeof(_internal->_size));
+        stream.Write(&_internal->_maxDistance, sizeof(_internal->_maxDistance));
+        stream.Write(&_internal->_layer, sizeof(_internal->_layer));
+        stream.Write(&_internal->_layerMask, sizeof(_internal->_layerMask));
+    }
+
+    void CDecal::ReadProperties(DataStream& stream)
+    {
+        UUID materialUUID;
+        Vector2 size;
+        float maxDistance = 0.0f;
+        UINT64 layer = 0;
+        UINT32 layerMask = 0;
+
+        stream.Read(&materialUUID, sizeof(materialUUID));
+        stream.Read(&size, sizeof(size));
+        stream.Read(&maxDistance, sizeof(maxDistance));
+        stream.Read(&layer, sizeof(layer));
+        stream.Read(&layerMask, sizeof(layerMask));
+
+        if (!materialUUID.Empty())
+        {
+            HMaterial material = gResourceManager().Load<Material>(materialUUID);
+            if (material.IsLoaded())
+                _internal->SetMaterial(material.GetInternalPtr());
+        }
+
+        _internal->SetSize(size);
+        _internal->SetMaxDistance(maxDistance);
+        _internal->SetLayer(layer);
+        _internal->SetLayerMask(layerMask);
+    }
 }
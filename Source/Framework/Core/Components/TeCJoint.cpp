@@ -11,6 +11,7 @@ namespace te
         , _internal(nullptr)
     {
         SetName("Joint");
+        SetUpdatePhase(ComponentUpdatePhase::Update);
         SetNotifyFlags(TCF_Parent | TCF_Transform);
 
         _positions[0] = Vector3::ZERO;
@@ -25,6 +26,7 @@ namespace te
         , _internal(nullptr)
     {
         SetName("Joint");
+        SetUpdatePhase(ComponentUpdatePhase::Update);
         SetNotifyFlags(TCF_Parent | TCF_Transform);
 
         _positions[0] = Vector3::ZERO;
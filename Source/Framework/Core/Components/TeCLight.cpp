@@ -1,6 +1,7 @@
 #include "Components/TeCLight.h"
 #include "Scene/TeSceneManager.h"
 #include "Renderer/TeRenderer.h"
+#include "Utility/TeDataStream.h"
 
 namespace te
 {
@@ -127,4 +128,42 @@ namespace te
 
         return false;
     }
+
+    void CLight::WriteProperties(DataStream& stream) const
+    {
+        const UINT32 type = (UINT32)_internal->_type;
+        const float spotAngle = _internal->_spotAngle.ValueDegrees();
+
+        stream.Write(&type, sizeof(type));
+        stream.Write(&_internal->_color, sizeof(_internal->_color));
+        stream.Write(&_internal->_intensity, sizeof(_internal->_intensity));
+        stream.Write(&_internal->_attRadius, sizeof(_internal->_attRadius));
+        stream.Write(&_internal->_linearAttenuation, sizeof(_internal->_linearAttenuation));
+        stream.Write(&_internal->_quadraticAttenuation, sizeof(_internal->_quadraticAttenuation));
+        stream.Write(&spotAngle, sizeof(spotAngle));
+        stream.Write(&_internal->_castShadows, sizeof(_internal->_castShadows));
+        stream.Write(&_internal->_shadowBias, sizeof(_internal->_shadowBias));
+    }
+
+    void CLight::ReadProperties(DataStream& stream)
+    {
+        UINT32 type = 0;
+        float spotAngle = 0.0f;
+
+        stream.Read(&type, sizeof(type));
+        stream.Read(&_internal->_color, sizeof(_internal->_color));
+        stream.Read(&_internal->_intensity, sizeof(_internal->_intensity));
+        stream.Read(&_internal->_attRadius, sizeof(_internal->_attRadius));
+        stream.Read(&_internal->_linearAttenuation, sizeof(_internal->_linearAttenuation));
+        stream.Read(&_internal->_quadraticAttenuation, sizeof(_internal->_quadraticAttenuation));
+        stream.Read(&spotAngle, sizeof(spotAngle));
+        stream.Read(&_internal->_castShadows, sizeof(_internal->_castShadows));
+        stream.Read(&_internal->_shadowBias, sizeof(_internal->_shadowBias));
+
+        _internal->_type = (LightType)type;
+        _internal->_spotAngle = Degree(spotAngle);
+
+        _internal->UpdateBounds();
+        _internal->_markCoreDirty();
+    }
 }
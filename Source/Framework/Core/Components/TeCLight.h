@@ -139,5 +139,14 @@ namespace te
 
         /** @copydoc Component::OnDestroyed */
         void OnDestroyed() override;
+
+        /** @copydoc Component::CanBeSaved */
+        bool CanBeSaved() const override { return true; }
+
+        /** @copydoc Component::WriteProperties */
+        void WriteProperties(DataStream& stream) const override;
+
+        /** @copydoc Component::ReadProperties */
+        void ReadProperties(DataStream& stream) override;
     };
 }
@@ -2,6 +2,9 @@
 #include "Scene/TeSceneManager.h"
 #include "Components/TeCAnimation.h"
 #include "Renderer/TeRenderer.h"
+#include "Resources/TeResourceManager.h"
+#include "Material/TeMaterial.h"
+#include "Utility/TeDataStream.h"
 
 namespace te
 {
@@ -164,4 +167,77 @@ namespace te
 
         return false;
     }
+
+    void CRenderable::WriteProperties(DataStream& stream) const
+    {
+        // Resources are referenced by UUID, they must be loaded before the scene is
+        const UUID meshUUID = _internal->_mesh ? _internal->_mesh->GetUUID() : UUID::EMPTY;
+        const UINT32 numMaterials = (UINT32)_internal->_materials.size();
+
+        stream.Write(&meshUUID, sizeof(meshUUID));
+        stream.Write(&numMaterials, sizeof(numMaterials));
+
+        for (const auto& material : _internal->_materials)
+        {
+            const UUID materialUUID = material ? material->GetUUID() : UUID::EMPTY;
+            stream.Write(&materialUUID, sizeof(materialUUID));
+        }
+
+        const RenderableProperties& properties = _internal->_properties;
+        stream.Write(&properties.Instancing, sizeof(properties.Instancing));
+        stream.Write(&properties.CanBeMerged, sizeof(properties.CanBeMerged));
+        stream.Write(&properties.CastShadows, sizeof(properties.CastShadows));
+        stream.Write(&properties.CastLights, sizeof(properties.CastLights));
+        stream.Write(&properties.ReceiveShadows, sizeof(properties.ReceiveShadows));
+        stream.Write(&properties.UseForDynamicEnvMapping, sizeof(properties.UseForDynamicEnvMapping));
+        stream.Write(&properties.WriteVelocity, sizeof(properties.WriteVelocity));
+        stream.Write(&properties.Occluder, sizeof(properties.Occluder));
+        stream.Write(&properties.CullDistanceFactor, sizeof(properties.CullDistanceFactor));
+        stream.Write(&_internal->_layer, sizeof(_internal->_layer));
+    }
+
+    void CRenderable::ReadProperties(DataStream& stream)
+    {
+        UUID meshUUID;
+        UINT32 numMaterials = 0;
+
+        stream.Read(&meshUUID, sizeof(meshUUID));
+        stream.Read(&numMaterials, sizeof(numMaterials));
+
+        Vector<SPtr<Material>> materials(numMaterials);
+        for (auto& material : materials)
+        {
+            UUID materialUUID;
+            stream.Read(&materialUUID, sizeof(materialUUID));
+
+            if (materialUUID.Empty())
+                continue;
+
+            HMaterial handle = gResourceManager().Load<Material>(materialUUID);
+            if (handle.IsLoaded())
+                material = handle.GetInternalPtr();
+        }
+
+        RenderableProperties& properties = _internal->_properties;
+        stream.Read(&properties.Instancing, sizeof(properties.Instancing));
+        stream.Read(&properties.CanBeMerged, sizeof(properties.CanBeMerged));
+        stream.Read(&properties.CastShadows, sizeof(properties.CastShadows));
+        stream.Read(&properties.CastLights, sizeof(properties.CastLights));
+        stream.Read(&properties.ReceiveShadows, sizeof(properties.ReceiveShadows));
+        stream.Read(&properties.UseForDynamicEnvMapping, sizeof(properties.UseForDynamicEnvMapping));
+        stream.Read(&properties.WriteVelocity, sizeof(properties.WriteVelocity));
+        stream.Read(&properties.Occluder, sizeof(properties.Occluder));
+        stream.Read(&properties.CullDistanceFactor, sizeof(properties.CullDistanceFactor));
+        stream.Read(&_internal->_layer, sizeof(_internal->_layer));
+
+        if (!meshUUID.Empty())
+        {
+            HMesh mesh = gResourceManager().Load<Mesh>(meshUUID);
+            if (mesh.IsLoaded())
+                _internal->SetMesh(mesh.GetInternalPtr());
+        }
+
+        _internal->SetMaterials(materials);
+        _internal->_markCoreDirty();
+    }
 }
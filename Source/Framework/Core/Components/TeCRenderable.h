@@ -95,6 +95,12 @@ namespace te
         /** @copydoc Renderable::GetUseForDynamicEnvMapping */
         float GetUseForDynamicEnvMapping() const { return _internal->GetUseForDynamicEnvMapping(); }
 
+        /** @copydoc Renderable::SetOccluder */
+        void SetOccluder(bool occluder) { _internal->SetOccluder(occluder); }
+
+        /** @copydoc Renderable::GetOccluder */
+        bool GetOccluder() const { return _internal->GetOccluder(); }
+
         /** @copydoc Renderable::SetLayer */
         void SetLayer(UINT64 layer) { _internal->SetLayer(layer); }
 
@@ -170,6 +176,15 @@ namespace te
         /** @copydoc Component::OnDestroyed */
         void OnDestroyed() override;
 
+        /** @copydoc Component::CanBeSaved */
+        bool CanBeSaved() const override { return true; }
+
+        /** @copydoc Component::WriteProperties */
+        void WriteProperties(DataStream& stream) const override;
+
+        /** @copydoc Component::ReadProperties */
+        void ReadProperties(DataStream& stream) override;
+
     protected:
         mutable SPtr<Renderable> _internal;
         HAnimation _animation;
@@ -11,6 +11,7 @@ namespace te
         : Component(HSceneObject(), (UINT32)TID_CScript)
     {
         SetName("Script");
+        SetUpdatePhase(ComponentUpdatePhase::Update);
         SetNotifyFlags(TCF_Parent);
         SetFlag(Component::AlwaysRun, true);
     }
@@ -19,6 +20,7 @@ namespace te
         : Component(parent, (UINT32)TID_CScript)
     {
         SetName("Script");
+        SetUpdatePhase(ComponentUpdatePhase::Update);
         SetNotifyFlags(TCF_Parent);
         SetFlag(Component::AlwaysRun, true);
     }
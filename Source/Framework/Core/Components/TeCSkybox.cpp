@@ -2,6 +2,9 @@
 #include "Scene/TeSceneManager.h"
 #include "Renderer/TeRenderer.h"
 #include "Renderer/TeSkybox.h"
+#include "Resources/TeResourceManager.h"
+#include "Image/TeTexture.h"
+#include "Utility/TeDataStream.h"
 
 namespace te
 {
@@ -97,4 +100,42 @@ namespace te
 
         return false;
     }
+
+    void CSkybox::WriteProperties(DataStream& stream) const
+    {
+        // Textures are referenced by UUID, they must be loaded before the scene is
+        const UUID textureUUID = _internal->_texture ? _internal->_texture->GetUUID() : UUID::EMPTY;
+        const UUID irradianceUUID = _internal->_irradiance ? _internal->_irradiance->GetUUID() : UUID::EMPTY;
+
+        stream.Write(&textureUUID, sizeof(textureUUID));
+        stream.Write(&irradianceUUID, sizeof(irradianceUUID));
+        stream.Write(&_internal->_brightness, sizeof(_internal->_brightness));
+    }
+
+    void CSkybox::ReadProperties(DataStream& stream)
+    {
+        UUID textureUUID;
+        UUID irradianceUUID;
+        float brightness = 1.0f;
+
+        stream.Read(&textureUUID, sizeof(textureUUID));
+        stream.Read(&irradianceUUID, sizeof(irradianceUUID));
+        stream.Read(&brightness, sizeof(brightness));
+
+        if (!textureUUID.Empty())
+        {
+            HTexture texture = gResourceManager().Load<Texture>(textureUUID);
+            if (texture.IsLoaded())
+                _internal->SetTexture(texture);
+        }
+
+        if (!irradianceUUID.Empty())
+        {
+            HTexture irradiance = gResourceManager().Load<Texture>(irradianceUUID);
+            if (irradiance.IsLoaded())
+                _internal->SetIrradiance(irradiance);
+        }
+
+        _internal->SetBrightness(brightness);
+    }
 }
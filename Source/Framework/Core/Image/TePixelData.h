@@ -399,6 +399,9 @@ namespace te
         /** Returns the needed size of the internal buffer, in bytes. */
         UINT32 GetInternalBufferSize() const override;
 
+        /** @copydoc GpuResourceData::GetMemoryCategory */
+        MemoryCategory GetMemoryCategory() const override { return MemoryCategory::Texture; }
+
     private:
         PixelVolume _extents = PixelVolume(0, 0, 0, 0);
         PixelFormat _format = PF_UNKNOWN;
@@ -441,6 +441,30 @@ namespace te
         memcpy(dest, src, pixelData.GetSize());
     }
 
+    void Texture::RequestMip(UINT32 mipLevel)
+    {
+        if (!_isStreamed)
+            return;
+
+        UINT32 requested = _requestedMip.load(std::memory_order_relaxed);
+        while (mipLevel < requested &&
+            !_requestedMip.compare_exchange_weak(requested, mipLevel, std::memory_order_relaxed))
+        { }
+    }
+
+    void Texture::ClampToResidentMips(UINT32& mostDetailMip, UINT32& numMips) const
+    {
+        const UINT32 residentMip = GetResidentMip();
+        if (mostDetailMip >= residentMip)
+            return;
+
+        const UINT32 totalMips = _properties.GetNumMipmaps() + 1;
+        const UINT32 lastMip = numMips == 0 ? totalMips - 1 : mostDetailMip + numMips - 1;
+
+        mostDetailMip = std::min(residentMip, totalMips - 1);
+        numMips = lastMip >= mostDetailMip ? lastMip - mostDetailMip + 1 : 1;
+    }
+
     SPtr<TextureView> Texture::RequestView(UINT32 mostDetailMip, UINT32 numMips, UINT32 firstArraySlice, UINT32 numArraySlices, GpuViewUsage usage)
     {
         const TextureProperties& texProps = GetProperties();
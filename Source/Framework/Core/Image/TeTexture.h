@@ -315,6 +315,27 @@ namespace te
          */
         SPtr<TextureView> RequestView(UINT32 mostDetailMip, UINT32 numMips, UINT32 firstArraySlice, UINT32 numArraySlices, GpuViewUsage usage);
 
+        /**
+         * Returns the most detailed mip level that can currently be sampled. Always 0 unless the texture is streamed, in
+         * which case more detailed mips only become available once TextureStreaming has loaded them.
+         */
+        UINT32 GetResidentMip() const { return _residentMip.load(std::memory_order_acquire); }
+
+        /** Checks if the mip levels of this texture are loaded on demand by TextureStreaming. */
+        bool IsStreamed() const { return _isStreamed; }
+
+        /**
+         * Notifies TextureStreaming that the renderer would like to sample the provided mip level this frame. The most
+         * detailed mip requested during a frame wins. Does nothing for textures that aren't streamed. Thread safe.
+         */
+        void RequestMip(UINT32 mipLevel);
+
+        /**
+         * Restricts a mip range to the mip levels that are resident. @p numMips of 0 means all the mips starting at
+         * @p mostDetailMip, as for RequestView(). Used by render APIs when binding a texture for sampling.
+         */
+        void ClampToResidentMips(UINT32& mostDetailMip, UINT32& numMips) const;
+
         /** Returns a plain white texture. */
         static SPtr<Texture> WHITE;
 
@@ -326,6 +347,7 @@ namespace te
 
     protected:
         friend class TextureManager;
+        friend class TextureStreaming;
 
         Texture();
         Texture(const TEXTURE_DESC& desc);
@@ -371,5 +393,11 @@ namespace te
         TextureProperties _properties;
         mutable SPtr<PixelData> _initData;
         Vector<SPtr<PixelData>> _CPUSubresourceData;
+
+        bool _isStreamed = false;
+        std::atomic<UINT32> _residentMip { 0 };
+        std::atomic<UINT32> _requestedMip { NO_MIP_REQUESTED };
+
+        static constexpr UINT32 NO_MIP_REQUESTED = static_cast<UINT32>(-1);
     };
 }
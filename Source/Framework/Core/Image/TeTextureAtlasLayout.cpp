@@ -0,0 +1,166 @@
+#include "Image/TeTextureAtlasLayout.h"
+#include "Utility/TeBitwise.h"
+
+namespace te
+{
+    TextureAtlasLayout::TextureAtlasLayout(UINT32 width, UINT32 height, UINT32 padding)
+        : _width(width)
+        , _height(height)
+        , _padding(padding)
+    {
+        Clear();
+    }
+
+    void TextureAtlasLayout::Clear()
+    {
+        _skyline.clear();
+        _skyline.push_back({ 0, 0, _width });
+        _usedHeight = 0;
+    }
+
+    INT32 TextureAtlasLayout::Fit(UINT32 nodeIdx, UINT32 width, UINT32 height) const
+    {
+        const UINT32 x = _skyline[nodeIdx].X;
+        if (x + width > _width)
+            return -1;
+
+        // The rectangle rests on the highest node it spans
+        UINT32 y = 0;
+        UINT32 remaining = width;
+        for (UINT32 i = nodeIdx; remaining > 0; i++)
+        {
+            y = std::max(y, _skyline[i].Y);
+            if (y + height > _height)
+                return -1;
+
+            remaining -= std::min(remaining, _skyline[i].Width);
+        }
+
+        return (INT32)y;
+    }
+
+    bool TextureAtlasLayout::AddElement(UINT32 width, UINT32 height, UINT32& x, UINT32& y)
+    {
+        const UINT32 paddedWidth = std::min(width + _padding, _width);
+        const UINT32 paddedHeight = std::min(height + _padding, _height);
+
+        if (width > _width || height > _height)
+            return false;
+
+        UINT32 bestIdx = (UINT32)-1;
+        UINT32 bestBottom = std::numeric_limits<UINT32>::max();
+        UINT32 bestWidth = std::numeric_limits<UINT32>::max();
+
+        for (UINT32 i = 0; i < (UINT32)_skyline.size(); i++)
+        {
+            const INT32 fitY = Fit(i, paddedWidth, paddedHeight);
+            if (fitY < 0)
+                continue;
+
+            // Lowest top edge first, then the narrowest node to keep wide gaps for wide rectangles
+            const UINT32 bottom = (UINT32)fitY + paddedHeight;
+            if (bottom < bestBottom || (bottom == bestBottom && _skyline[i].Width < bestWidth))
+            {
+                bestIdx = i;
+                bestBottom = bottom;
+                bestWidth = _skyline[i].Width;
+                y = (UINT32)fitY;
+            }
+        }
+
+        if (bestIdx == (UINT32)-1)
+            return false;
+
+        x = _skyline[bestIdx].X;
+
+        SkylineNode node = { x, bestBottom, paddedWidth };
+        _skyline.insert(_skyline.begin() + bestIdx, node);
+
+        // Shrink or remove the nodes now covered by the new one
+        for (UINT32 i = bestIdx + 1; i < (UINT32)_skyline.size();)
+        {
+            SkylineNode& current = _skyline[i];
+            const UINT32 coveredEnd = node.X + node.Width;
+
+            if (current.X >= coveredEnd)
+                break;
+
+            const UINT32 shrink = coveredEnd - current.X;
+            if (shrink < current.Width)
+            {
+                current.X += shrink;
+                current.Width -= shrink;
+                break;
+            }
+
+            _skyline.erase(_skyline.begin() + i);
+        }
+
+        // Merge neighbours at the same height
+        for (UINT32 i = 0; i + 1 < (UINT32)_skyline.size();)
+        {
+            if (_skyline[i].Y == _skyline[i + 1].Y)
+            {
+                _skyline[i].Width += _skyline[i + 1].Width;
+                _skyline.erase(_skyline.begin() + i + 1);
+            }
+            else
+                i++;
+        }
+
+        _usedHeight = std::max(_usedHeight, y + height);
+        return true;
+    }
+
+    Vector<TextureAtlasUtility::Page> TextureAtlasUtility::CreateAtlasLayout(Vector<Element>& elements, UINT32 maxWidth,
+        UINT32 maxHeight, UINT32 padding)
+    {
+        // Tallest first, which keeps the skyline flat
+        Vector<UINT32> order(elements.size());
+        for (UINT32 i = 0; i < (UINT32)order.size(); i++)
+            order[i] = i;
+
+        std::sort(order.begin(), order.end(), [&elements](UINT32 a, UINT32 b)
+        {
+            if (elements[a].Height != elements[b].Height)
+                return elements[a].Height > elements[b].Height;
+
+            return elements[a].Width > elements[b].Width;
+        });
+
+        Vector<TextureAtlasLayout> layouts;
+        for (auto& idx : order)
+        {
+            Element& element = elements[idx];
+            if (element.Width == 0 || element.Height == 0 || element.Width > maxWidth || element.Height > maxHeight)
+            {
+                element.X = element.Y = element.Page = 0;
+                continue;
+            }
+
+            bool placed = false;
+            for (UINT32 page = 0; page < (UINT32)layouts.size() && !placed; page++)
+            {
+                placed = layouts[page].AddElement(element.Width, element.Height, element.X, element.Y);
+                element.Page = page;
+            }
+
+            if (!placed)
+            {
+                layouts.push_back(TextureAtlasLayout(maxWidth, maxHeight, padding));
+                layouts.back().AddElement(element.Width, element.Height, element.X, element.Y);
+                element.Page = (UINT32)layouts.size() - 1;
+            }
+        }
+
+        Vector<Page> pages(std::max((UINT32)layouts.size(), 1U));
+        for (UINT32 i = 0; i < (UINT32)pages.size(); i++)
+        {
+            pages[i].Width = maxWidth;
+            pages[i].Height = i < (UINT32)layouts.size() ?
+                std::min(Bitwise::NextPow2(std::max(layouts[i].GetUsedHeight(), 1U)), maxHeight) : 1;
+        }
+
+        return pages;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+namespace te
+{
+    /**
+     * Packs rectangles into a texture page of a fixed size, using the skyline bottom-left heuristic: each rectangle is
+     * placed where its top edge ends up the lowest, on the outline formed by the rectangles placed so far.
+     */
+    class TE_CORE_EXPORT TextureAtlasLayout
+    {
+    public:
+        /**
+         * @param[in]	width	Width of the page, in pixels.
+         * @param[in]	height	Height of the page, in pixels.
+         * @param[in]	padding	Empty space kept to the right and below each rectangle, in pixels.
+         */
+        TextureAtlasLayout(UINT32 width, UINT32 height, UINT32 padding = 0);
+
+        /**
+         * Attempts to place a rectangle of the provided size in the page.
+         *
+         * @param[in]	width	Width of the rectangle, in pixels.
+         * @param[in]	height	Height of the rectangle, in pixels.
+         * @param[out]	x		Horizontal position of the top left corner of the rectangle, if placed.
+         * @param[out]	y		Vertical position of the top left corner of the rectangle, if placed.
+         * @return				True if the rectangle was placed, false if there is no room left for it.
+         */
+        bool AddElement(UINT32 width, UINT32 height, UINT32& x, UINT32& y);
+
+        /** Removes all the rectangles from the page. */
+        void Clear();
+
+        /** Returns the width of the page, in pixels. */
+        UINT32 GetWidth() const { return _width; }
+
+        /** Returns the height of the page, in pixels. */
+        UINT32 GetHeight() const { return _height; }
+
+        /** Returns the lowest bottom edge of all the rectangles placed so far, in pixels. */
+        UINT32 GetUsedHeight() const { return _usedHeight; }
+
+    private:
+        /** Horizontal segment of the outline of the rectangles placed so far. */
+        struct SkylineNode
+        {
+            UINT32 X;
+            UINT32 Y;
+            UINT32 Width;
+        };
+
+        /**
+         * Checks if a rectangle fits with its left edge on the provided node. Returns the vertical position it would be
+         * placed at, or -1 if it doesn't fit.
+         */
+        INT32 Fit(UINT32 nodeIdx, UINT32 width, UINT32 height) const;
+
+    private:
+        UINT32 _width;
+        UINT32 _height;
+        UINT32 _padding;
+        UINT32 _usedHeight = 0;
+        Vector<SkylineNode> _skyline;
+    };
+
+    /** Helper class for packing a set of rectangles into as few texture pages as possible. */
+    class TE_CORE_EXPORT TextureAtlasUtility
+    {
+    public:
+        /** Rectangle to pack into the atlas. */
+        struct Element
+        {
+            UINT32 Width = 0; /**< Width of the rectangle, set before packing. */
+            UINT32 Height = 0; /**< Height of the rectangle, set before packing. */
+            UINT32 X = 0; /**< Horizontal position of the rectangle in its page, set by packing. */
+            UINT32 Y = 0; /**< Vertical position of the rectangle in its page, set by packing. */
+            UINT32 Page = 0; /**< Index of the page the rectangle is placed in, set by packing. */
+        };
+
+        /** Size of a page of the atlas. */
+        struct Page
+        {
+            UINT32 Width = 0;
+            UINT32 Height = 0;
+        };
+
+        /**
+         * Packs all the provided rectangles into pages of at most @p maxWidth x @p maxHeight pixels. Pages are made as
+         * small as their content allows, keeping power of two heights. Empty rectangles and rectangles larger than a
+         * page are not placed, and are left at position 0 of the first page.
+         *
+         * @param[in, out]	elements	Rectangles to pack. Their position and page are written back.
+         * @param[in]		maxWidth	Maximum width of a page, in pixels.
+         * @param[in]		maxHeight	Maximum height of a page, in pixels.
+         * @param[in]		padding		Empty space to keep between the rectangles, in pixels.
+         * @return						Size of each page of the atlas.
+         */
+        static Vector<Page> CreateAtlasLayout(Vector<Element>& elements, UINT32 maxWidth, UINT32 maxHeight,
+            UINT32 padding = 0);
+    };
+}
@@ -0,0 +1,184 @@
+#include "Image/TeTextureStreaming.h"
+#include "Image/TePixelData.h"
+#include "RenderAPI/TeRenderAPI.h"
+
+namespace te
+{
+    TE_MODULE_STATIC_MEMBER(TextureStreaming)
+
+    void TextureStreaming::OnShutDown()
+    {
+        // Sources may live in plugins that are unloaded after this module, let the workers release them first
+        for (auto& streamed : _textures)
+        {
+            if (streamed.Load != nullptr)
+                streamed.LoadTask->Wait();
+        }
+
+        _textures.clear();
+        _registered.clear();
+    }
+
+    void TextureStreaming::Register(const SPtr<Texture>& texture, const SPtr<TextureStreamingSource>& source,
+        UINT32 residentMip)
+    {
+        residentMip = std::min(residentMip, texture->GetProperties().GetNumMipmaps());
+
+        texture->_residentMip.store(residentMip, std::memory_order_release);
+        texture->_isStreamed = true;
+
+        StreamedTexture streamed;
+        streamed.TextureElem = texture;
+        streamed.Source = source;
+        streamed.MinResidentMip = residentMip;
+        streamed.WantedMip = residentMip;
+
+        Lock lock(_registerMutex);
+        _registered.push_back(std::move(streamed));
+        _numStreamedTextures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TextureStreaming::Update(UINT64 frameIdx)
+    {
+        {
+            Lock lock(_registerMutex);
+            for (auto& streamed : _registered)
+                _textures.push_back(std::move(streamed));
+
+            _registered.clear();
+        }
+
+        UINT32 loadsInFlight = 0;
+        for (UINT32 i = 0; i < (UINT32)_textures.size();)
+        {
+            StreamedTexture& streamed = _textures[i];
+
+            SPtr<Texture> texture = streamed.TextureElem.lock();
+            if (texture == nullptr)
+            {
+                // An in flight load keeps its own references and finishes in the background
+                _textures[i] = std::move(_textures.back());
+                _textures.pop_back();
+                _numStreamedTextures.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            if (streamed.Load != nullptr && streamed.LoadTask->IsComplete())
+                CompleteLoad(streamed);
+
+            const UINT32 requestedMip = texture->_requestedMip.exchange(Texture::NO_MIP_REQUESTED,
+                std::memory_order_relaxed);
+
+            if (requestedMip != Texture::NO_MIP_REQUESTED)
+            {
+                streamed.LastUsedFrame = frameIdx;
+                streamed.WantedMip = std::min(requestedMip, streamed.MinResidentMip);
+            }
+
+            if (streamed.Load != nullptr)
+                loadsInFlight++;
+
+            i++;
+        }
+
+        if (loadsInFlight >= _maxLoadsInFlight)
+            return;
+
+        // Textures used this frame that are missing mips, blurriest first
+        Vector<std::pair<UINT32, UINT32>> candidates;
+        for (UINT32 i = 0; i < (UINT32)_textures.size(); i++)
+        {
+            const StreamedTexture& streamed = _textures[i];
+            if (streamed.Load != nullptr || streamed.LastUsedFrame != frameIdx)
+                continue;
+
+            SPtr<Texture> texture = streamed.TextureElem.lock();
+            const UINT32 residentMip = texture->GetResidentMip();
+
+            if (streamed.WantedMip < residentMip)
+                candidates.push_back(std::make_pair(residentMip - streamed.WantedMip, i));
+        }
+
+        std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        for (auto& candidate : candidates)
+        {
+            if (loadsInFlight >= _maxLoadsInFlight)
+                break;
+
+            StreamedTexture& streamed = _textures[candidate.second];
+            SPtr<Texture> texture = streamed.TextureElem.lock();
+
+            SPtr<LoadRequest> load = te_shared_ptr_new<LoadRequest>();
+            load->FirstMip = streamed.WantedMip;
+            load->LastMip = texture->GetResidentMip() - 1;
+
+            SPtr<TextureStreamingSource> source = streamed.Source;
+            streamed.LoadTask = Task::Create("TextureStreaming", [load, source]()
+            {
+                load->Succeeded = source->LoadMips(load->FirstMip, load->LastMip, load->Data);
+            });
+
+            streamed.Load = load;
+            loadsInFlight++;
+
+            gTaskScheduler().AddTask(streamed.LoadTask);
+        }
+    }
+
+    void TextureStreaming::CompleteLoad(StreamedTexture& streamed)
+    {
+        SPtr<LoadRequest> load = std::move(streamed.Load);
+        streamed.Load = nullptr;
+        streamed.LoadTask = nullptr;
+
+        SPtr<Texture> texture = streamed.TextureElem.lock();
+        const TextureProperties& properties = texture->GetProperties();
+
+        const UINT32 numMips = load->LastMip - load->FirstMip + 1;
+        const UINT32 numFaces = properties.GetNumFaces();
+
+        if (!load->Succeeded || (UINT32)load->Data.size() != numFaces * numMips)
+        {
+            TE_LOG(Warning, "Texture", "Failed to stream mips " << load->FirstMip << " to " << load->LastMip
+                << " of texture " << texture->GetName());
+
+            return;
+        }
+
+        for (UINT32 face = 0; face < numFaces; face++)
+        {
+            for (UINT32 mip = load->FirstMip; mip <= load->LastMip; mip++)
+                texture->WriteData(*load->Data[face * numMips + mip - load->FirstMip], mip, face);
+        }
+
+        texture->_residentMip.store(load->FirstMip, std::memory_order_release);
+    }
+
+    bool TextureStreaming::IsSupported()
+    {
+        return gCaps().HasCapability(RSC_TEXTURE_MIP_CLAMP);
+    }
+
+    UINT32 TextureStreaming::GetMinResidentMip(const TextureProperties& properties)
+    {
+        UINT32 width = properties.GetWidth();
+        UINT32 height = properties.GetHeight();
+
+        UINT32 mip = 0;
+        while (std::max(width, height) > MIN_RESIDENT_SIZE && mip < properties.GetNumMipmaps())
+        {
+            width = std::max(width / 2, 1U);
+            height = std::max(height / 2, 1U);
+            mip++;
+        }
+
+        return mip;
+    }
+
+    TextureStreaming& gTextureStreaming()
+    {
+        return TextureStreaming::Instance();
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TeModule.h"
+#include "Image/TeTexture.h"
+#include "Threading/TeTaskScheduler.h"
+
+namespace te
+{
+    /**
+     * Provides the pixels of the mip levels of a streamed texture. Implemented by importers, which keep the mips they
+     * generated when importing the texture so they can be read back without processing the source asset again.
+     */
+    class TE_CORE_EXPORT TextureStreamingSource
+    {
+    public:
+        virtual ~TextureStreamingSource() = default;
+
+        /**
+         * Loads mip levels [@p firstMip, @p lastMip] of every face of the texture. Called from a worker thread.
+         *
+         * @param[in]	firstMip	Most detailed mip level to load.
+         * @param[in]	lastMip		Least detailed mip level to load.
+         * @param[out]	output		Pixels of each mip level, in the texture format and size. Stored face by face:
+         *							output[face * (lastMip - firstMip + 1) + mip - firstMip].
+         * @return					True if all the mip levels were loaded.
+         */
+        virtual bool LoadMips(UINT32 firstMip, UINT32 lastMip, Vector<SPtr<PixelData>>& output) = 0;
+    };
+
+    /**
+     * Loads the mip levels of streamed textures on demand. Only the small mip levels of a streamed texture are uploaded
+     * when it is imported, the renderer then requests more detailed mips from the screen space size of the objects using
+     * the texture (see Texture::RequestMip()). Requested mips are loaded on worker threads and uploaded during
+     * Update(), so textures can be rendered as soon as they are imported and mips of textures nothing looks at closely
+     * are never uploaded.
+     *
+     * Streamed mips that are not resident are never sampled (see Texture::ClampToResidentMips()). Render APIs allocate
+     * the whole mip chain when a texture is created and releasing mips would mean creating the texture again, so loaded
+     * mips stay resident until the texture is destroyed.
+     */
+    class TE_CORE_EXPORT TextureStreaming : public Module<TextureStreaming>
+    {
+    public:
+        TE_MODULE_STATIC_HEADER_MEMBER(TextureStreaming)
+
+        TextureStreaming() = default;
+        ~TextureStreaming() = default;
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+        /**
+         * Starts streaming the mip levels of the provided texture. Mips less detailed than @p residentMip, and that mip
+         * itself, must have been written already. Thread safe.
+         */
+        void Register(const SPtr<Texture>& texture, const SPtr<TextureStreamingSource>& source, UINT32 residentMip);
+
+        /**
+         * Uploads the mip levels loaded since the last call and queues loads for the mips the renderer requested. Must be
+         * called once per frame from the thread allowed to use the render API, while nothing is being rendered.
+         *
+         * @param[in]	frameIdx	Index of the current frame, used to find the textures requested during it.
+         */
+        void Update(UINT64 frameIdx);
+
+        /** Sets how many textures may be loaded at the same time on worker threads. */
+        void SetMaxLoadsInFlight(UINT32 count) { _maxLoadsInFlight = std::max(count, 1U); }
+
+        /** Returns the number of textures being streamed. */
+        UINT32 GetNumStreamedTextures() const { return _numStreamedTextures.load(std::memory_order_relaxed); }
+
+        /**
+         * Checks if the render API restricts sampling to the resident mips of streamed textures. If not, textures must
+         * be uploaded with all their mips instead of being streamed.
+         */
+        static bool IsSupported();
+
+        /**
+         * Returns the first mip level of a texture small enough to always be resident, and thus the mip a streamed
+         * texture must be initialized with.
+         */
+        static UINT32 GetMinResidentMip(const TextureProperties& properties);
+
+        /** Largest width or height of the mip levels that are always resident. */
+        static constexpr UINT32 MIN_RESIDENT_SIZE = 64;
+
+    private:
+        /** Mip levels of a single texture being loaded by a worker thread. */
+        struct LoadRequest
+        {
+            UINT32 FirstMip = 0;
+            UINT32 LastMip = 0;
+            Vector<SPtr<PixelData>> Data;
+            bool Succeeded = false;
+        };
+
+        /** Streaming state of a single texture. */
+        struct StreamedTexture
+        {
+            WPtr<Texture> TextureElem;
+            SPtr<TextureStreamingSource> Source;
+            UINT32 MinResidentMip = 0; // Mips from this one on are written on import
+            UINT32 WantedMip = 0;
+            UINT64 LastUsedFrame = 0;
+            SPtr<LoadRequest> Load;
+            SPtr<Task> LoadTask;
+        };
+
+        /** Uploads the mips of a completed load request, if it succeeded. */
+        void CompleteLoad(StreamedTexture& streamed);
+
+    private:
+        Vector<StreamedTexture> _textures;
+        Vector<StreamedTexture> _registered; // Waiting to be moved to _textures by Update()
+        Mutex _registerMutex;
+
+        UINT32 _maxLoadsInFlight = 4;
+        std::atomic<UINT32> _numStreamedTextures { 0 };
+    };
+
+    /** Provides easy access to the TextureStreaming. */
+    TE_CORE_EXPORT TextureStreaming& gTextureStreaming();
+}
@@ -31,6 +31,13 @@ namespace te
          */
         bool SRGB = false;
 
+        /**
+         * Determines whether the most detailed mip levels are loaded on demand, from the source file, instead of all being
+         * uploaded on import. Requires GenerateMips. Ignored if the render API doesn't support it, see
+         * TextureStreaming::IsSupported().
+         */
+        bool StreamMips = false;
+
         /** Determines whether the texture data is also stored in main memory, available for fast CPU access. */
         bool CpuCached = false;
 
@@ -42,6 +49,20 @@ namespace te
 
         CubemapSourceType CubemapType = CubemapSourceType::Faces;
 
+        /**
+         * Determines whether the textures used by image based lighting are baked from the cubemap on import: an irradiance
+         * cubemap (see Skybox::SetIrradiance()) and a GGX prefiltered specular cubemap, with roughness increasing along
+         * its mip levels. They are returned as the "irradiance" and "specular" sub-resources of Importer::ImportAll().
+         * Requires IsCubemap. See IBLUtility.
+         */
+        bool GenerateIBL = false;
+
+        /** Width and height of the faces of the baked irradiance cubemap, in pixels. */
+        UINT32 IrradianceSize = 32;
+
+        /** Width and height of the most detailed mip of the baked specular cubemap, in pixels. */
+        UINT32 SpecularSize = 128;
+
         /** Creates a new import options object that allows you to customize how are textures imported. */
         static SPtr<TextureImportOptions> Create();
     };
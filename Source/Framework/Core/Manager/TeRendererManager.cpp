@@ -3,6 +3,7 @@
 #include "Renderer/TeRendererFactory.h"
 #include "Utility/TeDynLib.h"
 #include "Utility/TeDynLibManager.h"
+#include "TeCoreApplication.h"
 
 namespace te
 {
@@ -10,6 +11,8 @@ namespace te
 
     RendererManager::~RendererManager()
     {
+        _notifications.clear();
+
         for (auto& renderer : _renderers)
         {
             renderer.second->Destroy();
@@ -71,4 +74,30 @@ namespace te
 
         return nullptr;
     }
+
+    void RendererManager::QueueNotification(std::function<void()> notification)
+    {
+        _notifications.push_back(std::move(notification));
+    }
+
+    void RendererManager::ApplyNotifications()
+    {
+        // Notifications can queue new ones or destroy objects that sync the queue, the index is shared by nested calls
+        while (_nextNotification < _notifications.size())
+        {
+            std::function<void()> notification = std::move(_notifications[_nextNotification++]);
+            notification();
+        }
+
+        _notifications.clear();
+        _nextNotification = 0;
+    }
+
+    void RendererManager::SyncNotifications()
+    {
+        if (CoreApplication::IsStarted())
+            gCoreApplication().WaitUntilFrameRendered();
+
+        ApplyNotifications();
+    }
 }
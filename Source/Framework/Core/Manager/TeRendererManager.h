@@ -30,9 +30,27 @@ namespace te
         /** Registers a new render API factory responsible for creating a specific render system type. */
         void RegisterFactory(SPtr<RendererFactory> factory);
 
+        /**
+         * Records a renderer notification sent by the main thread. Notifications are applied in order by
+         * ApplyNotifications(), when the render thread doesn't use the renderer scenes.
+         */
+        void QueueNotification(std::function<void()> notification);
+
+        /** Applies the queued notifications. Main thread only, render thread must be idle. */
+        void ApplyNotifications();
+
+        /**
+         * Waits for the frame in flight and applies the queued notifications, so that a notification can be sent to a
+         * renderer right away. Used by objects being destroyed, that can't be referenced by a queued notification.
+         */
+        void SyncNotifications();
+
     private:
         Vector<SPtr<RendererFactory>> _availableFactories;
         Map<String, SPtr<Renderer>> _renderers;
         SPtr<Renderer> _defaultRenderer;
+
+        Vector<std::function<void()>> _notifications;
+        size_t _nextNotification = 0;
     };
 }
@@ -405,6 +405,15 @@ namespace te
         return it->second->TextureElem;
     }
 
+    void Material::GetTextures(Vector<Texture*>& output) const
+    {
+        for (auto& texture : _textures)
+        {
+            if (texture.second->TextureElem != nullptr)
+                output.push_back(texture.second->TextureElem.get());
+        }
+    }
+
     void Material::RemoveTexture(const String& name)
     {
         auto it = _textures.find(name);
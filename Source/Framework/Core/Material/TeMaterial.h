@@ -261,6 +261,9 @@ namespace te
         /** Returns a pointer to the texture associated to "name". Returns nullptr if not exists */
         SPtr<Texture> GetTexture(const String& name);
 
+        /** Appends every texture assigned to a sampled texture parameter to @p output. */
+        void GetTextures(Vector<Texture*>& output) const;
+
         /** We can reset a texture on a material */
         void RemoveTexture(const String& name);
 
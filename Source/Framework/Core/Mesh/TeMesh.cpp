@@ -278,7 +278,7 @@ namespace te
 
     SPtr<Mesh> Mesh::CreatePtr(const MESH_DESC& desc, GpuDeviceFlags deviceMask)
     {
-        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh>()) Mesh(desc, deviceMask));
+        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh, MemoryCategory::Mesh>()) Mesh(desc, deviceMask));
         mesh->SetThisPtr(mesh);
         mesh->Initialize();
 
@@ -287,7 +287,7 @@ namespace te
 
     SPtr<Mesh> Mesh::CreatePtr(const SPtr<MeshData>& initialMeshData, const MESH_DESC& desc, GpuDeviceFlags deviceMask)
     {
-        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh>()) Mesh(initialMeshData, desc, deviceMask));
+        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh, MemoryCategory::Mesh>()) Mesh(initialMeshData, desc, deviceMask));
         mesh->SetThisPtr(mesh);
         mesh->Initialize();
 
@@ -300,7 +300,7 @@ namespace te
         desc.Usage = usage;
         desc.SubMeshes.push_back(SubMesh(0, initialMeshData->GetNumIndices(), drawOp));
 
-        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh>()) Mesh(initialMeshData, desc, deviceMask));
+        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh, MemoryCategory::Mesh>()) Mesh(initialMeshData, desc, deviceMask));
         mesh->SetThisPtr(mesh);
         mesh->Initialize();
 
@@ -309,7 +309,7 @@ namespace te
 
     SPtr<Mesh> Mesh::CreateEmpty()
     {
-        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh>()) Mesh());
+        SPtr<Mesh> mesh = te_core_ptr<Mesh>(new (te_allocate<Mesh, MemoryCategory::Mesh>()) Mesh());
         mesh->SetThisPtr(mesh);
 
         return mesh;
@@ -156,6 +156,9 @@ namespace te
         /**	Returns the size of the internal buffer in bytes. */
         UINT32 GetInternalBufferSize() const override;
 
+        /** @copydoc GpuResourceData::GetMemoryCategory */
+        MemoryCategory GetMemoryCategory() const override { return MemoryCategory::Mesh; }
+
     public:
         /**	Returns an offset in bytes to the start of the index buffer from the start of the internal buffer. */
         UINT32 GetIndexBufferOffset() const;
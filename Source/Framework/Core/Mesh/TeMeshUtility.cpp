@@ -1,4 +1,7 @@
 #include "Mesh/TeMeshUtility.h"
+#include "Mesh/TeMesh.h"
+#include "Mesh/TeMeshData.h"
+#include "RenderAPI/TeVertexDataDesc.h"
 #include "Math/TeVector4.h"
 #include "Math/TeVector3.h"
 #include "Math/TeVector2.h"
@@ -136,4 +139,53 @@ namespace te
         CalculateNormals(vertices, indices, numVertices, numIndices, normals, indexSize);
         CalculateTangents(vertices, normals, uv, indices, numVertices, numIndices, tangents, bitangents, indexSize);
     }
+
+    bool MeshUtility::GetTriangles(const SPtr<Mesh>& mesh, Vector<Vector3>& positions, Vector<UINT32>& indices,
+        Vector<UINT32>* firstTriangles)
+    {
+        SPtr<MeshData> meshData = mesh->GetCachedData();
+        if (meshData == nullptr || !meshData->GetVertexDesc()->HasElement(VES_POSITION))
+            return false;
+
+        const UINT8* vertexPositions = meshData->GetElementData(VES_POSITION);
+        const UINT32 stride = meshData->GetVertexDesc()->GetVertexStride(0);
+        const UINT32 numVertices = meshData->GetNumVertices();
+        const bool indices32 = meshData->GetIndexType() == IT_32BIT;
+        const UINT16* indices16 = indices32 ? nullptr : meshData->GetIndices16();
+        const UINT32* meshIndices = indices32 ? meshData->GetIndices32() : nullptr;
+        const UINT32 numIndices = meshData->GetNumIndices();
+
+        positions.resize(numVertices);
+        for (UINT32 i = 0; i < numVertices; i++)
+            memcpy(&positions[i], vertexPositions + i * stride, sizeof(Vector3));
+
+        MeshProperties& properties = mesh->GetProperties();
+        for (UINT32 i = 0; i < properties.GetNumSubMeshes(); i++)
+        {
+            const SubMesh& subMesh = properties.GetSubMesh(i);
+
+            if (firstTriangles != nullptr)
+                firstTriangles->push_back((UINT32)indices.size() / 3);
+
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST)
+                continue;
+
+            const UINT32 end = std::min(subMesh.IndexOffset + subMesh.IndexCount, numIndices);
+            for (UINT32 j = subMesh.IndexOffset; j + 2 < end; j += 3)
+            {
+                const UINT32 i0 = indices32 ? meshIndices[j] : indices16[j];
+                const UINT32 i1 = indices32 ? meshIndices[j + 1] : indices16[j + 1];
+                const UINT32 i2 = indices32 ? meshIndices[j + 2] : indices16[j + 2];
+
+                if (i0 >= numVertices || i1 >= numVertices || i2 >= numVertices)
+                    continue;
+
+                indices.push_back(i0);
+                indices.push_back(i1);
+                indices.push_back(i2);
+            }
+        }
+
+        return true;
+    }
 }
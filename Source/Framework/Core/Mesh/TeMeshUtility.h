@@ -149,5 +149,19 @@ namespace te
          */
         static void CalculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices,
             UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize = 4);
+
+        /**
+         * Reads the vertex positions and the triangles of a mesh back from the data it keeps on the CPU (see
+         * Mesh::GetCachedData()). Only sub-meshes drawn as triangle lists are read, and triangles referencing vertices
+         * out of range are skipped.
+         *
+         * @param[in]	mesh			Mesh to read.
+         * @param[out]	positions		Position of each vertex of the mesh.
+         * @param[out]	indices			Three indices into @p positions per triangle.
+         * @param[out]	firstTriangles	If not null, receives the index of the first triangle of each sub-mesh.
+         * @return						False if the mesh has no CPU data or no vertex positions.
+         */
+        static bool GetTriangles(const SPtr<Mesh>& mesh, Vector<Vector3>& positions, Vector<UINT32>& indices,
+            Vector<UINT32>* firstTriangles = nullptr);
     };
 }
@@ -0,0 +1,246 @@
+#include "Picking/TeRayPicking.h"
+#include "Mesh/TeMesh.h"
+#include "Mesh/TeMeshUtility.h"
+#include "Scene/TeSceneObject.h"
+#include "Components/TeCCamera.h"
+#include "Components/TeCRenderable.h"
+
+namespace te
+{
+    namespace
+    {
+        /**
+         * Ray/triangle intersection (Moller-Trumbore), both sides of the triangle count. Outputs the distance along the
+         * ray in multiples of the length of @p direction.
+         */
+        bool IntersectsTriangle(const Vector3& origin, const Vector3& direction, const Vector3& a, const Vector3& b,
+            const Vector3& c, float& distance)
+        {
+            const Vector3 edge0 = b - a;
+            const Vector3 edge1 = c - a;
+
+            const Vector3 p = direction.Cross(edge1);
+            const float det = edge0.Dot(p);
+            if (std::abs(det) < 1e-12f)
+                return false;
+
+            const float invDet = 1.0f / det;
+            const Vector3 toOrigin = origin - a;
+
+            const float u = toOrigin.Dot(p) * invDet;
+            if (u < 0.0f || u > 1.0f)
+                return false;
+
+            const Vector3 q = toOrigin.Cross(edge0);
+            const float v = direction.Dot(q) * invDet;
+            if (v < 0.0f || u + v > 1.0f)
+                return false;
+
+            distance = edge1.Dot(q) * invDet;
+            return distance >= 0.0f;
+        }
+    }
+
+    void RayPicking::Build(const HSceneObject& root, bool pickHud)
+    {
+        _entries.clear();
+
+        Vector<AABox> bounds;
+        CollectObjects(root, pickHud, bounds);
+
+        _hierarchy.Build(bounds);
+
+        // Forget the meshes that were destroyed
+        for (auto iter = _meshTriangles.begin(); iter != _meshTriangles.end();)
+        {
+            if (iter->second->MeshElem.expired())
+                iter = _meshTriangles.erase(iter);
+            else
+                ++iter;
+        }
+    }
+
+    void RayPicking::CollectObjects(const HSceneObject& sceneObject, bool pickHud, Vector<AABox>& bounds)
+    {
+        if (!sceneObject->GetActive())
+            return;
+
+        for (const auto& component : sceneObject->GetComponents())
+        {
+            const UINT32 type = component->GetCoreType();
+
+            // Same components as the ones PickingUtils::FillPerInstanceHud() draws icons for
+            if (type == TypeID_Core::TID_CLight || type == TypeID_Core::TID_CCamera ||
+                type == TypeID_Core::TID_CAudioListener || type == TypeID_Core::TID_CAudioSource)
+            {
+                if (!pickHud)
+                    continue;
+
+                const Vector3 position = sceneObject->GetTransform().GetPosition();
+                const Vector3 extents = Vector3::ONE * (HUD_ICON_SIZE * 0.5f);
+
+                Entry entry;
+                entry.Object = component.GetInternalPtr();
+                entry.Bounds = AABox(position - extents, position + extents);
+
+                _entries.push_back(entry);
+                bounds.push_back(entry.Bounds);
+                continue;
+            }
+
+            if (type != TypeID_Core::TID_CRenderable)
+                continue;
+
+            HRenderable renderable = static_object_cast<CRenderable>(component);
+            SPtr<Mesh> mesh = renderable->GetMesh();
+
+            if (!renderable->GetActive() || mesh == nullptr)
+                continue;
+
+            Entry entry;
+            entry.Object = renderable.GetInternalPtr();
+            entry.Triangles = GetTriangles(mesh);
+            entry.WorldToLocal = renderable->GetMatrix().InverseAffine();
+            entry.Bounds = renderable->GetBounds().GetBox();
+
+            _entries.push_back(entry);
+            bounds.push_back(entry.Bounds);
+        }
+
+        for (const auto& childSO : sceneObject->GetChildren())
+            CollectObjects(childSO, pickHud, bounds);
+    }
+
+    SPtr<RayPicking::MeshTriangles> RayPicking::GetTriangles(const SPtr<Mesh>& mesh)
+    {
+        auto iterFind = _meshTriangles.find(mesh.get());
+        if (iterFind != _meshTriangles.end() && !iterFind->second->MeshElem.expired())
+            return iterFind->second;
+
+        Vector<Vector3> positions;
+        Vector<UINT32> indices;
+        Vector<UINT32> firstTriangles;
+
+        if (!MeshUtility::GetTriangles(mesh, positions, indices, &firstTriangles))
+            return nullptr;
+
+        SPtr<MeshTriangles> triangles = te_shared_ptr_new<MeshTriangles>();
+        triangles->MeshElem = mesh;
+        triangles->FirstTriangles = firstTriangles;
+
+        const UINT32 numTriangles = (UINT32)indices.size() / 3;
+        triangles->Positions.reserve(indices.size());
+        triangles->SubMeshes.reserve(numTriangles);
+
+        Vector<AABox> bounds;
+        bounds.reserve(numTriangles);
+
+        UINT32 subMesh = 0;
+        for (UINT32 i = 0; i < numTriangles; i++)
+        {
+            while (subMesh + 1 < (UINT32)firstTriangles.size() && firstTriangles[subMesh + 1] <= i)
+                subMesh++;
+
+            const Vector3& a = positions[indices[i * 3]];
+            const Vector3& b = positions[indices[i * 3 + 1]];
+            const Vector3& c = positions[indices[i * 3 + 2]];
+
+            AABox box(a, a);
+            box.Merge(b);
+            box.Merge(c);
+
+            triangles->Positions.push_back(a);
+            triangles->Positions.push_back(b);
+            triangles->Positions.push_back(c);
+            triangles->SubMeshes.push_back(subMesh);
+            bounds.push_back(box);
+        }
+
+        triangles->Hierarchy.Build(bounds);
+        _meshTriangles[mesh.get()] = triangles;
+
+        return triangles;
+    }
+
+    bool RayPicking::Pick(const HCamera& camera, const Vector2I& pixel, Hit& hit)
+    {
+        return RayCast(camera->ScreenPointToRay(pixel), hit);
+    }
+
+    bool RayPicking::RayCast(const Ray& ray, Hit& hit)
+    {
+        const Vector3 origin = ray.GetOrigin();
+        const Vector3 direction = Vector3::Normalize(ray.GetDirection());
+
+        INT32 hitSubMesh = -1;
+        INT32 hitTriangle = -1;
+        float distance = std::numeric_limits<float>::max();
+
+        const INT32 hitEntry = _hierarchy.RayCast(origin, direction, distance, [&](UINT32 entryIdx, float& closest)
+        {
+            const Entry& entry = _entries[entryIdx];
+            if (entry.Object.expired())
+                return false;
+
+            // No triangles to refine the hit with, settle for the bounds
+            if (entry.Triangles == nullptr)
+            {
+                std::pair<bool, float> boxHit = Ray(origin, direction).Intersects(entry.Bounds);
+                if (!boxHit.first || boxHit.second >= closest)
+                    return false;
+
+                closest = boxHit.second;
+                hitSubMesh = -1;
+                hitTriangle = -1;
+                return true;
+            }
+
+            // Distances are the same in local space as long as the direction isn't normalized again
+            const Vector3 localOrigin = entry.WorldToLocal.MultiplyAffine(origin);
+            const Vector3 localDirection = entry.WorldToLocal.MultiplyDirection(direction);
+            const MeshTriangles& triangles = *entry.Triangles;
+
+            const INT32 triangle = triangles.Hierarchy.RayCast(localOrigin, localDirection, closest,
+                [&](UINT32 triangleIdx, float& closestTriangle)
+                {
+                    float triangleDistance;
+                    if (!IntersectsTriangle(localOrigin, localDirection, triangles.Positions[triangleIdx * 3],
+                        triangles.Positions[triangleIdx * 3 + 1], triangles.Positions[triangleIdx * 3 + 2],
+                        triangleDistance) || triangleDistance >= closestTriangle)
+                    {
+                        return false;
+                    }
+
+                    closestTriangle = triangleDistance;
+                    return true;
+                });
+
+            if (triangle < 0)
+                return false;
+
+            hitSubMesh = (INT32)triangles.SubMeshes[triangle];
+            hitTriangle = triangle - (INT32)triangles.FirstTriangles[hitSubMesh];
+            return true;
+        });
+
+        if (hitEntry < 0)
+            return false;
+
+        hit.Object = _entries[hitEntry].Object.lock();
+        hit.Distance = distance;
+        hit.Position = origin + direction * distance;
+        hit.SubMesh = hitSubMesh;
+        hit.Triangle = hitTriangle;
+
+        return true;
+    }
+
+    SPtr<GameObject> RayPicking::GetGameObjectAt(const HCamera& camera, const Vector2I& pixel)
+    {
+        Hit hit;
+        if (!Pick(camera, pixel, hit))
+            return nullptr;
+
+        return hit.Object;
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeBVH.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeRay.h"
+
+namespace te
+{
+    /**
+     * Picks renderables on the CPU, by casting a ray against a bounding volume hierarchy of their world bounds and then
+     * against the triangles of the meshes whose bounds are hit. Unlike Picking it never reads back from the GPU, so it
+     * doesn't stall the pipeline.
+     *
+     * Triangles can only be tested for meshes created with MU_CPUCACHED (see MeshImportOptions::CpuCached). Other meshes
+     * are picked from their bounds. Animated meshes are tested in their bind pose. Lights, cameras and audio components
+     * can also be picked, from a box matching the size of their HUD icon.
+     */
+    class TE_CORE_EXPORT RayPicking
+    {
+    public:
+        /** Closest object hit by a ray. */
+        struct Hit
+        {
+            SPtr<GameObject> Object; /**< Renderable or HUD component hit. */
+            float Distance = 0.0f; /**< Distance from the origin of the ray, in world units. */
+            Vector3 Position; /**< Position of the hit, in world space. */
+            INT32 SubMesh = -1; /**< Index of the sub-mesh hit, or -1 if only the bounds were tested. */
+            INT32 Triangle = -1; /**< Index of the triangle hit in its sub-mesh, or -1 if only the bounds were tested. */
+        };
+
+    public:
+        RayPicking() = default;
+        ~RayPicking() = default;
+
+        /** Size of the HUD icons drawn for lights, cameras and audio components, in world units. */
+        static constexpr float HUD_ICON_SIZE = 1.0f;
+
+        /**
+         * Builds the hierarchy from the active renderables under @p root, with their current transform. Must be called
+         * again once objects moved. Triangle hierarchies of the meshes are kept between builds.
+         *
+         * @param[in]	root		Root of the objects that can be picked.
+         * @param[in]	pickHud		If true, components drawn as HUD icons (lights, cameras, audio) can be picked too.
+         */
+        void Build(const HSceneObject& root, bool pickHud = false);
+
+        /**
+         * Finds the closest object hit by a ray going through a pixel of a camera.
+         *
+         * @param[in]	camera	Camera the pixel is relative to.
+         * @param[in]	pixel	Position in the viewport of the camera, in pixels.
+         * @param[out]	hit		Closest hit, if any.
+         * @return				True if an object was hit.
+         */
+        bool Pick(const HCamera& camera, const Vector2I& pixel, Hit& hit);
+
+        /** Finds the closest object hit by a ray, in world space. */
+        bool RayCast(const Ray& ray, Hit& hit);
+
+        /** @copydoc Picking::GetGameObjectAt */
+        SPtr<GameObject> GetGameObjectAt(const HCamera& camera, const Vector2I& pixel);
+
+    private:
+        /** Triangles of a mesh in its local space, and their hierarchy. */
+        struct MeshTriangles
+        {
+            WPtr<Mesh> MeshElem;
+            Vector<Vector3> Positions; // 3 per triangle
+            Vector<UINT32> SubMeshes; // Sub-mesh of each triangle
+            Vector<UINT32> FirstTriangles; // Index of the first triangle of each sub-mesh
+            BVH Hierarchy;
+        };
+
+        /** Renderable or HUD component the hierarchy was built with. */
+        struct Entry
+        {
+            WPtr<GameObject> Object;
+            SPtr<MeshTriangles> Triangles; // Null for HUD components, and if the mesh isn't CPU cached
+            Matrix4 WorldToLocal;
+            AABox Bounds; // In world space
+        };
+
+        /** Collects the renderables, and HUD components if @p pickHud is true, under a scene object. */
+        void CollectObjects(const HSceneObject& sceneObject, bool pickHud, Vector<AABox>& bounds);
+
+        /** Returns the triangles of a mesh, building them on first use. Returns null if the mesh isn't CPU cached. */
+        SPtr<MeshTriangles> GetTriangles(const SPtr<Mesh>& mesh);
+
+    private:
+        Vector<Entry> _entries;
+        BVH _hierarchy;
+        UnorderedMap<const Mesh*, SPtr<MeshTriangles>> _meshTriangles;
+    };
+}
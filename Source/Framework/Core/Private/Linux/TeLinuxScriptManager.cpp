@@ -1,10 +1,104 @@
 #include "Scripting/TeScriptManager.h"
 #include "Utility/TeFileSystem.h"
+#include "Utility/TeDynLib.h"
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <cerrno>
+#include <cstdio>
+
+extern char** environ;
 
 namespace te
 {
+    /** Returns the command line building a script library, with the same flags as the engine */
+    static Vector<String> GetCompileArguments(const ScriptIdentifier& identifier, const String& output, const String& libraryPath)
+    {
+#ifdef TE_ENGINE_BUILD
+        static String appRoot = RAW_APP_ROOT;
+        static String includePath = appRoot + "Source/Framework/";
+#else
+        static String appRoot = "";
+        static String includePath = appRoot + "Include/";
+#endif
+
+        Vector<String> arguments = {
+            CXX_COMPILER_PATH,
+            "-shared", "-fPIC", "-std=c++17",
+            "-Wall", "-Wextra", "-Wno-unused-parameter",
+            "-fno-exceptions", "-fno-strict-aliasing", "-msse4.1"
+        };
+
+#if TE_COMPILER == TE_COMPILER_GNUC
+        // Unique symbols (static members of templates and inline functions) would prevent dlclose() from unloading the
+        // library, and the new version would never be loaded
+        arguments.push_back("-fno-gnu-unique");
+#endif
+
+#if TE_DEBUG_MODE
+        arguments.insert(arguments.end(), { "-ggdb", "-O0", "-DDEBUG" });
+#else
+        arguments.insert(arguments.end(), { "-O2", "-DNDEBUG" });
+#endif
+
+        arguments.push_back("-I" + includePath + "Core");
+        arguments.push_back("-I" + includePath + "Utility");
+        arguments.push_back(identifier.AbsolutePath + identifier.Name + ".cpp");
+        arguments.push_back("-o");
+        arguments.push_back(output);
+        arguments.push_back("-L" + libraryPath);
+        arguments.push_back("-ltef");
+
+        return arguments;
+    }
+
     bool ScriptManager::CompileLibrary(const ScriptIdentifier& identifier)
     {
-        return false;
+        String directory = FileSystem::GetWorkingDirectoryPath();
+        String library = String(DynLib::PREFIX) + identifier.Name + "." + DynLib::EXTENSION;
+
+        // The compiler writes to a temporary file which then replaces the library: the previous version can stay loaded
+        // while compiling, and dlopen() sees a new file once it is unloaded
+        String output = library + ".tmp";
+
+        Vector<String> arguments = GetCompileArguments(identifier, output, directory);
+        Vector<char*> argv;
+        for (auto& argument : arguments)
+            argv.push_back(const_cast<char*>(argument.c_str()));
+        argv.push_back(nullptr);
+
+        pid_t pid;
+        int error = posix_spawn(&pid, argv[0], nullptr, nullptr, argv.data(), environ);
+        if (error != 0)
+        {
+            TE_DEBUG("Failed to compile library \"" + identifier.Name + "\", error : " + ToString((INT32)error));
+            return false;
+        }
+
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0)
+        {
+            if (errno != EINTR)
+            {
+                TE_DEBUG("Failed to wait for the compilation of library \"" + identifier.Name + "\", error : " + ToString((INT32)errno));
+                return false;
+            }
+        }
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            TE_DEBUG("Failed to compile library \"" + identifier.Name + "\"");
+            std::remove(output.c_str());
+            return false;
+        }
+
+        if (std::rename(output.c_str(), library.c_str()) != 0)
+        {
+            TE_DEBUG("Failed to replace library \"" + library + "\", error : " + ToString((INT32)errno));
+            std::remove(output.c_str());
+            return false;
+        }
+
+        return true;
     }
 }
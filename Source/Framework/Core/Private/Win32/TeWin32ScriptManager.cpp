@@ -124,6 +124,7 @@ namespace te
             CloseHandle(pi.hProcess);
             CloseHandle(pi.hThread);
 
+            RecursiveLock lock(_mutex);
             _lastBuildTimes[identifier] = gTime().GetTimeMs();
         }
         else
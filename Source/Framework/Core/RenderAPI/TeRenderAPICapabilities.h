@@ -53,6 +53,16 @@ namespace te
         RSC_RENDER_TARGET_LAYERS		= TE_CAPS_VALUE(CAPS_CATEGORY_COMMON, 10),
         /** Has native support for command buffers that can be populated from secondary threads. */
         RSC_MULTI_THREADED_CB			= TE_CAPS_VALUE(CAPS_CATEGORY_COMMON, 11),
+        /**
+         * Restricts the mip levels sampled from streamed textures to their resident ones when binding them (see
+         * Texture::ClampToResidentMips()).
+         */
+        RSC_TEXTURE_MIP_CLAMP			= TE_CAPS_VALUE(CAPS_CATEGORY_COMMON, 12),
+        /**
+         * The render API can be used from a thread other than the one that created it, one thread at a time. Required by
+         * START_UP_DESC::RenderThread.
+         */
+        RSC_RENDER_THREAD				= TE_CAPS_VALUE(CAPS_CATEGORY_COMMON, 13),
     };
 
     /** Conventions used for a specific render backend. */
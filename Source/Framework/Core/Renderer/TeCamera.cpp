@@ -29,6 +29,9 @@ namespace te
 
     Camera::~Camera()
     {
+        // Render thread must be done with the object, and notifications still referencing it applied
+        Renderer::SyncNotifications();
+
         if (_renderer) _renderer->NotifyCameraRemoved(this);
     }
 
@@ -36,7 +39,7 @@ namespace te
     {
         CoreObject::Initialize();
         gSceneManager()._registerCamera(std::static_pointer_cast<Camera>(GetThisPtr()));
-        if (_renderer) _renderer->NotifyCameraAdded(this);
+        if (_renderer) _renderer->QueueNotification(&Renderer::NotifyCameraAdded, this);
     }
 
     void Camera::Destroy()
@@ -446,12 +449,12 @@ namespace te
     void Camera::AttachTo(SPtr<Renderer> renderer)
     {
         if (_renderer)
-            _renderer->NotifyCameraRemoved(this);
+            _renderer->QueueNotification(&Renderer::NotifyCameraRemoved, this);
 
         _renderer = renderer;
 
         if (_renderer)
-            _renderer->NotifyCameraAdded(this);
+            _renderer->QueueNotification(&Renderer::NotifyCameraAdded, this);
 
         _markCoreDirty();
     }
@@ -683,6 +686,6 @@ namespace te
             _needComputeView = true;
         }
 
-        if (_renderer) _renderer->NotifyCameraUpdated(this, (UINT32)dirtyFlag);
+        if (_renderer) _renderer->QueueNotification(&Renderer::NotifyCameraUpdated, this, (UINT32)dirtyFlag);
     }
 }
@@ -30,13 +30,16 @@ namespace te
 
     Decal::~Decal()
     { 
+        // Render thread must be done with the object, and notifications still referencing it applied
+        Renderer::SyncNotifications();
+
         if (_renderer) _renderer->NotifyDecalRemoved(this);
     }
 
     void Decal::Initialize()
     { 
         UpdateBounds();
-        if (_renderer) _renderer->NotifyDecalAdded(this);
+        if (_renderer) _renderer->QueueNotification(&Renderer::NotifyDecalAdded, this);
 
         CoreObject::Initialize();
     }
@@ -70,12 +73,12 @@ namespace te
     void Decal::AttachTo(SPtr<Renderer> renderer)
     {
         if (_renderer)
-            _renderer->NotifyDecalRemoved(this);
+            _renderer->QueueNotification(&Renderer::NotifyDecalRemoved, this);
 
         _renderer = renderer;
 
         if (_renderer)
-            _renderer->NotifyDecalAdded(this);
+            _renderer->QueueNotification(&Renderer::NotifyDecalAdded, this);
 
         _markCoreDirty();
     }
@@ -131,7 +134,7 @@ namespace te
         {
             if (_active)
             {
-                if (_renderer) _renderer->NotifyDecalUpdated(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyDecalUpdated, this);
             }
         }
         else
@@ -140,17 +143,17 @@ namespace te
             {
                 if (_active)
                 {
-                    if (_renderer) _renderer->NotifyDecalAdded(this);
+                    if (_renderer) _renderer->QueueNotification(&Renderer::NotifyDecalAdded, this);
                 }
                 else
                 {
-                    if (_renderer) _renderer->NotifyDecalRemoved(this);
+                    if (_renderer) _renderer->QueueNotification(&Renderer::NotifyDecalRemoved, this);
                 }
             }
             else
             {
-                if (_renderer) _renderer->NotifyDecalRemoved(this);
-                if (_renderer) _renderer->NotifyDecalAdded(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyDecalRemoved, this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyDecalAdded, this);
             }
         }
 
@@ -271,6 +271,13 @@ namespace te
         return desc;
     }
 
+    bool POOLED_RENDER_TEXTURE_DESC::operator==(const POOLED_RENDER_TEXTURE_DESC& other) const
+    {
+        return Width == other.Width && Height == other.Height && Depth == other.Depth &&
+            NumSamples == other.NumSamples && Format == other.Format && Flag == other.Flag && Type == other.Type &&
+            HwGamma == other.HwGamma && ArraySize == other.ArraySize && NumMipLevels == other.NumMipLevels;
+    }
+
     POOLED_STORAGE_BUFFER_DESC POOLED_STORAGE_BUFFER_DESC::CreateStandard(GpuBufferFormat format, UINT32 numElements,
         GpuBufferUsage usage)
     {
@@ -176,6 +176,9 @@ namespace te
         static POOLED_RENDER_TEXTURE_DESC CreateCube(PixelFormat format, UINT32 width, UINT32 height,
             INT32 usage = TU_STATIC, UINT32 arraySize = 1);
 
+        /** Checks if both descriptors describe the same kind of texture, so the textures can be swapped for another. */
+        bool operator==(const POOLED_RENDER_TEXTURE_DESC& other) const;
+
     private:
         friend class GpuResourcePool;
 
@@ -0,0 +1,491 @@
+#include "Renderer/TeIBLUtility.h"
+#include "Image/TeColor.h"
+#include "Image/TePixelUtil.h"
+#include "Math/TeMath.h"
+#include "Math/TeSIMD.h"
+#include "Threading/TeTaskScheduler.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Cubemap face of linear RGBA floats, 4 per texel, rows packed. */
+        struct FloatFace
+        {
+            UINT32 Size = 0;
+            Vector<float> Texels;
+
+            const float* GetTexel(UINT32 x, UINT32 y) const { return &Texels[(y * Size + x) * 4]; }
+            float* GetTexel(UINT32 x, UINT32 y) { return &Texels[(y * Size + x) * 4]; }
+        };
+
+        /** Six faces of a single mip level of a cubemap. */
+        typedef std::array<FloatFace, 6> FloatCubemap;
+
+        /**
+         * Returns the direction pointing to the position (s, t) of a face, both in [-1, 1] range from the top left of the
+         * face. Matches the face orientations generated by the importers.
+         */
+        Vector3 GetDirection(UINT32 face, float s, float t)
+        {
+            switch (face)
+            {
+            case 0: return Vector3(1.0f, -t, -s); // X+
+            case 1: return Vector3(-1.0f, -t, s); // X-
+            case 2: return Vector3(s, 1.0f, t); // Y+
+            case 3: return Vector3(s, -1.0f, -t); // Y-
+            case 4: return Vector3(s, -t, 1.0f); // Z+
+            default: return Vector3(-s, -t, -1.0f); // Z-
+            }
+        }
+
+        /** Inverse of GetDirection(), @p direction doesn't need to be normalized. */
+        void GetFaceCoords(const Vector3& direction, UINT32& face, float& s, float& t)
+        {
+            const float absX = std::abs(direction.x);
+            const float absY = std::abs(direction.y);
+            const float absZ = std::abs(direction.z);
+
+            if (absX >= absY && absX >= absZ)
+            {
+                face = direction.x > 0.0f ? 0 : 1;
+                s = (direction.x > 0.0f ? -direction.z : direction.z) / absX;
+                t = -direction.y / absX;
+            }
+            else if (absY >= absZ)
+            {
+                face = direction.y > 0.0f ? 2 : 3;
+                s = direction.x / absY;
+                t = (direction.y > 0.0f ? direction.z : -direction.z) / absY;
+            }
+            else
+            {
+                face = direction.z > 0.0f ? 4 : 5;
+                s = (direction.z > 0.0f ? direction.x : -direction.x) / absZ;
+                t = -direction.y / absZ;
+            }
+        }
+
+        /** Returns the texel of a cubemap mip level in the provided direction, without filtering. */
+        const float* GetTexel(const FloatCubemap& cubemap, const Vector3& direction)
+        {
+            UINT32 face;
+            float s, t;
+            GetFaceCoords(direction, face, s, t);
+
+            const FloatFace& faceData = cubemap[face];
+            const INT32 maxCoord = (INT32)faceData.Size - 1;
+            const INT32 x = Math::Clamp(Math::FloorToInt((s * 0.5f + 0.5f) * faceData.Size), 0, maxCoord);
+            const INT32 y = Math::Clamp(Math::FloorToInt((t * 0.5f + 0.5f) * faceData.Size), 0, maxCoord);
+
+            return faceData.GetTexel((UINT32)x, (UINT32)y);
+        }
+
+        /** Returns the position, in [-1, 1] range, of the center of a texel of a face of the provided size. */
+        float GetTexelCenter(UINT32 coord, UINT32 size)
+        {
+            return ((coord + 0.5f) / size) * 2.0f - 1.0f;
+        }
+
+        /** Solid angle covered by the texel at (x, y) of a face of the provided size. */
+        float GetTexelSolidAngle(UINT32 x, UINT32 y, UINT32 size)
+        {
+            auto areaElement = [](float s, float t) { return std::atan2(s * t, std::sqrt(s * s + t * t + 1.0f)); };
+
+            const float invSize = 1.0f / size;
+            const float s = GetTexelCenter(x, size);
+            const float t = GetTexelCenter(y, size);
+
+            const float s0 = s - invSize;
+            const float s1 = s + invSize;
+            const float t0 = t - invSize;
+            const float t1 = t + invSize;
+
+            return areaElement(s0, t0) - areaElement(s0, t1) - areaElement(s1, t0) + areaElement(s1, t1);
+        }
+
+        /** Converts the faces of a cubemap into linear floats. */
+        void ReadFaces(const std::array<SPtr<PixelData>, 6>& faces, bool isSRGB, FloatCubemap& output)
+        {
+            for (UINT32 face = 0; face < 6; face++)
+            {
+                const PixelData& source = *faces[face];
+
+                FloatFace& faceData = output[face];
+                faceData.Size = source.GetWidth();
+                faceData.Texels.resize(faceData.Size * faceData.Size * 4);
+
+                for (UINT32 y = 0; y < faceData.Size; y++)
+                {
+                    for (UINT32 x = 0; x < faceData.Size; x++)
+                    {
+                        Color color = source.GetColorAt(x, y);
+                        if (isSRGB)
+                            color = color.GetLinear();
+
+                        float* texel = faceData.GetTexel(x, y);
+                        texel[0] = color.r;
+                        texel[1] = color.g;
+                        texel[2] = color.b;
+                        texel[3] = color.a;
+                    }
+                }
+            }
+        }
+
+        /** Creates a face of the provided format from linear floats. */
+        SPtr<PixelData> WriteFace(const FloatFace& faceData, PixelFormat format, bool isSRGB)
+        {
+            SPtr<PixelData> output = PixelData::Create(faceData.Size, faceData.Size, 1, format);
+
+            for (UINT32 y = 0; y < faceData.Size; y++)
+            {
+                for (UINT32 x = 0; x < faceData.Size; x++)
+                {
+                    const float* texel = faceData.GetTexel(x, y);
+
+                    Color color(texel[0], texel[1], texel[2], texel[3]);
+                    if (isSRGB)
+                        color = color.GetGamma();
+
+                    output->SetColorAt(color, x, y);
+                }
+            }
+
+            return output;
+        }
+
+        /** Halves the size of each face of a cubemap by averaging 2x2 blocks of texels. */
+        void Downsample(const FloatCubemap& source, FloatCubemap& output)
+        {
+            for (UINT32 face = 0; face < 6; face++)
+            {
+                const FloatFace& sourceFace = source[face];
+
+                FloatFace& faceData = output[face];
+                faceData.Size = std::max(sourceFace.Size / 2, 1U);
+                faceData.Texels.resize(faceData.Size * faceData.Size * 4);
+
+                const UINT32 maxCoord = sourceFace.Size - 1;
+                const SIMD::Float4 quarter = SIMD::Splat(0.25f);
+
+                for (UINT32 y = 0; y < faceData.Size; y++)
+                {
+                    for (UINT32 x = 0; x < faceData.Size; x++)
+                    {
+                        const UINT32 x0 = std::min(x * 2, maxCoord);
+                        const UINT32 x1 = std::min(x * 2 + 1, maxCoord);
+                        const UINT32 y0 = std::min(y * 2, maxCoord);
+                        const UINT32 y1 = std::min(y * 2 + 1, maxCoord);
+
+                        SIMD::Float4 sum = SIMD::Add(SIMD::Load(sourceFace.GetTexel(x0, y0)),
+                            SIMD::Load(sourceFace.GetTexel(x1, y0)));
+                        sum = SIMD::Add(sum, SIMD::Load(sourceFace.GetTexel(x0, y1)));
+                        sum = SIMD::Add(sum, SIMD::Load(sourceFace.GetTexel(x1, y1)));
+
+                        SIMD::Store(faceData.GetTexel(x, y), SIMD::Mul(sum, quarter));
+                    }
+                }
+            }
+        }
+
+        /** Value of the first, constant, spherical harmonics basis function. */
+        const float SH_BASIS_0 = 0.282095f;
+
+        /** Values of the 9 first real spherical harmonics basis functions in a normalized direction. */
+        void EvaluateSHBasis(const Vector3& dir, float (&basis)[9])
+        {
+            basis[0] = SH_BASIS_0;
+            basis[1] = 0.488603f * dir.y;
+            basis[2] = 0.488603f * dir.z;
+            basis[3] = 0.488603f * dir.x;
+            basis[4] = 1.092548f * dir.x * dir.y;
+            basis[5] = 1.092548f * dir.y * dir.z;
+            basis[6] = 0.315392f * (3.0f * dir.z * dir.z - 1.0f);
+            basis[7] = 1.092548f * dir.x * dir.z;
+            basis[8] = 0.546274f * (dir.x * dir.x - dir.y * dir.y);
+        }
+
+        /** Number of texel rows processed by each task. */
+        const UINT32 ROWS_PER_TASK = 8;
+    }
+
+    Vector3 SHCoefficientsRGB::Evaluate(const Vector3& direction) const
+    {
+        float basis[9];
+        EvaluateSHBasis(direction, basis);
+
+        Vector3 output(TeZero);
+        for (UINT32 i = 0; i < 9; i++)
+            output += Coeffs[i] * basis[i];
+
+        return output;
+    }
+
+    Vector3 SHCoefficientsRGB::EvaluateIrradiance(const Vector3& normal) const
+    {
+        // Convolution with the clamped cosine lobe scales each band (PI, 2PI/3, PI/4), then divided by PI
+        static const float BAND_SCALE[9] =
+        {
+            1.0f,
+            2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+            0.25f, 0.25f, 0.25f, 0.25f, 0.25f
+        };
+
+        float basis[9];
+        EvaluateSHBasis(normal, basis);
+
+        Vector3 output(TeZero);
+        for (UINT32 i = 0; i < 9; i++)
+            output += Coeffs[i] * (basis[i] * BAND_SCALE[i]);
+
+        return Vector3::Max(output, Vector3::ZERO);
+    }
+
+    SHCoefficientsRGB IBLUtility::ProjectToSH(const std::array<SPtr<PixelData>, 6>& faces, bool isSRGB)
+    {
+        FloatCubemap cubemap;
+        ReadFaces(faces, isSRGB, cubemap);
+
+        const UINT32 size = cubemap[0].Size;
+        const UINT32 numRows = size * 6;
+        const UINT32 numRanges = Math::DivideAndRoundUp(numRows, ROWS_PER_TASK);
+
+        // Each range sums into its own coefficients (RGB and weight in the last lane), summed together afterwards
+        Vector<std::array<float, 9 * 4>> partialSums(numRanges);
+        ParallelFor("IBLUtility", numRows, ROWS_PER_TASK, [&](UINT32 begin, UINT32 end)
+        {
+            SIMD::Float4 sums[9];
+            for (UINT32 i = 0; i < 9; i++)
+                sums[i] = SIMD::Zero();
+
+            for (UINT32 row = begin; row < end; row++)
+            {
+                const UINT32 face = row / size;
+                const UINT32 y = row % size;
+
+                for (UINT32 x = 0; x < size; x++)
+                {
+                    const Vector3 dir = Vector3::Normalize(GetDirection(face, GetTexelCenter(x, size),
+                        GetTexelCenter(y, size)));
+                    const float solidAngle = GetTexelSolidAngle(x, y, size);
+
+                    const float* texel = cubemap[face].GetTexel(x, y);
+                    const SIMD::Float4 radiance = SIMD::Set(texel[0], texel[1], texel[2], 1.0f);
+                    const SIMD::Float4 weighted = SIMD::Mul(radiance, SIMD::Splat(solidAngle));
+
+                    float basis[9];
+                    EvaluateSHBasis(dir, basis);
+
+                    for (UINT32 i = 0; i < 9; i++)
+                        sums[i] = SIMD::MulAdd(weighted, SIMD::Splat(basis[i]), sums[i]);
+                }
+            }
+
+            for (UINT32 i = 0; i < 9; i++)
+                SIMD::Store(&partialSums[begin / ROWS_PER_TASK][i * 4], sums[i]);
+        });
+
+        float sums[9 * 4] = {};
+        for (auto& partialSum : partialSums)
+        {
+            for (UINT32 i = 0; i < 9 * 4; i++)
+                sums[i] += partialSum[i];
+        }
+
+        // Texel solid angles sum to 4PI in theory, normalize by the actual sum to remove the discretization error. The
+        // weight lane of the first coefficient holds that sum times the constant first basis function.
+        const float totalSolidAngle = sums[3] / SH_BASIS_0;
+        const float normalization = totalSolidAngle > 0.0f ? 4.0f * Math::PI / totalSolidAngle : 0.0f;
+
+        SHCoefficientsRGB output;
+        for (UINT32 i = 0; i < 9; i++)
+            output.Coeffs[i] = Vector3(sums[i * 4 + 0], sums[i * 4 + 1], sums[i * 4 + 2]) * normalization;
+
+        return output;
+    }
+
+    void IBLUtility::GenerateIrradiance(const SHCoefficientsRGB& sh, UINT32 size, PixelFormat format, bool isSRGB,
+        std::array<SPtr<PixelData>, 6>& output)
+    {
+        size = std::max(size, 1U);
+
+        FloatCubemap cubemap;
+        for (auto& faceData : cubemap)
+        {
+            faceData.Size = size;
+            faceData.Texels.resize(size * size * 4);
+        }
+
+        ParallelFor("IBLUtility", size * 6, ROWS_PER_TASK, [&](UINT32 begin, UINT32 end)
+        {
+            for (UINT32 row = begin; row < end; row++)
+            {
+                const UINT32 face = row / size;
+                const UINT32 y = row % size;
+
+                for (UINT32 x = 0; x < size; x++)
+                {
+                    const Vector3 dir = Vector3::Normalize(GetDirection(face, GetTexelCenter(x, size),
+                        GetTexelCenter(y, size)));
+                    const Vector3 irradiance = sh.EvaluateIrradiance(dir);
+
+                    SIMD::Store(cubemap[face].GetTexel(x, y), SIMD::Set(irradiance.x, irradiance.y, irradiance.z, 1.0f));
+                }
+            }
+        });
+
+        for (UINT32 face = 0; face < 6; face++)
+            output[face] = WriteFace(cubemap[face], format, isSRGB);
+    }
+
+    void IBLUtility::FilterSpecular(const std::array<SPtr<PixelData>, 6>& faces, bool isSRGB, UINT32 size,
+        UINT32 numMips, PixelFormat format, UINT32 numSamples, Vector<SPtr<PixelData>>& output)
+    {
+        // Mip chain of the source, samples with a low probability read from the blurrier levels
+        Vector<FloatCubemap> sourceMips(1);
+        ReadFaces(faces, isSRGB, sourceMips[0]);
+
+        while (sourceMips.back()[0].Size > 1)
+        {
+            FloatCubemap mip;
+            Downsample(sourceMips.back(), mip);
+            sourceMips.push_back(std::move(mip));
+        }
+
+        const UINT32 sourceSize = sourceMips[0][0].Size;
+        const float texelSolidAngle = 4.0f * Math::PI / (6.0f * sourceSize * sourceSize);
+        const float maxSourceMip = (float)(sourceMips.size() - 1);
+
+        size = std::max(size, 1U);
+        numMips = Math::Clamp(numMips, 1U, PixelUtil::GetMaxMipmaps(size, size, 1) + 1);
+        numSamples = std::max(numSamples, 1U);
+
+        Vector<FloatCubemap> outputMips(numMips);
+        for (UINT32 mip = 0; mip < numMips; mip++)
+        {
+            const UINT32 mipSize = std::max(size >> mip, 1U);
+            for (auto& faceData : outputMips[mip])
+            {
+                faceData.Size = mipSize;
+                faceData.Texels.resize(mipSize * mipSize * 4);
+            }
+        }
+
+        // Sample direction in tangent space (normal along Z), with its weight and the source mip it reads from
+        struct Sample
+        {
+            Vector3 Direction;
+            float Weight;
+            float SourceMip;
+        };
+
+        for (UINT32 mip = 0; mip < numMips; mip++)
+        {
+            const float roughness = numMips > 1 ? mip / (float)(numMips - 1) : 0.0f;
+            const float alpha = std::max(roughness * roughness, 1e-4f);
+            const float alpha2 = alpha * alpha;
+            const UINT32 mipSize = outputMips[mip][0].Size;
+
+            // With the view direction equal to the normal, the samples are the same for every texel up to a rotation
+            Vector<Sample> samples;
+            for (UINT32 i = 0; i < (UINT32)numSamples && roughness > 0.0f; i++)
+            {
+                // Hammersley sequence
+                UINT32 bits = i;
+                bits = (bits << 16u) | (bits >> 16u);
+                bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+                bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+                bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+                bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+
+                const float u = (i + 0.5f) / numSamples;
+                const float v = bits * 2.3283064365386963e-10f;
+
+                const float phi = Math::TWO_PI * u;
+                const float cosTheta = std::sqrt((1.0f - v) / (1.0f + (alpha2 - 1.0f) * v));
+                const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+
+                // Half vector, reflected around it to get the light direction
+                const Vector3 halfVector(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+                const Vector3 lightDir = halfVector * (2.0f * cosTheta) - Vector3::UNIT_Z;
+                if (lightDir.z <= 0.0f)
+                    continue;
+
+                // pdf = D * NdotH / (4 * VdotH), which is D / 4 with V == N
+                const float denom = cosTheta * cosTheta * (alpha2 - 1.0f) + 1.0f;
+                const float pdf = alpha2 / (Math::PI * denom * denom) * 0.25f;
+                const float sampleSolidAngle = 1.0f / (numSamples * pdf);
+
+                Sample sample;
+                sample.Direction = lightDir;
+                sample.Weight = lightDir.z;
+                sample.SourceMip = Math::Clamp(0.5f * Math::Log2(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f,
+                    maxSourceMip);
+
+                samples.push_back(sample);
+            }
+
+            // The source level closest in size to the output mip, read directly for a roughness of 0
+            UINT32 mirrorMip = 0;
+            while (mirrorMip + 1 < (UINT32)sourceMips.size() && sourceMips[mirrorMip][0].Size > mipSize)
+                mirrorMip++;
+
+            ParallelFor("IBLUtility", mipSize * 6, ROWS_PER_TASK, [&](UINT32 begin, UINT32 end)
+            {
+                for (UINT32 row = begin; row < end; row++)
+                {
+                    const UINT32 face = row / mipSize;
+                    const UINT32 y = row % mipSize;
+
+                    for (UINT32 x = 0; x < mipSize; x++)
+                    {
+                        const Vector3 normal = Vector3::Normalize(GetDirection(face, GetTexelCenter(x, mipSize),
+                            GetTexelCenter(y, mipSize)));
+
+                        float* outputTexel = outputMips[mip][face].GetTexel(x, y);
+                        if (samples.empty())
+                        {
+                            SIMD::Store(outputTexel, SIMD::Load(GetTexel(sourceMips[mirrorMip], normal)));
+                            continue;
+                        }
+
+                        const Vector3 up = std::abs(normal.z) < 0.999f ? Vector3::UNIT_Z : Vector3::UNIT_X;
+                        const Vector3 tangentX = Vector3::Normalize(Vector3::Cross(up, normal));
+                        const Vector3 tangentY = Vector3::Cross(normal, tangentX);
+
+                        SIMD::Float4 sum = SIMD::Zero();
+                        float totalWeight = 0.0f;
+
+                        for (auto& sample : samples)
+                        {
+                            const Vector3 dir = tangentX * sample.Direction.x + tangentY * sample.Direction.y +
+                                normal * sample.Direction.z;
+
+                            // Blend the two closest source levels
+                            const UINT32 mip0 = (UINT32)sample.SourceMip;
+                            const UINT32 mip1 = std::min(mip0 + 1, (UINT32)sourceMips.size() - 1);
+                            const float blend = sample.SourceMip - mip0;
+
+                            const SIMD::Float4 value0 = SIMD::Load(GetTexel(sourceMips[mip0], dir));
+                            const SIMD::Float4 value1 = SIMD::Load(GetTexel(sourceMips[mip1], dir));
+                            const SIMD::Float4 value = SIMD::MulAdd(SIMD::Sub(value1, value0), SIMD::Splat(blend), value0);
+
+                            sum = SIMD::MulAdd(value, SIMD::Splat(sample.Weight), sum);
+                            totalWeight += sample.Weight;
+                        }
+
+                        SIMD::Store(outputTexel, SIMD::Mul(sum, SIMD::Splat(1.0f / totalWeight)));
+                    }
+                }
+            });
+        }
+
+        output.clear();
+        for (UINT32 face = 0; face < 6; face++)
+        {
+            for (UINT32 mip = 0; mip < numMips; mip++)
+                output.push_back(WriteFace(outputMips[mip][face], format, isSRGB));
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Image/TePixelData.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    /** Radiance projected onto the first three bands (9 coefficients) of the real spherical harmonics, per channel. */
+    struct TE_CORE_EXPORT SHCoefficientsRGB
+    {
+        /** Evaluates the radiance in the provided direction. */
+        Vector3 Evaluate(const Vector3& direction) const;
+
+        /**
+         * Evaluates the irradiance received by a surface with the provided normal, divided by PI. This is the light a white
+         * lambertian surface reflects, which is what irradiance maps store.
+         */
+        Vector3 EvaluateIrradiance(const Vector3& normal) const;
+
+        Vector3 Coeffs[9];
+    };
+
+    /**
+     * Bakes the textures used by image based lighting from an environment cubemap, on the CPU so it also runs on machines
+     * without a GPU (e.g. build servers). Work is spread over the task scheduler when it is running.
+     *
+     * Cubemaps are provided and returned as six faces, in the order of the CubemapFace enum, using the same face
+     * orientations as the textures generated by the importers.
+     */
+    class TE_CORE_EXPORT IBLUtility
+    {
+    public:
+        /**
+         * Projects the radiance of a cubemap onto spherical harmonics.
+         *
+         * @param[in]	faces	Faces of the cubemap. Must be square and of the same size.
+         * @param[in]	isSRGB	True if the faces store gamma corrected values, which are then converted to linear space.
+         */
+        static SHCoefficientsRGB ProjectToSH(const std::array<SPtr<PixelData>, 6>& faces, bool isSRGB = false);
+
+        /**
+         * Generates an irradiance cubemap from radiance projected onto spherical harmonics. See
+         * SHCoefficientsRGB::EvaluateIrradiance().
+         *
+         * @param[in]	sh		Projected radiance, as returned by ProjectToSH().
+         * @param[in]	size	Width and height of the generated faces, in pixels.
+         * @param[in]	format	Pixel format of the generated faces.
+         * @param[in]	isSRGB	True if the values must be gamma corrected before being written.
+         * @param[out]	output	Faces of the irradiance cubemap.
+         */
+        static void GenerateIrradiance(const SHCoefficientsRGB& sh, UINT32 size, PixelFormat format, bool isSRGB,
+            std::array<SPtr<PixelData>, 6>& output);
+
+        /**
+         * Prefilters a cubemap for specular reflections with the GGX distribution: each mip level stores the radiance
+         * reflected toward the mirror direction for a roughness increasing linearly from 0 at mip 0 to 1 at the last mip.
+         * Uses importance sampling, reading samples from a lower resolution copy of the source the less likely they are,
+         * which keeps the result smooth with few samples.
+         *
+         * @param[in]	faces		Faces of the source cubemap. Must be square and of the same size.
+         * @param[in]	isSRGB		True if the faces store gamma corrected values. Output is then gamma corrected too.
+         * @param[in]	size		Width and height of the most detailed mip of the generated faces, in pixels.
+         * @param[in]	numMips		Number of mip levels to generate, including the most detailed one. Clamped to the
+         *							size of the faces.
+         * @param[in]	format		Pixel format of the generated faces.
+         * @param[in]	numSamples	Number of samples taken for each pixel.
+         * @param[out]	output		Pixels of each mip level, face by face: output[face * numMips + mip].
+         */
+        static void FilterSpecular(const std::array<SPtr<PixelData>, 6>& faces, bool isSRGB, UINT32 size,
+            UINT32 numMips, PixelFormat format, UINT32 numSamples, Vector<SPtr<PixelData>>& output);
+
+        /** Default value for the number of samples of FilterSpecular(). */
+        static constexpr UINT32 DEFAULT_SPECULAR_SAMPLES = 128;
+    };
+}
@@ -43,13 +43,16 @@ namespace te
 
     Light::~Light()
     {
+        // Render thread must be done with the object, and notifications still referencing it applied
+        Renderer::SyncNotifications();
+
         if (_renderer) _renderer->NotifyLightRemoved(this);
     }
 
     void Light::Initialize()
     {
         UpdateBounds();
-        if (_renderer) _renderer->NotifyLightAdded(const_cast<Light*>(this));
+        if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightAdded, const_cast<Light*>(this));
 
         CoreObject::Initialize();
     }
@@ -61,7 +64,6 @@ namespace te
 
     void Light::FrameSync()
     {
-        LightType oldType = _type;
         UINT32 dirtyFlag = GetCoreDirtyFlags();
         UINT32 updateEverythingFlag = (UINT32)ActorDirtyFlag::Everything | (UINT32)ActorDirtyFlag::Active;
 
@@ -73,23 +75,17 @@ namespace te
             {
                 if (_active)
                 {
-                    if (_renderer) _renderer->NotifyLightAdded(this);
+                    if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightAdded, this);
                 }
                 else
                 {
-                    LightType newType = _type;
-                    _type = oldType;
-                    if (_renderer) _renderer->NotifyLightRemoved(this);
-                    _type = newType;
+                    if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightRemoved, this);
                 }
             }
             else
             {
-                LightType newType = _type;
-                _type = oldType;
-                if (_renderer) _renderer->NotifyLightRemoved(this);
-                _type = newType;
-                if (_renderer) _renderer->NotifyLightAdded(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightRemoved, this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightAdded, this);
             }
         }
         else if ((dirtyFlag & (UINT32)ActorDirtyFlag::Mobility) != 0)
@@ -97,15 +93,15 @@ namespace te
             // TODO I'm not sure for that, we might check if SceneActor is active
             if (_active)
             {
-                if (_renderer) _renderer->NotifyLightRemoved(this);
-                if (_renderer) _renderer->NotifyLightAdded(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightRemoved, this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightAdded, this);
             }
         }
         else if ((dirtyFlag & (UINT32)ActorDirtyFlag::Transform) != 0)
         {
             if (_active)
             {
-                if (_renderer) _renderer->NotifyLightUpdated(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyLightUpdated, this);
             }
         }
 
@@ -115,12 +111,12 @@ namespace te
     void Light::AttachTo(SPtr<Renderer> renderer)
     {
         if (_renderer)
-            _renderer->NotifyLightRemoved(this);
+            _renderer->QueueNotification(&Renderer::NotifyLightRemoved, this);
 
         _renderer = renderer;
 
         if (_renderer)
-            _renderer->NotifyLightAdded(this);
+            _renderer->QueueNotification(&Renderer::NotifyLightAdded, this);
 
         _markCoreDirty();
     }
@@ -0,0 +1,406 @@
+#include "Renderer/TeOcclusionBuffer.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Math/TeSIMD.h"
+#include "Math/TeMath.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Vertices closer than this to the eye, in clip space w, are clipped away. */
+        const float MIN_CLIP_W = 1e-4f;
+
+        /** Number of occluders set up by each task. */
+        const UINT32 OCCLUDERS_PER_TASK = 4;
+
+        /** Polygon resulting from the clipping of a triangle against the 5 clip planes used. */
+        struct ClipPolygon
+        {
+            Vector4 Vertices[8];
+            UINT32 Count = 0;
+        };
+
+        /** Distance of a clip space position to one of the planes triangles are clipped against. Positive inside. */
+        float GetPlaneDistance(const Vector4& position, UINT32 plane)
+        {
+            switch (plane)
+            {
+            case 0: return position.w - MIN_CLIP_W;
+            case 1: return position.w + position.x;
+            case 2: return position.w - position.x;
+            case 3: return position.w + position.y;
+            default: return position.w - position.y;
+            }
+        }
+
+        /** Clips a polygon against a plane (Sutherland-Hodgman). */
+        void ClipAgainstPlane(const ClipPolygon& input, UINT32 plane, ClipPolygon& output)
+        {
+            output.Count = 0;
+
+            for (UINT32 i = 0; i < input.Count; i++)
+            {
+                const Vector4& current = input.Vertices[i];
+                const Vector4& next = input.Vertices[(i + 1) % input.Count];
+                const float currentDistance = GetPlaneDistance(current, plane);
+                const float nextDistance = GetPlaneDistance(next, plane);
+
+                if (currentDistance >= 0.0f)
+                    output.Vertices[output.Count++] = current;
+
+                if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+                {
+                    const float t = currentDistance / (currentDistance - nextDistance);
+                    output.Vertices[output.Count++] = current + (next - current) * t;
+                }
+            }
+        }
+    }
+
+    OcclusionBuffer::OcclusionBuffer(UINT32 width, UINT32 height)
+    {
+        SetResolution(width, height);
+    }
+
+    void OcclusionBuffer::SetResolution(UINT32 width, UINT32 height)
+    {
+        _requestedWidth = std::max(width, 1U);
+        _requestedHeight = std::max(height, 1U);
+    }
+
+    void OcclusionBuffer::Clear(const Matrix4& viewProj)
+    {
+        _width = (_requestedWidth + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE;
+        _height = (_requestedHeight + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE;
+        _tilesX = _width / TILE_SIZE;
+        _tilesY = _height / TILE_SIZE;
+
+        _viewProj = viewProj;
+        _depth.assign(_width * _height, std::numeric_limits<float>::max());
+        _tileMaxDepth.assign(_tilesX * _tilesY, std::numeric_limits<float>::max());
+
+        _occluders.clear();
+        _numTriangles = 0;
+    }
+
+    void OcclusionBuffer::AddOccluder(const Vector3* positions, UINT32 numVertices, const UINT32* indices,
+        UINT32 numIndices, const Matrix4& world)
+    {
+        if (numVertices == 0 || numIndices < 3)
+            return;
+
+        _occluders.push_back({ positions, numVertices, indices, numIndices, _viewProj * world });
+    }
+
+    void OcclusionBuffer::Rasterize()
+    {
+        const UINT32 numOccluders = (UINT32)_occluders.size();
+        if (_triangles.size() < numOccluders)
+            _triangles.resize(numOccluders);
+
+        ParallelFor("OcclusionBuffer", numOccluders, OCCLUDERS_PER_TASK, [this](UINT32 begin, UINT32 end)
+        {
+            for (UINT32 i = begin; i < end; i++)
+                SetupTriangles(_occluders[i], _triangles[i]);
+        });
+
+        _numTriangles = 0;
+        for (UINT32 i = 0; i < numOccluders; i++)
+            _numTriangles += (UINT32)_triangles[i].size();
+
+        // Each task owns whole rows of tiles, so it can update them without synchronization
+        ParallelFor("OcclusionBuffer", _tilesY, 1, [this](UINT32 begin, UINT32 end)
+        {
+            RasterizeRows(begin * TILE_SIZE, end * TILE_SIZE);
+        });
+    }
+
+    void OcclusionBuffer::SetupTriangles(const Occluder& occluder, Vector<Triangle>& output) const
+    {
+        output.clear();
+
+        Vector<Vector4> clipPositions(occluder.NumVertices);
+        for (UINT32 i = 0; i < occluder.NumVertices; i++)
+        {
+            const Vector3& position = occluder.Positions[i];
+            clipPositions[i] = occluder.WorldViewProj.Multiply(Vector4(position.x, position.y, position.z, 1.0f));
+        }
+
+        const float width = (float)_width;
+        const float height = (float)_height;
+
+        for (UINT32 i = 0; i + 2 < occluder.NumIndices; i += 3)
+        {
+            const UINT32 i0 = occluder.Indices[i];
+            const UINT32 i1 = occluder.Indices[i + 1];
+            const UINT32 i2 = occluder.Indices[i + 2];
+
+            if (i0 >= occluder.NumVertices || i1 >= occluder.NumVertices || i2 >= occluder.NumVertices)
+                continue;
+
+            ClipPolygon polygon;
+            polygon.Vertices[0] = clipPositions[i0];
+            polygon.Vertices[1] = clipPositions[i1];
+            polygon.Vertices[2] = clipPositions[i2];
+            polygon.Count = 3;
+
+            // Only clip against the planes the triangle crosses, most triangles are either entirely inside or outside
+            bool culled = false;
+            UINT32 crossedPlanes = 0;
+            for (UINT32 plane = 0; plane < 5; plane++)
+            {
+                UINT32 numInside = 0;
+                for (UINT32 j = 0; j < 3; j++)
+                    numInside += GetPlaneDistance(polygon.Vertices[j], plane) >= 0.0f ? 1 : 0;
+
+                if (numInside == 0)
+                    culled = true;
+                else if (numInside < 3)
+                    crossedPlanes |= 1 << plane;
+            }
+
+            if (culled)
+                continue;
+
+            for (UINT32 plane = 0; plane < 5 && polygon.Count >= 3; plane++)
+            {
+                if ((crossedPlanes & (1 << plane)) == 0)
+                    continue;
+
+                ClipPolygon clipped;
+                ClipAgainstPlane(polygon, plane, clipped);
+                polygon = clipped;
+            }
+
+            if (polygon.Count < 3)
+                continue;
+
+            // Project to pixels
+            Vector3 screen[8];
+            for (UINT32 j = 0; j < polygon.Count; j++)
+            {
+                const Vector4& position = polygon.Vertices[j];
+                const float invW = 1.0f / position.w;
+
+                screen[j].x = (position.x * invW * 0.5f + 0.5f) * width;
+                screen[j].y = (0.5f - position.y * invW * 0.5f) * height;
+                screen[j].z = position.z * invW;
+            }
+
+            // Triangulate as a fan
+            for (UINT32 j = 1; j + 1 < polygon.Count; j++)
+            {
+                const Vector3* vertices[3] = { &screen[0], &screen[j], &screen[j + 1] };
+
+                Triangle triangle;
+                for (UINT32 k = 0; k < 3; k++)
+                {
+                    const Vector3& from = *vertices[k];
+                    const Vector3& to = *vertices[(k + 1) % 3];
+
+                    triangle.EdgeA[k] = from.y - to.y;
+                    triangle.EdgeB[k] = to.x - from.x;
+                    triangle.EdgeC[k] = (to.y - from.y) * from.x - (to.x - from.x) * from.y;
+                }
+
+                const Vector3& v0 = *vertices[0];
+                const Vector3& v1 = *vertices[1];
+                const Vector3& v2 = *vertices[2];
+
+                const float area = triangle.EdgeA[0] * v2.x + triangle.EdgeB[0] * v2.y + triangle.EdgeC[0];
+                if (std::abs(area) < 1e-6f)
+                    continue;
+
+                // Both faces are rasterized, make edge functions positive inside whatever the winding
+                if (area < 0.0f)
+                {
+                    for (UINT32 k = 0; k < 3; k++)
+                    {
+                        triangle.EdgeA[k] = -triangle.EdgeA[k];
+                        triangle.EdgeB[k] = -triangle.EdgeB[k];
+                        triangle.EdgeC[k] = -triangle.EdgeC[k];
+                    }
+                }
+
+                const float dx1 = v1.x - v0.x, dy1 = v1.y - v0.y, dz1 = v1.z - v0.z;
+                const float dx2 = v2.x - v0.x, dy2 = v2.y - v0.y, dz2 = v2.z - v0.z;
+                const float det = dx1 * dy2 - dx2 * dy1;
+
+                triangle.DepthA = (dz1 * dy2 - dz2 * dy1) / det;
+                triangle.DepthB = (dx1 * dz2 - dx2 * dz1) / det;
+                triangle.DepthC = v0.z - triangle.DepthA * v0.x - triangle.DepthB * v0.y;
+
+                // Pixels are sampled at their center
+                const float minX = std::min(std::min(v0.x, v1.x), v2.x);
+                const float maxX = std::max(std::max(v0.x, v1.x), v2.x);
+                const float minY = std::min(std::min(v0.y, v1.y), v2.y);
+                const float maxY = std::max(std::max(v0.y, v1.y), v2.y);
+
+                triangle.MinX = std::max((INT32)Math::Ceil(minX - 0.5f), 0);
+                triangle.MaxX = std::min((INT32)Math::Floor(maxX - 0.5f), (INT32)_width - 1);
+                triangle.MinY = std::max((INT32)Math::Ceil(minY - 0.5f), 0);
+                triangle.MaxY = std::min((INT32)Math::Floor(maxY - 0.5f), (INT32)_height - 1);
+
+                if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+                    continue;
+
+                output.push_back(triangle);
+            }
+        }
+    }
+
+    void OcclusionBuffer::RasterizeRows(UINT32 begin, UINT32 end)
+    {
+        const SIMD::Float4 laneOffsets = SIMD::Set(0.5f, 1.5f, 2.5f, 3.5f);
+        const SIMD::Float4 zero = SIMD::Zero();
+
+        for (UINT32 i = 0; i < (UINT32)_occluders.size(); i++)
+        {
+            for (const auto& triangle : _triangles[i])
+            {
+                const INT32 minY = std::max(triangle.MinY, (INT32)begin);
+                const INT32 maxY = std::min(triangle.MaxY, (INT32)end - 1);
+                if (minY > maxY)
+                    continue;
+
+                // Rows are a multiple of 4 pixels wide, aligned starts never read past the end of a row
+                const INT32 minX = triangle.MinX & ~3;
+
+                const SIMD::Float4 edgeA[3] = {
+                    SIMD::Splat(triangle.EdgeA[0]), SIMD::Splat(triangle.EdgeA[1]), SIMD::Splat(triangle.EdgeA[2])
+                };
+                const SIMD::Float4 depthA = SIMD::Splat(triangle.DepthA);
+
+                for (INT32 y = minY; y <= maxY; y++)
+                {
+                    const float centerY = y + 0.5f;
+
+                    SIMD::Float4 edgeRow[3];
+                    for (UINT32 k = 0; k < 3; k++)
+                        edgeRow[k] = SIMD::Splat(triangle.EdgeB[k] * centerY + triangle.EdgeC[k]);
+
+                    const SIMD::Float4 depthRow = SIMD::Splat(triangle.DepthB * centerY + triangle.DepthC);
+                    float* row = &_depth[y * _width];
+
+                    for (INT32 x = minX; x <= triangle.MaxX; x += 4)
+                    {
+                        const SIMD::Float4 centerX = SIMD::Add(SIMD::Splat((float)x), laneOffsets);
+
+                        SIMD::Float4 outside = SIMD::Greater(zero, SIMD::MulAdd(edgeA[0], centerX, edgeRow[0]));
+                        outside = SIMD::Or(outside, SIMD::Greater(zero, SIMD::MulAdd(edgeA[1], centerX, edgeRow[1])));
+                        outside = SIMD::Or(outside, SIMD::Greater(zero, SIMD::MulAdd(edgeA[2], centerX, edgeRow[2])));
+
+                        if (SIMD::MoveMask(outside) == 0xF)
+                            continue;
+
+                        const SIMD::Float4 depth = SIMD::MulAdd(depthA, centerX, depthRow);
+                        const SIMD::Float4 current = SIMD::Load(&row[x]);
+
+                        SIMD::Store(&row[x], SIMD::Select(outside, current, SIMD::Min(current, depth)));
+                    }
+                }
+            }
+        }
+
+        // Farthest depth of each tile
+        for (UINT32 tileY = begin / TILE_SIZE; tileY < end / TILE_SIZE; tileY++)
+        {
+            for (UINT32 tileX = 0; tileX < _tilesX; tileX++)
+            {
+                SIMD::Float4 maxDepth = SIMD::Splat(-std::numeric_limits<float>::max());
+                for (UINT32 y = 0; y < TILE_SIZE; y++)
+                {
+                    const float* row = &_depth[(tileY * TILE_SIZE + y) * _width + tileX * TILE_SIZE];
+                    for (UINT32 x = 0; x < TILE_SIZE; x += 4)
+                        maxDepth = SIMD::Max(maxDepth, SIMD::Load(&row[x]));
+                }
+
+                float lanes[4];
+                SIMD::Store(lanes, maxDepth);
+                _tileMaxDepth[tileY * _tilesX + tileX] = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+            }
+        }
+    }
+
+    bool OcclusionBuffer::IsVisible(const AABox& box) const
+    {
+        if (_depth.empty())
+            return true;
+
+        const Vector3& min = box.GetMin();
+        const Vector3& max = box.GetMax();
+
+        float minX = std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxX = -std::numeric_limits<float>::max();
+        float maxY = -std::numeric_limits<float>::max();
+        float nearestDepth = std::numeric_limits<float>::max();
+
+        for (UINT32 i = 0; i < 8; i++)
+        {
+            const Vector4 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z, 1.0f);
+            const Vector4 position = _viewProj.Multiply(corner);
+
+            if (position.w < MIN_CLIP_W)
+                return true;
+
+            const float invW = 1.0f / position.w;
+            const float x = (position.x * invW * 0.5f + 0.5f) * _width;
+            const float y = (0.5f - position.y * invW * 0.5f) * _height;
+
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+            nearestDepth = std::min(nearestDepth, position.z * invW);
+        }
+
+        if (maxX < 0.0f || maxY < 0.0f || minX > (float)_width || minY > (float)_height)
+            return true;
+
+        // Every pixel the box might touch
+        const INT32 pixelMinX = std::max((INT32)Math::Floor(minX), 0);
+        const INT32 pixelMaxX = std::min((INT32)Math::Floor(maxX), (INT32)_width - 1);
+        const INT32 pixelMinY = std::max((INT32)Math::Floor(minY), 0);
+        const INT32 pixelMaxY = std::min((INT32)Math::Floor(maxY), (INT32)_height - 1);
+
+        const SIMD::Float4 nearest = SIMD::Splat(nearestDepth);
+
+        for (INT32 tileY = pixelMinY / (INT32)TILE_SIZE; tileY <= pixelMaxY / (INT32)TILE_SIZE; tileY++)
+        {
+            for (INT32 tileX = pixelMinX / (INT32)TILE_SIZE; tileX <= pixelMaxX / (INT32)TILE_SIZE; tileX++)
+            {
+                // Everything in the tile is in front of the box
+                if (_tileMaxDepth[tileY * _tilesX + tileX] < nearestDepth)
+                    continue;
+
+                const INT32 startX = std::max(pixelMinX, tileX * (INT32)TILE_SIZE);
+                const INT32 endX = std::min(pixelMaxX, (tileX + 1) * (INT32)TILE_SIZE - 1);
+                const INT32 startY = std::max(pixelMinY, tileY * (INT32)TILE_SIZE);
+                const INT32 endY = std::min(pixelMaxY, (tileY + 1) * (INT32)TILE_SIZE - 1);
+
+                for (INT32 y = startY; y <= endY; y++)
+                {
+                    const float* row = &_depth[y * _width];
+                    for (INT32 x = startX & ~3; x <= endX; x += 4)
+                    {
+                        const int behind = SIMD::MoveMask(SIMD::Greater(nearest, SIMD::Load(&row[x])));
+
+                        // Lanes outside of the box count as hidden
+                        int lanes = 0xF;
+                        for (INT32 lane = 0; lane < 4; lane++)
+                        {
+                            if (x + lane < startX || x + lane > endX)
+                                lanes &= ~(1 << lane);
+                        }
+
+                        if ((behind & lanes) != lanes)
+                            return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeAABox.h"
+
+namespace te
+{
+    /**
+     * Low resolution depth buffer filled on the CPU with the triangles of occluders, and used to find out whether
+     * bounding boxes are hidden behind them. It doesn't need a GPU, nor any read back from it.
+     *
+     * The buffer stores normalized device depth (z / w), which is linear in screen space whatever the projection. It is
+     * split in tiles of TILE_SIZE x TILE_SIZE pixels that also keep the farthest depth they contain, so most tests are
+     * answered without looking at individual pixels.
+     *
+     * Occluders are queued with AddOccluder() and rasterized with Rasterize(). Triangles are set up in parallel per
+     * occluder, then rasterized in parallel per horizontal band of tiles, four pixels at a time. Both faces of the
+     * triangles are rasterized. Occluders must not be bigger than what they are meant to hide, or visible objects will
+     * be culled.
+     */
+    class TE_CORE_EXPORT OcclusionBuffer
+    {
+    public:
+        OcclusionBuffer(UINT32 width = DEFAULT_WIDTH, UINT32 height = DEFAULT_HEIGHT);
+        ~OcclusionBuffer() = default;
+
+        /**
+         * Changes the resolution of the buffer. Rounded up to a multiple of TILE_SIZE. Takes effect on the next call to
+         * Clear().
+         */
+        void SetResolution(UINT32 width, UINT32 height);
+
+        /** Returns the width of the buffer, in pixels. */
+        UINT32 GetWidth() const { return _width; }
+
+        /** Returns the height of the buffer, in pixels. */
+        UINT32 GetHeight() const { return _height; }
+
+        /** Empties the buffer and forgets queued occluders. Occluders and tests will use @p viewProj. */
+        void Clear(const Matrix4& viewProj);
+
+        /**
+         * Queues a triangle list to be rasterized by the next call to Rasterize(). Data isn't copied and must stay valid
+         * until then.
+         *
+         * @param[in]	positions		Positions of the vertices, in the local space of the occluder.
+         * @param[in]	numVertices		Number of entries in @p positions.
+         * @param[in]	indices			Three indices per triangle.
+         * @param[in]	numIndices		Number of entries in @p indices.
+         * @param[in]	world			Transform from the local space of the occluder to world space.
+         */
+        void AddOccluder(const Vector3* positions, UINT32 numVertices, const UINT32* indices, UINT32 numIndices,
+            const Matrix4& world);
+
+        /** Rasterizes the occluders queued since the last Clear(). */
+        void Rasterize();
+
+        /**
+         * Tests a world space box against the rasterized occluders. Returns false only if the box is entirely hidden.
+         * Boxes crossing the near plane or leaving the screen are always considered visible.
+         */
+        bool IsVisible(const AABox& box) const;
+
+        /** Returns the number of triangles rasterized by the last call to Rasterize(). */
+        UINT32 GetNumRasterizedTriangles() const { return _numTriangles; }
+
+        /** Returns the depth of each pixel, row by row. Pixels not covered by occluders are FLT_MAX. */
+        const Vector<float>& GetDepth() const { return _depth; }
+
+        static constexpr UINT32 DEFAULT_WIDTH = 256;
+        static constexpr UINT32 DEFAULT_HEIGHT = 128;
+        static constexpr UINT32 TILE_SIZE = 8;
+
+    private:
+        /** Occluder queued by AddOccluder(). */
+        struct Occluder
+        {
+            const Vector3* Positions;
+            UINT32 NumVertices;
+            const UINT32* Indices;
+            UINT32 NumIndices;
+            Matrix4 WorldViewProj;
+        };
+
+        /** Triangle ready to be rasterized, in pixel coordinates. */
+        struct Triangle
+        {
+            float EdgeA[3], EdgeB[3], EdgeC[3]; // Edge functions, positive inside
+            float DepthA, DepthB, DepthC; // Depth plane: depth = DepthA * x + DepthB * y + DepthC
+            INT32 MinX, MinY, MaxX, MaxY; // Pixels whose center may be inside
+        };
+
+        /** Clips the triangles of an occluder and outputs them in pixel coordinates. */
+        void SetupTriangles(const Occluder& occluder, Vector<Triangle>& output) const;
+
+        /** Rasterizes all triangles overlapping rows [@p begin, @p end), and updates the tiles they contain. */
+        void RasterizeRows(UINT32 begin, UINT32 end);
+
+    private:
+        UINT32 _width = 0;
+        UINT32 _height = 0;
+        UINT32 _tilesX = 0;
+        UINT32 _tilesY = 0;
+        UINT32 _requestedWidth;
+        UINT32 _requestedHeight;
+
+        Matrix4 _viewProj = Matrix4::IDENTITY;
+        Vector<float> _depth;
+        Vector<float> _tileMaxDepth;
+
+        Vector<Occluder> _occluders;
+        Vector<Vector<Triangle>> _triangles; // Per occluder
+        UINT32 _numTriangles = 0;
+    };
+}
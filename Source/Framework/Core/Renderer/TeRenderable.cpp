@@ -39,12 +39,15 @@ namespace te
 
     Renderable::~Renderable()
     {
+        // Render thread must be done with the object, and notifications still referencing it applied
+        Renderer::SyncNotifications();
+
         if (_renderer) _renderer->NotifyRenderableRemoved(this);
     }
 
     void Renderable::Initialize()
     {
-        if (_renderer) _renderer->NotifyRenderableAdded(this);
+        if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableAdded, this);
         CoreObject::Initialize();
     }
 
@@ -64,7 +67,6 @@ namespace te
         _tfrmMatrixNoScale = Matrix4::TRS(transform.GetPosition(), transform.GetRotation(), Vector3::ONE);
 
         _boundsDirty = true;
-        _subMeshesBoundsDirty = true;
 
         _markCoreDirty(ActorDirtyFlag::Transform);
     }
@@ -82,11 +84,9 @@ namespace te
         {
             UINT32 numSubMeshes = mesh->GetProperties().GetNumSubMeshes();
             _materials.resize(numSubMeshes);
-            _subMeshesBounds.resize(numSubMeshes);
         }
 
         _boundsDirty = true;
-        _subMeshesBoundsDirty = true;
 
         OnMeshChanged();
         _markCoreDirty(ActorDirtyFlag::GpuParams);
@@ -290,11 +290,15 @@ namespace te
         }
     }
 
-    Bounds Renderable::GetSubMeshBounds(UINT32 subMeshIdx)
+    Bounds Renderable::GetSubMeshBounds(UINT32 subMeshIdx) const
     {
-        SPtr<Mesh> mesh = GetMesh();
+        SPtr<Mesh> mesh = _mesh;
+        SubMesh* subMesh = nullptr;
 
-        if (!mesh || subMeshIdx > mesh->GetProperties().GetNumSubMeshes() - 1)
+        if (mesh && subMeshIdx < mesh->GetProperties().GetNumSubMeshes())
+            subMesh = mesh->GetProperties().GetSubMeshPtr(subMeshIdx);
+
+        if (!subMesh)
         {
             const Transform& tfrm = GetTransform();
 
@@ -304,34 +308,10 @@ namespace te
             return Bounds(box, sphere);
         }
 
-        if (!_subMeshesBoundsDirty)
-            return _subMeshesBounds.at(subMeshIdx);
-
-        Bounds returnBounds;
-
-        _subMeshesBoundsDirty = false;
-        _subMeshesBounds.clear();
-
-        for (UINT32 i = 0; i < mesh->GetProperties().GetNumSubMeshes(); i++)
-        {
-            SubMesh* subMesh = mesh->GetProperties().GetSubMeshPtr(i);
-            if (subMesh)
-            {
-                Bounds subMeshBounds = subMesh->SubMeshBounds;
-                subMeshBounds.TransformAffine(_tfrmMatrix);
-
-                _subMeshesBounds.push_back(subMeshBounds);
-
-                if (i == subMeshIdx)
-                    returnBounds = subMeshBounds;
-            }
-            else
-            {
-                _subMeshesBounds.push_back(returnBounds);
-            }
-        }
+        Bounds bounds = subMesh->SubMeshBounds;
+        bounds.TransformAffine(_tfrmMatrix);
 
-        return returnBounds;
+        return bounds;
     }
 
     void Renderable::UpdateAnimationBuffers(const EvaluatedAnimationData& animData)
@@ -420,12 +400,12 @@ namespace te
     void Renderable::AttachTo(SPtr<Renderer> renderer)
     {
         if (_renderer)
-            _renderer->NotifyRenderableRemoved(this);
+            _renderer->QueueNotification(&Renderer::NotifyRenderableRemoved, this);
 
         _renderer = renderer;
 
         if (_renderer)
-            _renderer->NotifyRenderableAdded(this);
+            _renderer->QueueNotification(&Renderer::NotifyRenderableAdded, this);
 
         _markCoreDirty();
     }
@@ -524,17 +504,17 @@ namespace te
             {
                 if (_active)
                 {
-                    if (_renderer) _renderer->NotifyRenderableAdded(this);
+                    if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableAdded, this);
                 }
                 else
                 {
-                    if (_renderer) _renderer->NotifyRenderableRemoved(this);
+                    if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableRemoved, this);
                 }
             }
             else
             {
-                if (_renderer) _renderer->NotifyRenderableRemoved(this);
-                if (_renderer) _renderer->NotifyRenderableAdded(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableRemoved, this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableAdded, this);
             }
         }
         else if ((dirtyFlag & (UINT32)ActorDirtyFlag::Mobility) != 0)
@@ -542,15 +522,15 @@ namespace te
             // TODO I'm not sure for that, we might check if SceneActor is active
             if (_active)
             {
-                if (_renderer) _renderer->NotifyRenderableRemoved(this);
-                if (_renderer) _renderer->NotifyRenderableAdded(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableRemoved, this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableAdded, this);
             }
         }
         else if ((dirtyFlag & (UINT32)ActorDirtyFlag::Transform) != 0)
         {
             if (_active)
             {
-                if (_renderer) _renderer->NotifyRenderableUpdated(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableUpdated, this);
             }
         }
         else if ((dirtyFlag & (UINT32)ActorDirtyFlag::GpuParams) != 0)
@@ -559,7 +539,7 @@ namespace te
 
             if (_active)
             {
-                if (_renderer) _renderer->NotifyRenderableUpdated(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifyRenderableUpdated, this);
             }
         }
 
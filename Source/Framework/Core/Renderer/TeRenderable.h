@@ -19,6 +19,7 @@ namespace te
         bool ReceiveShadows = true;
         bool UseForDynamicEnvMapping  = false;
         bool WriteVelocity = true;
+        bool Occluder = false;
         float CullDistanceFactor = 1.0f;
     };
 
@@ -154,6 +155,16 @@ namespace te
         /** @copydoc SetCastLights */
         bool GetCastLights() const { return _properties.CastLights; }
 
+        /**
+         * Determines if the mesh of this object hides what is behind it, so it can be used for occlusion culling. The mesh
+         * must be CPU cached (see MeshImportOptions::CpuCached) and fill its bounds well enough: occluders are rasterized
+         * on the CPU, and only the objects entirely hidden behind them are culled. Ignored for animated objects.
+         */
+        void SetOccluder(bool occluder) { _properties.Occluder = occluder; _markCoreDirty(); }
+
+        /** @copydoc SetOccluder */
+        bool GetOccluder() const { return _properties.Occluder; }
+
         /** Set whole properties in a row */
         void SetPorperties(RenderableProperties& properties) { _properties = properties; _markCoreDirty(); }
 
@@ -184,8 +195,11 @@ namespace te
         /**	Gets world bounds of the mesh rendered by this object. */
         Bounds GetBounds();
 
-        /** Get subMesh specific bounding box */
-        Bounds GetSubMeshBounds(UINT32 subMeshIdx = 0);
+        /** 
+         * Get subMesh specific bounding box. Computed on each call from the local bounds stored in the mesh, the renderer
+         * keeps its own copy of all sub-mesh world bounds.
+         */
+        Bounds GetSubMeshBounds(UINT32 subMeshIdx = 0) const;
 
         /** Determines the animation that will be used for animating the attached mesh. */
         void SetAnimation(const SPtr<Animation>& animation);
@@ -282,10 +296,6 @@ namespace te
         Bounds _cachedBounds;
         bool _boundsDirty = true; 
 
-        // For rendering sorting, it's better to use subMesh bounds instead of mesh bounds
-        Vector<Bounds> _subMeshesBounds;
-        bool _subMeshesBoundsDirty = true;
-
         UINT32 _rendererId = 0;
         SPtr<Renderer> _renderer; /** Default renderer if this attributes is not filled in constructor. */
     };
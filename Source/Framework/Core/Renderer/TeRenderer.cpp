@@ -15,6 +15,17 @@ namespace te
             RendererMeshData(meshData));
     }
 
+    void Renderer::QueueNotification(std::function<void()> notification)
+    {
+        RendererManager::Instance().QueueNotification(std::move(notification));
+    }
+
+    void Renderer::SyncNotifications()
+    {
+        if (RendererManager::IsStarted())
+            RendererManager::Instance().SyncNotifications();
+    }
+
     SPtr<Renderer> gRenderer()
     {
         return RendererManager::Instance().GetRenderer();
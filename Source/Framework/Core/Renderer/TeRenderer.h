@@ -12,6 +12,11 @@ namespace te
     struct PerFrameData
     {
         const EvaluatedAnimationData* Animation = nullptr;
+
+        /** Time values captured when the frame was synced with the renderer. */
+        float Time = 0.0f;
+        float TimeDelta = 0.0f;
+        UINT64 FrameIdx = 0;
     };
 
     /**	Set of options that can be used for controlling the renderer. */
@@ -149,6 +154,23 @@ namespace te
          */
         virtual void NotifyDecalsCleared() { }
 
+        /**
+         * Queues a call to @p notify for @p object, applied at the next sync point between the main thread and the render
+         * thread. Scene objects use it instead of calling Notify* methods directly, as the render thread might be
+         * iterating over the scene.
+         */
+        template<class T, class... Args>
+        void QueueNotification(void (Renderer::*notify)(T*, Args...), T* object, Args... args)
+        {
+            QueueNotification([this, notify, object, args...]() { (this->*notify)(object, args...); });
+        }
+
+        /** @copydoc RendererManager::QueueNotification */
+        static void QueueNotification(std::function<void()> notification);
+
+        /** @copydoc RendererManager::SyncNotifications */
+        static void SyncNotifications();
+
         /**
          * Called by the user when he want to batch several renderables into only one big renderable.
          */
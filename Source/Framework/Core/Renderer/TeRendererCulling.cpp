@@ -0,0 +1,38 @@
+#include "Renderer/TeRendererCulling.h"
+
+namespace te
+{
+    void RendererCulling::CalculateVisibility(const Vector<CullInfo>& cullInfos, UINT64 visibleLayers,
+        const ConvexVolume& frustum, const Vector3& viewOrigin, float cullDistance,
+        Vector<RenderableVisibility>& visibility)
+    {
+        for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+        {
+            if ((cullInfos[i].Layer & visibleLayers) == 0)
+                continue;
+
+            // Do distance culling
+            const Sphere& boundingSphere = cullInfos[i].Boundaries.GetSphere();
+            const Vector3& worldRenderablePosition = boundingSphere.GetCenter();
+
+            float distanceToCameraSq = viewOrigin.SquaredDistance(worldRenderablePosition);
+            float correctedCullDistance = cullInfos[i].CullDistanceFactor * cullDistance;
+            float maxDistanceToCamera = correctedCullDistance + boundingSphere.GetRadius();
+
+            if (distanceToCameraSq > maxDistanceToCamera* maxDistanceToCamera)
+                continue;
+
+            // Do frustum culling
+            // Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
+            // operations, as it is trivial to update them. Also consider spatial partitioning.
+            if (frustum.Intersects(boundingSphere))
+            {
+                // More precise with the box
+                const AABox& boundingBox = cullInfos[i].Boundaries.GetBox();
+
+                if (frustum.Intersects(boundingBox))
+                    visibility[i].Visible = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeBounds.h"
+#include "Math/TeConvexVolume.h"
+
+namespace te
+{
+    /** Information used for culling an object against a view. */
+    struct CullInfo
+    {
+        CullInfo(const Bounds& bounds, UINT64 layer = -1, float cullDistanceFactor = 1.0f)
+            : Layer(layer)
+            , Boundaries(bounds)
+            , CullDistanceFactor(cullDistanceFactor)
+        { }
+
+        UINT64 Layer;
+        Bounds Boundaries;
+        float CullDistanceFactor;
+    };
+
+    /** Visibility of a renderable object in a view. */
+    struct RenderableVisibility
+    {
+        bool Visible = false;
+        bool Instanced = false;
+    };
+
+    /** Culling of renderable objects against a view. Doesn't depend on any GPU state. */
+    class TE_CORE_EXPORT RendererCulling
+    {
+    public:
+        /**
+         * Culls the provided objects by layer, by distance and then against the view frustum.
+         *
+         * @param[in]	cullInfos		Bounds and culling information of each object.
+         * @param[in]	visibleLayers	Layers visible from the view.
+         * @param[in]	frustum			World space frustum of the view.
+         * @param[in]	viewOrigin		World space position of the view.
+         * @param[in]	cullDistance	Distance after which objects are culled, scaled by their cull distance factor.
+         * @param[out]	visibility		Set to visible for every visible object, never set back to invisible. Must be the
+         *								same size as @p cullInfos.
+         */
+        static void CalculateVisibility(const Vector<CullInfo>& cullInfos, UINT64 visibleLayers,
+            const ConvexVolume& frustum, const Vector3& viewOrigin, float cullDistance,
+            Vector<RenderableVisibility>& visibility);
+    };
+}
@@ -188,8 +188,8 @@ namespace te
 
     void RendererUtility::SetPassParams(const SPtr<GpuParams> gpuParams, UINT32 gpuParamsBindFlags, bool isInstanced)
     {
-        static const Vector<String> PerInstancedBuffer = { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer" };
-        static const Vector<String> PerNonInstancedBuffer = { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer", "PerInstanceBuffer"};
+        static const Vector<String> PerInstancedBuffer = { "PerCameraBuffer", "PerLightsBuffer", "PerShadowsBuffer", "PerFrameBuffer" };
+        static const Vector<String> PerNonInstancedBuffer = { "PerCameraBuffer", "PerLightsBuffer", "PerShadowsBuffer", "PerFrameBuffer", "PerInstanceBuffer"};
 
         if (gpuParams == nullptr)
             return;
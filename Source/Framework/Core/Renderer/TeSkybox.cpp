@@ -16,7 +16,10 @@ namespace te
 
     Skybox::~Skybox()
     {
-        if(_active)
+        // Render thread must be done with the object, and notifications still referencing it applied
+        Renderer::SyncNotifications();
+
+        if (_active)
         {
             if (_renderer) _renderer->NotifySkyboxRemoved(this);
         }
@@ -24,7 +27,7 @@ namespace te
 
     void Skybox::Initialize()
     {
-        if (_renderer) _renderer->NotifySkyboxAdded(this);
+        if (_renderer) _renderer->QueueNotification(&Renderer::NotifySkyboxAdded, this);
         CoreObject::Initialize();
     }
 
@@ -55,12 +58,12 @@ namespace te
     void Skybox::AttachTo(SPtr<Renderer> renderer)
     {
         if (_renderer)
-            _renderer->NotifySkyboxRemoved(this);
+            _renderer->QueueNotification(&Renderer::NotifySkyboxRemoved, this);
 
         _renderer = renderer;
 
         if (_renderer)
-            _renderer->NotifySkyboxAdded(this);
+            _renderer->QueueNotification(&Renderer::NotifySkyboxAdded, this);
 
         _markCoreDirty();
     }
@@ -95,17 +98,21 @@ namespace te
         {
             if (_active)
             {
-                if (_renderer) _renderer->NotifySkyboxAdded(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifySkyboxAdded, this);
             }
             else
             {
-                if (_renderer) _renderer->NotifySkyboxRemoved(this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifySkyboxRemoved, this);
             }
         }
-        else if ((dirtyFlag & ((UINT32)SkyboxDirtyFlag::Texture)) != 0)
+        else if ((dirtyFlag & ((UINT32)SkyboxDirtyFlag::Texture | (UINT32)ActorDirtyFlag::Everything)) != 0)
         {
-            if (_renderer) _renderer->NotifySkyboxRemoved(this);
-            if (_renderer) _renderer->NotifySkyboxAdded(this);
+            // Renderer keeps a copy of the skybox properties, taken when it is added
+            if (_active)
+            {
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifySkyboxRemoved, this);
+                if (_renderer) _renderer->QueueNotification(&Renderer::NotifySkyboxAdded, this);
+            }
         }
 
         _oldActive = _active;
@@ -148,6 +148,16 @@ namespace te
                 InitShaderDecal();
             shader = _shaderDecal;
             break;
+        case BuiltinShader::ShadowDepth:
+            if (!_shaderShadowDepth.IsLoaded())
+                InitShaderShadowDepth();
+            shader = _shaderShadowDepth;
+            break;
+        case BuiltinShader::ShadowDepthClear:
+            if (!_shaderShadowDepthClear.IsLoaded())
+                InitShaderShadowDepthClear();
+            shader = _shaderShadowDepthClear;
+            break;
         default:
             TE_ASSERT_ERROR(false, "Can't find \"" + ToString((UINT32)type) + "\" shader.")
             break;
@@ -500,6 +510,26 @@ namespace te
             _pixelShaderDecalDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
             _pixelShaderDecalDesc.Source = shaderFile.GetAsString();
         }
+
+        {
+            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/ShadowDepth_VS.hlsl"));
+            _vertexShaderShadowDepthDesc.Type = GPT_VERTEX_PROGRAM;
+            _vertexShaderShadowDepthDesc.FilePath = SHADERS_FOLDER + String("HLSL/ShadowDepth_VS.hlsl");
+            _vertexShaderShadowDepthDesc.EntryPoint = "main";
+            _vertexShaderShadowDepthDesc.Language = "hlsl";
+            _vertexShaderShadowDepthDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
+            _vertexShaderShadowDepthDesc.Source = shaderFile.GetAsString();
+        }
+
+        {
+            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/ShadowDepth_PS.hlsl"));
+            _pixelShaderShadowDepthDesc.Type = GPT_PIXEL_PROGRAM;
+            _pixelShaderShadowDepthDesc.FilePath = SHADERS_FOLDER + String("HLSL/ShadowDepth_PS.hlsl");
+            _pixelShaderShadowDepthDesc.EntryPoint = "main";
+            _pixelShaderShadowDepthDesc.Language = "hlsl";
+            _pixelShaderShadowDepthDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
+            _pixelShaderShadowDepthDesc.Source = shaderFile.GetAsString();
+        }
     }
     void BuiltinResources::InitStates()
     {
@@ -989,6 +1019,58 @@ namespace te
         _shaderDecal = Shader::Create("Decal", shaderDesc);
     }
 
+    void BuiltinResources::InitShaderShadowDepth()
+    {
+        PASS_DESC passDesc;
+        passDesc.BlendStateDesc = _blendOpaqueStateDesc;
+        passDesc.DepthStencilStateDesc = _depthStencilStateDesc;
+        passDesc.RasterizerStateDesc = _rasterizerStateDesc;
+        passDesc.VertexProgramDesc = _vertexShaderShadowDepthDesc;
+        passDesc.PixelProgramDesc = _pixelShaderShadowDepthDesc;
+
+        // Both faces are rendered, so closed meshes don't leak light whatever their winding
+        passDesc.RasterizerStateDesc.cullMode = CullingMode::CULL_NONE;
+        passDesc.RasterizerStateDesc.multisampleEnable = false;
+        passDesc.RasterizerStateDesc.slopeScaledDepthBias = 1.5f;
+        passDesc.DepthStencilStateDesc.DepthComparisonFunc = CMPF_LESS;
+        passDesc.DepthStencilStateDesc.StencilEnable = false;
+
+        SPtr<Pass> pass = Pass::Create(passDesc);
+        SPtr<Technique> technique = Technique::Create("hlsl", { pass });
+        technique->Compile();
+
+        SHADER_DESC shaderDesc = _shadowDepthShaderDesc;
+        shaderDesc.QueueType = QueueSortType::FrontToBack;
+        shaderDesc.Techniques.push_back(technique);
+
+        _shaderShadowDepth = Shader::Create("ShadowDepth", shaderDesc);
+    }
+
+    void BuiltinResources::InitShaderShadowDepthClear()
+    {
+        PASS_DESC passDesc;
+        passDesc.BlendStateDesc = _blendOpaqueStateDesc;
+        passDesc.DepthStencilStateDesc = _depthStencilStateDesc;
+        passDesc.RasterizerStateDesc = _rasterizerStateDesc;
+        passDesc.VertexProgramDesc = _vertexShaderShadowDepthDesc;
+        passDesc.PixelProgramDesc = _pixelShaderShadowDepthDesc;
+
+        passDesc.RasterizerStateDesc.cullMode = CullingMode::CULL_NONE;
+        passDesc.RasterizerStateDesc.multisampleEnable = false;
+        passDesc.DepthStencilStateDesc.DepthComparisonFunc = CMPF_ALWAYS_PASS;
+        passDesc.DepthStencilStateDesc.StencilEnable = false;
+
+        SPtr<Pass> pass = Pass::Create(passDesc);
+        SPtr<Technique> technique = Technique::Create("hlsl", { pass });
+        technique->Compile();
+
+        SHADER_DESC shaderDesc = _shadowDepthShaderDesc;
+        shaderDesc.QueueType = QueueSortType::None;
+        shaderDesc.Techniques.push_back(technique);
+
+        _shaderShadowDepthClear = Shader::Create("ShadowDepthClear", shaderDesc);
+    }
+
     void BuiltinResources::InitDefaultMaterial()
     {
         MaterialProperties properties;
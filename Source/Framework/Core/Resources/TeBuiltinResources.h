@@ -59,6 +59,10 @@ namespace te
         PreviewOpaque = 0x13,
         /** Shader used for material's preview for transparent objects */
         PreviewTransparent = 0x14,
+        /** Shader used to render shadow casters into shadow maps */
+        ShadowDepth = 0x15,
+        /** Shader used to clear an area of a shadow map to the farthest depth */
+        ShadowDepthClear = 0x16,
     };
 
     /** Types of builtin shaders that are always available. */
@@ -131,6 +135,8 @@ namespace te
         void InitShaderSSAOBlur();
         void InitShaderSSAODownSample();
         void InitShaderDecal();
+        void InitShaderShadowDepth();
+        void InitShaderShadowDepthClear();
 
         void InitDefaultMaterial();
 
@@ -156,6 +162,8 @@ namespace te
         HShader _shaderSSAOBlur;
         HShader _shaderSSAODownSample;
         HShader _shaderDecal;
+        HShader _shaderShadowDepth;
+        HShader _shaderShadowDepthClear;
 
         SPtr<SamplerState> _anisotropicSamplerState = nullptr;
         SPtr<SamplerState> _bilinearSamplerState = nullptr;
@@ -176,6 +184,7 @@ namespace te
         SHADER_DESC _ssaoBlurShaderDesc;
         SHADER_DESC _ssaoDownSampleShaderDesc;
         SHADER_DESC _decalShaderDesc;
+        SHADER_DESC _shadowDepthShaderDesc;
 
         GPU_PROGRAM_DESC _vertexShaderForwardDesc;
         GPU_PROGRAM_DESC _pixelShaderForwardDesc;
@@ -227,6 +236,9 @@ namespace te
         GPU_PROGRAM_DESC _vertexShaderDecalDesc;
         GPU_PROGRAM_DESC _pixelShaderDecalDesc;
 
+        GPU_PROGRAM_DESC _vertexShaderShadowDepthDesc;
+        GPU_PROGRAM_DESC _pixelShaderShadowDepthDesc;
+
         BLEND_STATE_DESC _blendOpaqueStateDesc;
         BLEND_STATE_DESC _blendTransparentStateDesc;
 
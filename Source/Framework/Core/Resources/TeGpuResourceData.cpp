@@ -28,10 +28,11 @@ namespace te
 
     void GpuResourceData::SetData(UPtr<UINT8[]> &data)
     {
-        FreeInternalBuffer();
+        // Data was allocated with new[] so it can't be adopted and released with te_free, copy it instead
+        AllocateInternalBuffer();
+        memcpy(_data, data.get(), GetInternalBufferSize());
 
-        _data = data.release();
-        _ownsData = true;
+        data.reset();
     }
 
     void GpuResourceData::AllocateInternalBuffer()
@@ -43,7 +44,7 @@ namespace te
     {
         FreeInternalBuffer();
 
-        _data = (UINT8*)te_allocate(size);
+        _data = (UINT8*)MemoryAllocator::Allocate(size, GetMemoryCategory());
         _ownsData = true;
     }
 
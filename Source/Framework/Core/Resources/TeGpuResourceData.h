@@ -32,7 +32,8 @@ namespace te
         UINT8* GetData() const;
 
         /**
-         * Sets the internal pointer to point at provided data. GpuResourceData takes ownership of provided memory.
+         * Replaces the internal buffer with a copy of the provided data, which is released. Provided data must be at
+         * least as large as the internal buffer.
          * @note If any internal data is allocated, it is freed.
          */
         void SetData(UPtr<UINT8[]> &data);
@@ -73,6 +74,9 @@ namespace te
          */
         virtual UINT32 GetInternalBufferSize() const = 0;
 
+        /** Returns the category the internal buffer is accounted under. See MemoryStats. */
+        virtual MemoryCategory GetMemoryCategory() const { return MemoryCategory::General; }
+
     private:
         UINT8* _data = nullptr;
         bool _ownsData = false;
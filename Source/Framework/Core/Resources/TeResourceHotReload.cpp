@@ -0,0 +1,489 @@
+#include "Resources/TeResourceHotReload.h"
+#include "Resources/TeResourceManager.h"
+#include "Importer/TeImporter.h"
+#include "Material/TeMaterial.h"
+#include "Material/TeShader.h"
+#include "Mesh/TeMesh.h"
+#include "Image/TeTexture.h"
+#include "Scene/TeSceneManager.h"
+#include "Components/TeCRenderable.h"
+#include "Utility/TeDataStream.h"
+#include "Utility/TeTime.h"
+
+#include <filesystem>
+
+using namespace std::placeholders;
+
+namespace te
+{
+    TE_MODULE_STATIC_MEMBER(ResourceHotReload)
+
+    namespace
+    {
+        /** Extensions of the shader sources whose #include directives are followed. */
+        const UnorderedSet<String> INCLUDE_EXTENSIONS =
+        {
+            "shader", "hlsl", "hlsli", "glsl", "fx", "fxh", "vert", "frag", "geom", "comp", "inc"
+        };
+
+        /** Returns the absolute path of a file, in the same form as the ResourceManager. */
+        String GetAbsolutePath(const String& filePath)
+        {
+            std::error_code e;
+            auto path = std::filesystem::weakly_canonical(filePath, e);
+            return path.generic_string();
+        }
+
+        /** Resolves a path referenced from a file, relative to the folder of that file. */
+        String ResolveReference(const String& filePath, const String& reference)
+        {
+            return GetAbsolutePath((std::filesystem::path(filePath).parent_path() / reference).generic_string());
+        }
+
+        /** Returns the lower case extension of a file, without the dot. */
+        String GetExtension(const String& filePath)
+        {
+            String extension = std::filesystem::path(filePath).extension().generic_string();
+            if (!extension.empty())
+                extension.erase(0, 1);
+
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                [](unsigned char c) -> unsigned char { return static_cast<unsigned char>(std::tolower(c)); });
+
+            return extension;
+        }
+
+        /** Returns the string between the first pair of double quotes found from @p start, or an empty string. */
+        String ReadQuoted(const String& content, size_t start, size_t end)
+        {
+            const size_t open = content.find('"', start);
+            if (open == String::npos || open >= end)
+                return String();
+
+            const size_t close = content.find('"', open + 1);
+            if (close == String::npos || close >= end)
+                return String();
+
+            return content.substr(open + 1, close - open - 1);
+        }
+
+        /** Finds the files referenced by the content of a file, for the file types that can reference others. */
+        void ScanReferences(const String& filePath, const String& content, Vector<String>& references)
+        {
+            const String extension = GetExtension(filePath);
+            const bool followIncludes = INCLUDE_EXTENSIONS.find(extension) != INCLUDE_EXTENSIONS.end();
+
+            if (!followIncludes && extension != "obj" && extension != "mtl")
+                return;
+
+            // Program sources of .shader files, which are json documents
+            if (extension == "shader")
+            {
+                for (size_t pos = content.find("\"path\""); pos != String::npos; pos = content.find("\"path\"", pos + 1))
+                {
+                    const size_t separator = content.find(':', pos + 6);
+                    if (separator == String::npos)
+                        break;
+
+                    const String reference = ReadQuoted(content, separator + 1, content.find_first_of(",}", separator));
+                    if (!reference.empty())
+                        references.push_back(ResolveReference(filePath, reference));
+                }
+            }
+
+            size_t lineStart = 0;
+            while (lineStart < content.size())
+            {
+                size_t lineEnd = content.find('\n', lineStart);
+                if (lineEnd == String::npos)
+                    lineEnd = content.size();
+
+                const size_t first = content.find_first_not_of(" \t", lineStart);
+                if (first != String::npos && first < lineEnd)
+                {
+                    auto startsWith = [&](const char* token)
+                    {
+                        return content.compare(first, strlen(token), token) == 0;
+                    };
+
+                    String reference;
+                    if (followIncludes && startsWith("#include"))
+                    {
+                        reference = ReadQuoted(content, first, lineEnd);
+                    }
+                    else if ((extension == "obj" && startsWith("mtllib ")) ||
+                        (extension == "mtl" && (startsWith("map_") || startsWith("bump ") || startsWith("norm "))))
+                    {
+                        // Last token of the line, options may come first
+                        const size_t last = content.find_last_not_of(" \t\r", lineEnd - 1);
+                        if (last != String::npos && last >= first)
+                        {
+                            const size_t tokenStart = content.find_last_of(" \t", last) + 1;
+                            reference = content.substr(tokenStart, last - tokenStart + 1);
+                        }
+                    }
+
+                    if (!reference.empty())
+                        references.push_back(ResolveReference(filePath, reference));
+                }
+
+                lineStart = lineEnd + 1;
+            }
+        }
+    }
+
+    void ResourceHotReload::OnStartUp()
+    {
+        _fileImportedConn = gResourceManager().OnFileImported.Connect(
+            std::bind(&ResourceHotReload::OnFileImported, this, _1));
+
+        _folderMonitor.OnAdded.Connect(std::bind(&ResourceHotReload::OnFileChanged, this, _1));
+        _folderMonitor.OnModified.Connect(std::bind(&ResourceHotReload::OnFileChanged, this, _1));
+        _folderMonitor.OnRenamed.Connect(std::bind(&ResourceHotReload::OnFileChanged, this, _2));
+    }
+
+    void ResourceHotReload::OnShutDown()
+    {
+        _fileImportedConn.Disconnect();
+        _folderMonitor.StopMonitorAll();
+
+        for (auto& scan : _scans)
+            scan->ScanTask->Wait();
+
+        _scans.clear();
+        _importQueue.clear();
+        _importedFiles.clear();
+        DestroyReplaced(true);
+    }
+
+    void ResourceHotReload::Update()
+    {
+        Vector<String> importedFiles;
+        {
+            Lock lock(_importedFilesMutex);
+            std::swap(importedFiles, _importedFiles);
+        }
+
+        for (auto& filePath : importedFiles)
+        {
+            WatchFolderOf(filePath);
+
+            // Reads the file once to know its content and what it references, unless that's already known or being read
+            const bool scanning = std::find_if(_scans.begin(), _scans.end(),
+                [&filePath](const SPtr<FileScan>& scan) { return scan->FilePath == filePath; }) != _scans.end();
+
+            if (!scanning && _contentHashes.find(filePath) == _contentHashes.end())
+                Scan(filePath, false);
+        }
+
+        _folderMonitor.Update();
+
+        // Files that stopped changing long enough are read again, unless they are still being read
+        const float time = gTime().GetTime();
+        for (auto iter = _pendingChanges.begin(); iter != _pendingChanges.end();)
+        {
+            const bool scanning = std::find_if(_scans.begin(), _scans.end(),
+                [&iter](const SPtr<FileScan>& scan) { return scan->FilePath == iter->first; }) != _scans.end();
+
+            if (time - iter->second >= _debounceDelay && !scanning)
+            {
+                Scan(iter->first, true);
+                iter = _pendingChanges.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        // Completing a scan can start new ones
+        Vector<SPtr<FileScan>> completedScans;
+        for (auto iter = _scans.begin(); iter != _scans.end();)
+        {
+            if ((*iter)->ScanTask->IsComplete())
+            {
+                completedScans.push_back(*iter);
+                iter = _scans.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        for (auto& scan : completedScans)
+            CompleteScan(*scan);
+
+        const UINT32 numImports = std::min((UINT32)_importQueue.size(), _maxImportsPerFrame);
+        for (UINT32 i = 0; i < numImports; i++)
+            Reload(_importQueue[i]);
+
+        _importQueue.erase(_importQueue.begin(), _importQueue.begin() + numImports);
+
+        DestroyReplaced(false);
+    }
+
+    void ResourceHotReload::AddDependency(const String& dependent, const String& dependency)
+    {
+        const String dependencyPath = GetAbsolutePath(dependency);
+
+        _declaredDependencies[GetAbsolutePath(dependent)].insert(dependencyPath);
+        WatchFolderOf(dependencyPath);
+
+        if (_contentHashes.find(dependencyPath) == _contentHashes.end())
+            Scan(dependencyPath, false);
+    }
+
+    void ResourceHotReload::RemoveDependencies(const String& dependent)
+    {
+        _declaredDependencies.erase(GetAbsolutePath(dependent));
+    }
+
+    void ResourceHotReload::OnFileImported(const String& filePath)
+    {
+        Lock lock(_importedFilesMutex);
+        _importedFiles.push_back(filePath);
+    }
+
+    void ResourceHotReload::OnFileChanged(const String& filePath)
+    {
+        // Only files that have been imported or are referenced by one are followed, the others are never read
+        const String absolutePath = GetAbsolutePath(filePath);
+        if (_contentHashes.find(absolutePath) != _contentHashes.end())
+            _pendingChanges[absolutePath] = gTime().GetTime();
+    }
+
+    void ResourceHotReload::Scan(const String& filePath, bool changed)
+    {
+        SPtr<FileScan> scan = te_shared_ptr_new<FileScan>();
+        scan->FilePath = filePath;
+        scan->Changed = changed;
+
+        scan->ScanTask = Task::Create("ResourceHotReload", [scan]()
+        {
+            std::error_code e;
+            if (!std::filesystem::is_regular_file(scan->FilePath, e))
+                return;
+
+            FileStream file(scan->FilePath);
+            if (file.Fail())
+                return;
+
+            String content(file.Size(), '\0');
+            if (!content.empty())
+                file.Read(&content[0], content.size());
+
+            scan->Exists = true;
+            scan->Hash = std::hash<String>()(content);
+            ScanReferences(scan->FilePath, content, scan->Dependencies);
+        });
+
+        _scans.push_back(scan);
+        gTaskScheduler().AddTask(scan->ScanTask);
+    }
+
+    void ResourceHotReload::CompleteScan(FileScan& scan)
+    {
+        if (!scan.Exists)
+            return;
+
+        auto iterHash = _contentHashes.find(scan.FilePath);
+        const bool modified = iterHash == _contentHashes.end() || iterHash->second != scan.Hash;
+        _contentHashes[scan.FilePath] = scan.Hash;
+
+        if (!modified)
+            return;
+
+        // Referenced files are scanned as well, so changes to the files they reference are followed too
+        for (auto& dependency : scan.Dependencies)
+        {
+            WatchFolderOf(dependency);
+
+            const bool scanning = std::find_if(_scans.begin(), _scans.end(),
+                [&dependency](const SPtr<FileScan>& other) { return other->FilePath == dependency; }) != _scans.end();
+
+            if (!scanning && _contentHashes.find(dependency) == _contentHashes.end())
+                Scan(dependency, false);
+        }
+
+        _scannedDependencies[scan.FilePath] = std::move(scan.Dependencies);
+
+        if (scan.Changed)
+            QueueImports(scan.FilePath);
+    }
+
+    void ResourceHotReload::WatchFolderOf(const String& filePath)
+    {
+        const String folder = std::filesystem::path(filePath).parent_path().generic_string();
+
+        std::error_code e;
+        if (folder.empty() || !std::filesystem::is_directory(folder, e))
+            return;
+
+        if (!_watchedFolders.insert(folder).second)
+            return;
+
+        UINT32 folderChanges = 0;
+        folderChanges |= (UINT32)FolderChangeFlag::FileName;
+        folderChanges |= (UINT32)FolderChangeFlag::FileWrite;
+
+        _folderMonitor.StartMonitor(folder, false, folderChanges);
+    }
+
+    void ResourceHotReload::QueueImports(const String& filePath)
+    {
+        // Files directly depending on each file
+        UnorderedMap<String, Vector<String>> dependents;
+        for (auto& entry : _scannedDependencies)
+        {
+            for (auto& dependency : entry.second)
+                dependents[dependency].push_back(entry.first);
+        }
+
+        for (auto& entry : _declaredDependencies)
+        {
+            for (auto& dependency : entry.second)
+                dependents[dependency].push_back(entry.first);
+        }
+
+        // The changed file and everything depending on it, breadth first so a file is imported after those it uses
+        Vector<String> affected = { filePath };
+        UnorderedSet<String> visited = { filePath };
+
+        for (size_t i = 0; i < affected.size(); i++)
+        {
+            auto iterFind = dependents.find(affected[i]);
+            if (iterFind == dependents.end())
+                continue;
+
+            for (auto& dependent : iterFind->second)
+            {
+                if (visited.insert(dependent).second)
+                    affected.push_back(dependent);
+            }
+        }
+
+        for (auto& affectedPath : affected)
+        {
+            SPtr<const ImportOptions> options;
+            bool importAll;
+
+            // Files that aren't loaded, such as included sources, only link the others
+            if (!gResourceManager().GetImportInfo(affectedPath, options, importAll))
+                continue;
+
+            auto iterQueued = std::find(_importQueue.begin(), _importQueue.end(), affectedPath);
+            if (iterQueued != _importQueue.end())
+                _importQueue.erase(iterQueued);
+
+            _importQueue.push_back(affectedPath);
+        }
+    }
+
+    void ResourceHotReload::Reload(const String& filePath)
+    {
+        SPtr<const ImportOptions> options;
+        bool importAll;
+
+        if (!gResourceManager().GetImportInfo(filePath, options, importAll))
+            return;
+
+        Vector<SubResourceRaw> resources;
+        if (importAll)
+        {
+            resources = gImporter()._importAll(filePath, options);
+        }
+        else
+        {
+            SPtr<Resource> resource = gImporter()._import(filePath, options);
+            if (resource != nullptr)
+                resources.push_back({ u8"primary", resource });
+        }
+
+        if (resources.empty())
+        {
+            TE_LOG(Warning, "Resource", "Failed to reload " << filePath << ", keeping the previous import");
+            return;
+        }
+
+        Vector<std::pair<SPtr<Resource>, SPtr<Resource>>> replaced;
+        gResourceManager()._reload(filePath, resources, replaced);
+
+        for (auto& entry : replaced)
+        {
+            Rebind(entry.first, entry.second);
+            _replaced.push_back(entry.first);
+        }
+
+        // Sub-resources that didn't replace anything aren't referenced by anyone
+        for (auto& entry : resources)
+        {
+            if (entry.Res.use_count() == 1)
+                entry.Res->Destroy();
+        }
+
+        OnReloaded(filePath);
+    }
+
+    void ResourceHotReload::Rebind(const SPtr<Resource>& replaced, const SPtr<Resource>& resource)
+    {
+        const UINT32 type = resource->GetCoreType();
+
+        if (type == TypeID_Core::TID_Texture || type == TypeID_Core::TID_Shader)
+        {
+            for (auto& materialHandle : gResourceManager().FindByType(TypeID_Core::TID_Material))
+            {
+                SPtr<Material> material = std::static_pointer_cast<Material>(materialHandle.GetInternalPtr());
+                SPtr<Shader> shader = material->GetShader();
+
+                if (shader == nullptr)
+                    continue;
+
+                if (type == TypeID_Core::TID_Shader)
+                {
+                    if (shader == replaced)
+                        material->SetShader(std::static_pointer_cast<Shader>(resource));
+
+                    continue;
+                }
+
+                for (auto& param : shader->GetTextureParams())
+                {
+                    if (material->GetTexture(param.first) == replaced)
+                        material->SetTexture(param.first, std::static_pointer_cast<Texture>(resource));
+                }
+            }
+        }
+        else if (type == TypeID_Core::TID_Mesh)
+        {
+            for (auto& renderable : gSceneManager().FindComponents<CRenderable>())
+            {
+                if (renderable->GetMesh() == replaced)
+                    renderable->SetMesh(std::static_pointer_cast<Mesh>(resource));
+            }
+        }
+    }
+
+    void ResourceHotReload::DestroyReplaced(bool force)
+    {
+        for (auto iter = _replaced.begin(); iter != _replaced.end();)
+        {
+            if (force || iter->use_count() == 1)
+            {
+                if (!(*iter)->IsDestroyed())
+                    (*iter)->Destroy();
+
+                iter = _replaced.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    ResourceHotReload& gResourceHotReload()
+    {
+        return ResourceHotReload::Instance();
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TeModule.h"
+#include "Utility/TeEvent.h"
+#include "Importer/TeBaseImporter.h"
+#include "Platform/TeFolderMonitor.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Threading/TeThreading.h"
+
+namespace te
+{
+    /**
+     * Imports files loaded through the ResourceManager again when they change on disk, and swaps the new resources in
+     * through ResourceManager::Update() so existing handles point to them. Materials and renderables, which keep
+     * pointers rather than handles, are pointed to the new textures, shaders and meshes as well.
+     *
+     * The folder of each imported file is monitored. Changes are debounced: a file is only looked at once it hasn't
+     * changed for GetDebounceDelay() seconds, which absorbs the burst of notifications editors produce when saving. It is
+     * then read on a worker thread, and ignored if its content didn't actually change. Otherwise the file and all the
+     * loaded files depending on it, directly or not, are imported again.
+     *
+     * Dependencies are found by scanning text sources: #include directives of shader sources, program paths of .shader
+     * files and material libraries of .obj files. Others, such as a material using textures or a prefab using meshes,
+     * can be declared with AddDependency().
+     *
+     * Importers create GPU resources, which the render APIs and the CoreObjectManager only allow from the main thread,
+     * so imports themselves run in Update(), at most GetMaxImportsPerFrame() per frame.
+     *
+     * Only started when START_UP_DESC::HotReload is set.
+     */
+    class TE_CORE_EXPORT ResourceHotReload : public Module<ResourceHotReload>
+    {
+    public:
+        TE_MODULE_STATIC_HEADER_MEMBER(ResourceHotReload)
+
+        ResourceHotReload() = default;
+        ~ResourceHotReload() = default;
+
+        /** @copydoc Module::OnStartUp */
+        void OnStartUp() override;
+
+        /** @copydoc Module::OnShutDown */
+        void OnShutDown() override;
+
+        /**
+         * Processes file changes, imports changed files again and swaps them in. Must be called once per frame from the
+         * main thread, while nothing is being rendered.
+         */
+        void Update();
+
+        /**
+         * Declares that @p dependent must be imported again whenever @p dependency changes. Both are file paths, the
+         * folder of @p dependency is monitored.
+         */
+        void AddDependency(const String& dependent, const String& dependency);
+
+        /** Removes the dependencies declared with AddDependency() for @p dependent. */
+        void RemoveDependencies(const String& dependent);
+
+        /** Sets how long, in seconds, a file must stay unchanged before it is imported again. */
+        void SetDebounceDelay(float seconds) { _debounceDelay = std::max(seconds, 0.0f); }
+
+        /** @copydoc SetDebounceDelay */
+        float GetDebounceDelay() const { return _debounceDelay; }
+
+        /** Sets how many files may be imported again during a single Update(). */
+        void SetMaxImportsPerFrame(UINT32 count) { _maxImportsPerFrame = std::max(count, 1U); }
+
+        /** @copydoc SetMaxImportsPerFrame */
+        UINT32 GetMaxImportsPerFrame() const { return _maxImportsPerFrame; }
+
+        /** Triggered once the resources of a file have been swapped. Provides the absolute path of the file. */
+        Event<void(const String&)> OnReloaded;
+
+        /** Default value of SetDebounceDelay(). */
+        static constexpr float DEFAULT_DEBOUNCE_DELAY = 0.3f;
+
+    private:
+        /** Content of a file read by a worker thread. */
+        struct FileScan
+        {
+            String FilePath;
+            bool Exists = false;
+            size_t Hash = 0;
+            Vector<String> Dependencies;
+            bool Changed = false; // Reported by the folder monitor, as opposed to scanned on import or discovery
+            SPtr<Task> ScanTask;
+        };
+
+        /**
+         * Triggered by the ResourceManager when a file is imported, possibly from a worker thread. The file is only
+         * queued, and picked up by the next Update().
+         */
+        void OnFileImported(const String& filePath);
+
+        /** Triggered by the folder monitor when a file is added, modified or renamed. */
+        void OnFileChanged(const String& filePath);
+
+        /** Queues a worker thread read of a file. */
+        void Scan(const String& filePath, bool changed);
+
+        /** Applies the result of a completed scan. */
+        void CompleteScan(FileScan& scan);
+
+        /** Starts monitoring the folder containing a file. */
+        void WatchFolderOf(const String& filePath);
+
+        /** Queues the import of @p filePath and of the loaded files depending on it. */
+        void QueueImports(const String& filePath);
+
+        /** Imports a file again and swaps the result in. */
+        void Reload(const String& filePath);
+
+        /** Points the materials and renderables using a replaced resource to the resource replacing it. */
+        void Rebind(const SPtr<Resource>& replaced, const SPtr<Resource>& resource);
+
+        /** Destroys the resources that have been replaced, once nothing else references them. */
+        void DestroyReplaced(bool force);
+
+    private:
+        FolderMonitor _folderMonitor;
+        UnorderedSet<String> _watchedFolders;
+        HEvent _fileImportedConn;
+
+        Mutex _importedFilesMutex;
+        Vector<String> _importedFiles; // Imported since the last Update(), guarded by _importedFilesMutex
+
+        UnorderedMap<String, UnorderedSet<String>> _declaredDependencies; // File -> files it depends on
+        UnorderedMap<String, Vector<String>> _scannedDependencies; // File -> files it references
+        UnorderedMap<String, size_t> _contentHashes;
+
+        UnorderedMap<String, float> _pendingChanges; // File -> time of its last change
+        Vector<SPtr<FileScan>> _scans;
+        Vector<String> _importQueue;
+        Vector<SPtr<Resource>> _replaced;
+
+        float _debounceDelay = DEFAULT_DEBOUNCE_DELAY;
+        UINT32 _maxImportsPerFrame = 4;
+    };
+
+    /** Provides easy access to the ResourceHotReload. */
+    TE_CORE_EXPORT ResourceHotReload& gResourceHotReload();
+}
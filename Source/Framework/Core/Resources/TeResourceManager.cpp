@@ -89,6 +89,7 @@ namespace te
                 }
 
                 _resourcesChunks[uuid] = subResourcesUUID;
+                RegisterImport(filePath, options, true);
             }
         }
         else
@@ -279,6 +280,7 @@ namespace te
         auto iterUUID = _UUIDToFile.find(uuid);
         if (iterUUID != _UUIDToFile.end())
         {
+            _fileToImportInfo.erase(iterUUID->second);
             _UUIDToFile.erase(iterUUID);
         }
 
@@ -294,6 +296,87 @@ namespace te
         _loadingResourceMutex.unlock();
     }
 
+    void ResourceManager::RegisterImport(const String& filePath, const SPtr<const ImportOptions>& options, bool importAll)
+    {
+        std::error_code e;
+        auto path = std::filesystem::weakly_canonical(filePath, e);
+        String absolutePath = path.generic_string();
+
+        {
+            RecursiveLock lock(_loadingResourceMutex);
+
+            ImportInfo& info = _fileToImportInfo[absolutePath];
+            info.Options = options;
+            info.ImportAll = importAll;
+        }
+
+        OnFileImported(absolutePath);
+    }
+
+    bool ResourceManager::GetImportInfo(const String& filePath, SPtr<const ImportOptions>& options, bool& importAll)
+    {
+        std::error_code e;
+        auto path = std::filesystem::weakly_canonical(filePath, e);
+        String absolutePath = path.generic_string();
+        RecursiveLock lock(_loadingResourceMutex);
+
+        auto iterFind = _fileToImportInfo.find(absolutePath);
+        if (iterFind == _fileToImportInfo.end())
+            return false;
+
+        options = iterFind->second.Options;
+        importAll = iterFind->second.ImportAll;
+        return true;
+    }
+
+    bool ResourceManager::_reload(const String& filePath, const Vector<SubResourceRaw>& resources,
+        Vector<std::pair<SPtr<Resource>, SPtr<Resource>>>& replaced)
+    {
+        UUID uuid;
+        if (!GetUUIDFromFile(filePath, uuid))
+            return false;
+
+        RecursiveLock lock(_loadingResourceMutex);
+
+        auto replace = [this, &replaced](const UUID& resourceUuid, const SPtr<Resource>& resource)
+        {
+            auto iterFind = _loadedResources.find(resourceUuid);
+            if (iterFind == _loadedResources.end() || resource == nullptr)
+                return;
+
+            HResource handle = iterFind->second.resource.GetNewHandleFromExisting();
+            if (handle.IsLoaded())
+                replaced.push_back(std::make_pair(handle.GetInternalPtr(), resource));
+
+            resource->_UUID = resourceUuid;
+            Update(handle, resource);
+        };
+
+        auto iterChunks = _resourcesChunks.find(uuid);
+        for (auto& entry : resources)
+        {
+            if (entry.Name == "primary")
+            {
+                replace(uuid, entry.Res);
+                continue;
+            }
+
+            if (iterChunks == _resourcesChunks.end())
+                continue;
+
+            for (auto& subResource : iterChunks->second)
+            {
+                if (subResource.Name == entry.Name)
+                {
+                    replace(subResource.Uuid, entry.Res);
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+
     HResource ResourceManager::_createResourceHandle(const SPtr<Resource>& obj)
     {
         UUID uuid = UUIDGenerator::GenerateRandom();
@@ -55,6 +55,7 @@ namespace te
                     uuid = resourceHandle.GetUUID();
                     resourceHandle.GetInternalPtr()->_UUID = uuid;
                     RegisterResource(uuid, filePath);
+                    RegisterImport(filePath, options, false);
                     _loadedResources[uuid] = static_resource_cast<Resource>(resourceHandle);
 
                     return static_resource_cast<T>(Get(uuid));
@@ -76,6 +77,30 @@ namespace te
 
         void Update(HResource& handle, const SPtr<Resource>& resource);
 
+        /**
+         * Retrieves how a file was last imported by Load() or LoadAll().
+         *
+         * @param[in]	filePath	Path of the file.
+         * @param[out]	options		Import options the file was imported with (may be null).
+         * @param[out]	importAll	True if the file was imported with LoadAll().
+         * @return					False if no resource is currently loaded from this file.
+         */
+        bool GetImportInfo(const String& filePath, SPtr<const ImportOptions>& options, bool& importAll);
+
+        /**
+         * Replaces the resources loaded from a file with the result of a new import of the same file, through Update(),
+         * so existing handles point to the new resources. Sub-resources are matched by name, new sub-resources that
+         * didn't exist in the previous import are ignored.
+         *
+         * @param[in]	filePath	Path of the file that was imported again.
+         * @param[in]	resources	Result of the new import, see Importer::_importAll().
+         * @param[out]	replaced	Receives each resource that was replaced, paired with the resource replacing it. Caller
+         *							is responsible for destroying the replaced ones once they are no longer used.
+         * @return					False if no resource is currently loaded from this file.
+         */
+        bool _reload(const String& filePath, const Vector<SubResourceRaw>& resources,
+            Vector<std::pair<SPtr<Resource>, SPtr<Resource>>>& replaced);
+
         void Release(const HResource& resource) 
         { 
             Release((ResourceHandleBase&)resource); 
@@ -113,6 +138,9 @@ namespace te
         /** Called when the internal resource the handle is pointing to has changed. */
         Event<void(const HResource&)> OnResourceModified;
 
+        /** Called when a file has been imported by Load() or LoadAll(). Provides the absolute path of the file. */
+        Event<void(const String&)> OnFileImported;
+
     private:
         friend class ResourceHandleBase;
 
@@ -121,10 +149,21 @@ namespace te
         void RegisterResource(const UUID& uuid, const String& filePath);
         void UnregisterResource(const UUID& uuid);
 
+        /** Remembers how a file has been imported, so it can be imported again the same way. */
+        void RegisterImport(const String& filePath, const SPtr<const ImportOptions>& options, bool importAll);
+
     private:
+        /** How a file was imported. */
+        struct ImportInfo
+        {
+            SPtr<const ImportOptions> Options;
+            bool ImportAll = false;
+        };
+
         UnorderedMap<UUID, LoadedResourceData> _loadedResources;
         UnorderedMap<UUID, String> _UUIDToFile;
         UnorderedMap<String, UUID> _fileToUUID;
+        UnorderedMap<String, ImportInfo> _fileToImportInfo;
 
         // In case we use LoadAll, we need to keep a link between primary 
         // resource (which is linked to a file) and all subresources
@@ -9,6 +9,15 @@ namespace te
 {
     typedef UINT32 ComponentFlags;
 
+    /** Determines if and when SceneManager calls Component::Update() on a component. */
+    enum class ComponentUpdatePhase
+    {
+        None, /**< Update() is never called. Default for components without per-frame logic. */
+        PreUpdate, /**< Update() is called before components from the Update phase. */
+        Update, /**< Update() is called once per frame, after PreUpdate and before PostUpdate components. */
+        PostUpdate /**< Update() is called after components from the Update phase. */
+    };
+
     /**
      * Components represent primary logic elements in the scene. They are attached to scene objects.
      *
@@ -40,9 +49,21 @@ namespace te
         /** */
         virtual void Initialize();
 
-        /** Called once per frame. Only called if the component is in Running state. */
+        /**
+         * Called once per frame, only for components that declared an update phase other than
+         * ComponentUpdatePhase::None (see SetUpdatePhase()).
+         */
         virtual void Update() { }
 
+        /** Returns the phase during which the scene manager calls Update() on this component. */
+        ComponentUpdatePhase GetUpdatePhase() const { return _updatePhase; }
+
+        /**
+         * Returns true if Update() of this component type doesn't depend on other component types and can be
+         * executed on a worker thread, in parallel with the update of other types.
+         */
+        bool IsParallelUpdate() const { return _parallelUpdate; }
+
         /**
          * Calculates bounds of the visible contents represented by this component (for example a mesh for Renderable).
          *
@@ -129,6 +150,21 @@ namespace te
         /** @copydoc Component::Clone */
         bool Clone(const SPtr<Component>& c, const String& suffix = "");
 
+        /**
+         * Checks if WriteProperties() writes everything needed to restore the component from a SceneFile. Components
+         * that can't be saved are left out of saved files, and reported.
+         */
+        virtual bool CanBeSaved() const { return false; }
+
+        /** Writes the properties of the component that must be restored when it is loaded from a SceneFile. */
+        virtual void WriteProperties(DataStream& stream) const { }
+
+        /**
+         * Restores the properties written by WriteProperties(). Called by SceneFile once the component has been added to
+         * its scene object, before it is initialized.
+         */
+        virtual void ReadProperties(DataStream& stream) { }
+
         /** 
          * Called once when the component has been created. Called regardless of the state the component is in. 
          */
@@ -166,6 +202,20 @@ namespace te
         /** Checks whether the component wants to received the specified transform changed message. */
         bool SupportsNotify(TransformChangedFlags flags) const { return ( _notifyFlags & flags) != 0; }
 
+        /**
+         * Declares if and when Update() must be called. Must be called from the constructor, before the component
+         * is registered with the SceneManager. All components of the same type are expected to use the same values.
+         *
+         * @param[in]	phase		Phase during which Update() is called.
+         * @param[in]	parallel	If true, all components of this type are updated on a worker thread, in parallel
+         *							with other types from the same phase.
+         */
+        void SetUpdatePhase(ComponentUpdatePhase phase, bool parallel = false)
+        {
+            _updatePhase = phase;
+            _parallelUpdate = parallel;
+        }
+
         /** Sets an index that uniquely identifies a component with the SceneManager. */
         void SetSceneManagerId(UINT32 id) { _sceneManagerId = id; }
 
@@ -190,11 +240,14 @@ namespace te
     protected:
         friend class SceneManager;
         friend class SceneObject;
+        friend class SceneFile;
 
         HComponent _thisHandle;
         UINT32 _notifyFlags;
         ComponentFlags _flags;
         UINT32 _sceneManagerId;
+        ComponentUpdatePhase _updatePhase = ComponentUpdatePhase::None;
+        bool _parallelUpdate = false;
 
         HSceneObject _parent;
 
@@ -14,9 +14,11 @@ namespace te
     {
         SPtr<GameObject> myPtr = _instanceData->Object;
         UINT64 oldId = _instanceData->InstanceId;
+        UINT32 slotIndex = _instanceData->SlotIndex;
 
         _instanceData = other;
         _instanceData->Object = myPtr;
+        _instanceData->SlotIndex = slotIndex;
 
         GameObjectManager::Instance().RemapId(oldId, _instanceData->InstanceId);
     }
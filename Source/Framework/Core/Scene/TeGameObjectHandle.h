@@ -11,11 +11,12 @@ namespace te
     struct GameObjectInstanceData
     {
         GameObjectInstanceData()
-            : Object(nullptr), InstanceId(0)
+            : Object(nullptr), InstanceId(0), SlotIndex((UINT32)-1)
         { }
 
         SPtr<GameObject> Object;
         UINT64 InstanceId;
+        UINT32 SlotIndex; /**< Index of the object in the GameObjectManager object table, or -1 if not registered. */
     };
 
     typedef SPtr<GameObjectInstanceData> GameObjectInstanceDataPtr;
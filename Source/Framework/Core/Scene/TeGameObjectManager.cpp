@@ -12,19 +12,19 @@ namespace te
 
     GameObjectHandleBase GameObjectManager::GetObjectHandle(UINT64 id) const
     {
-        const auto iterFind = _objects.find(id);
-        if (iterFind != _objects.end())
-            return iterFind->second;
+        const UINT32 slot = FindSlot(id);
+        if (slot != INVALID_SLOT)
+            return GameObjectHandleBase(_slots[slot].HandleData);
 
         return nullptr;
     }
 
     bool GameObjectManager::TryGetObjectHandle(UINT64 id, GameObjectHandleBase& object) const
     {
-        const auto iterFind = _objects.find(id);
-        if (iterFind != _objects.end())
+        const UINT32 slot = FindSlot(id);
+        if (slot != INVALID_SLOT)
         {
-            object = iterFind->second;
+            object = GameObjectHandleBase(_slots[slot].HandleData);
             return true;
         }
 
@@ -33,7 +33,7 @@ namespace te
 
     bool GameObjectManager::ObjectExists(UINT64 id) const
     {
-        return _objects.find(id) != _objects.end();
+        return FindSlot(id) != INVALID_SLOT;
     }
 
     void GameObjectManager::RemapId(UINT64 oldId, UINT64 newId)
@@ -41,13 +41,23 @@ namespace te
         if (oldId == newId)
             return;
 
-        _objects[newId] = _objects[oldId];
-        _objects.erase(oldId);
+        const UINT32 slot = FindSlot(oldId);
+        if (slot == INVALID_SLOT)
+            return;
+
+        ObjectSlot& entry = _slots[slot];
+        if (entry.InstanceId != MakeId(slot, entry.Generation))
+            _remappedIds.erase(entry.InstanceId);
+
+        entry.InstanceId = newId;
+        if (newId != MakeId(slot, entry.Generation))
+            _remappedIds[newId] = slot;
     }
 
     UINT64 GameObjectManager::ReserveId()
     {
-        return _nextAvailableID.fetch_add(1, std::memory_order_relaxed);
+        // Reserved IDs don't reference any slot, so they can never collide with IDs of registered objects
+        return (UINT64)_nextReservedId.fetch_add(1, std::memory_order_relaxed) << 32;
     }
 
     void GameObjectManager::QueueForDestroy(const GameObjectHandleBase& object)
@@ -55,26 +65,50 @@ namespace te
         if (object.IsDestroyed())
             return;
 
-        const UINT64 instanceId = object->GetInstanceId();
-        _queuedForDestroy[instanceId] = object;
+        const UINT32 slot = object._data->Ptr->SlotIndex;
+        if (slot == INVALID_SLOT || _slots[slot].QueuedForDestroy)
+            return;
+
+        _slots[slot].QueuedForDestroy = true;
+        _queuedForDestroy.push_back({ slot, _slots[slot].Generation });
     }
 
     void GameObjectManager::DestroyQueuedObjects()
     {
-        for (auto& objPair : _queuedForDestroy)
-            objPair.second->DestroyInternal(objPair.second, true);
+        // Destruction callbacks are allowed to queue more objects, keep going until nothing is left
+        while (!_queuedForDestroy.empty())
+        {
+            std::swap(_queuedForDestroy, _destroying);
 
-        _queuedForDestroy.clear();
+            for (auto& queued : _destroying)
+            {
+                const ObjectSlot& entry = _slots[queued.Slot];
+
+                // Skip objects already destroyed along with their parent
+                if (entry.Generation != queued.Generation || !entry.QueuedForDestroy)
+                    continue;
+
+                GameObjectHandleBase handle(entry.HandleData);
+                handle->DestroyInternal(handle, true);
+            }
+
+            _destroying.clear();
+        }
     }
 
     GameObjectHandleBase GameObjectManager::RegisterObject(const SPtr<GameObject>& object)
     {
-        const UINT64 id = _nextAvailableID.fetch_add(1, std::memory_order_relaxed);
+        const UINT32 slot = AllocateSlot();
+        const UINT64 id = MakeId(slot, _slots[slot].Generation);
+
         object->Initialize(object, id);
+        object->_instanceData->SlotIndex = slot;
 
         GameObjectHandleBase handle(object);
         {
-            _objects[id] = handle;
+            ObjectSlot& entry = _slots[slot];
+            entry.HandleData = handle._data;
+            entry.InstanceId = id;
         }
 
         return handle;
@@ -82,8 +116,77 @@ namespace te
 
     void GameObjectManager::UnregisterObject(GameObjectHandleBase& object)
     {
-        _objects.erase(object->GetInstanceId());
+        object.ThrowIfDestroyed();
+
+        GameObjectInstanceData* instanceData = object._data->Ptr.get();
+        if (instanceData->SlotIndex != INVALID_SLOT)
+        {
+            FreeSlot(instanceData->SlotIndex);
+            instanceData->SlotIndex = INVALID_SLOT;
+        }
+
         OnDestroyed(static_object_cast<GameObject>(object));
         object.Destroy();
     }
+
+    UINT32 GameObjectManager::FindSlot(UINT64 id) const
+    {
+        const UINT32 slotBits = (UINT32)(id & 0xFFFFFFFF);
+        if (slotBits != 0)
+        {
+            const UINT32 slot = slotBits - 1;
+            if (slot < (UINT32)_slots.size() && _slots[slot].HandleData != nullptr && _slots[slot].InstanceId == id)
+                return slot;
+        }
+
+        if (!_remappedIds.empty())
+        {
+            const auto iterFind = _remappedIds.find(id);
+            if (iterFind != _remappedIds.end())
+                return iterFind->second;
+        }
+
+        return INVALID_SLOT;
+    }
+
+    void GameObjectManager::Reserve(UINT32 count)
+    {
+        // Free slots are recycled first
+        if (count <= (UINT32)_freeSlots.size())
+            return;
+
+        _slots.reserve(_slots.size() + count - _freeSlots.size());
+    }
+
+    UINT32 GameObjectManager::AllocateSlot()
+    {
+        if (!_freeSlots.empty())
+        {
+            const UINT32 slot = _freeSlots.back();
+            _freeSlots.pop_back();
+
+            return slot;
+        }
+
+        _slots.push_back(ObjectSlot());
+        return (UINT32)_slots.size() - 1;
+    }
+
+    void GameObjectManager::FreeSlot(UINT32 slot)
+    {
+        ObjectSlot& entry = _slots[slot];
+
+        if (entry.InstanceId != MakeId(slot, entry.Generation))
+            _remappedIds.erase(entry.InstanceId);
+
+        entry.HandleData = nullptr;
+        entry.InstanceId = 0;
+        entry.QueuedForDestroy = false;
+
+        // Generation 0 is skipped so valid IDs always have their upper bits set
+        if (++entry.Generation == 0)
+            entry.Generation = 1;
+
+        _freeSlots.push_back(slot);
+    }
 }
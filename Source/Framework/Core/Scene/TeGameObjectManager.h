@@ -11,6 +11,11 @@ namespace te
 {
     /**
      * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
+     *
+     * Objects are stored in a slot table: each registered object occupies a slot, and its instance ID encodes the slot
+     * index and the generation of the slot. Resolving an ID is a direct array access followed by an ID comparison,
+     * and slots of destroyed objects get recycled with an incremented generation so stale IDs never resolve to a new
+     * object.
      */
     class TE_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
     {
@@ -79,9 +84,52 @@ namespace te
         /**	Triggered when a game object is being destroyed. */
         Event<void(const HGameObject&)> OnDestroyed;
 
+        /**
+         * Makes room in the object table for @p count more objects, so registering many objects at once doesn't grow
+         * it again and again.
+         */
+        void Reserve(UINT32 count);
+
+        /** Returns the number of currently registered GameObjects. */
+        UINT32 GetNumObjects() const { return (UINT32)(_slots.size() - _freeSlots.size()); }
+
     private:
-        std::atomic<UINT64> _nextAvailableID = { 1 }; // 0 is not a valid ID
-        UnorderedMap<UINT64, GameObjectHandleBase> _objects;
-        UnorderedMap<UINT64, GameObjectHandleBase> _queuedForDestroy;
+        /** Entry in the object table. */
+        struct ObjectSlot
+        {
+            SPtr<GameObjectHandleData> HandleData; /**< Data shared by handles to the object, null if the slot is free. */
+            UINT64 InstanceId = 0;
+            UINT32 Generation = 1;
+            bool QueuedForDestroy = false;
+        };
+
+        /** Object queued for destruction, generation is used to detect if the slot was freed in the meantime. */
+        struct QueuedObject
+        {
+            UINT32 Slot;
+            UINT32 Generation;
+        };
+
+        /** Builds the instance ID of an object stored in the provided slot. */
+        static UINT64 MakeId(UINT32 slot, UINT32 generation) { return ((UINT64)generation << 32) | (UINT64)(slot + 1); }
+
+        /** Returns the index of the slot holding the object with the provided instance ID, or -1 if none. */
+        UINT32 FindSlot(UINT64 id) const;
+
+        /** Returns an unused slot, recycling slots of destroyed objects first. */
+        UINT32 AllocateSlot();
+
+        /** Releases the slot, making any ID referencing it invalid. */
+        void FreeSlot(UINT32 slot);
+
+        static const UINT32 INVALID_SLOT = (UINT32)-1;
+
+        std::atomic<UINT32> _nextReservedId = { 1 };
+        Vector<ObjectSlot> _slots;
+        Vector<UINT32> _freeSlots;
+        UnorderedMap<UINT64, UINT32> _remappedIds; /**< Slots of objects whose ID was remapped to one not encoding it. */
+
+        Vector<QueuedObject> _queuedForDestroy;
+        Vector<QueuedObject> _destroying;
     };
 }
@@ -3,6 +3,7 @@
 #include "TeCoreApplication.h"
 #include "Physics/TePhysics.h"
 #include "Utility/TeFrameAllocator.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
@@ -61,7 +62,9 @@ namespace te
 
     SceneManager::SceneManager()
         : _mainScene(te_shared_ptr_new<SceneInstance>(
-            "Main", SceneObject::CreateInternal("SceneRoot"), gPhysics().CreatePhysicsScene()))
+            "Main", SceneObject::CreateInternal("SceneRoot"),
+            // Physics is optional, headless tools (e.g. benchmarks) don't load any physics plugin
+            Physics::IsStarted() ? gPhysics().CreatePhysicsScene() : nullptr))
     {
         _mainScene->_root->SetScene(_mainScene);
     }
@@ -74,6 +77,7 @@ namespace te
         _mainCameras.clear();
         _cameras.clear();
         _components.clear();
+        _transformSystem.Clear();
         _mainRTResizedConn.Disconnect();
     }
 
@@ -126,6 +130,7 @@ namespace te
         _mainScene->_root = root;
         _mainScene->_root->_setParent(HSceneObject());
         _mainScene->_root->SetScene(_mainScene);
+        _transformSystem.NotifyHierarchyChanged();
 
         oldRoot->Destroy();
     }
@@ -239,10 +244,26 @@ namespace te
         }
     }
 
+    void SceneManager::SetBatchedTransforms(bool enabled)
+    {
+        // Make sure nothing stays pending once changes are propagated immediately again
+        if (!enabled)
+            UpdateTransforms();
+
+        _transformSystem.SetEnabled(enabled);
+    }
+
+    void SceneManager::UpdateTransforms()
+    {
+        _transformSystem.Update(_mainScene->GetRoot());
+    }
+
     void SceneManager::NotifyComponentCreated(const HComponent& component)
     {
         component->OnCreated();
         _components.push_back(component);
+
+        RegisterForUpdate(component.Get());
     }
 
     void SceneManager::NotifyComponentActivated(const HComponent& component, bool triggerEvent)
@@ -269,6 +290,8 @@ namespace te
 
         component->OnDestroyed();
 
+        UnregisterFromUpdate(component.Get());
+
         // TODO immediate not used here as every destruction is automatically immediate
         auto co = std::find(_components.begin(), _components.end(), component);
         if (co != _components.end())
@@ -282,13 +305,168 @@ namespace te
         return component->GetCoreType() == id;
     }
 
-    void SceneManager::Update()
+    void SceneManager::RegisterForUpdate(Component* component)
     {
-        for (auto& entry : _components)
+        if (component->GetUpdatePhase() == ComponentUpdatePhase::None)
+            return;
+
+        // Adding a list or growing one would invalidate the lists and entries being iterated, on this thread and on
+        // the workers updating parallel types. The component is added once all phases are updated, and its first
+        // update happens on the next frame
+        if (_isUpdatingComponents)
         {
-            entry->Update();
+            _pendingUpdateComponents.push_back(component);
+            return;
         }
 
+        const UINT32 phaseIdx = (UINT32)component->GetUpdatePhase() - 1;
+        const UINT32 type = component->GetCoreType();
+
+        Vector<ComponentUpdateList>& lists = _updateLists[phaseIdx];
+        UnorderedMap<UINT32, UINT32>& lookup = _updateListLookup[phaseIdx];
+
+        auto iterFind = lookup.find(type);
+        if (iterFind == lookup.end())
+        {
+            ComponentUpdateList list;
+            list.Type = type;
+            list.Parallel = component->IsParallelUpdate();
+
+            iterFind = lookup.insert(std::make_pair(type, (UINT32)lists.size())).first;
+            lists.push_back(std::move(list));
+        }
+
+        Vector<Component*>& components = lists[iterFind->second].Components;
+        component->SetSceneManagerId((UINT32)components.size());
+        components.push_back(component);
+    }
+
+    void SceneManager::UnregisterFromUpdate(Component* component)
+    {
+        if (component->GetUpdatePhase() == ComponentUpdatePhase::None)
+            return;
+
+        auto iterPending = std::find(_pendingUpdateComponents.begin(), _pendingUpdateComponents.end(), component);
+        if (iterPending != _pendingUpdateComponents.end())
+        {
+            _pendingUpdateComponents.erase(iterPending);
+            return;
+        }
+
+        const UINT32 phaseIdx = (UINT32)component->GetUpdatePhase() - 1;
+
+        auto iterFind = _updateListLookup[phaseIdx].find(component->GetCoreType());
+        if (iterFind == _updateListLookup[phaseIdx].end())
+            return;
+
+        ComponentUpdateList& list = _updateLists[phaseIdx][iterFind->second];
+        Vector<Component*>& components = list.Components;
+        const UINT32 idx = component->GetSceneManagerId();
+        if (idx >= components.size() || components[idx] != component)
+            return;
+
+        // Moving entries while the lists are iterated would skip the one moved into the slot, so the entry is only
+        // cleared and the list compacted once all phases are updated
+        if (_isUpdatingComponents)
+        {
+            components[idx] = nullptr;
+            list.HasRemovedComponents = true;
+            return;
+        }
+
+        // Swap with the last entry so the list stays densely packed
+        Component* last = components.back();
+        components[idx] = last;
+        last->SetSceneManagerId(idx);
+        components.pop_back();
+    }
+
+    void SceneManager::UpdatePhase(ComponentUpdatePhase phase)
+    {
+        Vector<ComponentUpdateList>& lists = _updateLists[(UINT32)phase - 1];
+
+        // Parallel types are sent to the task scheduler first, so they run while serial types update on this thread
+        te_frame_mark();
+        {
+            FrameVector<SPtr<Task>> tasks;
+            for (auto& list : lists)
+            {
+                if (!list.Parallel || list.Components.empty())
+                    continue;
+
+                Vector<Component*>* components = &list.Components;
+                SPtr<Task> task = Task::Create("ComponentUpdate", [components]()
+                {
+                    for (UINT32 i = 0; i < (UINT32)components->size(); i++)
+                    {
+                        if ((*components)[i] != nullptr)
+                            (*components)[i]->Update();
+                    }
+                });
+
+                tasks.push_back(task);
+                gTaskScheduler().AddTask(task);
+            }
+
+            for (auto& list : lists)
+            {
+                if (list.Parallel)
+                    continue;
+
+                // Iterate by index on purpose, components are allowed to destroy others (or themselves) while updating
+                for (UINT32 i = 0; i < (UINT32)list.Components.size(); i++)
+                {
+                    if (list.Components[i] != nullptr)
+                        list.Components[i]->Update();
+                }
+            }
+
+            for (auto& task : tasks)
+                task->Wait();
+        }
+        te_frame_clear();
+    }
+
+    void SceneManager::CompactUpdateLists()
+    {
+        for (UINT32 i = 0; i < NUM_UPDATE_PHASES; i++)
+        {
+            for (auto& list : _updateLists[i])
+            {
+                if (!list.HasRemovedComponents)
+                    continue;
+
+                UINT32 count = 0;
+                for (auto& component : list.Components)
+                {
+                    if (component == nullptr)
+                        continue;
+
+                    component->SetSceneManagerId(count);
+                    list.Components[count++] = component;
+                }
+
+                list.Components.resize(count);
+                list.HasRemovedComponents = false;
+            }
+        }
+
+        for (auto& component : _pendingUpdateComponents)
+            RegisterForUpdate(component);
+
+        _pendingUpdateComponents.clear();
+    }
+
+    void SceneManager::Update()
+    {
+        _isUpdatingComponents = true;
+        UpdatePhase(ComponentUpdatePhase::PreUpdate);
+        UpdatePhase(ComponentUpdatePhase::Update);
+        UpdatePhase(ComponentUpdatePhase::PostUpdate);
+        _isUpdatingComponents = false;
+
+        CompactUpdateLists();
+
         GameObjectManager::Instance().DestroyQueuedObjects();
     }
 
@@ -3,6 +3,7 @@
 #include "TeCorePrerequisites.h"
 #include "Utility/TeEvent.h"
 #include "TeSceneObject.h"
+#include "TeSceneTransformSystem.h"
 #include "Physics/TePhysicsCommon.h"
 
 #include <cfloat>
@@ -24,6 +25,18 @@ namespace te
         HSceneObject So;
     };
 
+    /**
+     * Densely packed list of all components of a single type that share the same update phase. Components are updated
+     * list by list so the same Update() implementation runs back to back.
+     */
+    struct ComponentUpdateList
+    {
+        UINT32 Type = 0; /**< Type id of the components in the list. */
+        bool Parallel = false; /**< If true, the whole list is updated on a worker thread. */
+        bool HasRemovedComponents = false; /**< Components removed during an update left null entries behind. */
+        Vector<Component*> Components;
+    };
+
     /** Contains information about an instantiated scene. */
     class TE_CORE_EXPORT SceneInstance
     {
@@ -167,9 +180,42 @@ namespace te
         /**	Notifies the scene manager that a camera either became the main camera, or has stopped being main camera. */
         void _notifyMainCameraStateChanged(const SPtr<Camera>& camera);
 
-        /** Called every frame. Calls update methods on all scene objects and their components. */
+        /**
+         * Called every frame. Calls update methods on all components that declared an update phase, phase by phase
+         * and type by type.
+         */
         void Update();
 
+        /**
+         * Enables or disables batched transform updates. When enabled, transform changes are not propagated to
+         * children and components right away but resolved once per frame (see SceneTransformSystem).
+         */
+        void SetBatchedTransforms(bool enabled);
+
+        /** @copydoc SetBatchedTransforms */
+        bool GetBatchedTransforms() const { return _transformSystem.IsEnabled(); }
+
+        /**
+         * Resolves all pending transform changes when batched transforms are enabled. Called once per frame by the
+         * application, before rendering.
+         */
+        void UpdateTransforms();
+
+        /**
+         * Returns a counter incremented whenever scene objects or components are added to, removed from or moved in the
+         * hierarchy. Lets tools cache views of the hierarchy, and only rebuild them when it changed.
+         */
+        UINT64 GetHierarchyVersion() const { return _hierarchyVersion; }
+
+        /** Increments the hierarchy version. See GetHierarchyVersion(). */
+        void _notifyHierarchyChanged() { _hierarchyVersion++; }
+
+        /** Makes room for @p count more components, before creating many of them at once. */
+        void _reserveComponents(UINT32 count) { _components.reserve(_components.size() + count); }
+
+        /** Returns the system responsible for batched transform updates. */
+        SceneTransformSystem& _getTransformSystem() { return _transformSystem; }
+
         /** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
         void NotifyComponentCreated(const HComponent& component);
 
@@ -210,6 +256,21 @@ namespace te
         /** Checks does the specified component type match the provided id. */
         static bool IsComponentOfType(const HComponent& component, UINT32 id);
 
+        /** Adds the component to the update list matching its type and update phase, if it has one. */
+        void RegisterForUpdate(Component* component);
+
+        /** Removes the component from the update list it was added to by RegisterForUpdate(). */
+        void UnregisterFromUpdate(Component* component);
+
+        /** Calls Update() on all components registered for the provided phase. */
+        void UpdatePhase(ComponentUpdatePhase phase);
+
+        /**
+         * Removes the null entries left in the update lists by components unregistered while updating, and adds the
+         * components registered while updating.
+         */
+        void CompactUpdateLists();
+
     protected:
         SPtr<SceneInstance> _mainScene;
 
@@ -219,8 +280,17 @@ namespace te
 
         Vector<HComponent> _components;
 
+        static const UINT32 NUM_UPDATE_PHASES = (UINT32)ComponentUpdatePhase::PostUpdate;
+        Vector<ComponentUpdateList> _updateLists[NUM_UPDATE_PHASES];
+        UnorderedMap<UINT32, UINT32> _updateListLookup[NUM_UPDATE_PHASES];
+        Vector<Component*> _pendingUpdateComponents; // Registered while updating, added once all phases are updated
+        bool _isUpdatingComponents = false;
+
         SPtr<RenderTarget> _mainRenderTarget;
         HEvent _mainRTResizedConn;
+
+        SceneTransformSystem _transformSystem;
+        UINT64 _hierarchyVersion = 0;
     };
 
     template<class T>
@@ -446,6 +446,7 @@ namespace te
                 (*iter)->DestroyInternal(*iter, true);
 
             _children.clear();
+            NotifyHierarchyChanged();
 
             // It's important to remove the elements from the array as soon as they're destroyed, as OnDestroy callbacks
             // for components might query the SO's components, and we want to only return live ones
@@ -470,6 +471,8 @@ namespace te
 
     const Transform& SceneObject::GetTransform() const
     {
+        SyncPendingTransforms();
+
         if (!IsCachedWorldTfrmUpToDate())
             UpdateWorldTfrm();
 
@@ -564,6 +567,8 @@ namespace te
 
     const Matrix4& SceneObject::GetWorldMatrix() const
     {
+        SyncPendingTransforms();
+
         if (!IsCachedWorldTfrmUpToDate())
             UpdateWorldTfrm();
 
@@ -572,6 +577,8 @@ namespace te
 
     Matrix4 SceneObject::GetInvWorldMatrix() const
     {
+        SyncPendingTransforms();
+
         if (!IsCachedWorldTfrmUpToDate())
             UpdateWorldTfrm();
 
@@ -704,6 +711,7 @@ namespace te
 
             (*iter)->DestroyInternal(*iter, immediate);
             _components.erase(iter);
+            NotifyComponentsChanged();
         }
         else
         {
@@ -732,6 +740,28 @@ namespace te
     }
 
     void SceneObject::NotifyTransformChanged(TransformChangedFlags flags) const
+    {
+        if (IsTransformBatched())
+            gSceneManager()._getTransformSystem().QueueTransformChanged(*this, flags);
+        else
+            PropagateTransformChanged(flags);
+    }
+
+    void SceneObject::PropagateTransformChanged(TransformChangedFlags flags) const
+    {
+        MarkTransformChanged(flags);
+        NotifyComponents(flags);
+
+        // Mobility flag is only relevant for this scene object
+        flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
+        if (flags != 0)
+        {
+            for (auto& entry : _children)
+                entry->PropagateTransformChanged(flags);
+        }
+    }
+
+    TransformChangedFlags SceneObject::MarkTransformChanged(TransformChangedFlags flags) const
     {
         // If object is immovable, don't send transform changed events nor mark the transform dirty
         TransformChangedFlags componentFlags = flags;
@@ -743,6 +773,15 @@ namespace te
             _dirtyHash++;
         }
 
+        return componentFlags;
+    }
+
+    void SceneObject::NotifyComponents(TransformChangedFlags flags) const
+    {
+        TransformChangedFlags componentFlags = flags;
+        if (_mobility != ObjectMobility::Movable)
+            componentFlags = (TransformChangedFlags)(componentFlags & ~TCF_Transform);
+
         // Only send component flags if we haven't removed them all
         if (componentFlags != 0)
         {
@@ -758,16 +797,52 @@ namespace te
                 }
             }
         }
+    }
 
-        // Mobility flag is only relevant for this scene object
-        flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
-        if (flags != 0)
+    bool SceneObject::IsTransformBatched() const
+    {
+        return _parentScene != nullptr && SceneManager::IsStarted() &&
+            gSceneManager()._getTransformSystem().IsEnabled() && _parentScene == gSceneManager().GetMainScene();
+    }
+
+    void SceneObject::SyncPendingTransforms() const
+    {
+        if (!SceneManager::IsStarted())
+            return;
+
+        SceneTransformSystem& transformSystem = gSceneManager()._getTransformSystem();
+        if (!transformSystem.HasPendingChanges() || transformSystem.IsUpdating())
+            return;
+
+        const HSceneObject* parent = &_parent;
+        while (!parent->IsDestroyed())
         {
-            for (auto& entry : _children)
-                entry->NotifyTransformChanged(flags);
+            const SceneObject* parentSO = parent->Get();
+            if (parentSO->_pendingTfrmFlags != 0)
+            {
+                gSceneManager().UpdateTransforms();
+                return;
+            }
+
+            parent = &parentSO->_parent;
         }
     }
 
+    void SceneObject::NotifyHierarchyChanged()
+    {
+        if (SceneManager::IsStarted())
+        {
+            gSceneManager()._getTransformSystem().NotifyHierarchyChanged();
+            gSceneManager()._notifyHierarchyChanged();
+        }
+    }
+
+    void SceneObject::NotifyComponentsChanged()
+    {
+        if (SceneManager::IsStarted())
+            gSceneManager()._notifyHierarchyChanged();
+    }
+
     void SceneObject::UpdateWorldTfrm() const
     {
         _worldTfrm = _localTfrm;
@@ -945,6 +1020,7 @@ namespace te
     void SceneObject::AddChild(const HSceneObject& object)
     {
         _children.push_back(object);
+        NotifyHierarchyChanged();
 
         object->SetFlags(_flags);
     }
@@ -954,7 +1030,10 @@ namespace te
         auto result = find(_children.begin(), _children.end(), object);
 
         if (result != _children.end())
+        {
             _children.erase(result);
+            NotifyHierarchyChanged();
+        }
         else
         {
             TE_ASSERT_ERROR(false, "Trying to remove a child but it's not a child of the transform.");
@@ -1211,6 +1290,7 @@ namespace te
         newComponent->_thisHandle = newComponent;
 
         _components.push_back(newComponent);
+        NotifyComponentsChanged();
     }
 
     bool SceneObject::IsDescendantOf(const HSceneObject& sceneObject)
@@ -1241,6 +1321,7 @@ namespace te
         component->Instantiate();
 
         _components.push_back(component);
+        NotifyComponentsChanged();
 
         gSceneManager().NotifyComponentCreated(component);
     }
@@ -1261,6 +1342,7 @@ namespace te
             if ((*iter)->GetUUID() == component->GetUUID())
             {
                 _components.erase(iter);
+                NotifyComponentsChanged();
                 break;
             }
         }
@@ -1279,6 +1361,9 @@ namespace te
         }
 
         if (!alreadyPresent)
+        {
             _components.push_back(component.GetNewHandleFromExisting());
+            NotifyComponentsChanged();
+        }
     }
 }
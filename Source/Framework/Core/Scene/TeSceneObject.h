@@ -50,6 +50,8 @@ namespace te
         };
 
         friend class SceneManager;
+        friend class SceneTransformSystem;
+        friend class SceneFile;
 
     public:
         virtual ~SceneObject();
@@ -268,11 +270,39 @@ namespace te
 
     private:
         /**
-         * Notifies components and child scene object that a transform has been changed.
+         * Notifies components and child scene object that a transform has been changed. If batched transforms are
+         * enabled in the SceneManager, the change is only recorded and resolved later by the SceneTransformSystem.
          * @param	flags		Specifies in what way was the transform changed.
          */
         void NotifyTransformChanged(TransformChangedFlags flags) const;
 
+        /** Immediately notifies components of this object and recursively all child scene objects of a change. */
+        void PropagateTransformChanged(TransformChangedFlags flags) const;
+
+        /**
+         * Marks cached transforms dirty if the object is movable. Returns the flags components of this object
+         * should be notified with.
+         */
+        TransformChangedFlags MarkTransformChanged(TransformChangedFlags flags) const;
+
+        /** Notifies components of this object (not its children) that the transform has been changed. */
+        void NotifyComponents(TransformChangedFlags flags) const;
+
+        /** Returns true if transform changes of this object are handled by the SceneTransformSystem. */
+        bool IsTransformBatched() const;
+
+        /**
+         * Makes sure changes recorded by the SceneTransformSystem on any of the parents of this object are resolved
+         * before its world transform is used.
+         */
+        void SyncPendingTransforms() const;
+
+        /** Notifies the SceneTransformSystem that a child was added or removed. */
+        static void NotifyHierarchyChanged();
+
+        /** Notifies the SceneManager that a component was added to or removed from an object. */
+        static void NotifyComponentsChanged();
+
         /** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
         void UpdateLocalTfrm() const;
 
@@ -646,6 +676,8 @@ namespace te
 
         mutable UINT32 _dirtyFlags = 0xFFFFFFFF;
         mutable UINT32 _dirtyHash = 0;
+        mutable UINT32 _pendingTfrmFlags = 0;
+        UINT32 _transformSystemId = (UINT32)-1;
 
         HSceneObject _thisHandle;
         UINT32 _flags;
@@ -0,0 +1,199 @@
+#include "Scene/TeSceneTransformSystem.h"
+#include "Scene/TeSceneObject.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Utility/TeFrameAllocator.h"
+
+namespace te
+{
+    void SceneTransformSystem::SetEnabled(bool enabled)
+    {
+        if (_enabled == enabled)
+            return;
+
+        _enabled = enabled;
+        _hierarchyDirty = true;
+    }
+
+    void SceneTransformSystem::QueueTransformChanged(const SceneObject& so, TransformChangedFlags flags)
+    {
+        if (so._pendingTfrmFlags == 0)
+            _pending.push_back(so._thisHandle);
+
+        so._pendingTfrmFlags |= flags;
+
+        // Keep queries on the object itself correct, descendants are resolved in Update()
+        so.MarkTransformChanged(flags);
+    }
+
+    void SceneTransformSystem::Update(const HSceneObject& root)
+    {
+        if (_pending.empty() || _updating || root.IsDestroyed())
+            return;
+
+        _updating = true;
+
+        if (_hierarchyDirty)
+        {
+            Rebuild(root);
+            _hierarchyDirty = false;
+        }
+
+        // Changes queued from component callbacks below will be handled by the next update
+        std::swap(_pending, _processing);
+
+        const UINT32 numObjects = (UINT32)_objects.size();
+        UINT32 firstChanged = numObjects;
+
+        for (auto& handle : _processing)
+        {
+            if (handle.IsDestroyed())
+                continue;
+
+            SceneObject* so = handle.Get();
+            TransformChangedFlags flags = (TransformChangedFlags)so->_pendingTfrmFlags;
+            so->_pendingTfrmFlags = 0;
+
+            UINT32 id = so->_transformSystemId;
+            if (id < numObjects && _objects[id] == so)
+            {
+                _changedFlags[id] |= flags;
+                firstChanged = std::min(firstChanged, id);
+            }
+            else // Not part of the main scene, use the regular path
+                so->PropagateTransformChanged(flags);
+        }
+
+        _processing.clear();
+
+        // Resolve world transforms level by level, objects within a level don't depend on each other
+        UINT32 numLevels = (UINT32)_levels.size() - 1;
+        for (UINT32 i = 0; i < numLevels; i++)
+        {
+            if (_levels[i + 1] <= firstChanged)
+                continue;
+
+            const UINT32 start = std::max(_levels[i], firstChanged);
+            const UINT32 end = _levels[i + 1];
+
+            if (end - start < PARALLEL_CHUNK_SIZE * 2)
+            {
+                UpdateRange(start, end);
+                continue;
+            }
+
+            te_frame_mark();
+            {
+                FrameVector<SPtr<Task>> tasks;
+                for (UINT32 j = start; j < end; j += PARALLEL_CHUNK_SIZE)
+                {
+                    UINT32 chunkEnd = std::min(j + PARALLEL_CHUNK_SIZE, end);
+                    SPtr<Task> task = Task::Create("TransformUpdate", [this, j, chunkEnd]() { UpdateRange(j, chunkEnd); });
+
+                    tasks.push_back(task);
+                    gTaskScheduler().AddTask(task);
+                }
+
+                for (auto& task : tasks)
+                    task->Wait();
+            }
+            te_frame_clear();
+        }
+
+        // Notifications are sent from this thread only, since components talk to the renderer, physics, ...
+        for (UINT32 i = firstChanged; i < numObjects; i++)
+        {
+            TransformChangedFlags flags = (TransformChangedFlags)_changedFlags[i];
+            if (flags == 0)
+                continue;
+
+            _changedFlags[i] = 0;
+
+            // Callbacks are allowed to destroy objects
+            if (_handles[i].IsDestroyed(true))
+                continue;
+
+            _objects[i]->NotifyComponents(flags);
+        }
+
+        _updating = false;
+    }
+
+    void SceneTransformSystem::UpdateRange(UINT32 start, UINT32 end)
+    {
+        for (UINT32 i = start; i < end; i++)
+        {
+            UINT32 flags = _changedFlags[i];
+
+            // Mobility only concerns the object it was set on
+            UINT32 parentIdx = _parents[i];
+            if (parentIdx != (UINT32)-1)
+                flags |= _changedFlags[parentIdx] & ~TCF_Mobility;
+
+            if (flags == 0)
+                continue;
+
+            _changedFlags[i] = flags;
+
+            SceneObject* so = _objects[i];
+            so->MarkTransformChanged((TransformChangedFlags)flags);
+            so->UpdateTransformsIfDirty();
+        }
+    }
+
+    void SceneTransformSystem::Rebuild(const HSceneObject& root)
+    {
+        _objects.clear();
+        _handles.clear();
+        _parents.clear();
+        _levels.clear();
+
+        SceneObject* rootSO = root.Get();
+        rootSO->_transformSystemId = 0;
+
+        _objects.push_back(rootSO);
+        _handles.push_back(root);
+        _parents.push_back((UINT32)-1);
+
+        // Breadth first, so each level is stored contiguously and parents always precede their children
+        UINT32 levelStart = 0;
+        while (levelStart < (UINT32)_objects.size())
+        {
+            _levels.push_back(levelStart);
+
+            UINT32 levelEnd = (UINT32)_objects.size();
+            for (UINT32 i = levelStart; i < levelEnd; i++)
+            {
+                for (auto& child : _objects[i]->_children)
+                {
+                    if (child.IsDestroyed())
+                        continue;
+
+                    SceneObject* childSO = child.Get();
+                    childSO->_transformSystemId = (UINT32)_objects.size();
+
+                    _objects.push_back(childSO);
+                    _handles.push_back(child);
+                    _parents.push_back(i);
+                }
+            }
+
+            levelStart = levelEnd;
+        }
+
+        _levels.push_back((UINT32)_objects.size());
+        _changedFlags.assign(_objects.size(), 0);
+    }
+
+    void SceneTransformSystem::Clear()
+    {
+        _objects.clear();
+        _handles.clear();
+        _parents.clear();
+        _changedFlags.clear();
+        _levels.clear();
+        _pending.clear();
+        _processing.clear();
+
+        _hierarchyDirty = true;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Scene/TeGameObject.h"
+#include "Scene/TeGameObjectHandle.h"
+
+namespace te
+{
+    /**
+     * Optional, data oriented alternative to the recursive transform propagation done by SceneObject. When enabled,
+     * transform setters only mark the modified object as dirty. All pending changes are then resolved at once in
+     * Update(): world transforms of dirty objects and their descendants are recomputed in a single linear pass over
+     * objects sorted by hierarchy depth (levels large enough are split across the task scheduler), and components get
+     * notified once per object instead of once per setter call.
+     *
+     * Querying the world transform of an object whose ancestor has a pending change flushes pending changes, so
+     * results are always up to date.
+     *
+     * @note	Owned by the SceneManager, only scene objects belonging to the main scene are handled.
+     */
+    class TE_CORE_EXPORT SceneTransformSystem
+    {
+    public:
+        SceneTransformSystem() = default;
+        ~SceneTransformSystem() = default;
+
+        /** Enables or disables batched transform updates. Any pending change is resolved when disabling. */
+        void SetEnabled(bool enabled);
+
+        /** @copydoc SetEnabled */
+        bool IsEnabled() const { return _enabled; }
+
+        /** Returns true if at least one scene object has a transform change waiting for Update(). */
+        bool HasPendingChanges() const { return !_pending.empty(); }
+
+        /** Returns true while Update() is resolving pending changes. */
+        bool IsUpdating() const { return _updating; }
+
+        /** Notifies the system that the hierarchy of the scene changed and the depth sorted arrays must be rebuilt. */
+        void NotifyHierarchyChanged() { _hierarchyDirty = true; }
+
+        /** Records a transform change of the provided object, to be resolved during the next Update(). */
+        void QueueTransformChanged(const SceneObject& so, TransformChangedFlags flags);
+
+        /** Recomputes world transforms of all objects affected by pending changes and notifies their components. */
+        void Update(const HSceneObject& root);
+
+        /** Releases all internal data. */
+        void Clear();
+
+    private:
+        /** Rebuilds the depth sorted arrays with a breadth first walk of the hierarchy starting at @p root. */
+        void Rebuild(const HSceneObject& root);
+
+        /** Recomputes world transforms of changed objects in range [start, end), all on the same hierarchy level. */
+        void UpdateRange(UINT32 start, UINT32 end);
+
+    private:
+        static const UINT32 PARALLEL_CHUNK_SIZE = 512;
+
+        bool _enabled = false;
+        bool _hierarchyDirty = true;
+        bool _updating = false;
+
+        Vector<SceneObject*> _objects; /**< All objects of the scene, parents always come before their children. */
+        Vector<HSceneObject> _handles; /**< Handles matching _objects, used to detect objects destroyed by callbacks. */
+        Vector<UINT32> _parents; /**< Index of the parent of each object in _objects, or -1. */
+        Vector<UINT32> _changedFlags; /**< TransformChangedFlags to apply to each object during the current Update(). */
+        Vector<UINT32> _levels; /**< Index of the first object of each hierarchy level, plus one past the last object. */
+
+        Vector<HSceneObject> _pending;
+        Vector<HSceneObject> _processing;
+    };
+}
@@ -65,6 +65,11 @@ namespace te
 #endif
 
         _folderMonitor.StopMonitorAll();
+
+        for (auto& compilation : _compilations)
+            compilation->CompileThread.join();
+
+        _compilations.clear();
         _scripts.clear();
         UnloadAll();
     }
@@ -108,6 +113,7 @@ namespace te
     void ScriptManager::Update()
     {
         _folderMonitor.Update();
+        UpdateCompilations();
     }
 
     void ScriptManager::RegisterScript(Script* script)
@@ -255,11 +261,16 @@ namespace te
     bool ScriptManager::LibraryExists(const String& name)
     {
         String path = name + "." + DynLib::EXTENSION;
+        if (DynLib::PREFIX != nullptr)
+            path.insert(0, DynLib::PREFIX);
+
         return FileSystem::Exists(path);
     }
 
     bool ScriptManager::CheckLastBuildOldEnough(const ScriptIdentifier& identifier)
     {
+        RecursiveLock lock(_mutex);
+
         if (_lastBuildTimes.find(identifier) == _lastBuildTimes.end())
             return true;
 
@@ -272,51 +283,85 @@ namespace te
         return false;
     }
 
-    void ScriptManager::OnMonitorFileModified(const String& path)
+    void ScriptManager::QueueCompilation(const ScriptIdentifier& identifier, const String& previousName)
     {
-        std::filesystem::path filePath(path);
-        String fileName;
-        String fileExtension;
-        Vector<UnloadedScript> unloadedScripts;
-
-        if (filePath.has_filename())
+        for (auto& compilation : _compilations)
         {
-            SetPaused(true);
-            fileName = filePath.filename().string();
-            fileExtension = filePath.extension().string();
-
-            if(fileExtension == ".cpp")
+            if (compilation->Identifier == identifier)
             {
-                fileName = ReplaceAll(fileName, fileExtension, "");
-                this->UnloadScriptLibrary(fileName, &unloadedScripts);
+                compilation->Recompile = true;
+                return;
             }
         }
 
-        auto FileModifiedTask = [this, filePath, fileName, fileExtension, unloadedScripts]() {
+        SPtr<ScriptCompilation> compilation = te_shared_ptr_new<ScriptCompilation>(identifier, previousName);
+        ScriptCompilation* compilationPtr = compilation.get();
 
-            if (filePath.has_filename() && fileExtension == ".cpp")
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+        // A loaded dll can't be overwritten
+        UnloadScriptLibrary(previousName, &compilation->UnloadedScripts);
+#endif
+
+        compilation->CompileThread = Thread([this, compilationPtr]() {
+            compilationPtr->Succeeded = this->CompileLibrary(compilationPtr->Identifier);
+            compilationPtr->Done.store(true, std::memory_order_release);
+        });
+
+        _compilations.push_back(compilation);
+    }
+
+    void ScriptManager::UpdateCompilations()
+    {
+        Vector<ScriptIdentifier> recompilations;
+
+        for (auto iter = _compilations.begin(); iter != _compilations.end();)
+        {
+            SPtr<ScriptCompilation> compilation = *iter;
+            if (!compilation->Done.load(std::memory_order_acquire))
             {
-                if (this->CompileLibrary(fileName))
+                ++iter;
+                continue;
+            }
+
+            compilation->CompileThread.join();
+            iter = _compilations.erase(iter);
+
+            if (compilation->Succeeded)
+            {
+                Vector<UnloadedScript>& unloadedScripts = compilation->UnloadedScripts;
+                UnloadScriptLibrary(compilation->PreviousName, &unloadedScripts);
+
+                for (auto& unloadedScript : unloadedScripts)
                 {
-                    // RecursiveLock lock(_mutex);
-                    for (auto& unloadedScript : unloadedScripts)
-                    {
-                        unloadedScript.ScriptToReload->SetNativeScript(
-                            fileName, unloadedScript.PreviousSceneObject, filePath.parent_path().generic_string());
-                    }
+                    // Script may have been destroyed while compiling
+                    if (std::find(_scripts.begin(), _scripts.end(), unloadedScript.ScriptToReload) == _scripts.end())
+                        continue;
+
+                    unloadedScript.ScriptToReload->SetNativeScript(compilation->Identifier, unloadedScript.PreviousSceneObject);
                 }
             }
-        };
+            else
+            {
+                TE_DEBUG("Script \"" + compilation->Identifier.Name + "\" could not be compiled, previous version is kept");
+            }
 
-        auto FileModifiedCallback = [this]() {
-            SetPaused(false);
-        };
+            if (compilation->Recompile)
+                recompilations.push_back(compilation->Identifier);
+        }
 
-        FileModifiedTask();
-        FileModifiedCallback();
+        for (auto& identifier : recompilations)
+            QueueCompilation(identifier, identifier.Name);
+    }
 
-        //SPtr<Task> task = Task::Create("OnMonitorFileModified", FileModifiedTask, FileModifiedCallback);
-        //gTaskScheduler().AddTask(task); TODO rewrite ScriptManager
+    void ScriptManager::OnMonitorFileModified(const String& path)
+    {
+        std::filesystem::path filePath(path);
+
+        if (filePath.has_filename() && filePath.extension().string() == ".cpp")
+        {
+            String fileName = filePath.stem().string();
+            QueueCompilation(ScriptIdentifier(fileName, filePath.parent_path().generic_string()), fileName);
+        }
     }
 
     void ScriptManager::OnMonitorFileAdded(const String& path)
@@ -342,48 +387,29 @@ namespace te
 
     void ScriptManager::OnMonitorFileRenamed(const String& from, const String& to)
     {
-        auto FileRenamedTask = [this, from, to]() {
-            // RecursiveLock lock(_mutex);
-            std::filesystem::path oldFilePath(from);
-            std::filesystem::path newFilePath(to);
-
-            SetPaused(true);
-
-            if (oldFilePath.has_filename() && newFilePath.has_filename())
-            {
-                String oldFileName = oldFilePath.filename().string();
-                String newFileName = newFilePath.filename().string();
-                String oldFileExtension = oldFilePath.extension().string();
-                String newFileExtension = newFilePath.extension().string();
+        std::filesystem::path oldFilePath(from);
+        std::filesystem::path newFilePath(to);
 
-                if (oldFileExtension == ".cpp")
-                {
-                    oldFileName = ReplaceAll(oldFileName, oldFileExtension, "");
+        if (!oldFilePath.has_filename() || !newFilePath.has_filename())
+            return;
 
-                    Vector<UnloadedScript> unloadedScripts;
-                    UnloadScriptLibrary(oldFileName, &unloadedScripts);
-                    if (unloadedScripts.size() > 0 && CompileLibrary(newFileName))
-                    {
-                        if (newFileExtension == ".cpp")
-                        {
-                            newFileName = ReplaceAll(newFileName, newFileExtension, "");
-                            for (auto& unloadedScript : unloadedScripts)
-                            {
-                                unloadedScript.ScriptToReload->SetNativeScript(
-                                    newFileName, unloadedScript.PreviousSceneObject, newFilePath.parent_path().generic_string());
-                            }
-                        }
-                    }
-                }
-            }
+        if (oldFilePath.extension().string() != ".cpp")
+            return;
 
-            SetPaused(false);
-        };
+        String oldFileName = oldFilePath.stem().string();
 
-        FileRenamedTask();
+        if (newFilePath.extension().string() != ".cpp")
+        {
+            UnloadScriptLibrary(oldFileName);
+            return;
+        }
 
-        //SPtr<Task> task = Task::Create("OnMonitorFileRenamed", FileRenamedTask);
-        //gTaskScheduler().AddTask(task); TODO rewrite ScriptManager
+        // Only libraries in use are compiled under their new name
+        if (_scriptLibraries.find(ScriptIdentifier(oldFileName)) != _scriptLibraries.end())
+        {
+            String newFileName = newFilePath.stem().string();
+            QueueCompilation(ScriptIdentifier(newFileName, newFilePath.parent_path().generic_string()), oldFileName);
+        }
     }
 
     void ScriptManager::SetPaused(bool paused)
@@ -7,6 +7,7 @@
 #include "Threading/TeThreading.h"
 
 #include <filesystem>
+#include <atomic>
 
 namespace te
 {
@@ -66,6 +67,27 @@ namespace te
         }
     };
 
+    /**
+     * Compilation of a script library on its own thread, which mostly waits for the compiler and would hold up a
+     * TaskScheduler worker for seconds. The previous version of the library keeps running until the compilation is
+     * complete, its instances are then moved to the new version by ScriptManager::Update().
+     */
+    struct ScriptCompilation
+    {
+        ScriptCompilation(const ScriptIdentifier& identifier, const String& previousName)
+            : Identifier(identifier)
+            , PreviousName(previousName)
+        { }
+
+        ScriptIdentifier Identifier;
+        String PreviousName; // Library whose instances are moved to the new one, differs from Identifier on rename
+        Thread CompileThread;
+        std::atomic<bool> Done{ false };
+        Vector<UnloadedScript> UnloadedScripts; // Instances unloaded before compiling, on platforms which can't overwrite a loaded library
+        bool Succeeded = false;
+        bool Recompile = false; // Sources have been modified again while compiling
+    };
+
     /**	Handles initialization of a scripting system. */
     class TE_CORE_EXPORT ScriptManager : public Module<ScriptManager>
     {
@@ -132,7 +154,7 @@ namespace te
         /** Called once per frame after engine render */
         void PostRender();
 
-        /** Update any script which has been modified */
+        /** Update any script which has been modified, and swaps instances of scripts whose compilation is complete */
         void Update();
 
     public: // #### EVENTS FOR SCRIPTS FOLRDER WATCHING
@@ -164,6 +186,15 @@ namespace te
         /** Compiles a library using provided name. All libraries will be located in the same directory as dlls and binaries */
         bool CompileLibrary(const ScriptIdentifier& identifier);
 
+        /** 
+         * Compiles a library in the background. Once compiled, instances of @p previousName are replaced by instances of
+         * the new library. Scripts are compiled in parallel.
+         */
+        void QueueCompilation(const ScriptIdentifier& identifier, const String& previousName);
+
+        /** Replaces instances of scripts whose compilation is complete. */
+        void UpdateCompilations();
+
         /** Check if a library already exists. Usefull if we don't want to compile everything (time consuming) */
         bool LibraryExists(const String& name);
 
@@ -178,6 +209,7 @@ namespace te
         UnorderedMap<ScriptIdentifier, DynLib*, HashFunc, EqualFunc> _scriptLibraries;
         UnorderedMap<ScriptIdentifier, UINT64, HashFunc, EqualFunc> _lastBuildTimes;
         Vector<Script*> _scripts;
+        Vector<SPtr<ScriptCompilation>> _compilations;
         FolderMonitor _folderMonitor;
         RecursiveMutex _mutex;
         bool _paused;
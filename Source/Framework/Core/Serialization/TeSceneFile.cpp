@@ -0,0 +1,462 @@
+#include "Serialization/TeSceneFile.h"
+#include "Scene/TeSceneObject.h"
+#include "Scene/TeSceneManager.h"
+#include "Scene/TeGameObjectManager.h"
+#include "Utility/TeDataStream.h"
+
+#include "Components/TeCCamera.h"
+#include "Components/TeCCameraFlyer.h"
+#include "Components/TeCCameraUI.h"
+#include "Components/TeCLight.h"
+#include "Components/TeCRenderable.h"
+#include "Components/TeCSkybox.h"
+#include "Components/TeCScript.h"
+#include "Components/TeCAnimation.h"
+#include "Components/TeCBone.h"
+#include "Components/TeCAudioSource.h"
+#include "Components/TeCAudioListener.h"
+#include "Components/TeCRigidBody.h"
+#include "Components/TeCMeshSoftBody.h"
+#include "Components/TeCEllipsoidSoftBody.h"
+#include "Components/TeCRopeSoftBody.h"
+#include "Components/TeCPatchSoftBody.h"
+#include "Components/TeCConeTwistJoint.h"
+#include "Components/TeCD6Joint.h"
+#include "Components/TeCHingeJoint.h"
+#include "Components/TeCSliderJoint.h"
+#include "Components/TeCSphericalJoint.h"
+#include "Components/TeCBoxCollider.h"
+#include "Components/TeCPlaneCollider.h"
+#include "Components/TeCSphereCollider.h"
+#include "Components/TeCCylinderCollider.h"
+#include "Components/TeCCapsuleCollider.h"
+#include "Components/TeCMeshCollider.h"
+#include "Components/TeCConeCollider.h"
+#include "Components/TeCHeightFieldCollider.h"
+#include "Components/TeCDecal.h"
+
+namespace te
+{
+    static_assert(sizeof(SceneFile::Header) % 4 == 0, "Tables following the header must stay aligned");
+    static_assert(sizeof(SceneFile::ObjectRecord) % 4 == 0, "Tables following the objects must stay aligned");
+    static_assert(sizeof(SceneFile::ComponentRecord) % 4 == 0, "Tables following the components must stay aligned");
+
+    bool SceneFile::Save(const String& path, const HSceneObject& root, bool includeRoot)
+    {
+        if (root.Empty())
+        {
+            TE_DEBUG("Tries to save a scene file using an invalid sceneObject handle");
+            return false;
+        }
+
+        Vector<ObjectRecord> objects;
+        Vector<ComponentRecord> components;
+        String strings;
+        MemoryDataStream properties;
+
+        auto addString = [&strings](const String& value, UINT32& offset, UINT32& length)
+        {
+            offset = (UINT32)strings.size();
+            length = (UINT32)value.size();
+            strings += value;
+        };
+
+        // Depth first, so parents are always written before their children
+        Vector<std::pair<HSceneObject, UINT32>> stack;
+        if (includeRoot)
+            stack.push_back(std::make_pair(root, NO_PARENT));
+        else
+        {
+            const Vector<HSceneObject>& children = root->GetChildren();
+            for (auto iter = children.rbegin(); iter != children.rend(); ++iter)
+                stack.push_back(std::make_pair(*iter, NO_PARENT));
+        }
+
+        while (!stack.empty())
+        {
+            const HSceneObject so = stack.back().first;
+            const UINT32 parent = stack.back().second;
+            stack.pop_back();
+
+            if (so->HasFlag(SOF_DontSave))
+                continue;
+
+            const UINT32 objectIdx = (UINT32)objects.size();
+            const Transform& tfrm = so->GetLocalTransform();
+            const Vector3& position = tfrm.GetPosition();
+            const Quaternion& rotation = tfrm.GetRotation();
+            const Vector3& scale = tfrm.GetScale();
+
+            ObjectRecord object;
+            object.Parent = parent;
+            addString(so->GetName(), object.NameOffset, object.NameLength);
+            object.Flags = so->GetFlags();
+            object.NumChildren = 0;
+            object.FirstComponent = (UINT32)components.size();
+            object.NumComponents = 0;
+            object.Mobility = (UINT32)so->GetMobility();
+            object.Active = so->GetActive(true) ? 1 : 0;
+            object.Position[0] = position.x; object.Position[1] = position.y; object.Position[2] = position.z;
+            object.Rotation[0] = rotation.w; object.Rotation[1] = rotation.x;
+            object.Rotation[2] = rotation.y; object.Rotation[3] = rotation.z;
+            object.Scale[0] = scale.x; object.Scale[1] = scale.y; object.Scale[2] = scale.z;
+
+            for (const auto& component : so->GetComponents())
+            {
+                // Loading it back would silently reset its properties to their default values
+                if (!component->CanBeSaved())
+                {
+                    TE_DEBUG("Component " + component->GetName() + " of " + so->GetName() + " (type " +
+                        ToString(component->GetCoreType()) + ") can't be saved to a scene file and is left out");
+                    continue;
+                }
+
+                ComponentRecord record;
+                record.Type = component->GetCoreType();
+                record.Object = objectIdx;
+                addString(component->GetName(), record.NameOffset, record.NameLength);
+
+                record.PropertiesOffset = (UINT32)properties.Tell();
+                component->WriteProperties(properties);
+                record.PropertiesSize = (UINT32)properties.Tell() - record.PropertiesOffset;
+
+                components.push_back(record);
+                object.NumComponents++;
+            }
+
+            if (parent != NO_PARENT)
+                objects[parent].NumChildren++;
+
+            objects.push_back(object);
+
+            const Vector<HSceneObject>& children = so->GetChildren();
+            for (auto iter = children.rbegin(); iter != children.rend(); ++iter)
+                stack.push_back(std::make_pair(*iter, objectIdx));
+        }
+
+        // Keeps the property table aligned, as the string table is the only one not made of 32 bits values
+        while (strings.size() % 4 != 0)
+            strings.push_back('\0');
+
+        Header header;
+        header.Magic = MAGIC;
+        header.Version = VERSION;
+        header.NumObjects = (UINT32)objects.size();
+        header.NumComponents = (UINT32)components.size();
+        header.ObjectsOffset = (UINT32)sizeof(Header);
+        header.ComponentsOffset = header.ObjectsOffset + header.NumObjects * (UINT32)sizeof(ObjectRecord);
+        header.StringsOffset = header.ComponentsOffset + header.NumComponents * (UINT32)sizeof(ComponentRecord);
+        header.StringsSize = (UINT32)strings.size();
+        header.PropertiesOffset = header.StringsOffset + header.StringsSize;
+        header.PropertiesSize = (UINT32)properties.Tell();
+
+        FileStream stream(path, DataStream::WRITE);
+        if (stream.Fail())
+            return false;
+
+        stream.Write(&header, sizeof(header));
+        stream.Write(objects.data(), objects.size() * sizeof(ObjectRecord));
+        stream.Write(components.data(), components.size() * sizeof(ComponentRecord));
+        stream.Write(strings.data(), strings.size());
+        stream.Write(properties.Data(), header.PropertiesSize);
+        stream.Close();
+
+        return true;
+    }
+
+    Vector<HSceneObject> SceneFile::Load(const String& path, const HSceneObject& parent)
+    {
+        SceneFile file;
+        if (!file.Open(path))
+            return Vector<HSceneObject>();
+
+        return file.Instantiate(parent);
+    }
+
+    bool SceneFile::Open(const String& path)
+    {
+        Close();
+
+        if (!_file.Open(path))
+        {
+            TE_DEBUG("Cannot open scene file: " + path);
+            return false;
+        }
+
+        if (_file.GetSize() < sizeof(Header))
+        {
+            TE_DEBUG("Invalid scene file: " + path);
+            _file.Close();
+            return false;
+        }
+
+        const UINT8* data = _file.GetData();
+        _header = reinterpret_cast<const Header*>(data);
+
+        if (!Validate())
+        {
+            TE_DEBUG("Invalid scene file: " + path);
+            Close();
+            return false;
+        }
+
+        _objects = reinterpret_cast<const ObjectRecord*>(data + _header->ObjectsOffset);
+        _components = reinterpret_cast<const ComponentRecord*>(data + _header->ComponentsOffset);
+        _strings = reinterpret_cast<const char*>(data + _header->StringsOffset);
+        _properties = data + _header->PropertiesOffset;
+
+        return true;
+    }
+
+    void SceneFile::Close()
+    {
+        _header = nullptr;
+        _objects = nullptr;
+        _components = nullptr;
+        _strings = nullptr;
+        _properties = nullptr;
+
+        _file.Close();
+    }
+
+    UINT32 SceneFile::GetNumObjects() const
+    {
+        return _header ? _header->NumObjects : 0;
+    }
+
+    UINT32 SceneFile::GetNumComponents() const
+    {
+        return _header ? _header->NumComponents : 0;
+    }
+
+    bool SceneFile::Validate() const
+    {
+        if (_header->Magic != MAGIC || _header->Version != VERSION)
+            return false;
+
+        const UINT64 size = _file.GetSize();
+        auto inBounds = [size](UINT64 offset, UINT64 length) { return offset + length <= size; };
+
+        if (_header->ObjectsOffset % 4 != 0 || _header->ComponentsOffset % 4 != 0)
+            return false;
+
+        if (!inBounds(_header->ObjectsOffset, (UINT64)_header->NumObjects * sizeof(ObjectRecord)) ||
+            !inBounds(_header->ComponentsOffset, (UINT64)_header->NumComponents * sizeof(ComponentRecord)) ||
+            !inBounds(_header->StringsOffset, _header->StringsSize) ||
+            !inBounds(_header->PropertiesOffset, _header->PropertiesSize))
+        {
+            return false;
+        }
+
+        const UINT8* data = _file.GetData();
+        const ObjectRecord* objects = reinterpret_cast<const ObjectRecord*>(data + _header->ObjectsOffset);
+        const ComponentRecord* components = reinterpret_cast<const ComponentRecord*>(data + _header->ComponentsOffset);
+
+        for (UINT32 i = 0; i < _header->NumObjects; i++)
+        {
+            const ObjectRecord& object = objects[i];
+
+            // Parents must come first, which also rules out cycles
+            if (object.Parent != NO_PARENT && object.Parent >= i)
+                return false;
+
+            if ((UINT64)object.NameOffset + object.NameLength > _header->StringsSize ||
+                (UINT64)object.FirstComponent + object.NumComponents > _header->NumComponents)
+            {
+                return false;
+            }
+        }
+
+        for (UINT32 i = 0; i < _header->NumComponents; i++)
+        {
+            const ComponentRecord& component = components[i];
+
+            if (component.Object >= _header->NumObjects ||
+                (UINT64)component.NameOffset + component.NameLength > _header->StringsSize ||
+                (UINT64)component.PropertiesOffset + component.PropertiesSize > _header->PropertiesSize)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    String SceneFile::GetString(UINT32 offset, UINT32 length) const
+    {
+        return String(_strings + offset, length);
+    }
+
+    Vector<HSceneObject> SceneFile::Instantiate(const HSceneObject& parent, UINT32 numInstances) const
+    {
+        Vector<HSceneObject> topLevelObjects;
+        if (!IsOpen() || numInstances == 0)
+            return topLevelObjects;
+
+        HSceneObject topLevelParent = parent;
+        if (topLevelParent.Empty())
+            topLevelParent = gSceneManager().GetMainScene()->GetRoot();
+
+        const UINT32 numObjects = _header->NumObjects;
+        const UINT32 numComponents = _header->NumComponents;
+
+        UINT32 numTopLevelObjects = 0;
+        for (UINT32 i = 0; i < numObjects; i++)
+        {
+            if (_objects[i].Parent == NO_PARENT)
+                numTopLevelObjects++;
+        }
+
+        // Size every table once for all the instances
+        GameObjectManager::Instance().Reserve((numObjects + numComponents) * numInstances);
+        gSceneManager()._reserveComponents(numComponents * numInstances);
+
+        topLevelObjects.reserve(numTopLevelObjects * numInstances);
+        if (!topLevelParent.Empty())
+            topLevelParent->_children.reserve(topLevelParent->_children.size() + numTopLevelObjects * numInstances);
+
+        Vector<HSceneObject> objects(numObjects);
+        Vector<HComponent> components;
+        components.reserve(numComponents * numInstances);
+
+        for (UINT32 instanceIdx = 0; instanceIdx < numInstances; instanceIdx++)
+        {
+            // Objects are linked to their parent directly: going through SetParent() would first attach each of them
+            // to the scene root, and compute transforms the file already provides
+            for (UINT32 i = 0; i < numObjects; i++)
+            {
+                const ObjectRecord& record = _objects[i];
+
+                HSceneObject so = SceneObject::CreateInternal(GetString(record.NameOffset, record.NameLength),
+                    record.Flags);
+
+                so->_localTfrm.SetPosition(Vector3(record.Position[0], record.Position[1], record.Position[2]));
+                so->_localTfrm.SetRotation(Quaternion(record.Rotation[0], record.Rotation[1], record.Rotation[2],
+                    record.Rotation[3]));
+                so->_localTfrm.SetScale(Vector3(record.Scale[0], record.Scale[1], record.Scale[2]));
+                so->_mobility = (ObjectMobility)record.Mobility;
+                so->_activeSelf = record.Active != 0;
+                so->_activeHierarchy = so->_activeSelf;
+                so->_children.reserve(record.NumChildren);
+                so->_components.reserve(record.NumComponents);
+
+                const HSceneObject& soParent = record.Parent == NO_PARENT ? topLevelParent : objects[record.Parent];
+                if (!soParent.Empty())
+                {
+                    so->_parent = soParent;
+                    so->_parentScene = soParent->_parentScene;
+                    so->_flags |= soParent->_flags;
+                    so->_activeHierarchy = so->_activeSelf && soParent->_activeHierarchy;
+
+                    soParent->_children.push_back(so);
+                }
+
+                if (record.Parent == NO_PARENT)
+                    topLevelObjects.push_back(so);
+
+                objects[i] = so;
+            }
+
+            // All components are created before any of them is initialized, so they can find each other
+            for (UINT32 i = 0; i < numComponents; i++)
+            {
+                const ComponentRecord& record = _components[i];
+
+                HComponent component = CreateComponent(objects[record.Object], record.Type);
+                if (component.Empty())
+                    continue;
+
+                component->SetName(GetString(record.NameOffset, record.NameLength));
+
+                if (record.PropertiesSize > 0)
+                {
+                    MemoryDataStream stream(const_cast<UINT8*>(_properties + record.PropertiesOffset),
+                        record.PropertiesSize);
+                    component->ReadProperties(stream);
+                }
+
+                components.push_back(component);
+            }
+        }
+
+        for (auto& component : components)
+            component->Initialize();
+
+        SceneObject::NotifyHierarchyChanged();
+
+        for (auto& so : topLevelObjects)
+            so->NotifyTransformChanged((TransformChangedFlags)(TCF_Parent | TCF_Transform));
+
+        return topLevelObjects;
+    }
+
+    HComponent SceneFile::CreateComponent(const HSceneObject& so, UINT32 type)
+    {
+        switch (type)
+        {
+        case TID_CCamera:
+            return static_object_cast<Component>(so->AddComponent<CCamera>());
+        case TID_CCameraFlyer:
+            return static_object_cast<Component>(so->AddComponent<CCameraFlyer>());
+        case TID_CCameraUI:
+            return static_object_cast<Component>(so->AddComponent<CCameraUI>());
+        case TID_CLight:
+            return static_object_cast<Component>(so->AddComponent<CLight>());
+        case TID_CRenderable:
+            return static_object_cast<Component>(so->AddComponent<CRenderable>());
+        case TID_CScript:
+            return static_object_cast<Component>(so->AddComponent<CScript>());
+        case TID_CSkybox:
+            return static_object_cast<Component>(so->AddComponent<CSkybox>());
+        case TID_CAnimation:
+            return static_object_cast<Component>(so->AddComponent<CAnimation>());
+        case TID_CBone:
+            return static_object_cast<Component>(so->AddComponent<CBone>());
+        case TID_CAudioListener:
+            return static_object_cast<Component>(so->AddComponent<CAudioListener>());
+        case TID_CAudioSource:
+            return static_object_cast<Component>(so->AddComponent<CAudioSource>());
+        case TID_CRigidBody:
+            return static_object_cast<Component>(so->AddComponent<CRigidBody>());
+        case TID_CMeshSoftBody:
+            return static_object_cast<Component>(so->AddComponent<CMeshSoftBody>());
+        case TID_CEllipsoidSoftBody:
+            return static_object_cast<Component>(so->AddComponent<CEllipsoidSoftBody>());
+        case TID_CRopeSoftBody:
+            return static_object_cast<Component>(so->AddComponent<CRopeSoftBody>());
+        case TID_CPatchSoftBody:
+            return static_object_cast<Component>(so->AddComponent<CPatchSoftBody>());
+        case TID_CConeTwistJoint:
+            return static_object_cast<Component>(so->AddComponent<CConeTwistJoint>());
+        case TID_CD6Joint:
+            return static_object_cast<Component>(so->AddComponent<CD6Joint>());
+        case TID_CHingeJoint:
+            return static_object_cast<Component>(so->AddComponent<CHingeJoint>());
+        case TID_CSliderJoint:
+            return static_object_cast<Component>(so->AddComponent<CSliderJoint>());
+        case TID_CSphericalJoint:
+            return static_object_cast<Component>(so->AddComponent<CSphericalJoint>());
+        case TID_CBoxCollider:
+            return static_object_cast<Component>(so->AddComponent<CBoxCollider>());
+        case TID_CCapsuleCollider:
+            return static_object_cast<Component>(so->AddComponent<CCapsuleCollider>());
+        case TID_CConeCollider:
+            return static_object_cast<Component>(so->AddComponent<CConeCollider>());
+        case TID_CCylinderCollider:
+            return static_object_cast<Component>(so->AddComponent<CCylinderCollider>());
+        case TID_CHeightFieldCollider:
+            return static_object_cast<Component>(so->AddComponent<CHeightFieldCollider>());
+        case TID_CMeshCollider:
+            return static_object_cast<Component>(so->AddComponent<CMeshCollider>());
+        case TID_CPlaneCollider:
+            return static_object_cast<Component>(so->AddComponent<CPlaneCollider>());
+        case TID_CSphereCollider:
+            return static_object_cast<Component>(so->AddComponent<CSphereCollider>());
+        case TID_CDecal:
+            return static_object_cast<Component>(so->AddComponent<CDecal>());
+        default:
+            TE_DEBUG("Component type " + ToString(type) + " can't be loaded from a scene file");
+            return HComponent();
+        }
+    }
+}
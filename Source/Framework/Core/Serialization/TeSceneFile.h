@@ -0,0 +1,144 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TeFileSystem.h"
+
+namespace te
+{
+    /**
+     * Binary scene or prefab file: a hierarchy of scene objects with their transforms and components, stored in flat
+     * tables that reference each other by index and offset, so the file can be read in place.
+     *
+     * Layout of a file (all offsets are relative to the start of the file):
+     *  - Header, with the magic number, the version and the location of each table.
+     *  - Objects: one ObjectRecord per scene object, parents before their children. Objects without a parent in the
+     *    file are the top-level objects, attached to the parent provided to Instantiate().
+     *  - Components: one ComponentRecord per component, in the order of their scene objects.
+     *  - Strings: names of objects and components, not null terminated.
+     *  - Properties: data written by Component::WriteProperties() for each component.
+     *
+     * A file is opened once by memory mapping it, and can then be instantiated any number of times. Instantiation
+     * doesn't go through the usual one object at a time path: tables of the game object and scene managers are sized
+     * once for all the instances, objects are linked to their parent directly, all components are created before any
+     * of them is initialized, and transforms are only notified once per top-level object.
+     */
+    class TE_CORE_EXPORT SceneFile
+    {
+    public:
+        SceneFile() = default;
+        ~SceneFile() = default;
+
+        SceneFile(const SceneFile&) = delete;
+        SceneFile& operator=(const SceneFile&) = delete;
+
+        /**
+         * Writes a hierarchy to a file. Objects flagged with SOF_DontSave are skipped, with their children. Components
+         * that can't be saved (see Component::CanBeSaved()) are skipped and reported in the log.
+         *
+         * @param[in]	path			Path of the file to write.
+         * @param[in]	root			Root of the hierarchy to save.
+         * @param[in]	includeRoot		If false, only the children of @p root are saved (e.g. to save the content of a
+         *								scene without its root object).
+         * @return						False if the file can't be written.
+         */
+        static bool Save(const String& path, const HSceneObject& root, bool includeRoot = true);
+
+        /**
+         * Opens a file, instantiates its content once under @p parent and closes it.
+         *
+         * @copydetails SceneFile::Instantiate
+         */
+        static Vector<HSceneObject> Load(const String& path, const HSceneObject& parent = HSceneObject());
+
+        /** Maps a file in memory and validates its content. Closes the previously opened file, if any. */
+        bool Open(const String& path);
+
+        /** Releases the opened file. */
+        void Close();
+
+        /** Checks if a valid file is opened. */
+        bool IsOpen() const { return _header != nullptr; }
+
+        /** Returns the number of scene objects of a single instance of the file content. */
+        UINT32 GetNumObjects() const;
+
+        /** Returns the number of components of a single instance of the file content. */
+        UINT32 GetNumComponents() const;
+
+        /**
+         * Creates scene objects and components from the content of the opened file.
+         *
+         * @param[in]	parent			Object to attach the top-level objects of the file to. If empty, they are
+         *								attached to the root of the main scene.
+         * @param[in]	numInstances	Number of copies of the file content to create.
+         * @return						Top-level objects created, for all instances.
+         */
+        Vector<HSceneObject> Instantiate(const HSceneObject& parent = HSceneObject(), UINT32 numInstances = 1) const;
+
+    public:
+        static constexpr UINT32 MAGIC = 0x43534554; // "TESC"
+        static constexpr UINT32 VERSION = 1;
+        static constexpr UINT32 NO_PARENT = (UINT32)-1;
+
+        /** Header of a file. */
+        struct Header
+        {
+            UINT32 Magic;
+            UINT32 Version;
+            UINT32 NumObjects;
+            UINT32 NumComponents;
+            UINT32 ObjectsOffset;
+            UINT32 ComponentsOffset;
+            UINT32 StringsOffset;
+            UINT32 StringsSize;
+            UINT32 PropertiesOffset;
+            UINT32 PropertiesSize;
+        };
+
+        /** Scene object of a file. */
+        struct ObjectRecord
+        {
+            UINT32 Parent; /**< Index of the parent object, or NO_PARENT for top-level objects. */
+            UINT32 NameOffset; /**< Relative to the string table. */
+            UINT32 NameLength;
+            UINT32 Flags;
+            UINT32 NumChildren;
+            UINT32 FirstComponent;
+            UINT32 NumComponents;
+            UINT32 Mobility;
+            UINT32 Active;
+            float Position[3];
+            float Rotation[4];
+            float Scale[3];
+        };
+
+        /** Component of a file. */
+        struct ComponentRecord
+        {
+            UINT32 Type; /**< Core type id of the component. */
+            UINT32 Object; /**< Index of the scene object it is attached to. */
+            UINT32 NameOffset; /**< Relative to the string table. */
+            UINT32 NameLength;
+            UINT32 PropertiesOffset; /**< Relative to the property table. */
+            UINT32 PropertiesSize;
+        };
+
+    private:
+        /** Checks that the tables of the mapped file are within its bounds and consistent. */
+        bool Validate() const;
+
+        /** Returns a string of the string table. */
+        String GetString(UINT32 offset, UINT32 length) const;
+
+        /** Adds a component of the provided type to @p so. Returns an empty handle for unsupported types. */
+        static HComponent CreateComponent(const HSceneObject& so, UINT32 type);
+
+    private:
+        MappedFile _file;
+        const Header* _header = nullptr;
+        const ObjectRecord* _objects = nullptr;
+        const ComponentRecord* _components = nullptr;
+        const char* _strings = nullptr;
+        const UINT8* _properties = nullptr;
+    };
+}
@@ -4,6 +4,7 @@
 #include "Utility/TeTime.h"
 #include "Utility/TeDynLibManager.h"
 #include "Utility/TeDynLib.h"
+#include "Utility/TeMemoryStats.h"
 #include "Threading/TeTaskScheduler.h"
 
 #include "Manager/TePluginManager.h"
@@ -32,6 +33,8 @@
 
 #include "RenderAPI/TeRenderAPI.h"
 #include "Importer/TeImporter.h"
+#include "Image/TeTextureStreaming.h"
+#include "Resources/TeResourceHotReload.h"
 #include "Renderer/TeRenderer.h"
 #include "Profiling/TeProfilerGPU.h"
 
@@ -87,10 +90,14 @@ namespace te
         _renderer = RendererManager::Instance().Initialize(_startUpDesc.Renderer, "Default");
         TE_ASSERT_ERROR(_renderer.get(), "Failed to create renderer");
 
+        TextureStreaming::StartUp();
         Importer::StartUp();
         for (auto& importerName : _startUpDesc.Importers)
             LoadPlugin(importerName);
 
+        if (_startUpDesc.HotReload)
+            ResourceHotReload::StartUp();
+
         BuiltinResources::StartUp();
         PhysicsManager::StartUp(_startUpDesc.Physics);
         RendererMaterialManager::StartUp();
@@ -103,6 +110,7 @@ namespace te
 
         _window->InitializeGui();
         _perFrameData = te_shared_ptr_new<PerFrameData>();
+        _renderFrameData = _perFrameData;
 
         AudioManager::StartUp(_startUpDesc.Audio);
         AnimationManager::StartUp();
@@ -112,15 +120,21 @@ namespace te
 #endif
 
         PostStartUp();
+        StartRenderThread();
     }
     
     void CoreApplication::OnShutDown()
     {
+        StopRenderThread();
         PreShutDown();
 
         _window = nullptr;
         _renderer = nullptr;
 
+        if (ResourceHotReload::IsStarted())
+            ResourceHotReload::ShutDown();
+
+        TextureStreaming::ShutDown();
         TaskScheduler::ShutDown();
         Importer::ShutDown();
         VirtualInput::ShutDown();
@@ -152,6 +166,8 @@ namespace te
 
         while (_runMainLoop)
         {
+            MemoryStats::BeginFrame();
+
             Platform::Update();
             gTime().Update();
             gInput().Update();
@@ -185,12 +201,128 @@ namespace te
 
             DisplayFrameRate();
 
+            gSceneManager().UpdateTransforms();
+
+            // Previous frame must be done before renderer state can be modified
+            WaitUntilFrameRendered();
+            SyncRenderer();
             gRenderer()->Update();
-            gRenderer()->RenderAll(*_perFrameData);
+
+            if (_renderThreadRunning)
+                KickRenderThread();
+            else
+                gRenderer()->RenderAll(*_renderFrameData);
 
             gScriptManager().PostRender();
             PostRender();
         }
+
+        WaitUntilFrameRendered();
+    }
+
+    void CoreApplication::SyncRenderer()
+    {
+        CoreObjectManager::Instance().FrameSync();
+        RendererManager::Instance().ApplyNotifications();
+        gTextureStreaming().Update(gTime().GetFrameIdx());
+
+        if (ResourceHotReload::IsStarted())
+            gResourceHotReload().Update();
+
+        _renderFrameData->Time = gTime().GetTime();
+        _renderFrameData->TimeDelta = gTime().GetFrameDelta();
+        _renderFrameData->FrameIdx = gTime().GetFrameIdx();
+
+        if (_renderThreadRunning && _perFrameData->Animation != nullptr)
+        {
+            // Animation data is rewritten by the next simulation step while this frame renders
+            *_renderAnimationData = *_perFrameData->Animation;
+            _renderFrameData->Animation = _renderAnimationData.get();
+        }
+        else
+        {
+            _renderFrameData->Animation = _perFrameData->Animation;
+        }
+    }
+
+    void CoreApplication::StartRenderThread()
+    {
+        if (!_startUpDesc.RenderThread)
+            return;
+
+        if (!gCaps().HasCapability(RSC_RENDER_THREAD))
+        {
+            TE_DEBUG("The render API can't be used from a render thread, rendering stays on the main thread");
+            return;
+        }
+
+        _renderFrameData = te_shared_ptr_new<PerFrameData>();
+        _renderAnimationData = te_shared_ptr_new<EvaluatedAnimationData>();
+
+        _isFrameRenderingFinished = true;
+        _renderThreadRunning = true;
+        _renderThread = Thread(std::bind(&CoreApplication::RenderThreadWorker, this));
+    }
+
+    void CoreApplication::StopRenderThread()
+    {
+        if (!_renderThreadRunning)
+            return;
+
+        WaitUntilFrameRendered();
+
+        {
+            Lock lock(_renderMutex);
+            _renderThreadRunning = false;
+        }
+
+        _renderSignal.notify_all();
+        _renderThread.join();
+
+        _renderFrameData = _perFrameData;
+        _renderAnimationData = nullptr;
+    }
+
+    void CoreApplication::KickRenderThread()
+    {
+        {
+            Lock lock(_renderMutex);
+            _isFrameRenderingFinished = false;
+        }
+
+        _renderSignal.notify_all();
+    }
+
+    void CoreApplication::WaitUntilFrameRendered()
+    {
+        if (!_renderThreadRunning)
+            return;
+
+        Lock lock(_renderMutex);
+        _renderSignal.wait(lock, [this]() { return _isFrameRenderingFinished; });
+    }
+
+    void CoreApplication::RenderThreadWorker()
+    {
+        while (true)
+        {
+            {
+                Lock lock(_renderMutex);
+                _renderSignal.wait(lock, [this]() { return !_isFrameRenderingFinished || !_renderThreadRunning; });
+
+                if (_isFrameRenderingFinished)
+                    break;
+            }
+
+            gRenderer()->RenderAll(*_renderFrameData);
+
+            {
+                Lock lock(_renderMutex);
+                _isFrameRenderingFinished = true;
+            }
+
+            _renderSignal.notify_all();
+        }
     }
 
     void CoreApplication::StopMainLoop()
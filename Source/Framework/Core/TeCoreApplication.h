@@ -3,10 +3,12 @@
 #include "TeCorePrerequisites.h"
 #include "RenderAPI/TeRenderWindow.h"
 #include "Utility/TeModule.h"
+#include "Threading/TeThreading.h"
 
 namespace te
 {
     struct PerFrameData;
+    struct EvaluatedAnimationData;
 
     /**	Structure containing parameters for starting the application. */
     struct START_UP_DESC
@@ -20,6 +22,23 @@ namespace te
         RENDER_WINDOW_DESC WindowDesc; /** Describes the window to create during start-up. */
 
         Vector<String> Importers; /** A list of importer plugins to load. */
+
+        /**
+         * If true, RenderAll() runs on a dedicated render thread so the simulation of frame N+1 overlaps with the
+         * rendering of frame N. Core objects are synced with the renderer at a single point of the main loop, while the
+         * render thread is idle. While a frame is in flight the main thread must not use the render API directly
+         * (creating or updating GPU resources, resizing the window, building GUI draw data), which is why this is off by
+         * default and not suited to the editor. Only render APIs that accept commands from a thread other than the one
+         * that created them support it (RSC_RENDER_THREAD, currently D3D11 only): OpenGL contexts are only ever made
+         * current on the main thread, so the option is ignored with a warning there.
+         */
+        bool RenderThread = false;
+
+        /**
+         * If true, files loaded through the ResourceManager are imported again when they, or files they depend on,
+         * change on disk. See ResourceHotReload.
+         */
+        bool HotReload = false;
     };
 
     /** Represents the current state of the application */
@@ -118,6 +137,15 @@ namespace te
         /** Returns data computed at each frame */
         const SPtr<PerFrameData> GetPerFrameData() const { return _perFrameData; }
 
+        /** Returns true if rendering runs on a dedicated thread. See START_UP_DESC::RenderThread. */
+        bool IsRenderThreadEnabled() const { return _renderThreadRunning; }
+
+        /**
+         * Blocks until the render thread finished rendering the frame it was given. Must be called from the main thread
+         * before touching the render API when the render thread is enabled, does nothing otherwise.
+         */
+        void WaitUntilFrameRendered();
+
         /**
          * Loads a plugin.
          *
@@ -153,6 +181,26 @@ namespace te
         /** Call before core shutdown */
         virtual void PreShutDown() { }
 
+    private:
+        /**
+         * Sync point between simulation and rendering. Pushes dirty core object state and queued notifications to the
+         * renderers, and captures the per-frame data the next rendered frame will use. Render thread must be idle when
+         * this is called.
+         */
+        void SyncRenderer();
+
+        /** Hands the synced frame to the render thread. */
+        void KickRenderThread();
+
+        /** Starts the render thread if requested by the start-up description. */
+        void StartRenderThread();
+
+        /** Waits for the frame in flight and terminates the render thread. */
+        void StopRenderThread();
+
+        /** Loop executed by the render thread, rendering one frame each time it is kicked. */
+        void RenderThreadWorker();
+
     protected:
         typedef void(*UpdatePluginFunc)();
 
@@ -178,6 +226,15 @@ namespace te
         ApplicationState _state;
 
         SPtr<PerFrameData> _perFrameData;
+
+        // Render thread
+        Thread _renderThread;
+        Mutex _renderMutex;
+        Signal _renderSignal;
+        bool _renderThreadRunning = false;
+
+        SPtr<PerFrameData> _renderFrameData; /** Same as _perFrameData unless the render thread is enabled */
+        SPtr<EvaluatedAnimationData> _renderAnimationData; /** Copy of the animation data used by the frame in flight */
     };
 
     /**	Provides easy access to CoreApplication. */
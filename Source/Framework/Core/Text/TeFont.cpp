@@ -28,6 +28,39 @@ namespace te
         Resource::Initialize();
     }
 
+    SPtr<const FontBitmap> Font::GetBitmap(UINT32 size) const
+    {
+        if (_fontDataPerSize.size() == 1 && _fontDataPerSize.begin()->second->IsSignedDistanceField)
+            return _fontDataPerSize.begin()->second;
+
+        auto iterFind = _fontDataPerSize.find(size);
+        if (iterFind == _fontDataPerSize.end())
+            return nullptr;
+
+        return iterFind->second;
+    }
+
+    INT32 Font::GetClosestSize(UINT32 size) const
+    {
+        UINT32 minDiff = std::numeric_limits<UINT32>::max();
+        UINT32 bestSize = size;
+
+        for (auto iter = _fontDataPerSize.begin(); iter != _fontDataPerSize.end(); ++iter)
+        {
+            if (iter->first == size)
+                return size;
+
+            const UINT32 diff = iter->first > size ? iter->first - size : size - iter->first;
+            if (diff < minDiff)
+            {
+                minDiff = diff;
+                bestSize = iter->first;
+            }
+        }
+
+        return bestSize;
+    }
+
     HFont Font::Create(const Vector<SPtr<FontBitmap>>& fontData)
     {
         SPtr<Font> newFont = CreatePtr(fontData);
@@ -27,6 +27,15 @@ namespace te
         /** Width of a space in pixels. */
         UINT32 SpaceWidth;
 
+        /**
+         * True if the textures store the signed distance to the glyph outlines, instead of their coverage. Distances are
+         * mapped so 0.5 is on the outline and values above are inside the glyph.
+         */
+        bool IsSignedDistanceField = false;
+
+        /** Distance, in pixels, that maps to 0 or 1 in a signed distance field texture. */
+        UINT32 DistanceFieldSpread = 0;
+
         /** Textures in which the character's pixels are stored. */
         Vector<HTexture> TexturePages;
 
@@ -61,7 +70,17 @@ namespace te
         /** Creates a Font without initializing it. */
         static SPtr<Font> CreateEmpty();
 
-        // TODO
+        /**
+         * Returns font bitmap for a specific font size. Signed distance field fonts return their only bitmap whatever the
+         * size, the caller scaling it by @p size / FontBitmap::Size.
+         *
+         * @param[in]	size	Size of the bitmap in points.
+         * @return				Bitmap object if it exists, nullptr otherwise.
+         */
+        SPtr<const FontBitmap> GetBitmap(UINT32 size) const;
+
+        /** Finds the available font bitmap size closest to the provided size. */
+        INT32 GetClosestSize(UINT32 size) const;
 
     protected:
         friend class FontManager;
@@ -51,6 +51,22 @@ namespace te
         /**	Determines whether the italic font style should be used when rendering. */
         bool Italic = false;
 
+        /**
+         * If true, a single atlas storing the signed distance to the outline of each glyph is generated instead of one
+         * bitmap per entry of FontSizes. The same atlas can then render text at any size, with sharp edges. The render
+         * mode is ignored.
+         */
+        bool SignedDistanceField = false;
+
+        /** Size, in points, the signed distance field atlas is generated for. */
+        UINT32 DistanceFieldSize = 32;
+
+        /**
+         * Distance from the outline, in pixels of the distance field atlas, over which the stored distance goes from
+         * zero to its maximum. Glyphs are padded by this much.
+         */
+        UINT32 DistanceFieldSpread = 4;
+
         /** Creates a new import options object that allows you to customize how are fonts imported. */
         static SPtr<FontImportOptions> Create();
     };
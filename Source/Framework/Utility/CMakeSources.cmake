@@ -23,6 +23,7 @@ set(TE_UTILITY_SRC_THIRDPARTY
 set(TE_UTILITY_INC_MATH
     "Utility/Math/TeAABox.h"
     "Utility/Math/TeBounds.h"
+    "Utility/Math/TeBVH.h"
     "Utility/Math/TeVector2.h"
     "Utility/Math/TeVector2I.h"
     "Utility/Math/TeVector3.h"
@@ -45,10 +46,12 @@ set(TE_UTILITY_INC_MATH
     "Utility/Math/TeLine2.h"
     "Utility/Math/TeMatrixNxM.h"
     "Utility/Math/TeConvexVolume.h"
+    "Utility/Math/TeSIMD.h"
 )
 set(TE_UTILITY_SRC_MATH
     "Utility/Math/TeAABox.cpp"
     "Utility/Math/TeBounds.cpp"
+    "Utility/Math/TeBVH.cpp"
     "Utility/Math/TeVector2.cpp"
     "Utility/Math/TeVector2I.cpp"
     "Utility/Math/TeVector3.cpp"
@@ -86,9 +89,11 @@ set(TE_UTILITY_INC_ERROR
     "Utility/Error/TeConsole.h"
     "Utility/Error/TeError.h"
     "Utility/Error/TeDebug.h"
+    "Utility/Error/TeLog.h"
 )
 set(TE_UTILITY_SRC_ERROR
     "Utility/Error/TeConsole.cpp"
+    "Utility/Error/TeLog.cpp"
 )
 
 set(TE_UTILITY_INC_STRING
@@ -111,6 +116,7 @@ set(TE_UTILITY_INC_UTILITY
     "Utility/Utility/TeTimer.h"
     "Utility/Utility/TeUtility.h"
     "Utility/Utility/TeUUID.h"
+    "Utility/Utility/TeMemoryStats.h"
     "Utility/Utility/TeEvent.h"
     "Utility/Utility/TePlatformUtility.h"
     "Utility/Utility/TeBitwise.h"
@@ -127,6 +133,7 @@ set(TE_UTILITY_SRC_UTILITY
     "Utility/Utility/TeTimer.cpp"
     "Utility/Utility/TeUtility.cpp"
     "Utility/Utility/TeUUID.cpp"
+    "Utility/Utility/TeMemoryStats.cpp"
     "Utility/Utility/TeDataStream.cpp"
     "Utility/Utility/TeFrameAllocator.cpp"
     "Utility/Utility/TeFileSystem.cpp"
@@ -135,6 +142,7 @@ set(TE_UTILITY_SRC_UTILITY
 set(TE_UTILITY_INC_THREADING
     "Utility/Threading/TeThreading.h"
     "Utility/Threading/TeTaskScheduler.h"
+    "Utility/Threading/TeSPSCQueue.h"
 )
 set(TE_UTILITY_SRC_THREADING
     "Utility/Threading/TeTaskScheduler.cpp"
@@ -4,10 +4,9 @@
 #include <fstream>
 #include <cstring>
 
-#if TE_DEBUG_MODE == 1
-#   ifndef TE_DEBUG_FILE
-#       define TE_DEBUG_FILE "Log/Debug.log"
-#   endif
+#ifndef TE_DEBUG_FILE
+#   define TE_DEBUG_FILE "Log/Debug.log"
+#endif
 
 #if TE_PLATFORM == TE_PLATFORM_WIN32 && !defined __FILENAME__
 #   define __FILENAME__ (strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__)
@@ -16,23 +15,35 @@
 #   define __FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
 #endif
 
+// Messages below this verbosity are compiled out. Release builds keep warnings and errors.
+#ifndef TE_LOG_MIN_VERBOSITY
+#   if TE_DEBUG_MODE == 1
+#       define TE_LOG_MIN_VERBOSITY ::te::LogVerbosity::Verbose
+#   else
+#       define TE_LOG_MIN_VERBOSITY ::te::LogVerbosity::Warning
+#   endif
+#endif
+
+/**
+ * Logs a message through the asynchronous logger (see Log). @p verbosity is one of LogVerbosity values, @p category a
+ * string literal and @p message anything that can be written to a std::ostream, including chained << expressions. The
+ * message is not evaluated if its verbosity is filtered out.
+ */
+#ifndef TE_LOG
+#define TE_LOG(verbosity, category, message)                                                                        \
+    {                                                                                                               \
+        if (::te::LogVerbosity::verbosity >= TE_LOG_MIN_VERBOSITY                                                   \
+            && ::te::Log::Instance().IsEnabled(::te::LogVerbosity::verbosity))                                      \
+        {                                                                                                           \
+            ::te::LogMessage logMessage(::te::LogVerbosity::verbosity, category, __FILENAME__, __LINE__, __FUNCTION__); \
+            logMessage.GetStream() << message;                                                                      \
+        }                                                                                                           \
+    }
+#endif
+
+#if TE_DEBUG_MODE == 1
 #   ifndef TE_DEBUG
-#   define TE_DEBUG(message)                                                                     \
-        {                                                                                        \
-            ::std::ofstream logFile(TE_DEBUG_FILE, ::std::ios_base::out | ::std::ios_base::app); \
-                                                                                                 \
-            logFile << "Log: " << __FILENAME__ << ":" << __LINE__ << std::endl;                  \
-            logFile << "Inside " << __FUNCTION__ << std::endl;                                   \
-            logFile << "Date: " << __DATE__ << std::endl;                                        \
-            logFile << "Time: " << __TIME__ << std::endl;                                        \
-            logFile << "Message: " << message << std::endl;                                      \
-            logFile << "############################################: " << std::endl;            \
-                                                                                                 \
-            std::cout << "Log: " << __FILENAME__ << ":" << __LINE__ << std::endl;                \
-            std::cout << "Inside " << __FUNCTION__ << std::endl;                                 \
-            std::cout << "Message: " << message << std::endl;                                    \
-            std::cout << "############################################: " << std::endl;          \
-        }
+#   define TE_DEBUG(message) TE_LOG(Debug, "General", message)
 #   endif
 
 #   ifndef TE_PRINT
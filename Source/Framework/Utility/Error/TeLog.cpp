@@ -0,0 +1,355 @@
+#include "Error/TeLog.h"
+
+#include <chrono>
+#include <ctime>
+
+namespace te
+{
+    namespace
+    {
+        /** Size of the ring buffer allocated for each thread that logs messages. */
+        const UINT32 THREAD_BUFFER_SIZE = 64 * 1024;
+
+        /** Longer messages are truncated so a single message can never fill a whole buffer. */
+        const UINT32 MAX_MESSAGE_LENGTH = THREAD_BUFFER_SIZE / 4;
+
+        /** How often the writer thread checks for new messages when nobody wakes it up. */
+        const UINT32 WRITER_INTERVAL_MS = 10;
+
+        /** Header preceding each message in a thread buffer, followed by the message text. */
+        struct alignas(8) RecordHeader
+        {
+            UINT32 Size; // Including the header and the message, aligned
+            bool IsPadding; // Fills the end of the buffer when a record doesn't fit there, the record starts at 0 instead
+            LogVerbosity Verbosity;
+            UINT32 Line;
+            UINT32 MessageLength;
+            const char* Category;
+            const char* File;
+            const char* Function;
+            INT64 Timestamp; // Microseconds since epoch
+        };
+
+        UINT32 AlignRecordSize(UINT32 size)
+        {
+            return (size + 7) & ~7u;
+        }
+
+        /** Appends [YYYY-MM-DD HH:MM:SS.mmm] for the provided timestamp in microseconds. */
+        void AppendTimestamp(String& output, INT64 timestamp)
+        {
+            std::time_t seconds = (std::time_t)(timestamp / 1000000);
+            UINT32 milliseconds = (UINT32)((timestamp / 1000) % 1000);
+
+            std::tm time = {};
+#if TE_PLATFORM == TE_PLATFORM_WIN32
+            localtime_s(&time, &seconds);
+#else
+            localtime_r(&seconds, &time);
+#endif
+
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "[%04d-%02d-%02d %02d:%02d:%02d.%03u]", time.tm_year + 1900,
+                time.tm_mon + 1, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec, milliseconds);
+
+            output += buffer;
+        }
+
+        /** Stream reused by each LogMessage built on this thread, unless messages are nested. */
+        thread_local std::ostringstream gThreadStream;
+        thread_local bool gThreadStreamInUse = false;
+    }
+
+    /**
+     * Single producer, single consumer ring buffer. Written only by its owning thread, read only by the writer thread.
+     * Positions grow monotonically and are wrapped when accessing the data.
+     */
+    struct Log::ThreadBuffer
+    {
+        UINT8 Data[THREAD_BUFFER_SIZE];
+        std::atomic<UINT64> Head { 0 }; // Next byte written by the owning thread
+        std::atomic<UINT64> Tail { 0 }; // Next byte read by the writer thread
+        std::atomic<bool> Abandoned { false }; // Owning thread exited, buffer can be released once drained
+        UINT32 ThreadIdx = 0;
+    };
+
+    /** Per thread handle, flags the buffer when its thread exits so the writer thread can release it. */
+    struct Log::ThreadBufferHandle
+    {
+        ~ThreadBufferHandle()
+        {
+            if (Buffer)
+                Buffer->Abandoned.store(true, std::memory_order_release);
+        }
+
+        SPtr<ThreadBuffer> Buffer;
+    };
+
+    Log& Log::Instance()
+    {
+        static Log instance;
+        return instance;
+    }
+
+    Log::Log()
+        : _minVerbosity((UINT8)LogVerbosity::Verbose)
+        , _consoleOutput(true)
+        , _nextThreadIdx(0)
+    {
+        _writerThread = Thread([this]() { WriterWorker(); });
+    }
+
+    Log::~Log()
+    {
+        {
+            Lock lock(_writerMutex);
+            _running = false;
+        }
+
+        _writerSignal.notify_all();
+        _writerThread.join();
+    }
+
+    Log::ThreadBuffer& Log::GetThreadBuffer()
+    {
+        thread_local ThreadBufferHandle handle;
+
+        if (!handle.Buffer)
+        {
+            handle.Buffer = te_shared_ptr_new<ThreadBuffer>();
+            handle.Buffer->ThreadIdx = _nextThreadIdx.fetch_add(1, std::memory_order_relaxed);
+
+            Lock lock(_threadBuffersMutex);
+            _threadBuffers.push_back(handle.Buffer);
+        }
+
+        return *handle.Buffer;
+    }
+
+    void Log::Write(LogVerbosity verbosity, const char* category, const char* file, UINT32 line, const char* function,
+        const char* message, UINT32 length)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        length = std::min(length, MAX_MESSAGE_LENGTH);
+        const UINT32 size = AlignRecordSize((UINT32)sizeof(RecordHeader) + length);
+
+        UINT64 head = buffer.Head.load(std::memory_order_relaxed);
+        UINT32 offset = (UINT32)(head % THREAD_BUFFER_SIZE);
+        const UINT32 contiguous = THREAD_BUFFER_SIZE - offset;
+        const UINT32 padding = contiguous < size ? contiguous : 0;
+
+        // Buffer full, wait for the writer thread to catch up. Messages are never dropped.
+        if (head + padding + size - buffer.Tail.load(std::memory_order_acquire) > THREAD_BUFFER_SIZE)
+        {
+            {
+                Lock lock(_writerMutex);
+                _wakeUpRequested = true;
+            }
+
+            _writerSignal.notify_one();
+
+            while (head + padding + size - buffer.Tail.load(std::memory_order_acquire) > THREAD_BUFFER_SIZE)
+                std::this_thread::yield();
+        }
+
+        if (padding > 0)
+        {
+            RecordHeader* paddingHeader = (RecordHeader*)&buffer.Data[offset];
+            paddingHeader->Size = padding;
+            paddingHeader->IsPadding = true;
+
+            head += padding;
+            offset = 0;
+        }
+
+        RecordHeader* header = (RecordHeader*)&buffer.Data[offset];
+        header->Size = size;
+        header->IsPadding = false;
+        header->Verbosity = verbosity;
+        header->Line = line;
+        header->MessageLength = length;
+        header->Category = category;
+        header->File = file;
+        header->Function = function;
+        header->Timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        memcpy(&buffer.Data[offset + sizeof(RecordHeader)], message, length);
+
+        buffer.Head.store(head + size, std::memory_order_release);
+
+        if (verbosity == LogVerbosity::Fatal)
+            Flush();
+    }
+
+    void Log::Flush()
+    {
+        Lock lock(_writerMutex);
+        if (!_running)
+            return;
+
+        const UINT64 request = ++_flushRequests;
+        _writerSignal.notify_one();
+        _flushedSignal.wait(lock, [this, request]() { return _flushesDone >= request; });
+    }
+
+    const char* Log::GetVerbosityName(LogVerbosity verbosity)
+    {
+        switch (verbosity)
+        {
+        case LogVerbosity::Verbose: return "Verbose";
+        case LogVerbosity::Debug: return "Debug";
+        case LogVerbosity::Info: return "Info";
+        case LogVerbosity::Warning: return "Warning";
+        case LogVerbosity::Error: return "Error";
+        case LogVerbosity::Fatal: return "Fatal";
+        default: return "Unknown";
+        }
+    }
+
+    void Log::WriterWorker()
+    {
+        String output;
+
+        while (true)
+        {
+            bool running;
+            UINT64 flushRequests;
+
+            {
+                Lock lock(_writerMutex);
+                _writerSignal.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MS), [this]()
+                {
+                    return _wakeUpRequested || !_running || _flushRequests != _flushesDone;
+                });
+
+                _wakeUpRequested = false;
+                running = _running;
+                flushRequests = _flushRequests;
+            }
+
+            // Messages published before the flush requests were read are guaranteed to be drained here
+            output.clear();
+            if (Drain(output) > 0)
+                WriteOutput(output);
+
+            if (flushRequests > 0)
+            {
+                {
+                    Lock lock(_writerMutex);
+                    _flushesDone = flushRequests;
+                }
+
+                _flushedSignal.notify_all();
+            }
+
+            if (!running)
+                break;
+        }
+    }
+
+    UINT32 Log::Drain(String& output)
+    {
+        Lock lock(_threadBuffersMutex);
+
+        UINT32 numMessages = 0;
+        for (auto iter = _threadBuffers.begin(); iter != _threadBuffers.end();)
+        {
+            ThreadBuffer& buffer = **iter;
+
+            // Read before the head, so a buffer flagged as abandoned is guaranteed to be fully drained below
+            const bool abandoned = buffer.Abandoned.load(std::memory_order_acquire);
+
+            UINT64 tail = buffer.Tail.load(std::memory_order_relaxed);
+            const UINT64 head = buffer.Head.load(std::memory_order_acquire);
+
+            while (tail != head)
+            {
+                const RecordHeader* header = (const RecordHeader*)&buffer.Data[tail % THREAD_BUFFER_SIZE];
+                if (!header->IsPadding)
+                {
+                    AppendTimestamp(output, header->Timestamp);
+
+                    output += "[T" + ToString(buffer.ThreadIdx) + "][";
+                    output += GetVerbosityName(header->Verbosity);
+                    output += "][";
+                    output += header->Category;
+                    output += "] ";
+                    output += header->File;
+                    output += ":" + ToString(header->Line) + " (";
+                    output += header->Function;
+                    output += "): ";
+                    output.append((const char*)(header + 1), header->MessageLength);
+                    output += "\n";
+
+                    numMessages++;
+                }
+
+                tail += header->Size;
+            }
+
+            buffer.Tail.store(tail, std::memory_order_release);
+
+            if (abandoned)
+                iter = _threadBuffers.erase(iter);
+            else
+                ++iter;
+        }
+
+        return numMessages;
+    }
+
+    void Log::WriteOutput(const String& output)
+    {
+        if (!_fileOpenAttempted)
+        {
+            _file.open(TE_DEBUG_FILE, std::ios_base::out | std::ios_base::app);
+            _fileOpenAttempted = true;
+        }
+
+        if (_file.is_open())
+        {
+            _file.write(output.data(), (std::streamsize)output.size());
+            _file.flush();
+        }
+
+        if (_consoleOutput.load(std::memory_order_relaxed))
+        {
+            std::cout.write(output.data(), (std::streamsize)output.size());
+            std::cout.flush();
+        }
+    }
+
+    LogMessage::LogMessage(LogVerbosity verbosity, const char* category, const char* file, UINT32 line,
+        const char* function)
+        : _verbosity(verbosity)
+        , _category(category)
+        , _file(file)
+        , _line(line)
+        , _function(function)
+    {
+        if (!gThreadStreamInUse)
+        {
+            gThreadStreamInUse = true;
+            gThreadStream.str("");
+            gThreadStream.clear();
+
+            _stream = &gThreadStream;
+        }
+        else
+        {
+            _ownedStream = te_unique_ptr_new<std::ostringstream>();
+            _stream = _ownedStream.get();
+        }
+    }
+
+    LogMessage::~LogMessage()
+    {
+        const std::string message = _stream->str();
+        Log::Instance().Write(_verbosity, _category, _file, _line, _function, message.data(), (UINT32)message.size());
+
+        if (_stream == &gThreadStream)
+            gThreadStreamInUse = false;
+    }
+}
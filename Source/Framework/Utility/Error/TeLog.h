@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Threading/TeThreading.h"
+
+#include <atomic>
+#include <sstream>
+
+namespace te
+{
+    /** Severity of a logged message. */
+    enum class LogVerbosity : UINT8
+    {
+        Verbose = 0,
+        Debug = 1,
+        Info = 2,
+        Warning = 3,
+        Error = 4,
+        Fatal = 5
+    };
+
+    /**
+     * Asynchronous logger. Each thread writes its messages into its own lock-free ring buffer, a background writer
+     * thread drains all the buffers and writes them in batches to the log file and to the standard output. Callers
+     * only pay for building the message text and a copy into the ring buffer: headers, timestamps and file I/O are
+     * deferred to the writer thread.
+     *
+     * Usually accessed through TE_LOG and TE_DEBUG macros. Unlike other systems, the logger is not a module as messages
+     * can be logged before any module is started or after they are all shut down. It is created on first use and its
+     * remaining messages are flushed when the application exits.
+     */
+    class TE_UTILITY_EXPORT Log
+    {
+    public:
+        /** Returns the global logger, creating it and starting the writer thread on first call. */
+        static Log& Instance();
+
+        /**
+         * Queues a message. Thread safe and lock-free unless the calling thread's buffer is full, in which case the call
+         * waits until the writer thread makes room for it.
+         *
+         * @param[in]	verbosity	Severity of the message.
+         * @param[in]	category	Category of the message. Must be a string literal, or otherwise outlive the logger.
+         * @param[in]	file		Source file that logged the message, must be a string literal.
+         * @param[in]	line		Source line that logged the message.
+         * @param[in]	function	Function that logged the message, must be a string literal.
+         * @param[in]	message		Message text, copied into the ring buffer.
+         * @param[in]	length		Length of @p message in bytes.
+         */
+        void Write(LogVerbosity verbosity, const char* category, const char* file, UINT32 line, const char* function,
+            const char* message, UINT32 length);
+
+        /** Blocks until all messages logged before this call are written out. */
+        void Flush();
+
+        /** Messages with lower verbosity are discarded at runtime. Messages below TE_LOG_MIN_VERBOSITY are compiled out. */
+        void SetMinVerbosity(LogVerbosity verbosity) { _minVerbosity.store((UINT8)verbosity, std::memory_order_relaxed); }
+
+        /** Checks if messages with the provided verbosity are currently being logged. */
+        bool IsEnabled(LogVerbosity verbosity) const
+        {
+            return (UINT8)verbosity >= _minVerbosity.load(std::memory_order_relaxed);
+        }
+
+        /** Enables or disables writing messages to the standard output, in addition to the log file. */
+        void SetConsoleOutput(bool enabled) { _consoleOutput.store(enabled, std::memory_order_relaxed); }
+
+        /** Returns a human readable name of the provided verbosity. */
+        static const char* GetVerbosityName(LogVerbosity verbosity);
+
+    private:
+        struct ThreadBuffer;
+        struct ThreadBufferHandle;
+
+        Log();
+        ~Log();
+
+        /** Returns the ring buffer of the calling thread, registering a new one if needed. */
+        ThreadBuffer& GetThreadBuffer();
+
+        /** Loop executed by the writer thread. */
+        void WriterWorker();
+
+        /** Drains all the thread buffers into @p output. Returns the number of messages read. Writer thread only. */
+        UINT32 Drain(String& output);
+
+        /** Writes formatted messages to the log file and the console. Writer thread only. */
+        void WriteOutput(const String& output);
+
+    private:
+        Vector<SPtr<ThreadBuffer>> _threadBuffers;
+        Mutex _threadBuffersMutex;
+
+        Thread _writerThread;
+        Mutex _writerMutex;
+        Signal _writerSignal;
+        Signal _flushedSignal;
+        bool _running = true;
+        bool _wakeUpRequested = false;
+        UINT64 _flushRequests = 0;
+        UINT64 _flushesDone = 0;
+
+        std::atomic<UINT8> _minVerbosity;
+        std::atomic<bool> _consoleOutput;
+        std::atomic<UINT32> _nextThreadIdx;
+
+        std::ofstream _file;
+        bool _fileOpenAttempted = false;
+    };
+
+    /**
+     * Builds the text of a single message and hands it to the logger when destroyed. Reuses a stream owned by the calling
+     * thread so no stream has to be allocated per message, unless another message is already being built on this thread
+     * (e.g. a function called while evaluating the message logs something itself).
+     */
+    class TE_UTILITY_EXPORT LogMessage
+    {
+    public:
+        LogMessage(LogVerbosity verbosity, const char* category, const char* file, UINT32 line, const char* function);
+        ~LogMessage();
+
+        LogMessage(const LogMessage&) = delete;
+        LogMessage& operator=(const LogMessage&) = delete;
+
+        /** Returns the stream the message text is written to. */
+        std::ostream& GetStream() { return *_stream; }
+
+    private:
+        LogVerbosity _verbosity;
+        const char* _category;
+        const char* _file;
+        UINT32 _line;
+        const char* _function;
+
+        std::ostringstream* _stream;
+        UPtr<std::ostringstream> _ownedStream;
+    };
+}
@@ -0,0 +1,173 @@
+#include "Math/TeBVH.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Half the surface area of a box, enough to compare costs. */
+        float GetHalfArea(const Vector3& min, const Vector3& max)
+        {
+            const Vector3 size = max - min;
+            return size.x * size.y + size.y * size.z + size.z * size.x;
+        }
+    }
+
+    void BVH::Build(const Vector<AABox>& bounds)
+    {
+        Clear();
+
+        if (bounds.empty())
+            return;
+
+        Vector<Vector3> centers(bounds.size());
+        _items.resize(bounds.size());
+
+        for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
+        {
+            centers[i] = (bounds[i].GetMin() + bounds[i].GetMax()) * 0.5f;
+            _items[i] = i;
+        }
+
+        _nodes.reserve(bounds.size() * 2);
+        BuildNode(bounds, centers, 0, (UINT32)bounds.size(), 0);
+    }
+
+    void BVH::Clear()
+    {
+        _nodes.clear();
+        _items.clear();
+    }
+
+    AABox BVH::GetBounds() const
+    {
+        if (_nodes.empty())
+            return AABox::BOX_EMPTY;
+
+        return AABox(_nodes[0].Min, _nodes[0].Max);
+    }
+
+    UINT32 BVH::BuildNode(const Vector<AABox>& bounds, const Vector<Vector3>& centers, UINT32 start, UINT32 end,
+        UINT32 depth)
+    {
+        const UINT32 nodeIdx = (UINT32)_nodes.size();
+        _nodes.push_back(Node());
+
+        Vector3 min = bounds[_items[start]].GetMin();
+        Vector3 max = bounds[_items[start]].GetMax();
+        Vector3 centerMin = centers[_items[start]];
+        Vector3 centerMax = centerMin;
+
+        for (UINT32 i = start + 1; i < end; i++)
+        {
+            min.Min(bounds[_items[i]].GetMin());
+            max.Max(bounds[_items[i]].GetMax());
+            centerMin.Min(centers[_items[i]]);
+            centerMax.Max(centers[_items[i]]);
+        }
+
+        _nodes[nodeIdx].Min = min;
+        _nodes[nodeIdx].Max = max;
+
+        const UINT32 count = end - start;
+
+        // Split along the axis the centers are the most spread on
+        const Vector3 centerExtent = centerMax - centerMin;
+        UINT32 axis = 0;
+        if (centerExtent.y > centerExtent[axis])
+            axis = 1;
+        if (centerExtent.z > centerExtent[axis])
+            axis = 2;
+
+        if (count <= MAX_LEAF_SIZE || depth >= MAX_DEPTH || centerExtent[axis] <= 0.0f)
+        {
+            _nodes[nodeIdx].Start = start;
+            _nodes[nodeIdx].Count = count;
+            return nodeIdx;
+        }
+
+        struct Bin
+        {
+            Vector3 Min = Vector3(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                std::numeric_limits<float>::max());
+            Vector3 Max = -Min;
+            UINT32 Count = 0;
+        };
+
+        Bin bins[NUM_BINS];
+        const float binScale = NUM_BINS / centerExtent[axis];
+
+        auto getBin = [&](UINT32 item)
+        {
+            const UINT32 bin = (UINT32)((centers[item][axis] - centerMin[axis]) * binScale);
+            return std::min(bin, NUM_BINS - 1);
+        };
+
+        for (UINT32 i = start; i < end; i++)
+        {
+            Bin& bin = bins[getBin(_items[i])];
+            bin.Min.Min(bounds[_items[i]].GetMin());
+            bin.Max.Max(bounds[_items[i]].GetMax());
+            bin.Count++;
+        }
+
+        // Cost of the items on the right of each split plane, swept from the right
+        float rightCosts[NUM_BINS];
+        {
+            Bin right;
+            for (UINT32 i = NUM_BINS - 1; i > 0; i--)
+            {
+                right.Min.Min(bins[i].Min);
+                right.Max.Max(bins[i].Max);
+                right.Count += bins[i].Count;
+
+                rightCosts[i] = right.Count > 0 ? GetHalfArea(right.Min, right.Max) * right.Count : 0.0f;
+            }
+        }
+
+        UINT32 bestSplit = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        {
+            Bin left;
+            for (UINT32 i = 1; i < NUM_BINS; i++)
+            {
+                left.Min.Min(bins[i - 1].Min);
+                left.Max.Max(bins[i - 1].Max);
+                left.Count += bins[i - 1].Count;
+
+                if (left.Count == 0 || left.Count == count)
+                    continue;
+
+                const float cost = GetHalfArea(left.Min, left.Max) * left.Count + rightCosts[i];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        UINT32 mid;
+        if (bestSplit > 0)
+        {
+            auto iterMid = std::partition(_items.begin() + start, _items.begin() + end,
+                [&](UINT32 item) { return getBin(item) < bestSplit; });
+
+            mid = (UINT32)(iterMid - _items.begin());
+        }
+        else
+        {
+            // All the centers fell in a single bin, fall back to a median split
+            mid = start + count / 2;
+            std::nth_element(_items.begin() + start, _items.begin() + mid, _items.begin() + end,
+                [&](UINT32 a, UINT32 b) { return centers[a][axis] < centers[b][axis]; });
+        }
+
+        BuildNode(bounds, centers, start, mid, depth + 1);
+        const UINT32 right = BuildNode(bounds, centers, mid, end, depth + 1);
+
+        _nodes[nodeIdx].Start = right;
+        _nodes[nodeIdx].Count = 0;
+
+        return nodeIdx;
+    }
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Math/TeAABox.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    /**
+     * Bounding volume hierarchy over a set of axis aligned boxes, used to find the items a ray hits without testing all of
+     * them. Built top-down with the surface area heuristic, evaluated over a fixed number of bins per axis.
+     */
+    class TE_UTILITY_EXPORT BVH
+    {
+    public:
+        BVH() = default;
+
+        /** Builds the hierarchy over the provided boxes. Items are then identified by their index in @p bounds. */
+        void Build(const Vector<AABox>& bounds);
+
+        /** Removes all the items. */
+        void Clear();
+
+        /** Returns the number of items the hierarchy was built with. */
+        UINT32 GetNumItems() const { return (UINT32)_items.size(); }
+
+        /** Returns the box bounding all the items. Only valid if there is at least one item. */
+        AABox GetBounds() const;
+
+        /**
+         * Finds the closest item hit by a ray. Nodes are visited front to back, and skipped once they are further away than
+         * the closest hit found so far.
+         *
+         * @param[in]		origin		Origin of the ray.
+         * @param[in]		direction	Direction of the ray. Doesn't need to be normalized, distances are then measured
+         *								in multiples of its length.
+         * @param[in, out]	distance	Maximum distance to look for hits at. Receives the distance of the closest hit.
+         * @param[in]		test		Called as test(item, distance) for each item whose box the ray hits. Must return
+         *								true and update distance if the item is hit closer than distance.
+         * @return						Index of the closest item hit, or -1 if none.
+         */
+        template<class T>
+        INT32 RayCast(const Vector3& origin, const Vector3& direction, float& distance, T test) const
+        {
+            if (_nodes.empty())
+                return -1;
+
+            const Vector3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+            INT32 closestItem = -1;
+            UINT32 stack[64];
+            UINT32 stackSize = 0;
+
+            float entry;
+            if (!IntersectsNode(_nodes[0], origin, invDirection, distance, entry))
+                return -1;
+
+            stack[stackSize++] = 0;
+            while (stackSize > 0)
+            {
+                const Node& node = _nodes[stack[--stackSize]];
+
+                if (node.Count > 0)
+                {
+                    for (UINT32 i = node.Start; i < node.Start + node.Count; i++)
+                    {
+                        if (test(_items[i], distance))
+                            closestItem = (INT32)_items[i];
+                    }
+
+                    continue;
+                }
+
+                // Push the farthest child first so the closest one is visited next
+                const UINT32 left = (UINT32)(&node - &_nodes[0]) + 1;
+                const UINT32 right = node.Start;
+
+                float leftEntry, rightEntry;
+                const bool hitLeft = IntersectsNode(_nodes[left], origin, invDirection, distance, leftEntry);
+                const bool hitRight = IntersectsNode(_nodes[right], origin, invDirection, distance, rightEntry);
+
+                if (hitLeft && hitRight)
+                {
+                    const bool leftFirst = leftEntry <= rightEntry;
+                    stack[stackSize++] = leftFirst ? right : left;
+                    stack[stackSize++] = leftFirst ? left : right;
+                }
+                else if (hitLeft)
+                    stack[stackSize++] = left;
+                else if (hitRight)
+                    stack[stackSize++] = right;
+            }
+
+            return closestItem;
+        }
+
+        /**
+         * Finds the items that may overlap a volume. Nodes whose box the volume doesn't overlap are skipped with all their
+         * items, items of the remaining leaves are reported without looking at their own box.
+         *
+         * @param[in]	overlaps	Called as overlaps(box) for the box of each visited node. Must return false if the
+         *							volume doesn't overlap the box.
+         * @param[in]	onItem		Called as onItem(item) for each item of the leaves the volume overlaps.
+         */
+        template<class T, class U>
+        void Query(T overlaps, U onItem) const
+        {
+            if (_nodes.empty() || !overlaps(AABox(_nodes[0].Min, _nodes[0].Max)))
+                return;
+
+            UINT32 stack[64];
+            UINT32 stackSize = 0;
+
+            stack[stackSize++] = 0;
+            while (stackSize > 0)
+            {
+                const Node& node = _nodes[stack[--stackSize]];
+
+                if (node.Count > 0)
+                {
+                    for (UINT32 i = node.Start; i < node.Start + node.Count; i++)
+                        onItem(_items[i]);
+
+                    continue;
+                }
+
+                const UINT32 left = (UINT32)(&node - &_nodes[0]) + 1;
+                const UINT32 right = node.Start;
+
+                if (overlaps(AABox(_nodes[right].Min, _nodes[right].Max)))
+                    stack[stackSize++] = right;
+                if (overlaps(AABox(_nodes[left].Min, _nodes[left].Max)))
+                    stack[stackSize++] = left;
+            }
+        }
+
+    private:
+        /**
+         * Node of the hierarchy. Leaves reference Count items from Start in _items. Inner nodes have Count == 0, their
+         * left child directly follows them and Start is the index of their right child.
+         */
+        struct Node
+        {
+            Vector3 Min;
+            Vector3 Max;
+            UINT32 Start;
+            UINT32 Count;
+        };
+
+        /** Checks if a ray hits a node closer than @p maxDistance, and outputs the distance it enters the node at. */
+        static bool IntersectsNode(const Node& node, const Vector3& origin, const Vector3& invDirection,
+            float maxDistance, float& entry)
+        {
+            float tMin = 0.0f;
+            float tMax = maxDistance;
+
+            for (UINT32 axis = 0; axis < 3; axis++)
+            {
+                float t0 = (node.Min[axis] - origin[axis]) * invDirection[axis];
+                float t1 = (node.Max[axis] - origin[axis]) * invDirection[axis];
+
+                if (t0 > t1)
+                    std::swap(t0, t1);
+
+                // Written so NaNs, from a zero direction on a slab boundary, keep the previous range
+                tMin = t0 > tMin ? t0 : tMin;
+                tMax = t1 < tMax ? t1 : tMax;
+
+                if (tMin > tMax)
+                    return false;
+            }
+
+            entry = tMin;
+            return true;
+        }
+
+        /** Builds the subtree of the items [@p start, @p end) of _items, and returns the index of its root node. */
+        UINT32 BuildNode(const Vector<AABox>& bounds, const Vector<Vector3>& centers, UINT32 start, UINT32 end,
+            UINT32 depth);
+
+    private:
+        Vector<Node> _nodes;
+        Vector<UINT32> _items;
+
+        static constexpr UINT32 MAX_LEAF_SIZE = 4;
+        static constexpr UINT32 NUM_BINS = 16;
+        static constexpr UINT32 MAX_DEPTH = 60; // Keeps the traversal stack in bounds
+    };
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Math/TeMatrix4.h"
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace te
+{
+    /**
+     * Small set of SSE helpers used by data oriented code paths (animation, culling, ...). All supported architectures
+     * are x86 so SSE2 is always available. Data is always loaded unaligned, so callers don't need to care about
+     * alignment of their arrays.
+     */
+    class SIMD
+    {
+    public:
+        typedef __m128 Float4;
+
+        /** Loads 4 consecutive floats. */
+        static Float4 Load(const float* data) { return _mm_loadu_ps(data); }
+
+        /** Stores 4 consecutive floats. */
+        static void Store(float* data, Float4 value) { _mm_storeu_ps(data, value); }
+
+        /** Returns a value with all 4 lanes set to @p value. */
+        static Float4 Splat(float value) { return _mm_set1_ps(value); }
+
+        /** Returns a value with the lanes set to (x, y, z, w). */
+        static Float4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+
+        /** Returns a value with all 4 lanes set to zero. */
+        static Float4 Zero() { return _mm_setzero_ps(); }
+
+        static Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+        static Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+        static Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+        static Float4 Div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+        static Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+        static Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+        static Float4 Sqrt(Float4 a) { return _mm_sqrt_ps(a); }
+        static Float4 And(Float4 a, Float4 b) { return _mm_and_ps(a, b); }
+        static Float4 Or(Float4 a, Float4 b) { return _mm_or_ps(a, b); }
+
+        /** Clears the sign bit of each lane. */
+        static Float4 Abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+        /** Returns a * b + c. */
+        static Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+        /** Returns a lane mask with all bits set in lanes where a > b. */
+        static Float4 Greater(Float4 a, Float4 b) { return _mm_cmpgt_ps(a, b); }
+
+        /** Returns a lane mask with all bits set in lanes where a != b. */
+        static Float4 NotEqual(Float4 a, Float4 b) { return _mm_cmpneq_ps(a, b); }
+
+        /** Picks lanes from @p a where @p mask is set, and from @p b otherwise. */
+        static Float4 Select(Float4 mask, Float4 a, Float4 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        /** Returns a 4-bit mask made out of the sign bit of each lane. */
+        static int MoveMask(Float4 a) { return _mm_movemask_ps(a); }
+
+        /** Broadcasts the lane @p idx of @p a to all lanes. */
+        template<int idx>
+        static Float4 Broadcast(Float4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(idx, idx, idx, idx)); }
+
+        /** Transposes a 4x4 block stored in 4 registers. */
+        static void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+        /**
+         * Multiplies two matrices and writes the result in @p out. @p out is allowed to alias either of the
+         * inputs.
+         */
+        static void Multiply(const Matrix4& lhs, const Matrix4& rhs, Matrix4& out)
+        {
+            const Float4 b0 = Load(&rhs[0].x);
+            const Float4 b1 = Load(&rhs[1].x);
+            const Float4 b2 = Load(&rhs[2].x);
+            const Float4 b3 = Load(&rhs[3].x);
+
+            Float4 rows[4];
+            for (UINT32 i = 0; i < 4; i++)
+            {
+                const Float4 a = Load(&lhs[i].x);
+
+                Float4 r = Mul(Broadcast<0>(a), b0);
+                r = MulAdd(Broadcast<1>(a), b1, r);
+                r = MulAdd(Broadcast<2>(a), b2, r);
+                r = MulAdd(Broadcast<3>(a), b3, r);
+                rows[i] = r;
+            }
+
+            for (UINT32 i = 0; i < 4; i++)
+                Store(&out[i].x, rows[i]);
+        }
+
+        /**
+         * Builds four translation/rotation/scale matrices at once from values stored in SoA form (one lane per matrix).
+         * Rotations are expected to be normalized.
+         *
+         * @param[in]	tx, ty, tz		Translation components.
+         * @param[in]	qx, qy, qz, qw	Rotation quaternion components.
+         * @param[in]	sx, sy, sz		Scale components.
+         * @param[out]	out				Array of (at least) @p count matrices to write to.
+         * @param[in]	count			Number of lanes to output, in range [1, 4].
+         */
+        static void TRS4(Float4 tx, Float4 ty, Float4 tz, Float4 qx, Float4 qy, Float4 qz, Float4 qw,
+            Float4 sx, Float4 sy, Float4 sz, Matrix4* out, UINT32 count = 4)
+        {
+            const Float4 one = Splat(1.0f);
+
+            const Float4 x2 = Add(qx, qx);
+            const Float4 y2 = Add(qy, qy);
+            const Float4 z2 = Add(qz, qz);
+            const Float4 wx = Mul(x2, qw);
+            const Float4 wy = Mul(y2, qw);
+            const Float4 wz = Mul(z2, qw);
+            const Float4 xx = Mul(x2, qx);
+            const Float4 xy = Mul(y2, qx);
+            const Float4 xz = Mul(z2, qx);
+            const Float4 yy = Mul(y2, qy);
+            const Float4 yz = Mul(z2, qy);
+            const Float4 zz = Mul(z2, qz);
+
+            // Same layout as Matrix4::SetTRS (scale is applied per column)
+            Float4 r00 = Mul(Sub(one, Add(yy, zz)), sx);
+            Float4 r01 = Mul(Sub(xy, wz), sy);
+            Float4 r02 = Mul(Add(xz, wy), sz);
+            Float4 r03 = tx;
+
+            Float4 r10 = Mul(Add(xy, wz), sx);
+            Float4 r11 = Mul(Sub(one, Add(xx, zz)), sy);
+            Float4 r12 = Mul(Sub(yz, wx), sz);
+            Float4 r13 = ty;
+
+            Float4 r20 = Mul(Sub(xz, wy), sx);
+            Float4 r21 = Mul(Add(yz, wx), sy);
+            Float4 r22 = Mul(Sub(one, Add(xx, yy)), sz);
+            Float4 r23 = tz;
+
+            Transpose(r00, r01, r02, r03);
+            Transpose(r10, r11, r12, r13);
+            Transpose(r20, r21, r22, r23);
+
+            const Float4 row0[4] = { r00, r01, r02, r03 };
+            const Float4 row1[4] = { r10, r11, r12, r13 };
+            const Float4 row2[4] = { r20, r21, r22, r23 };
+            const Float4 row3 = Set(0.0f, 0.0f, 0.0f, 1.0f);
+
+            for (UINT32 i = 0; i < count; i++)
+            {
+                Store(&out[i][0].x, row0[i]);
+                Store(&out[i][1].x, row1[i]);
+                Store(&out[i][2].x, row2[i]);
+                Store(&out[i][3].x, row3);
+            }
+        }
+    };
+}
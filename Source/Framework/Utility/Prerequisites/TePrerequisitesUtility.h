@@ -103,3 +103,5 @@
 #include "Utility/TeUtility.h"
 
 #include "Utility/TeUUID.h"
+
+#include "Error/TeLog.h"
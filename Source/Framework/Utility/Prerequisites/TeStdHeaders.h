@@ -70,6 +70,13 @@ extern "C" {
 #   define TE_SLEEP(ms) usleep(ms)
 #endif
 
+/** Address the current function returns to, used to find out where allocations are made from. */
+#if TE_COMPILER == TE_COMPILER_MSVC
+#   define TE_RETURN_ADDRESS() _ReturnAddress()
+#else
+#   define TE_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
 namespace te
 {
     /* ###################################################################
@@ -118,47 +125,174 @@ namespace te
     }
 #endif
 
+#ifndef TE_MEMORY_TRACKING
+    /**
+     * If enabled, allocations made through MemoryAllocator are prefixed with a small header so they can be accounted per
+     * category (see MemoryStats). Memory obtained from it must always be released through it as well.
+     */
+#   define TE_MEMORY_TRACKING 1
+#endif
+
+    /** Categories memory allocations are accounted under. See MemoryStats. */
+    enum class MemoryCategory : uint8_t
+    {
+        General,
+        Mesh,
+        Texture,
+        Animation,
+        Physics,
+        Audio,
+        Renderer,
+        Scene,
+        Frame, /**< Blocks owned by frame allocators. */
+        Pool, /**< Blocks owned by pool allocators. */
+        Count
+    };
+
+    /**
+     * Receives notifications about allocations and deallocations, for memory accounting. Allocators that get their
+     * memory from elsewhere than MemoryAllocator can report it here so it still shows up in MemoryStats.
+     */
+    class TE_UTILITY_EXPORT MemoryTracker
+    {
+    public:
+        /**
+         * Notifies the tracker @p bytes were allocated under the provided category, from @p callSite (see
+         * TE_RETURN_ADDRESS()). Thread safe.
+         */
+        static void OnAllocate(MemoryCategory category, size_t bytes, void* callSite = nullptr);
+
+        /** Notifies the tracker @p bytes previously allocated under the provided category were freed. Thread safe. */
+        static void OnFree(MemoryCategory category, size_t bytes);
+    };
+
+#if TE_MEMORY_TRACKING
+    /** Placed right before each block returned by MemoryAllocator. */
+    struct MemoryAllocationHeader
+    {
+        /** Space reserved for the header. Keeps the 16 byte alignment of the underlying allocation. */
+        static constexpr size_t SIZE = 16;
+
+        size_t Size;
+        uint32_t Offset; // From the start of the underlying allocation to the returned block
+        MemoryCategory Category;
+
+        /**
+         * Writes the header for a block starting at @p offset bytes into @p data, and returns the block. @p callSite is
+         * where the allocation was requested from.
+         */
+        static void* Write(void* data, size_t offset, size_t bytes, MemoryCategory category, void* callSite)
+        {
+            if (data == nullptr)
+                return nullptr;
+
+            uint8_t* block = (uint8_t*)data + offset;
+
+            MemoryAllocationHeader* header = (MemoryAllocationHeader*)(block - SIZE);
+            header->Size = bytes;
+            header->Offset = (uint32_t)offset;
+            header->Category = category;
+
+            MemoryTracker::OnAllocate(category, bytes, callSite);
+            return block;
+        }
+
+        /** Reads the header of a block returned by Write() and returns the underlying allocation. */
+        static void* Release(void* block)
+        {
+            const MemoryAllocationHeader* header = (const MemoryAllocationHeader*)((uint8_t*)block - SIZE);
+            MemoryTracker::OnFree(header->Category, header->Size);
+
+            return (uint8_t*)block - header->Offset;
+        }
+    };
+
+    static_assert(sizeof(MemoryAllocationHeader) <= MemoryAllocationHeader::SIZE, "Memory header too large.");
+#endif
+
     /**
-    * Memory allocator providing a generic implementation. Specialize for specific categories as needed.
+    * Memory allocator providing a generic implementation. Every allocation is accounted under a MemoryCategory when
+    * TE_MEMORY_TRACKING is enabled. The call site defaults to the function calling the allocator; te_allocate() and the
+    * other helpers forward their own caller instead.
     */
     class MemoryAllocator
     {
     public:
-        static void* Allocate(size_t bytes)
+        static void* Allocate(size_t bytes, MemoryCategory category = MemoryCategory::General,
+            void* callSite = TE_RETURN_ADDRESS())
         {
+#if TE_MEMORY_TRACKING
+            return MemoryAllocationHeader::Write(::malloc(bytes + MemoryAllocationHeader::SIZE),
+                MemoryAllocationHeader::SIZE, bytes, category, callSite);
+#else
             return ::malloc(bytes);
+#endif
         }
 
         static void Deallocate(void* ptr)
         {
+#if TE_MEMORY_TRACKING
+            if (ptr == nullptr)
+                return;
+
+            ::free(MemoryAllocationHeader::Release(ptr));
+#else
             ::free(ptr);
+#endif
         }
 
         /**
          * Allocates @p bytes and aligns them to the specified boundary (in bytes). If the aligment is less or equal to
          * 16 it is more efficient to use the allocateAligned16() alternative of this method. Alignment must be power of two.
          */
-        static void* AllocateAligned(size_t bytes, size_t alignment)
+        static void* AllocateAligned(size_t bytes, size_t alignment, MemoryCategory category = MemoryCategory::General,
+            void* callSite = TE_RETURN_ADDRESS())
         {
+#if TE_MEMORY_TRACKING
+            const size_t offset = alignment > MemoryAllocationHeader::SIZE ? alignment : MemoryAllocationHeader::SIZE;
+            return MemoryAllocationHeader::Write(PlatformAlignedAllocate(bytes + offset, offset), offset, bytes, category,
+                callSite);
+#else
             return PlatformAlignedAllocate(bytes, alignment);
+#endif
         }
 
         /** Allocates @p bytes and aligns them to a 16 byte boundary. */
-        static void* AllocateAligned16(size_t bytes)
+        static void* AllocateAligned16(size_t bytes, MemoryCategory category = MemoryCategory::General,
+            void* callSite = TE_RETURN_ADDRESS())
         {
+#if TE_MEMORY_TRACKING
+            return MemoryAllocationHeader::Write(PlatformAlignedAllocate16(bytes + MemoryAllocationHeader::SIZE),
+                MemoryAllocationHeader::SIZE, bytes, category, callSite);
+#else
             return PlatformAlignedAllocate16(bytes);
+#endif
         }
 
         /** Frees memory allocated with allocateAligned */
         static void FreeAligned(void* ptr)
         {
+#if TE_MEMORY_TRACKING
+            if (ptr == nullptr)
+                return;
+
+            PlatformAlignedFree(MemoryAllocationHeader::Release(ptr));
+#else
             PlatformAlignedFree(ptr);
+#endif
         }
 
         /** Frees memory allocated with allocateAligned16 */
         static void FreeAligned16(void* ptr)
         {
+#if TE_MEMORY_TRACKING
+            if (ptr == nullptr)
+                return;
+
+            PlatformAlignedFree16(MemoryAllocationHeader::Release(ptr));
+#else
             PlatformAlignedFree16(ptr);
+#endif
         }
     };
 
@@ -167,7 +301,7 @@ namespace te
     */
     inline void* te_allocate(uint32_t count)
     {
-        return MemoryAllocator::Allocate(count);
+        return MemoryAllocator::Allocate(count, MemoryCategory::General, TE_RETURN_ADDRESS());
     }
 
     /**
@@ -176,7 +310,21 @@ namespace te
     template<class T>
     inline T* te_allocate(uint32_t count)
     {
-        return (T*)MemoryAllocator::Allocate(count);
+        return (T*)MemoryAllocator::Allocate(count, MemoryCategory::General, TE_RETURN_ADDRESS());
+    }
+
+    /** Allocates the specified number of bytes, accounted under the provided memory category. */
+    template<MemoryCategory Category>
+    inline void* te_allocate(size_t count)
+    {
+        return MemoryAllocator::Allocate(count, Category, TE_RETURN_ADDRESS());
+    }
+
+    /** Allocates enough bytes to hold the specified type, accounted under the provided category, without constructing it. */
+    template<class T, MemoryCategory Category>
+    inline T* te_allocate()
+    {
+        return (T*)MemoryAllocator::Allocate(sizeof(T), Category, TE_RETURN_ADDRESS());
     }
 
     /**
@@ -185,13 +333,13 @@ namespace te
      */
     inline void* te_allocate_aligned(size_t count, size_t align)
     {
-        return MemoryAllocator::AllocateAligned(count, align);
+        return MemoryAllocator::AllocateAligned(count, align, MemoryCategory::General, TE_RETURN_ADDRESS());
     }
 
     /** Allocates the specified number of bytes aligned to a 16 bytes boundary. */
     inline void* te_allocate_aligned16(size_t count)
     {
-        return MemoryAllocator::AllocateAligned16(count);
+        return MemoryAllocator::AllocateAligned16(count, MemoryCategory::General, TE_RETURN_ADDRESS());
     }
 
     /** Frees memory previously allocated with bs_alloc_aligned(). */
@@ -212,21 +360,21 @@ namespace te
     template<class T>
     inline T* te_allocate()
     {
-        return (T*)MemoryAllocator::Allocate(sizeof(T));
+        return (T*)MemoryAllocator::Allocate(sizeof(T), MemoryCategory::General, TE_RETURN_ADDRESS());
     }
 
     /** Allocates enough bytes to hold an array of @p count elements the specified type, but doesn't construct them. */
     template<class T>
     T* te_allocateN(size_t count)
     {
-        return (T*)MemoryAllocator::Allocate(count * sizeof(T));
+        return (T*)MemoryAllocator::Allocate(count * sizeof(T), MemoryCategory::General, TE_RETURN_ADDRESS());
     }
 
     /** Creates and constructs an array of @p count elements. */
     template<class T>
     T* te_newN(uint32_t count)
     {
-        T* ptr = (T*)te_allocate<T>(sizeof(T) * count);
+        T* ptr = (T*)MemoryAllocator::Allocate(sizeof(T) * count, MemoryCategory::General, TE_RETURN_ADDRESS());
 
         for (size_t i = 0; i < count; ++i)
             new (&ptr[i]) T;
@@ -240,7 +388,8 @@ namespace te
     template<class Type, class... Args>
     inline Type* te_new(Args &&...args)
     {
-        return new (te_allocate<Type>(sizeof(Type))) Type(std::forward<Args>(args)...);
+        return new (MemoryAllocator::Allocate(sizeof(Type), MemoryCategory::General, TE_RETURN_ADDRESS()))
+            Type(std::forward<Args>(args)...);
     }
 
     /**
@@ -500,12 +649,13 @@ namespace te
     }
 
     /**
-    * Create a new unique pointer using a custom allocator category.
+    * Create a new unique pointer. UPtr releases its object with the standard delete, so the object is allocated with
+    * the standard new rather than te_new.
     */
     template<class Type, class... Args>
     UPtr<Type> te_unique_ptr_new(Args &&... args)
     {
-        Type* rawPtr = te_new<Type>(std::forward<Args>(args)...);
+        Type* rawPtr = new Type(std::forward<Args>(args)...);
         return te_unique_ptr<Type>(rawPtr);
     }
 }
@@ -2,6 +2,8 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -186,4 +188,49 @@ namespace te
         te_free(buffer);
         return wd;
     }
+
+    bool MappedFile::Open(const String& path)
+    {
+        Close();
+
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            HANDLE_PATH_ERROR(path, errno);
+            return false;
+        }
+
+        struct stat st_buf;
+        if (fstat(file, &st_buf) != 0 || st_buf.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+
+        void* data = mmap(nullptr, (size_t)st_buf.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping keeps its own reference to the file
+        close(file);
+
+        if (data == MAP_FAILED)
+        {
+            HANDLE_PATH_ERROR(path, errno);
+            return false;
+        }
+
+        _data = (UINT8*)data;
+        _size = (UINT64)st_buf.st_size;
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (_data == nullptr)
+            return;
+
+        munmap(_data, (size_t)_size);
+        _data = nullptr;
+        _size = 0;
+    }
 }
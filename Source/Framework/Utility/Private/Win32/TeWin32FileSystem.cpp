@@ -320,4 +320,60 @@ namespace te
         const String utf8dir = UTF8::FromWide(win32_getCurrentDirectory());
         return utf8dir;
     }
+
+    bool MappedFile::Open(const String& path)
+    {
+        Close();
+
+        const WString widePath = UTF8::ToWide(path);
+        HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            win32_handleError(GetLastError(), widePath);
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) == FALSE || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            win32_handleError(GetLastError(), widePath);
+            CloseHandle(file);
+            return false;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+        // The view keeps its own references to the mapping and the file
+        CloseHandle(mapping);
+        CloseHandle(file);
+
+        if (data == nullptr)
+        {
+            win32_handleError(GetLastError(), widePath);
+            return false;
+        }
+
+        _data = (UINT8*)data;
+        _size = (UINT64)size.QuadPart;
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (_data == nullptr)
+            return;
+
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+        _size = 0;
+    }
 }
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+#include <atomic>
+
+namespace te
+{
+    /**
+     * Queue of fixed capacity with a single producer thread and a single consumer thread, that doesn't lock. Each side
+     * only writes its own index and reads the index of the other side to know how many elements it can use.
+     *
+     * @tparam	T			Type of the elements. Popped elements are moved out of the queue.
+     * @tparam	Capacity	Maximum number of elements in the queue. Must be a power of two.
+     */
+    template<class T, UINT32 Capacity>
+    class SPSCQueue
+    {
+        static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        SPSCQueue() = default;
+
+        SPSCQueue(const SPSCQueue&) = delete;
+        SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+        /**
+         * Adds an element at the end of the queue. Returns false if the queue is full, in which case @p value is left
+         * untouched. Producer thread only.
+         */
+        template<class U>
+        bool Push(U&& value)
+        {
+            const UINT32 tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _head.load(std::memory_order_acquire) == Capacity)
+                return false;
+
+            _items[tail & (Capacity - 1)] = std::forward<U>(value);
+            _tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /** Removes the first element of the queue and writes it to @p value. Returns false if the queue is empty. Consumer thread only. */
+        bool Pop(T& value)
+        {
+            const UINT32 head = _head.load(std::memory_order_relaxed);
+            if (head == _tail.load(std::memory_order_acquire))
+                return false;
+
+            value = std::move(_items[head & (Capacity - 1)]);
+            _head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /** Checks if the queue is empty. The result can be outdated as soon as it is returned if called from another thread. */
+        bool IsEmpty() const
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        // Indices only increase and wrap around, on separate cache lines so both threads don't keep invalidating each other
+        alignas(64) std::atomic<UINT32> _head{ 0 };
+        alignas(64) std::atomic<UINT32> _tail{ 0 };
+        T _items[Capacity];
+    };
+}
@@ -44,6 +44,12 @@ namespace te
         }        
     }
 
+    void Task::Wait() const
+    {
+        while (!IsComplete() && !IsCanceled())
+            std::this_thread::yield();
+    }
+
     TaskScheduler::TaskScheduler()
         : _shutdown(false)
         , _threadCount(0)
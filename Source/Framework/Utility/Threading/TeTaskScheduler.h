@@ -38,6 +38,9 @@ namespace te
         /** Calls worker method */
         void Execute();
 
+        /** Blocks the calling thread until the task is either completed or canceled. */
+        void Wait() const;
+
     private:
         friend class TaskScheduler;
 
@@ -100,4 +103,35 @@ namespace te
     };
 
     TE_UTILITY_EXPORT TaskScheduler& gTaskScheduler();
+
+    /**
+     * Calls @p worker(begin, end) over ranges of at most @p rangeSize items covering [0, @p count), spread over the task
+     * scheduler if it is running. The calling thread processes the last range itself, and returns once all ranges are
+     * done.
+     */
+    template<class T>
+    void ParallelFor(const String& name, UINT32 count, UINT32 rangeSize, const T& worker)
+    {
+        if (!TaskScheduler::IsStarted() || count <= rangeSize)
+        {
+            worker(0, count);
+            return;
+        }
+
+        Vector<SPtr<Task>> tasks;
+        UINT32 begin = 0;
+        for (; begin + rangeSize < count; begin += rangeSize)
+        {
+            const UINT32 end = begin + rangeSize;
+            SPtr<Task> task = Task::Create(name, [&worker, begin, end]() { worker(begin, end); });
+
+            gTaskScheduler().AddTask(task);
+            tasks.push_back(task);
+        }
+
+        worker(begin, count);
+
+        for (auto& task : tasks)
+            task->Wait();
+    }
 }
@@ -112,6 +112,44 @@ namespace te
         static String GetWorkingDirectoryPath();
     };
 
+    /**
+     * Read-only view of the content of a file, mapped in memory by the OS. Pages are only read from the disk when they
+     * are first accessed, and no copy of the file is made, so it can be read in place.
+     */
+    class TE_UTILITY_EXPORT MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * Maps the content of a file. Closes the previously mapped file, if any.
+         *
+         * @param[in]	path	Path to the file.
+         * @return				False if the file can't be opened or is empty.
+         */
+        bool Open(const String& path);
+
+        /** Unmaps the file. Pointers returned by GetData() are no longer valid. */
+        void Close();
+
+        /** Checks if a file is currently mapped. */
+        bool IsOpen() const { return _data != nullptr; }
+
+        /** Returns the content of the file. */
+        const UINT8* GetData() const { return _data; }
+
+        /** Returns the size of the file in bytes. */
+        UINT64 GetSize() const { return _size; }
+
+    private:
+        UINT8* _data = nullptr;
+        UINT64 _size = 0;
+    };
+
     /**
      * Locks access to files on the same drive, allowing only one file to be read at a time, per drive. This prevents
      * multiple threads accessing multiple files on the same drive at once, ruining performance on mechanical drives.
@@ -257,7 +257,7 @@ namespace te
         {
             UINT32 alignOffset = 16 - (sizeof(MemBlock) & (16 - 1));
 
-            UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(te_allocate_aligned16(blockSize + sizeof(MemBlock) + alignOffset));
+            UINT8* data = (UINT8*)MemoryAllocator::AllocateAligned16(blockSize + sizeof(MemBlock) + alignOffset, MemoryCategory::Frame);
             newBlock = new (data) MemBlock(blockSize);
             data += sizeof(MemBlock) + alignOffset;
             newBlock->_data = data;
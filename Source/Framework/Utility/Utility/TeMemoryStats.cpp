@@ -0,0 +1,288 @@
+#include "Utility/TeMemoryStats.h"
+#include "Threading/TeThreading.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+#   include <cxxabi.h>
+#endif
+
+namespace te
+{
+    namespace
+    {
+        const UINT32 NUM_CATEGORIES = (UINT32)MemoryCategory::Count;
+
+        /**
+         * Counters of a single category. Only made of atomics so they are usable during static initialization and
+         * destruction, when allocations happen before and after anything else is alive.
+         */
+        struct CategoryCounters
+        {
+            std::atomic<UINT64> LiveBytes;
+            std::atomic<UINT64> PeakBytes;
+            std::atomic<UINT64> LiveAllocations;
+            std::atomic<UINT64> TotalAllocations;
+            std::atomic<UINT64> BudgetBytes;
+            std::atomic<bool> OverBudget;
+        };
+
+        CategoryCounters gCounters[NUM_CATEGORIES];
+
+        std::atomic<UINT64> gFrameStartAllocations;
+        std::atomic<UINT64> gLastFrameAllocations;
+
+        /** Bytes and allocation count attributed to a single code location. */
+        struct CallSite
+        {
+            UINT64 Bytes = 0;
+            UINT64 Allocations = 0;
+        };
+
+        /**
+         * Call site data. Uses the standard allocator so recording an allocation doesn't allocate through the tracked
+         * allocator itself.
+         */
+        struct CallSites
+        {
+            std::atomic<bool> Enabled;
+            Mutex SitesMutex;
+            std::unordered_map<void*, CallSite> Sites;
+        };
+
+        CallSites& GetCallSites()
+        {
+            static CallSites callSites;
+            return callSites;
+        }
+
+        /** Returns a readable name for a code address, or the address itself if it can't be resolved. */
+        String GetAddressName(void* address)
+        {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%p", address);
+
+            String output = buffer;
+
+#if TE_PLATFORM == TE_PLATFORM_LINUX
+            Dl_info info;
+            if (dladdr(address, &info) != 0 && info.dli_sname != nullptr)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+
+                output += " ";
+                output += (status == 0 && demangled != nullptr) ? demangled : info.dli_sname;
+
+                ::free(demangled);
+            }
+#endif
+
+            return output;
+        }
+
+        /** Formats a byte count with a unit suited to its size. */
+        String FormatBytes(UINT64 bytes)
+        {
+            char buffer[32];
+            if (bytes >= 1024 * 1024)
+                std::snprintf(buffer, sizeof(buffer), "%.2f MB", bytes / (1024.0 * 1024.0));
+            else if (bytes >= 1024)
+                std::snprintf(buffer, sizeof(buffer), "%.2f KB", bytes / 1024.0);
+            else
+                std::snprintf(buffer, sizeof(buffer), "%u B", (UINT32)bytes);
+
+            return buffer;
+        }
+    }
+
+    void MemoryTracker::OnAllocate(MemoryCategory category, size_t bytes, void* callSite)
+    {
+        CategoryCounters& counters = gCounters[(UINT32)category];
+
+        const UINT64 liveBytes = counters.LiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        UINT64 peakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+        while (liveBytes > peakBytes &&
+            !counters.PeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+        { }
+
+        CallSites& callSites = GetCallSites();
+        if (callSites.Enabled.load(std::memory_order_relaxed))
+        {
+            Lock lock(callSites.SitesMutex);
+            CallSite& site = callSites.Sites[callSite];
+            site.Bytes += bytes;
+            site.Allocations++;
+        }
+    }
+
+    void MemoryTracker::OnFree(MemoryCategory category, size_t bytes)
+    {
+        CategoryCounters& counters = gCounters[(UINT32)category];
+
+        counters.LiveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    MemoryCategoryStats MemoryStats::GetStats(MemoryCategory category)
+    {
+        const CategoryCounters& counters = gCounters[(UINT32)category];
+
+        MemoryCategoryStats output;
+        output.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+        output.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+        output.LiveAllocations = counters.LiveAllocations.load(std::memory_order_relaxed);
+        output.TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed);
+        output.BudgetBytes = counters.BudgetBytes.load(std::memory_order_relaxed);
+
+        return output;
+    }
+
+    MemoryCategoryStats MemoryStats::GetTotalStats()
+    {
+        MemoryCategoryStats output;
+        for (UINT32 i = 0; i < NUM_CATEGORIES; i++)
+        {
+            MemoryCategoryStats stats = GetStats((MemoryCategory)i);
+
+            output.LiveBytes += stats.LiveBytes;
+            output.PeakBytes += stats.PeakBytes;
+            output.LiveAllocations += stats.LiveAllocations;
+            output.TotalAllocations += stats.TotalAllocations;
+            output.BudgetBytes += stats.BudgetBytes;
+        }
+
+        return output;
+    }
+
+    const char* MemoryStats::GetCategoryName(MemoryCategory category)
+    {
+        switch (category)
+        {
+        case MemoryCategory::General: return "General";
+        case MemoryCategory::Mesh: return "Mesh";
+        case MemoryCategory::Texture: return "Texture";
+        case MemoryCategory::Animation: return "Animation";
+        case MemoryCategory::Physics: return "Physics";
+        case MemoryCategory::Audio: return "Audio";
+        case MemoryCategory::Renderer: return "Renderer";
+        case MemoryCategory::Scene: return "Scene";
+        case MemoryCategory::Frame: return "Frame";
+        case MemoryCategory::Pool: return "Pool";
+        default: return "Unknown";
+        }
+    }
+
+    void MemoryStats::BeginFrame()
+    {
+        UINT64 totalAllocations = 0;
+        for (UINT32 i = 0; i < NUM_CATEGORIES; i++)
+            totalAllocations += gCounters[i].TotalAllocations.load(std::memory_order_relaxed);
+
+        gLastFrameAllocations.store(totalAllocations - gFrameStartAllocations.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        gFrameStartAllocations.store(totalAllocations, std::memory_order_relaxed);
+
+        for (UINT32 i = 0; i < NUM_CATEGORIES; i++)
+        {
+            const MemoryCategory category = (MemoryCategory)i;
+            const bool overBudget = IsOverBudget(category);
+
+            if (overBudget && !gCounters[i].OverBudget.load(std::memory_order_relaxed))
+            {
+                MemoryCategoryStats stats = GetStats(category);
+                TE_LOG(Warning, "Memory", GetCategoryName(category) << " memory is over budget: "
+                    << FormatBytes(stats.LiveBytes) << " used, " << FormatBytes(stats.BudgetBytes) << " allowed");
+            }
+
+            gCounters[i].OverBudget.store(overBudget, std::memory_order_relaxed);
+        }
+    }
+
+    UINT64 MemoryStats::GetLastFrameAllocations()
+    {
+        return gLastFrameAllocations.load(std::memory_order_relaxed);
+    }
+
+    void MemoryStats::SetBudget(MemoryCategory category, UINT64 bytes)
+    {
+        gCounters[(UINT32)category].BudgetBytes.store(bytes, std::memory_order_relaxed);
+    }
+
+    bool MemoryStats::IsOverBudget(MemoryCategory category)
+    {
+        const CategoryCounters& counters = gCounters[(UINT32)category];
+        const UINT64 budget = counters.BudgetBytes.load(std::memory_order_relaxed);
+
+        return budget > 0 && counters.LiveBytes.load(std::memory_order_relaxed) > budget;
+    }
+
+    void MemoryStats::SetCallSiteTracking(bool enabled)
+    {
+        GetCallSites().Enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void MemoryStats::ResetCallSites()
+    {
+        CallSites& callSites = GetCallSites();
+
+        Lock lock(callSites.SitesMutex);
+        callSites.Sites.clear();
+    }
+
+    String MemoryStats::GetReport(UINT32 numCallSites)
+    {
+        String output = "Memory usage:\n";
+
+        auto appendStats = [&output](const char* name, const MemoryCategoryStats& stats)
+        {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "  %-10s", name);
+
+            output += buffer;
+            output += " live " + FormatBytes(stats.LiveBytes) + " (" + ToString(stats.LiveAllocations) + " allocs)";
+            output += ", peak " + FormatBytes(stats.PeakBytes);
+            output += ", total allocs " + ToString(stats.TotalAllocations);
+
+            if (stats.BudgetBytes > 0)
+                output += ", budget " + FormatBytes(stats.BudgetBytes);
+
+            output += "\n";
+        };
+
+        for (UINT32 i = 0; i < NUM_CATEGORIES; i++)
+            appendStats(GetCategoryName((MemoryCategory)i), GetStats((MemoryCategory)i));
+
+        appendStats("Total", GetTotalStats());
+        output += "  Allocations last frame: " + ToString(GetLastFrameAllocations()) + "\n";
+
+        // Copy first, so the report itself can allocate without holding the call site lock
+        std::vector<std::pair<void*, CallSite>> sites;
+        {
+            CallSites& callSites = GetCallSites();
+
+            Lock lock(callSites.SitesMutex);
+            sites.assign(callSites.Sites.begin(), callSites.Sites.end());
+        }
+
+        if (!sites.empty() && numCallSites > 0)
+        {
+            std::sort(sites.begin(), sites.end(),
+                [](const auto& a, const auto& b) { return a.second.Bytes > b.second.Bytes; });
+
+            output += "Top allocation call sites:\n";
+            for (UINT32 i = 0; i < std::min(numCallSites, (UINT32)sites.size()); i++)
+            {
+                output += "  " + FormatBytes(sites[i].second.Bytes) + " in " + ToString(sites[i].second.Allocations) +
+                    " allocs at " + GetAddressName(sites[i].first) + "\n";
+            }
+        }
+
+        return output;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+namespace te
+{
+    /** Memory usage of a single MemoryCategory, or of all of them. */
+    struct MemoryCategoryStats
+    {
+        UINT64 LiveBytes = 0; /**< Bytes currently allocated. */
+        UINT64 PeakBytes = 0; /**< Highest value LiveBytes ever reached. */
+        UINT64 LiveAllocations = 0; /**< Number of allocations not freed yet. */
+        UINT64 TotalAllocations = 0; /**< Number of allocations made since start-up. */
+        UINT64 BudgetBytes = 0; /**< Budget set with MemoryStats::SetBudget(), zero if none. */
+    };
+
+    /**
+     * Memory accounting. Reports memory allocated through MemoryAllocator (te_allocate, te_new...) per
+     * MemoryCategory, the number of allocations per frame, and optionally the call sites that allocate the most.
+     *
+     * Counters are only updated if TE_MEMORY_TRACKING is enabled.
+     */
+    class TE_UTILITY_EXPORT MemoryStats
+    {
+    public:
+        /** Returns memory usage of the provided category. */
+        static MemoryCategoryStats GetStats(MemoryCategory category);
+
+        /** Returns memory usage summed over all categories. Peak is the sum of each category peak. */
+        static MemoryCategoryStats GetTotalStats();
+
+        /** Returns a human readable name for the provided category. */
+        static const char* GetCategoryName(MemoryCategory category);
+
+        /**
+         * Marks the start of a new frame. Called once per frame by the main loop. Counts allocations made during the
+         * previous frame and warns once when a category goes over its budget.
+         */
+        static void BeginFrame();
+
+        /** Returns the number of allocations, over all categories, made during the last complete frame. */
+        static UINT64 GetLastFrameAllocations();
+
+        /** Sets the maximum number of bytes a category is expected to use. Zero removes the budget. */
+        static void SetBudget(MemoryCategory category, UINT64 bytes);
+
+        /** Checks if the provided category currently uses more memory than its budget. */
+        static bool IsOverBudget(MemoryCategory category);
+
+        /**
+         * Enables or disables recording of the code locations allocations are made from. Tracking them adds a lock to
+         * every allocation, so it is disabled by default.
+         */
+        static void SetCallSiteTracking(bool enabled);
+
+        /** Clears all recorded call sites. */
+        static void ResetCallSites();
+
+        /**
+         * Returns a text report with the usage of each category and, if call site tracking was enabled, the
+         * @p numCallSites locations that allocated the most bytes since tracking started.
+         */
+        static String GetReport(UINT32 numCallSites = 20);
+    };
+}
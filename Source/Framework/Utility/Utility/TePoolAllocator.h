@@ -22,7 +22,10 @@ namespace te
     class PoolAllocator
     {
     private:
-        /** A single block able to hold ElemsPerBlock elements. */
+        /**
+         * A single block able to hold ElemsPerBlock elements. Blocks are allocated on a boundary of BlockAlignment, with
+         * this header at the start, so the block owning an element can be found directly from its address.
+         */
         class MemBlock
         {
         public:
@@ -30,6 +33,7 @@ namespace te
                 : BlockData(blockData)
                 , FreePtr(0)
                 , FreeElems(ElemsPerBlock)
+                , PrevBlock(nullptr)
                 , NextBlock(nullptr)
             {
                 UINT32 offset = 0;
@@ -78,6 +82,7 @@ namespace te
             UINT8* BlockData;
             UINT32 FreePtr;
             UINT32 FreeElems;
+            MemBlock* PrevBlock;
             MemBlock* NextBlock;
         };
 
@@ -93,7 +98,7 @@ namespace te
         {
             ScopedLock<Lock> lock(_lockPolicy);
 
-            MemBlock* curBlock = _freeBlock;
+            MemBlock* curBlock = _firstBlock;
             while (curBlock != nullptr)
             {
                 MemBlock* nextBlock = curBlock->NextBlock;
@@ -107,50 +112,35 @@ namespace te
         UINT8* Allocate()
         {
             ScopedLock<Lock> lock(_lockPolicy);
-
-            if (_freeBlock == nullptr || _freeBlock->FreeElems == 0)
-                AllocateBlock();
-
-            _totalNumElems++;
-            UINT8* output = _freeBlock->Allocate();
-
-            return output;
+            return AllocateInternal();
         }
 
         /** Deallocates an element from the pool. */
         void Free(void* data)
         {
             ScopedLock<Lock> lock(_lockPolicy);
+            FreeInternal(data);
+        }
 
-            MemBlock* curBlock = _freeBlock;
-            while (curBlock)
-            {
-                constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
-                if (data >= curBlock->BlockData && data < (curBlock->BlockData + blockDataSize))
-                {
-                    curBlock->Deallocate(data);
-                    _totalNumElems--;
-
-                    if (curBlock->FreeElems == 0 && curBlock->NextBlock)
-                    {
-                        // Free the block, but only if there is some extra free space in other blocks
-                        const UINT32 totalSpace = (_numBlocks - 1) * ElemsPerBlock;
-                        const UINT32 freeSpace = totalSpace - _totalNumElems;
-
-                        if (freeSpace > ElemsPerBlock / 2)
-                        {
-                            _freeBlock = curBlock->NextBlock;
-                            DeallocateBlock(curBlock);
-                        }
-                    }
+        /**
+         * Allocates @p count elements and writes their addresses to @p output. Equivalent to calling Allocate() @p count
+         * times, but only locks once.
+         */
+        void AllocateBatch(void** output, UINT32 count)
+        {
+            ScopedLock<Lock> lock(_lockPolicy);
 
-                    return;
-                }
+            for (UINT32 i = 0; i < count; i++)
+                output[i] = AllocateInternal();
+        }
 
-                curBlock = curBlock->NextBlock;
-            }
+        /** Deallocates @p count elements. Equivalent to calling Free() for each of them, but only locks once. */
+        void FreeBatch(void* const* data, UINT32 count)
+        {
+            ScopedLock<Lock> lock(_lockPolicy);
 
-            assert(false);
+            for (UINT32 i = 0; i < count; i++)
+                FreeInternal(data[i]);
         }
 
         /** Allocates and constructs a single pool element. */
@@ -172,66 +162,253 @@ namespace te
         }
     
     private:
-        /** Allocates a new block of memory using a heap allocator. */
-        MemBlock* AllocateBlock()
+        /**
+         * Blocks with free space are always kept in front of full blocks, so allocation only ever needs to look at the
+         * first block.
+         */
+        UINT8* AllocateInternal()
         {
-            MemBlock* newBlock = nullptr;
-            MemBlock* curBlock = _freeBlock;
+            if (_firstBlock == nullptr || _firstBlock->FreeElems == 0)
+                AllocateBlock();
 
-            while (curBlock != nullptr)
+            MemBlock* block = _firstBlock;
+            UINT8* output = block->Allocate();
+            _totalNumElems++;
+
+            if (block->FreeElems == 0)
             {
-                MemBlock* nextBlock = curBlock->NextBlock;
-                if (nextBlock != nullptr && nextBlock->FreeElems > 0)
-                {
-                    // Found an existing block with free space
-                    newBlock = nextBlock;
+                Unlink(block);
+                LinkBack(block);
+            }
 
-                    curBlock->NextBlock = newBlock->NextBlock;
-                    newBlock->NextBlock = _freeBlock;
+            return output;
+        }
 
-                    break;
-                }
+        void FreeInternal(void* data)
+        {
+            MemBlock* block = GetOwningBlock(data);
 
-                curBlock = nextBlock;
-            }
+#if TE_DEBUG_MODE == 1
+            constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
+            assert(data >= block->BlockData && data < (block->BlockData + blockDataSize) && "Pointer not owned by pool.");
+#endif
 
-            if (newBlock == nullptr)
-            {
-                constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
-                size_t paddedBlockDataSize = blockDataSize + (Alignment - 1); // Padding for potential alignment correction
+            const bool wasFull = block->FreeElems == 0;
+            block->Deallocate(data);
+            _totalNumElems--;
 
-                UINT8* data = (UINT8*)te_allocate(sizeof(MemBlock) + (UINT32)paddedBlockDataSize);
+            if (block->FreeElems == ElemsPerBlock && _numBlocks > 1)
+            {
+                // Free the block, but only if there is some extra free space in other blocks
+                const UINT32 totalSpace = (_numBlocks - 1) * ElemsPerBlock;
+                const UINT32 freeSpace = totalSpace - _totalNumElems;
 
-                void* blockData = data + sizeof(MemBlock);
-                blockData = std::align(Alignment, blockDataSize, blockData, paddedBlockDataSize);
+                if (freeSpace > ElemsPerBlock / 2)
+                {
+                    Unlink(block);
+                    DeallocateBlock(block);
 
-                newBlock = new (data) MemBlock((UINT8*)blockData);
-                _numBlocks++;
+                    return;
+                }
+            }
 
-                newBlock->NextBlock = _freeBlock;
+            if (wasFull)
+            {
+                Unlink(block);
+                LinkFront(block);
             }
+        }
 
-            _freeBlock = newBlock;
+        /** Returns the block an element was allocated from. */
+        static MemBlock* GetOwningBlock(void* data)
+        {
+            return (MemBlock*)((uintptr_t)data & ~(uintptr_t)(BlockAlignment - 1));
+        }
+
+        /** Allocates a new block of memory using a heap allocator and places it at the front of the block list. */
+        MemBlock* AllocateBlock()
+        {
+            // Allocated from the platform directly, as a tracking header would break the alignment trick and double the
+            // size of large blocks. Accounted manually instead.
+            UINT8* data = (UINT8*)PlatformAlignedAllocate(BlockAllocSize, BlockAlignment);
+            MemoryTracker::OnAllocate(MemoryCategory::Pool, BlockAllocSize, TE_RETURN_ADDRESS());
+
+            MemBlock* newBlock = new (data) MemBlock(data + BlockDataOffset);
+            _numBlocks++;
+
+            LinkFront(newBlock);
             return newBlock;
         }
 
-        /** Deallocates a block of memory. */
+        /** Deallocates a block of memory. Block must already be removed from the block list. */
         void DeallocateBlock(MemBlock* block)
         {
             block->~MemBlock();
-            te_free(block);
+
+            PlatformAlignedFree(block);
+            MemoryTracker::OnFree(MemoryCategory::Pool, BlockAllocSize);
 
             _numBlocks--;
         }
 
+        void LinkFront(MemBlock* block)
+        {
+            block->PrevBlock = nullptr;
+            block->NextBlock = _firstBlock;
+
+            if (_firstBlock != nullptr)
+                _firstBlock->PrevBlock = block;
+            else
+                _lastBlock = block;
+
+            _firstBlock = block;
+        }
+
+        void LinkBack(MemBlock* block)
+        {
+            block->PrevBlock = _lastBlock;
+            block->NextBlock = nullptr;
+
+            if (_lastBlock != nullptr)
+                _lastBlock->NextBlock = block;
+            else
+                _firstBlock = block;
+
+            _lastBlock = block;
+        }
+
+        void Unlink(MemBlock* block)
+        {
+            if (block->PrevBlock != nullptr)
+                block->PrevBlock->NextBlock = block->NextBlock;
+            else
+                _firstBlock = block->NextBlock;
+
+            if (block->NextBlock != nullptr)
+                block->NextBlock->PrevBlock = block->PrevBlock;
+            else
+                _lastBlock = block->PrevBlock;
+
+            block->PrevBlock = nullptr;
+            block->NextBlock = nullptr;
+        }
+
+        /** Returns the smallest power of two greater or equal to @p value. */
+        static constexpr size_t NextPowerOfTwo(size_t value)
+        {
+            size_t output = 1;
+            while (output < value)
+                output <<= 1;
+
+            return output;
+        }
+
         static constexpr int ActualElemSize = ((ElemSize + Alignment - 1) / Alignment) * Alignment;
+        static constexpr size_t BlockDataOffset = ((sizeof(MemBlock) + Alignment - 1) / Alignment) * Alignment;
+        static constexpr size_t BlockAllocSize = BlockDataOffset + (size_t)ActualElemSize * ElemsPerBlock;
+        static constexpr size_t BlockAlignment = NextPowerOfTwo(BlockAllocSize);
 
         LockingPolicy<Lock> _lockPolicy;
-        MemBlock* _freeBlock = nullptr;
+        MemBlock* _firstBlock = nullptr;
+        MemBlock* _lastBlock = nullptr;
         UINT32 _totalNumElems = 0;
         UINT32 _numBlocks = 0;
     };
 
+    /**
+     * Thread safe pool allocator for elements of type T, that keeps a small cache (magazine) of free elements for each
+     * thread. Allocations and deallocations only touch the calling thread's magazine, which is refilled from and returned
+     * to the shared pool in batches, so the shared pool lock is only taken once every few operations. Elements cached by
+     * a thread are returned to the shared pool when that thread exits.
+     *
+     * Magazines are shared by all instances with the same template parameters, so only a single instance may exist for
+     * each T. This is what StaticPoolAllocator provides.
+     */
+    template <class T, int ElemsPerBlock = 512, int Alignment = 4>
+    class ThreadCachedPoolAllocator
+    {
+    public:
+        /** Number of elements moved between a magazine and the shared pool at once. */
+        static constexpr UINT32 MagazineBatch = 32;
+
+        /** Maximum number of elements a magazine can hold. */
+        static constexpr UINT32 MagazineSize = MagazineBatch * 2;
+
+        /** Allocates enough memory for a single element in the pool. */
+        UINT8* Allocate()
+        {
+            Magazine& magazine = GetMagazine();
+            if (magazine.Count == 0)
+            {
+                _pool.AllocateBatch(magazine.Elems, MagazineBatch);
+                magazine.Count = MagazineBatch;
+            }
+
+            return (UINT8*)magazine.Elems[--magazine.Count];
+        }
+
+        /** Deallocates an element from the pool. */
+        void Free(void* data)
+        {
+            Magazine& magazine = GetMagazine();
+            if (magazine.Count == MagazineSize)
+            {
+                _pool.FreeBatch(&magazine.Elems[MagazineSize - MagazineBatch], MagazineBatch);
+                magazine.Count -= MagazineBatch;
+            }
+
+            magazine.Elems[magazine.Count++] = data;
+        }
+
+        /** Allocates and constructs a single pool element. */
+        template<class T2, class... Args>
+        T2* Construct(Args &&...args)
+        {
+            T2* data = (T2*)Allocate();
+            new ((void*)data) T2(std::forward<Args>(args)...);
+
+            return data;
+        }
+
+        /** Destructs and deallocates a single pool element. */
+        template<class T2>
+        void Destruct(T2* data)
+        {
+            data->~T2();
+            Free(data);
+        }
+
+    private:
+        /** Free elements cached by a single thread. */
+        struct Magazine
+        {
+            ~Magazine()
+            {
+                if (Owner != nullptr && Count > 0)
+                    Owner->_pool.FreeBatch(Elems, Count);
+            }
+
+            ThreadCachedPoolAllocator* Owner = nullptr;
+            void* Elems[MagazineSize];
+            UINT32 Count = 0;
+        };
+
+        /** Returns the magazine of the calling thread. */
+        Magazine& GetMagazine()
+        {
+            thread_local Magazine magazine;
+
+#if TE_DEBUG_MODE == 1
+            assert((magazine.Owner == nullptr || magazine.Owner == this) && "Only one instance allowed per type.");
+#endif
+
+            magazine.Owner = this;
+            return magazine;
+        }
+
+        PoolAllocator<sizeof(T), ElemsPerBlock, Alignment, true> _pool;
+    };
+
     /**
      * Helper class used by GlobalPoolAlloc that allocates a static pool allocator. GlobalPoolAlloc cannot do it
      * directly since it gets specialized which means the static members would need to be defined in the implementation
@@ -241,11 +418,16 @@ namespace te
     class StaticPoolAllocator
     {
     public:
-        static PoolAllocator<sizeof(T), ElemsPerBlock, Alignment, Lock> m;
+        typedef std::conditional_t<Lock,
+            ThreadCachedPoolAllocator<T, ElemsPerBlock, Alignment>,
+            PoolAllocator<sizeof(T), ElemsPerBlock, Alignment, false>> AllocatorType;
+
+        static AllocatorType m;
     };
 
     template <class T, int ElemsPerBlock, int Alignment, bool Lock>
-    PoolAllocator<sizeof(T), ElemsPerBlock, Alignment, Lock> StaticPoolAllocator<T, ElemsPerBlock, Alignment, Lock>::m;
+    typename StaticPoolAllocator<T, ElemsPerBlock, Alignment, Lock>::AllocatorType
+        StaticPoolAllocator<T, ElemsPerBlock, Alignment, Lock>::m;
 
     /** Specializable template that allows users to implement globally accessible pool allocators for custom types. */
     template<class T>
@@ -259,7 +441,8 @@ namespace te
 
     /**
      * Implements a global pool for the specified type. The pool will initially have enough room for ElemsPerBlock and
-     * will grow by that amount when exceeded. Global pools are thread safe by default.
+     * will grow by that amount when exceeded. Global pools are thread safe by default, and cache free elements per thread
+     * (see ThreadCachedPoolAllocator).
      */
 #define IMPLEMENT_GLOBAL_POOL(Type, ElemsPerBlock)									\
 	template<> class GlobalPoolAllocator<Type> : public StaticPoolAllocator<Type, ElemsPerBlock> { };
@@ -34,11 +34,28 @@ namespace te
 {
     TE_MODULE_STATIC_MEMBER(BulletPhysics)
 
+    namespace
+    {
+        void* BulletAllocate(size_t size)
+        {
+            return te_allocate<MemoryCategory::Physics>(size);
+        }
+
+        void* BulletAllocateAligned(size_t size, int alignment)
+        {
+            return MemoryAllocator::AllocateAligned(size, (size_t)alignment, MemoryCategory::Physics);
+        }
+    }
+
     BulletPhysics::BulletPhysics(const PHYSICS_INIT_DESC& desc)
         : Physics(desc)
         , _paused(false)
         , _debug(true)
     {
+        // Route Bullet's internal allocations through our allocator, so they are accounted as physics memory
+        btAlignedAllocSetCustom(&BulletAllocate, &te_free);
+        btAlignedAllocSetCustomAligned(&BulletAllocateAligned, &te_free_aligned);
+
         _broadphase = te_new<btDbvtBroadphase>();
         _constraintSolver = te_new<btSequentialImpulseConstraintSolver>();
 
@@ -66,6 +83,9 @@ namespace te
         te_delete(_collisionDispatcher);
         te_delete(_collisionConfiguration);
         te_delete(_broadphase);
+
+        btAlignedAllocSetCustom(nullptr, nullptr);
+        btAlignedAllocSetCustomAligned(nullptr, nullptr);
     }
 
     void BulletPhysics::SetPaused(bool paused)
@@ -392,7 +392,11 @@ namespace te
 
                     if (texture != nullptr)
                     {
-                        SPtr<TextureView> texView = texture->RequestView(surface.MipLevel, surface.NumMipLevels,
+                        UINT32 mostDetailMip = surface.MipLevel;
+                        UINT32 numMips = surface.NumMipLevels;
+                        texture->ClampToResidentMips(mostDetailMip, numMips);
+
+                        SPtr<TextureView> texView = texture->RequestView(mostDetailMip, numMips,
                             surface.Face, surface.NumFaces, GVU_DEFAULT);
 
                         D3D11TextureView* d3d11texView = static_cast<D3D11TextureView*>(texView.get());
@@ -1046,6 +1050,8 @@ namespace te
         caps.SetCapability(RSC_TEXTURE_VIEWS);
         caps.SetCapability(RSC_BYTECODE_CACHING);
         caps.SetCapability(RSC_RENDER_TARGET_LAYERS);
+        caps.SetCapability(RSC_TEXTURE_MIP_CLAMP);
+        caps.SetCapability(RSC_RENDER_THREAD);
 
         caps.AddShaderProfile("hlsl");
 
@@ -3,14 +3,16 @@
 #include "Image/TePixelData.h"
 #include "Image/TeTexture.h"
 #include "Utility/TeFileSystem.h"
+#include "Utility/TeDataStream.h"
+#include "Image/TeTextureAtlasLayout.h"
+#include "Threading/TeTaskScheduler.h"
 
 #include <cctype>
 #include <filesystem>
 #include <ft2build.h>
 #include <freetype/freetype.h>
 #include FT_FREETYPE_H
-
-using namespace std::placeholders;
+#include FT_SYNTHESIS_H
 
 namespace te
 { 
@@ -34,10 +36,353 @@ namespace te
         return te_shared_ptr_new<FontImportOptions>();
     }
 
+    namespace
+    {
+        /** Empty pixels kept between glyphs in a texture page, so filtering doesn't bleed neighbours in. */
+        const UINT32 GLYPH_PADDING = 1;
+
+        /** Number of characters rasterized by a single worker task. */
+        const UINT32 GLYPHS_PER_TASK = 64;
+
+        /** Distance fields are computed from glyphs rasterized this many times larger than the atlas, then downsampled. */
+        const UINT32 DISTANCE_FIELD_SUPERSAMPLING = 4;
+
+        /** Description and pixels (one byte each, rows packed) of a rasterized glyph. */
+        struct GlyphData
+        {
+            CharDesc Desc = {};
+            Vector<UINT8> Pixels;
+        };
+
+        /** Range of characters of one font size rasterized by a worker task, and its output. */
+        struct GlyphTask
+        {
+            UINT32 SizeIdx = 0;
+            UINT32 Size = 0;
+            UINT32 First = 0;
+            UINT32 Last = 0;
+            bool FaceMetrics = false; // Also output the data shared by all the glyphs of this size
+
+            bool Succeeded = false;
+            Vector<GlyphData> Glyphs;
+            GlyphData MissingGlyph;
+            INT32 BaselineOffset = 0;
+            UINT32 LineHeight = 0;
+            UINT32 SpaceWidth = 0;
+        };
+
+        /** Stands for an infinite distance, finite so the parabola intersections don't turn into NaNs. */
+        const float DISTANCE_INFINITY = 1e20f;
+
+        /** Converts a 26.6 fixed point value, measured on a glyph rasterized @p scale times larger, to pixels. */
+        INT32 FromFixed(FT_Pos value, UINT32 scale)
+        {
+            return Math::RoundToInt(value / (64.0f * scale));
+        }
+
+        /**
+         * Squared euclidean distance transform of a single row or column (Felzenszwalb & Huttenlocher). @p f holds zero
+         * for feature samples and DISTANCE_INFINITY elsewhere, @p d receives the squared distance to the nearest feature.
+         */
+        void DistanceTransform1D(const float* f, float* d, INT32 n, INT32* v, float* z)
+        {
+            INT32 k = 0;
+            v[0] = 0;
+            z[0] = -std::numeric_limits<float>::infinity();
+            z[1] = std::numeric_limits<float>::infinity();
+
+            for (INT32 q = 1; q < n; q++)
+            {
+                float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+                while (s <= z[k])
+                {
+                    k--;
+                    s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+                }
+
+                k++;
+                v[k] = q;
+                z[k] = s;
+                z[k + 1] = std::numeric_limits<float>::infinity();
+            }
+
+            k = 0;
+            for (INT32 q = 0; q < n; q++)
+            {
+                while (z[k + 1] < q)
+                    k++;
+
+                d[q] = (float)((q - v[k]) * (q - v[k])) + f[v[k]];
+            }
+        }
+
+        /** Computes the distance, in pixels, from each pixel to the closest pixel where @p feature is true. */
+        void DistanceTransform(const Vector<bool>& feature, UINT32 width, UINT32 height, Vector<float>& output)
+        {
+            const UINT32 size = std::max(width, height);
+            Vector<float> f(size);
+            Vector<float> d(size);
+            Vector<INT32> v(size);
+            Vector<float> z(size + 1);
+
+            output.resize(width * height);
+            for (UINT32 i = 0; i < width * height; i++)
+                output[i] = feature[i] ? 0.0f : DISTANCE_INFINITY;
+
+            for (UINT32 x = 0; x < width; x++)
+            {
+                for (UINT32 y = 0; y < height; y++)
+                    f[y] = output[y * width + x];
+
+                DistanceTransform1D(f.data(), d.data(), (INT32)height, v.data(), z.data());
+
+                for (UINT32 y = 0; y < height; y++)
+                    output[y * width + x] = d[y];
+            }
+
+            for (UINT32 y = 0; y < height; y++)
+            {
+                DistanceTransform1D(&output[y * width], d.data(), (INT32)width, v.data(), z.data());
+
+                for (UINT32 x = 0; x < width; x++)
+                    output[y * width + x] = std::sqrt(d[x]);
+            }
+        }
+
+        /**
+         * Converts the coverage of a glyph rasterized @p scale times larger than the atlas into a signed distance field.
+         * The glyph is padded by @p spread atlas pixels on each side, and its description updated to match.
+         */
+        void GenerateDistanceField(GlyphData& glyph, UINT32 spread, UINT32 scale)
+        {
+            const UINT32 padding = spread * scale;
+            const UINT32 width = Math::DivideAndRoundUp(glyph.Desc.Width + padding * 2, scale) * scale;
+            const UINT32 height = Math::DivideAndRoundUp(glyph.Desc.Height + padding * 2, scale) * scale;
+
+            Vector<bool> inside(width * height, false);
+            Vector<bool> outside(width * height, true);
+            for (UINT32 y = 0; y < glyph.Desc.Height; y++)
+            {
+                for (UINT32 x = 0; x < glyph.Desc.Width; x++)
+                {
+                    const UINT32 idx = (y + padding) * width + x + padding;
+                    inside[idx] = glyph.Pixels[y * glyph.Desc.Width + x] >= 128;
+                    outside[idx] = !inside[idx];
+                }
+            }
+
+            Vector<float> distanceToInside;
+            Vector<float> distanceToOutside;
+            DistanceTransform(inside, width, height, distanceToInside);
+            DistanceTransform(outside, width, height, distanceToOutside);
+
+            // Average the signed distance over each block of supersampled pixels, the outline lying between pixels
+            const UINT32 outputWidth = width / scale;
+            const UINT32 outputHeight = height / scale;
+            const float maxDistance = (float)std::max(spread, 1U);
+
+            Vector<UINT8> output(outputWidth * outputHeight);
+            for (UINT32 y = 0; y < outputHeight; y++)
+            {
+                for (UINT32 x = 0; x < outputWidth; x++)
+                {
+                    float distance = 0.0f;
+                    for (UINT32 sy = 0; sy < scale; sy++)
+                    {
+                        for (UINT32 sx = 0; sx < scale; sx++)
+                        {
+                            const UINT32 idx = (y * scale + sy) * width + x * scale + sx;
+                            distance += inside[idx] ? 0.5f - distanceToOutside[idx] : distanceToInside[idx] - 0.5f;
+                        }
+                    }
+
+                    distance /= (float)(scale * scale * scale);
+
+                    const float value = Math::Clamp01(0.5f - distance / (2.0f * maxDistance));
+                    output[y * outputWidth + x] = (UINT8)Math::RoundToInt(value * 255.0f);
+                }
+            }
+
+            glyph.Desc.XOffset = Math::FloorToInt((glyph.Desc.XOffset - (INT32)padding) / (float)scale);
+            glyph.Desc.YOffset = Math::CeilToInt((glyph.Desc.YOffset + (INT32)padding) / (float)scale);
+            glyph.Desc.Width = outputWidth;
+            glyph.Desc.Height = outputHeight;
+            glyph.Pixels = std::move(output);
+        }
+
+        /** Renders the glyph currently loaded in the face and copies its coverage into @p glyph. */
+        bool RenderGlyph(FT_Face face, FT_Render_Mode renderMode, const FontImportOptions& options, GlyphData& glyph)
+        {
+            FT_GlyphSlot slot = face->glyph;
+
+            if (options.Bold)
+                FT_GlyphSlot_Embolden(slot);
+
+            if (options.Italic)
+                FT_GlyphSlot_Oblique(slot);
+
+            if (FT_Render_Glyph(slot, renderMode))
+                return false;
+
+            const FT_Bitmap& bitmap = slot->bitmap;
+            if (bitmap.buffer == nullptr && bitmap.rows > 0)
+                return false;
+
+            glyph.Desc.Width = (UINT32)bitmap.width;
+            glyph.Desc.Height = (UINT32)bitmap.rows;
+            glyph.Desc.XOffset = slot->bitmap_left;
+            glyph.Desc.YOffset = slot->bitmap_top;
+            glyph.Pixels.resize(glyph.Desc.Width * glyph.Desc.Height);
+
+            for (UINT32 y = 0; y < glyph.Desc.Height; y++)
+            {
+                const UINT8* row = bitmap.buffer + y * bitmap.pitch;
+                for (UINT32 x = 0; x < glyph.Desc.Width; x++)
+                {
+                    UINT8 value;
+                    if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+                        value = (row[x / 8] & (0x80 >> (x % 8))) != 0 ? 255 : 0;
+                    else
+                        value = row[x];
+
+                    glyph.Pixels[y * glyph.Desc.Width + x] = value;
+                }
+            }
+
+            return true;
+        }
+
+        /** Rasterizes the characters [First, Last) of @p charCodes at the size of the task. Runs on a worker thread. */
+        void RasterizeGlyphs(const Vector<UINT8>& fontFile, const Vector<UINT32>& charCodes,
+            const FontImportOptions& options, GlyphTask& task)
+        {
+            FT_Library library;
+            if (FT_Init_FreeType(&library))
+                return;
+
+            FT_Face face;
+            if (FT_New_Memory_Face(library, fontFile.data(), (FT_Long)fontFile.size(), 0, &face))
+            {
+                FT_Done_FreeType(library);
+                return;
+            }
+
+            const bool distanceField = options.SignedDistanceField;
+            const UINT32 scale = distanceField ? DISTANCE_FIELD_SUPERSAMPLING : 1;
+
+            FT_Int32 loadFlags;
+            switch (options.RenderMode)
+            {
+            case FontRenderMode::Smooth:
+                loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
+                break;
+            case FontRenderMode::Raster:
+                loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_HINTING;
+                break;
+            case FontRenderMode::HintedSmooth:
+                loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_AUTOHINT;
+                break;
+            case FontRenderMode::HintedRaster:
+                loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_AUTOHINT;
+                break;
+            default:
+                loadFlags = FT_LOAD_TARGET_NORMAL;
+                break;
+            }
+
+            // Distance fields need smooth outlines, hinting for the supersampled size would be meaningless
+            if (distanceField)
+                loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
+
+            FT_Render_Mode renderMode = FT_LOAD_TARGET_MODE(loadFlags);
+
+            FT_Set_Char_Size(face, (FT_F26Dot6)(task.Size * scale * 64), 0, options.Dpi, options.Dpi);
+
+            auto loadGlyph = [&](FT_UInt glyphIdx, GlyphData& glyph)
+            {
+                if (FT_Load_Glyph(face, glyphIdx, loadFlags) || !RenderGlyph(face, renderMode, options, glyph))
+                    return false;
+
+                glyph.Desc.XAdvance = FromFixed(face->glyph->advance.x, scale);
+                glyph.Desc.YAdvance = FromFixed(face->glyph->advance.y, scale);
+
+                if (distanceField)
+                    GenerateDistanceField(glyph, options.DistanceFieldSpread, scale);
+
+                return true;
+            };
+
+            Vector<FT_UInt> glyphIndices(charCodes.size());
+            for (UINT32 i = 0; i < (UINT32)charCodes.size(); i++)
+                glyphIndices[i] = FT_Get_Char_Index(face, charCodes[i]);
+
+            bool succeeded = true;
+            for (UINT32 i = task.First; i < task.Last && succeeded; i++)
+            {
+                GlyphData glyph;
+                glyph.Desc.CharId = charCodes[i];
+
+                if (!loadGlyph(glyphIndices[i], glyph))
+                {
+                    succeeded = false;
+                    break;
+                }
+
+                if (FT_HAS_KERNING(face))
+                {
+                    for (UINT32 j = 0; j < (UINT32)charCodes.size(); j++)
+                    {
+                        FT_Vector kerning;
+                        FT_Get_Kerning(face, glyphIndices[j], glyphIndices[i], FT_KERNING_DEFAULT, &kerning);
+
+                        const INT32 amount = FromFixed(kerning.x, scale);
+                        if (amount != 0)
+                            glyph.Desc.KerningPairs.push_back({ charCodes[j], amount });
+                    }
+                }
+
+                task.Glyphs.push_back(std::move(glyph));
+            }
+
+            if (succeeded && task.FaceMetrics)
+            {
+                task.BaselineOffset = FromFixed(face->size->metrics.ascender, scale);
+                task.LineHeight = (UINT32)FromFixed(face->size->metrics.height, scale);
+
+                succeeded = loadGlyph(0, task.MissingGlyph);
+
+                if (succeeded && !FT_Load_Char(face, ' ', loadFlags))
+                    task.SpaceWidth = (UINT32)FromFixed(face->glyph->advance.x, scale);
+            }
+
+            task.Succeeded = succeeded;
+
+            FT_Done_Face(face);
+            FT_Done_FreeType(library);
+        }
+    }
+
     SPtr<Resource> FontImporter::Import(const String& filePath, SPtr<const ImportOptions> importOptions)
     {
         const FontImportOptions* fontImportOptions = static_cast<const FontImportOptions*>(importOptions.get());
 
+        // Read once, each worker then opens its own face from memory as FreeType objects aren't thread safe
+        Vector<UINT8> fontFile;
+        {
+            Lock lock = FileScheduler::GetLock(filePath);
+            FileStream file(filePath);
+
+            if (file.Fail())
+            {
+                TE_DEBUG("Cannot open file: " + filePath);
+                return nullptr;
+            }
+
+            fontFile.resize(file.Size());
+            file.Read(fontFile.data(), fontFile.size());
+            file.Close();
+        }
+
         FT_Library library;
 
         FT_Error error = FT_Init_FreeType(&library);
@@ -45,10 +390,7 @@ namespace te
             TE_ASSERT_ERROR(false, "Error occurred during FreeType library initialization.");
 
         FT_Face face;
-        {
-            Lock lock = FileScheduler::GetLock(filePath);
-            error = FT_New_Face(library, filePath.c_str(), 0, &face);
-        }
+        error = FT_New_Memory_Face(library, fontFile.data(), (FT_Long)fontFile.size(), 0, &face);
 
         if (error == FT_Err_Unknown_File_Format)
         {
@@ -59,37 +401,138 @@ namespace te
             TE_ASSERT_ERROR(false, "Failed to load font file: " + filePath + ". Unknown error.");
         }
 
-        Vector<CharRange> charIndexRanges = fontImportOptions->CharIndexRanges;
-        Vector<UINT32> fontSizes = fontImportOptions->FontSizes;
-        UINT32 dpi = fontImportOptions->Dpi;
+        FT_Done_Face(face);
+        FT_Done_FreeType(library);
+
+        Vector<UINT32> charCodes;
+        for (auto& range : fontImportOptions->CharIndexRanges)
+        {
+            for (UINT32 charCode = range.Start; charCode <= range.End; charCode++)
+                charCodes.push_back(charCode);
+        }
+
+        const bool distanceField = fontImportOptions->SignedDistanceField;
+        Vector<UINT32> fontSizes = distanceField ?
+            Vector<UINT32>{ fontImportOptions->DistanceFieldSize } : fontImportOptions->FontSizes;
+
+        // Rasterize every size and range of characters in parallel
+        Vector<GlyphTask> glyphTasks;
+        for (UINT32 i = 0; i < (UINT32)fontSizes.size(); i++)
+        {
+            for (UINT32 first = 0; first == 0 || first < (UINT32)charCodes.size(); first += GLYPHS_PER_TASK)
+            {
+                GlyphTask glyphTask;
+                glyphTask.SizeIdx = i;
+                glyphTask.Size = fontSizes[i];
+                glyphTask.First = first;
+                glyphTask.Last = std::min(first + GLYPHS_PER_TASK, (UINT32)charCodes.size());
+                glyphTask.FaceMetrics = first == 0;
 
-        FT_Int32 loadFlags;
-        switch (fontImportOptions->RenderMode)
+                glyphTasks.push_back(std::move(glyphTask));
+            }
+        }
+
+        Vector<SPtr<Task>> tasks;
+        for (auto& glyphTask : glyphTasks)
         {
-        case FontRenderMode::Smooth:
-            loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
-            break;
-        case FontRenderMode::Raster:
-            loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_HINTING;
-            break;
-        case FontRenderMode::HintedSmooth:
-            loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_AUTOHINT;
-            break;
-        case FontRenderMode::HintedRaster:
-            loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_AUTOHINT;
-            break;
-        default:
-            loadFlags = FT_LOAD_TARGET_NORMAL;
-            break;
+            SPtr<Task> task = Task::Create("FontImport", [&glyphTask, &fontFile, &charCodes, fontImportOptions]()
+            {
+                RasterizeGlyphs(fontFile, charCodes, *fontImportOptions, glyphTask);
+            });
+
+            gTaskScheduler().AddTask(task);
+            tasks.push_back(task);
         }
 
-        FT_Render_Mode renderMode = FT_LOAD_TARGET_MODE(loadFlags);
+        for (auto& task : tasks)
+            task->Wait();
 
         Vector<SPtr<FontBitmap>> dataPerSize;
-        for (size_t i = 0; i < fontSizes.size(); i++)
-        { }
+        for (UINT32 i = 0; i < (UINT32)fontSizes.size(); i++)
+        {
+            SPtr<FontBitmap> fontData = te_shared_ptr_new<FontBitmap>();
+            fontData->Size = fontSizes[i];
+            fontData->IsSignedDistanceField = distanceField;
+            fontData->DistanceFieldSpread = distanceField ? fontImportOptions->DistanceFieldSpread : 0;
 
-        FT_Done_FreeType(library);
+            Vector<GlyphData*> glyphs;
+            bool succeeded = true;
+
+            for (auto& glyphTask : glyphTasks)
+            {
+                if (glyphTask.SizeIdx != i)
+                    continue;
+
+                succeeded &= glyphTask.Succeeded;
+
+                if (glyphTask.FaceMetrics)
+                {
+                    fontData->BaselineOffset = glyphTask.BaselineOffset;
+                    fontData->LineHeight = glyphTask.LineHeight;
+                    fontData->SpaceWidth = glyphTask.SpaceWidth;
+                    glyphs.push_back(&glyphTask.MissingGlyph);
+                }
+
+                for (auto& glyph : glyphTask.Glyphs)
+                    glyphs.push_back(&glyph);
+            }
+
+            if (!succeeded)
+            {
+                TE_DEBUG("Failed to rasterize font " + filePath + " at size " + ToString(fontSizes[i]) + ".");
+                continue;
+            }
+
+            Vector<TextureAtlasUtility::Element> elements(glyphs.size());
+            for (UINT32 j = 0; j < (UINT32)glyphs.size(); j++)
+            {
+                elements[j].Width = glyphs[j]->Desc.Width;
+                elements[j].Height = glyphs[j]->Desc.Height;
+            }
+
+            Vector<TextureAtlasUtility::Page> pages = TextureAtlasUtility::CreateAtlasLayout(elements,
+                MAXIMUM_TEXTURE_SIZE, MAXIMUM_TEXTURE_SIZE, GLYPH_PADDING);
+
+            Vector<SPtr<PixelData>> pagePixels;
+            for (auto& page : pages)
+            {
+                SPtr<PixelData> pixelData = te_shared_ptr_new<PixelData>(page.Width, page.Height, 1, PF_R8);
+                pixelData->AllocateInternalBuffer();
+                memset(pixelData->GetData(), 0, pixelData->GetSize());
+
+                pagePixels.push_back(pixelData);
+            }
+
+            for (UINT32 j = 0; j < (UINT32)glyphs.size(); j++)
+            {
+                const TextureAtlasUtility::Element& element = elements[j];
+                const TextureAtlasUtility::Page& page = pages[element.Page];
+                CharDesc& charDesc = glyphs[j]->Desc;
+
+                charDesc.Page = element.Page;
+                charDesc.UvX = element.X / (float)page.Width;
+                charDesc.UvY = element.Y / (float)page.Height;
+                charDesc.UvWidth = charDesc.Width / (float)page.Width;
+                charDesc.UvHeight = charDesc.Height / (float)page.Height;
+
+                PixelData& pixelData = *pagePixels[element.Page];
+                for (UINT32 y = 0; y < charDesc.Height; y++)
+                {
+                    memcpy(pixelData.GetData() + (element.Y + y) * pixelData.GetRowPitch() + element.X,
+                        glyphs[j]->Pixels.data() + y * charDesc.Width, charDesc.Width);
+                }
+
+                if (j == 0)
+                    fontData->MissingGlyph = charDesc;
+                else
+                    fontData->Characters[charDesc.CharId] = charDesc;
+            }
+
+            for (auto& pixelData : pagePixels)
+                fontData->TexturePages.push_back(Texture::Create(pixelData));
+
+            dataPerSize.push_back(fontData);
+        }
 
         auto path = std::filesystem::absolute(filePath);
         SPtr<Font> newFont = Font::CreatePtr(dataPerSize);
@@ -2,14 +2,18 @@
 #include "Importer/TeTextureImportOptions.h"
 #include "Image/TeColor.h"
 #include "Image/TeTexture.h"
+#include "Image/TeTextureStreaming.h"
 #include "Image/TePixelData.h"
 #include "Image/TePixelUtil.h"
+#include "Renderer/TeIBLUtility.h"
 #include "Utility/TeBitwise.h"
 #include "Utility/TeDataStream.h"
 #include "Utility/TeFileSystem.h"
 
+#include <atomic>
 #include <cctype>
 #include <filesystem>
+#include <random>
 
 namespace te
 {
@@ -120,6 +124,112 @@ namespace te
         return te_shared_ptr_new<TextureImportOptions>();
     }
 
+    namespace
+    {
+        /** Returns the path of a new file to cache the mip levels of a streamed texture imported from @p filePath. */
+        String GetMipCachePath(const String& filePath)
+        {
+            static std::atomic<UINT32> NextCacheId { 0 };
+            static const UINT32 ProcessId = std::random_device()();
+
+            std::filesystem::path dirPath = std::filesystem::temp_directory_path() / "TeMipCache";
+            FileSystem::CreateDir(dirPath.generic_string());
+
+            const String fileName = std::filesystem::path(filePath).stem().generic_string() + "-" +
+                ToString(ProcessId) + "-" + ToString(NextCacheId.fetch_add(1, std::memory_order_relaxed)) + ".mips";
+
+            return (dirPath / fileName).generic_string();
+        }
+    }
+
+    /**
+     * Reads the mip levels of a streamed texture back from the file they were cached in when the texture was imported,
+     * so the source image doesn't have to be decoded and its mips generated again.
+     */
+    class FreeImgStreamingSource : public TextureStreamingSource
+    {
+    public:
+        FreeImgStreamingSource(const String& cachePath, const TEXTURE_DESC& texDesc, UINT32 numCachedMips)
+            : _cachePath(cachePath)
+            , _properties(texDesc)
+            , _numCachedMips(numCachedMips)
+        { }
+
+        ~FreeImgStreamingSource()
+        {
+            if (FileSystem::Exists(_cachePath))
+                FileSystem::Remove(_cachePath);
+        }
+
+        /**
+         * Writes the mip levels [0, numCachedMips - 1] of every face to the cache file. Returns false if the file can't
+         * be written.
+         *
+         * @param[in]	faceMips	Mip levels of each face, converted to the format of the texture.
+         */
+        bool WriteMips(const Vector<Vector<SPtr<PixelData>>>& faceMips)
+        {
+            Lock lock = FileScheduler::GetLock(_cachePath);
+            FileStream file(_cachePath, DataStream::WRITE);
+
+            if (file.Fail())
+                return false;
+
+            UINT64 offset = 0;
+            for (auto& mipLevels : faceMips)
+            {
+                for (UINT32 mip = 0; mip < _numCachedMips; mip++)
+                {
+                    const PixelData& data = *mipLevels[mip];
+
+                    _offsets.push_back(offset);
+                    file.Write(data.GetData(), data.GetSize());
+                    offset += data.GetSize();
+                }
+            }
+
+            const bool failed = file.Fail();
+            file.Close();
+
+            return !failed;
+        }
+
+        /** @copydoc TextureStreamingSource::LoadMips */
+        bool LoadMips(UINT32 firstMip, UINT32 lastMip, Vector<SPtr<PixelData>>& output) override
+        {
+            if (lastMip >= _numCachedMips)
+                return false;
+
+            Lock lock = FileScheduler::GetLock(_cachePath);
+            FileStream file(_cachePath);
+
+            if (file.Fail())
+                return false;
+
+            for (UINT32 face = 0; face < _properties.GetNumFaces(); face++)
+            {
+                for (UINT32 mip = firstMip; mip <= lastMip; mip++)
+                {
+                    SPtr<PixelData> data = _properties.AllocBuffer(face, mip);
+
+                    file.Seek((size_t)_offsets[face * _numCachedMips + mip]);
+                    if (file.Read(data->GetData(), data->GetSize()) != data->GetSize())
+                        return false;
+
+                    output.push_back(data);
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        String _cachePath;
+        TextureProperties _properties;
+        UINT32 _numCachedMips;
+        Vector<UINT64> _offsets; // Per face, then per mip
+    };
+
     SPtr<Resource> FreeImgImporter::Import(const String& filePath, const SPtr<const ImportOptions> importOptions)
     {
         const TextureImportOptions* textureImportOptions = static_cast<const TextureImportOptions*>(importOptions.get());
@@ -131,14 +241,155 @@ namespace te
         }
 
         Vector<SPtr<PixelData>> faceData;
+        return CreateTexture(filePath, imgData, *textureImportOptions, faceData);
+    }
+
+    Vector<SubResourceRaw> FreeImgImporter::ImportAll(const String& filePath, SPtr<const ImportOptions> importOptions)
+    {
+        const TextureImportOptions* textureImportOptions = static_cast<const TextureImportOptions*>(importOptions.get());
+
+        SPtr<PixelData> imgData = ImportRawImage(filePath);
+        if (imgData == nullptr || imgData->GetData() == nullptr)
+        {
+            return Vector<SubResourceRaw>();
+        }
+
+        Vector<SPtr<PixelData>> faceData;
+        SPtr<Texture> texture = CreateTexture(filePath, imgData, *textureImportOptions, faceData);
+
+        Vector<SubResourceRaw> output;
+        output.push_back({ u8"primary", texture });
+
+        if (textureImportOptions->GenerateIBL)
+        {
+            if (faceData.size() == 6)
+                GenerateIBL(faceData, *textureImportOptions, texture, output);
+            else
+                TE_DEBUG("Unable to bake image based lighting textures: " + filePath + " is not a cubemap.");
+        }
+
+        return output;
+    }
+
+    SPtr<Texture> FreeImgImporter::CreateTexture(const String& filePath, const SPtr<PixelData>& imgData,
+        const TextureImportOptions& options, Vector<SPtr<PixelData>>& faceData)
+    {
+        TEXTURE_DESC texDesc;
+        MipMapGenOptions mipOptions;
+        PrepareTexture(imgData, options, texDesc, mipOptions, faceData);
+
+        SPtr<Texture> texture = Texture::CreatePtr(texDesc);
+        const TextureProperties& properties = texture->GetProperties();
+
+        UINT32 numFaces = (UINT32)faceData.size();
+        Vector<Vector<SPtr<PixelData>>> faceMips(numFaces);
+
+        for (UINT32 i = 0; i < numFaces; i++)
+            GenerateMips(faceData[i], mipOptions, properties, 0, texDesc.NumMips, faceMips[i]);
+
+        // Streamed textures start with their small mips only, the others are cached to be loaded once the renderer
+        // needs them
+        SPtr<FreeImgStreamingSource> streamingSource;
+        UINT32 firstMip = 0;
+
+        if (options.StreamMips && texDesc.NumMips > 0 && TextureStreaming::IsSupported())
+            firstMip = TextureStreaming::GetMinResidentMip(properties);
+
+        if (firstMip > 0)
+        {
+            streamingSource = te_shared_ptr_new<FreeImgStreamingSource>(GetMipCachePath(filePath), texDesc, firstMip);
+            if (!streamingSource->WriteMips(faceMips))
+            {
+                TE_DEBUG("Unable to cache the mip levels of " + filePath + ", the texture won't be streamed.");
+
+                streamingSource = nullptr;
+                firstMip = 0;
+            }
+        }
+
+        for (UINT32 i = 0; i < numFaces; i++)
+        {
+            for (UINT32 mip = firstMip; mip < (UINT32)faceMips[i].size(); ++mip)
+                texture->WriteData(*faceMips[i][mip], mip, i);
+        }
+
+        auto path = std::filesystem::absolute(filePath);
+        texture->SetName(path.filename().generic_string());
+        texture->SetPath(path.generic_string());
+
+        if (streamingSource != nullptr)
+            gTextureStreaming().Register(texture, streamingSource, firstMip);
+
+        return texture;
+    }
+
+    void FreeImgImporter::GenerateIBL(const Vector<SPtr<PixelData>>& faceData, const TextureImportOptions& options,
+        const SPtr<Texture>& texture, Vector<SubResourceRaw>& output)
+    {
+        std::array<SPtr<PixelData>, 6> faces;
+        std::copy(faceData.begin(), faceData.end(), faces.begin());
+
+        TEXTURE_DESC texDesc;
+        texDesc.Type = TEX_TYPE_CUBE_MAP;
+        texDesc.Format = options.Format;
+        texDesc.HwGamma = options.SRGB;
+        texDesc.Usage = TU_DEFAULT | (options.CpuCached ? TU_CPUCACHED : 0);
+
+        // Irradiance
+        {
+            std::array<SPtr<PixelData>, 6> irradianceFaces;
+            SHCoefficientsRGB sh = IBLUtility::ProjectToSH(faces, options.SRGB);
+            IBLUtility::GenerateIrradiance(sh, options.IrradianceSize, options.Format, options.SRGB, irradianceFaces);
+
+            texDesc.Width = texDesc.Height = irradianceFaces[0]->GetWidth();
+            texDesc.NumMips = 0;
+
+            SPtr<Texture> irradiance = Texture::CreatePtr(texDesc);
+            for (UINT32 face = 0; face < 6; face++)
+                irradiance->WriteData(*irradianceFaces[face], 0, face);
 
+            irradiance->SetName("Irradiance - " + texture->GetName());
+            irradiance->SetPath(texture->GetPath());
+
+            output.push_back({ u8"irradiance", irradiance });
+        }
+
+        // Specular, never larger than the source as there would be nothing to gain
+        {
+            const UINT32 size = std::min(options.SpecularSize, faces[0]->GetWidth());
+            const UINT32 numMips = PixelUtil::GetMaxMipmaps(size, size, 1) + 1;
+
+            Vector<SPtr<PixelData>> specularMips;
+            IBLUtility::FilterSpecular(faces, options.SRGB, size, numMips, options.Format,
+                IBLUtility::DEFAULT_SPECULAR_SAMPLES, specularMips);
+
+            texDesc.Width = texDesc.Height = size;
+            texDesc.NumMips = numMips - 1;
+
+            SPtr<Texture> specular = Texture::CreatePtr(texDesc);
+            for (UINT32 face = 0; face < 6; face++)
+            {
+                for (UINT32 mip = 0; mip < numMips; mip++)
+                    specular->WriteData(*specularMips[face * numMips + mip], mip, face);
+            }
+
+            specular->SetName("Specular - " + texture->GetName());
+            specular->SetPath(texture->GetPath());
+
+            output.push_back({ u8"specular", specular });
+        }
+    }
+
+    void FreeImgImporter::PrepareTexture(const SPtr<PixelData>& imgData, const TextureImportOptions& options,
+        TEXTURE_DESC& texDesc, MipMapGenOptions& mipOptions, Vector<SPtr<PixelData>>& faceData)
+    {
         TextureType texType;
-        if (textureImportOptions->IsCubemap)
+        if (options.IsCubemap)
         {
             texType = TEX_TYPE_CUBE_MAP;
 
             std::array<SPtr<PixelData>, 6> cubemapFaces;
-            if (GenerateCubemap(imgData, textureImportOptions->CubemapType, cubemapFaces))
+            if (GenerateCubemap(imgData, options.CubemapType, cubemapFaces))
             {
                 faceData.insert(faceData.begin(), cubemapFaces.begin(), cubemapFaces.end());
             }
@@ -155,28 +406,26 @@ namespace te
         }
 
         int usage = TU_DEFAULT;
-        if (textureImportOptions->CpuCached)
+        if (options.CpuCached)
             usage |= TU_CPUCACHED;
 
-        bool sRGB = textureImportOptions->SRGB;
+        bool sRGB = options.SRGB;
 
-        TEXTURE_DESC texDesc;
         texDesc.Type = texType;
         texDesc.Width = faceData[0]->GetWidth();
         texDesc.Height = faceData[0]->GetHeight();
         texDesc.NumMips = 0;
-        texDesc.Format = textureImportOptions->Format;
+        texDesc.Format = options.Format;
         texDesc.Usage = usage;
         texDesc.HwGamma = sRGB;
 
-        MipMapGenOptions mipOptions;
         mipOptions.IsSRGB = sRGB;
         mipOptions.Alpha = AlphaMode::Transparency;
         mipOptions.Filter = MipMapFilter::Kaiser;
         mipOptions.Quality = CompressionQuality::Highest;
         mipOptions.RoundMode = MipMapRoundMode::RoundNone;
 
-        if (textureImportOptions->GenerateMips)
+        if (options.GenerateMips)
         {
             if (!Bitwise::IsPow2(faceData[0]->GetWidth()) || !Bitwise::IsPow2(faceData[0]->GetHeight()))
             {
@@ -205,37 +454,30 @@ namespace te
 
             UINT32 maxPossibleMip = PixelUtil::GetMaxMipmaps(texDesc.Width, texDesc.Height, faceData[0]->GetDepth());
 
-            if (textureImportOptions->MaxMip == 0)
+            if (options.MaxMip == 0)
                 texDesc.NumMips = maxPossibleMip;
             else
-                texDesc.NumMips = std::min(maxPossibleMip, textureImportOptions->MaxMip);
+                texDesc.NumMips = std::min(maxPossibleMip, options.MaxMip);
         }
+    }
 
-        SPtr<Texture> texture = Texture::CreatePtr(texDesc);
+    void FreeImgImporter::GenerateMips(const SPtr<PixelData>& face, const MipMapGenOptions& mipOptions,
+        const TextureProperties& properties, UINT32 firstMip, UINT32 lastMip, Vector<SPtr<PixelData>>& output)
+    {
+        Vector<SPtr<PixelData>> mipLevels;
+        if (properties.GetNumMipmaps() > 0)
+            mipLevels = PixelUtil::GenMipmaps(*face, mipOptions, properties.GetNumMipmaps());
+        else
+            mipLevels.push_back(face);
 
-        UINT32 numFaces = (UINT32)faceData.size();
-        for (UINT32 i = 0; i < numFaces; i++)
+        lastMip = std::min(lastMip, (UINT32)mipLevels.size() - 1);
+        for (UINT32 mip = firstMip; mip <= lastMip; ++mip)
         {
-            Vector<SPtr<PixelData>> mipLevels;
-            if (texDesc.NumMips > 0)
-                mipLevels = PixelUtil::GenMipmaps(*faceData[i], mipOptions, texDesc.NumMips);
-            else
-                mipLevels.push_back(faceData[i]);
-
-            for (UINT32 mip = 0; mip < (UINT32)mipLevels.size(); ++mip)
-            {
-                SPtr<PixelData> dst = texture->GetProperties().AllocBuffer(0, mip);
+            SPtr<PixelData> dst = properties.AllocBuffer(0, mip);
 
-                PixelUtil::BulkPixelConversion(*mipLevels[mip], *dst);
-                texture->WriteData(*dst, mip, i); //BUG in original version
-            }
+            PixelUtil::BulkPixelConversion(*mipLevels[mip], *dst);
+            output.push_back(dst);
         }
-
-        auto path = std::filesystem::absolute(filePath);
-        texture->SetName(path.filename().generic_string());
-        texture->SetPath(path.generic_string());
-
-        return texture;
     }
 
     SPtr<PixelData> FreeImgImporter::ImportRawImage(const String& filePath)
@@ -3,10 +3,14 @@
 #include "TeFreeImgImporterPrerequisites.h"
 #include "Importer/TeBaseImporter.h"
 #include "Image/TePixelData.h"
+#include "Image/TePixelUtil.h"
+#include "Image/TeTexture.h"
 #include "FreeImage.h"
 
 namespace te
 {
+    class TextureImportOptions;
+
     class FreeImgImporter : public BaseImporter
     {
     public:
@@ -19,10 +23,52 @@ namespace te
         /** @copydoc BasicImporter::Import */
         SPtr<Resource> Import(const String& filePath, const SPtr<const ImportOptions> importOptions) override;
 
+        /**
+         * @copydoc BasicImporter::ImportAll
+         *
+         * @note	If TextureImportOptions::GenerateIBL is set, "irradiance" and "specular" sub-resources are baked from the
+         *			imported cubemap.
+         */
+        Vector<SubResourceRaw> ImportAll(const String& filePath, SPtr<const ImportOptions> importOptions) override;
+
         /** @copydoc BasicImporter::CreateImportOptions */
         SPtr<ImportOptions> CreateImportOptions() const override;
 
     private:
+        /**
+         * Computes the description of the texture to create from an image, and the faces its mip levels are generated
+         * from.
+         *
+         * @param[in]	imgData		Image loaded with ImportRawImage().
+         * @param[in]	options		Options the texture is imported with.
+         * @param[out]	texDesc		Description of the texture to create.
+         * @param[out]	mipOptions	Options to generate the mip levels with.
+         * @param[out]	faceData	Image of each face of the texture.
+         */
+        void PrepareTexture(const SPtr<PixelData>& imgData, const TextureImportOptions& options, TEXTURE_DESC& texDesc,
+            MipMapGenOptions& mipOptions, Vector<SPtr<PixelData>>& faceData);
+
+        /**
+         * Creates the texture of an image, and fills @p faceData with the image of each of its faces, before mips are
+         * generated.
+         */
+        SPtr<Texture> CreateTexture(const String& filePath, const SPtr<PixelData>& imgData,
+            const TextureImportOptions& options, Vector<SPtr<PixelData>>& faceData);
+
+        /**
+         * Bakes the irradiance and specular prefiltered cubemaps of a cubemap texture, and appends them to @p output. See
+         * IBLUtility.
+         */
+        void GenerateIBL(const Vector<SPtr<PixelData>>& faceData, const TextureImportOptions& options,
+            const SPtr<Texture>& texture, Vector<SubResourceRaw>& output);
+
+        /**
+         * Generates the mip levels [@p firstMip, @p lastMip] of a face and appends them to @p output, converted to the
+         * format of the texture.
+         */
+        static void GenerateMips(const SPtr<PixelData>& face, const MipMapGenOptions& mipOptions,
+            const TextureProperties& properties, UINT32 firstMip, UINT32 lastMip, Vector<SPtr<PixelData>>& output);
+
         /** 
          * Converts a magic number into an extension name. 
          * 
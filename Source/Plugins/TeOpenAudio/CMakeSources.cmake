@@ -5,6 +5,7 @@ set (TE_OPENAUDIO_INC_NOFILTER
     "TeOAAudioClip.h"
     "TeOAAudioSource.h"
     "TeOAAudioListener.h"
+    "TeOAStreamingService.h"
     "TeAudioDecoder.h"
     "TeOggVorbisDecoder.h"
     "TeOggVorbisEncoder.h"
@@ -18,6 +19,7 @@ set (TE_OPENAUDIO_SRC_NOFILTER
     "TeOAAudio.cpp"
     "TeOAAudioSource.cpp"
     "TeOAAudioListener.cpp"
+    "TeOAStreamingService.cpp"
     "TeOAAudioClip.cpp"
     "TeOggVorbisDecoder.cpp"
     "TeOggVorbisEncoder.cpp"
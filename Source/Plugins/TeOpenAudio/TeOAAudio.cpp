@@ -3,7 +3,9 @@
 #include "Math/TeMath.h"
 #include "TeOAAudioListener.h"
 #include "TeOAAudioSource.h"
+#include "TeOAStreamingService.h"
 #include "Audio/TeAudioUtility.h"
+#include "Utility/TeTime.h"
 #include "AL/al.h"
 
 namespace te
@@ -12,6 +14,8 @@ namespace te
 
     OAAudio::OAAudio()
     {
+        _streamingService = te_new<OAStreamingService>();
+
         bool enumeratedDevices;
         if (alcIsExtensionPresent(nullptr, "ALC_ENUMERATE_ALL_EXT") != ALC_FALSE)
         {
@@ -70,6 +74,7 @@ namespace te
         StopManualSources();
 
         assert(_listeners.empty() && _sources.empty()); // Everything should be destroyed at this point
+        te_delete(_streamingService);
         ClearContexts();
 
         if (_device != nullptr)
@@ -102,14 +107,8 @@ namespace te
 
     void OAAudio::Update()
     {
-        auto worker = [this]() { UpdateStreaming(); };
-
-        // If previous task still hasn't completed, just skip streaming this frame, queuing more tasks won't help
-        if (_streamingTask != nullptr && !_streamingTask->IsComplete())
-            return;
-
-        _streamingTask = Task::Create("AudioStream", worker);
-        gTaskScheduler().AddTask(_streamingTask);
+        UpdateVoices();
+        _streamingService->Update();
 
         Audio::Update();
     }
@@ -254,7 +253,7 @@ namespace te
                 if (IsExtensionSupported("AL_EXT_float32"))
                 {
                     UINT32 bufferSize = info.NumSamples * sizeof(float);
-                    float* sampleBufferFloat = (float*)te_allocate(bufferSize);
+                    float* sampleBufferFloat = (float*)te_allocate<MemoryCategory::Audio>(bufferSize);
 
                     AudioUtility::ConvertToFloat(samples, info.BitDepth, sampleBufferFloat, info.NumSamples);
 
@@ -268,7 +267,7 @@ namespace te
                     TE_DEBUG("OpenAL doesn't support bit depth larger than 16. Your audio data will be truncated.");
 
                     UINT32 bufferSize = info.NumSamples * 2;
-                    UINT8* sampleBuffer16 = (UINT8*)te_allocate(bufferSize);
+                    UINT8* sampleBuffer16 = (UINT8*)te_allocate<MemoryCategory::Audio>(bufferSize);
 
                     AudioUtility::ConvertBitDepth(samples, info.BitDepth, sampleBuffer16, 16, info.NumSamples);
 
@@ -282,7 +281,7 @@ namespace te
             {
                 // OpenAL expects unsigned 8-bit data, but engine stores it as signed, so convert
                 UINT32 bufferSize = info.NumSamples * (info.BitDepth / 8);
-                UINT8* sampleBuffer = (UINT8*)te_allocate(bufferSize);
+                UINT8* sampleBuffer = (UINT8*)te_allocate<MemoryCategory::Audio>(bufferSize);
 
                 for (UINT32 i = 0; i < info.NumSamples; i++)
                     sampleBuffer[i] = ((INT8*)samples)[i] + 128;
@@ -305,7 +304,7 @@ namespace te
             if (info.BitDepth == 24) // 24-bit not supported, convert to 32-bit
             {
                 UINT32 bufferSize = info.NumSamples * sizeof(INT32);
-                UINT8* sampleBuffer32 = (UINT8*)te_allocate(bufferSize);
+                UINT8* sampleBuffer32 = (UINT8*)te_allocate<MemoryCategory::Audio>(bufferSize);
 
                 AudioUtility::ConvertBitDepth(samples, info.BitDepth, sampleBuffer32, 32, info.NumSamples);
 
@@ -318,7 +317,7 @@ namespace te
             {
                 // OpenAL expects unsigned 8-bit data, but engine stores it as signed, so convert
                 UINT32 bufferSize = info.NumSamples * (info.BitDepth / 8);
-                UINT8* sampleBuffer = (UINT8*)te_allocate(bufferSize);
+                UINT8* sampleBuffer = (UINT8*)te_allocate<MemoryCategory::Audio>(bufferSize);
 
                 for (UINT32 i = 0; i < info.NumSamples; i++)
                     sampleBuffer[i] = ((INT8*)samples)[i] + 128;
@@ -377,60 +376,130 @@ namespace te
         _contexts.clear();
     }
 
-    /** Streams new data to audio sources that require it. */
-    void OAAudio::UpdateStreaming()
+    UINT64 OAAudio::StartStreaming(OAAudioSource* source, UINT32 position)
     {
+        return _streamingService->StartStreaming(source, source->_streamGeneration, source->GetClip().GetInternalPtr(),
+            position, _streamingLookAhead);
+    }
+
+    UINT64 OAAudio::StopStreaming(OAAudioSource* source)
+    {
+        return _streamingService->StopStreaming(source);
+    }
+
+    void OAAudio::WaitForStreamingCommand(UINT64 id)
+    {
+        _streamingService->WaitForCommand(id);
+    }
+
+    void OAAudio::UpdateVoices()
+    {
+        // Virtual sources don't advance either while audio is paused, and voices are kept as they are
+        if (_isPaused)
+            return;
+
+        const float frameDelta = gTime().GetFrameDelta();
+
+        _voiceCandidates.clear();
+        for (auto& source : _sources)
         {
-            Lock lock(_mutex);
+            if (source->IsVirtual())
+                source->UpdateVirtual(frameDelta);
 
-            for (auto& command : _streamingCommandQueue)
+            if (source->GetState() != AudioSourceState::Playing)
             {
-                switch (command.type)
-                {
-                case StreamingCommandType::Start:
-                    _streamingSources.insert(command.source);
-                    break;
-                case StreamingCommandType::Stop:
-                    _streamingSources.erase(command.source);
-                    break;
-                default:
-                    break;
-                }
+                // Stopped or paused sources don't need their voice until they play again
+                ReleaseVoice(source);
+                continue;
             }
 
-            _streamingCommandQueue.clear();
-            _destroyedSources.clear();
+            float audibility = GetAudibility(source);
+            if (audibility < MIN_AUDIBILITY)
+            {
+                ReleaseVoice(source);
+                continue;
+            }
+
+            // Sources owning a voice keep it against sources that are only slightly louder, so voices don't swap back
+            // and forth every frame
+            if (!source->IsVirtual())
+                audibility *= VOICE_KEEP_FACTOR;
+
+            _voiceCandidates.push_back({ source, source->GetPriority(), audibility });
         }
 
-        for (auto& source : _streamingSources)
+        UINT32 numAudible = std::min((UINT32)_voiceCandidates.size(), _maxVoices);
+        if ((UINT32)_voiceCandidates.size() > numAudible)
         {
-            // Check if the source got destroyed while streaming
+            auto compare = [](const VoiceCandidate& a, const VoiceCandidate& b)
             {
-                Lock lock(_mutex);
+                if (a.Priority != b.Priority)
+                    return a.Priority > b.Priority;
 
-                auto iterFind = _destroyedSources.find(source);
-                if (iterFind != _destroyedSources.end())
-                    continue;
-            }
+                return a.Audibility > b.Audibility;
+            };
+
+            std::nth_element(_voiceCandidates.begin(), _voiceCandidates.begin() + numAudible, _voiceCandidates.end(),
+                compare);
 
-            source->Stream();
+            // Voices are released first, so they can be given to the sources ranked before
+            for (UINT32 i = numAudible; i < (UINT32)_voiceCandidates.size(); i++)
+                ReleaseVoice(_voiceCandidates[i].Source);
         }
+
+        for (UINT32 i = 0; i < numAudible; i++)
+            AcquireVoice(_voiceCandidates[i].Source);
+    }
+
+    bool OAAudio::AcquireVoice(OAAudioSource* source)
+    {
+        if (!source->IsVirtual())
+            return true;
+
+        if (_numVoices >= _maxVoices)
+            return false;
+
+        _numVoices++;
+        source->Devirtualize();
+
+        return true;
     }
 
-    void OAAudio::StartStreaming(OAAudioSource* source)
+    void OAAudio::ReleaseVoice(OAAudioSource* source)
     {
-        Lock lock(_mutex);
+        if (source->IsVirtual())
+            return;
 
-        _streamingCommandQueue.push_back({ StreamingCommandType::Start, source });
-        _destroyedSources.erase(source);
+        source->Virtualize();
+        _numVoices--;
     }
 
-    void OAAudio::StopStreaming(OAAudioSource* source)
+    float OAAudio::GetAudibility(const OAAudioSource* source) const
     {
-        Lock lock(_mutex);
+        float gain = source->GetVolume();
+        if (!source->Is3D() || !source->GetIsPlay3D())
+            return gain;
+
+        // OpenAL uses a listener at the origin if none was created
+        Vector3 position = source->GetTransform().GetPosition();
+        float distance = position.Length();
+
+        if (!_listeners.empty())
+        {
+            distance = std::numeric_limits<float>::max();
+            for (auto& listener : _listeners)
+                distance = std::min(distance, position.Distance(listener->GetTransform().GetPosition()));
+        }
+
+        // AL_INVERSE_DISTANCE_CLAMPED, the default distance model
+        float minDistance = source->GetMinDistance();
+        distance = std::max(distance, minDistance);
+
+        float attenuation = minDistance + source->GetAttenuation() * (distance - minDistance);
+        if (attenuation > 0.0f)
+            gain *= minDistance / attenuation;
 
-        _streamingCommandQueue.push_back({ StreamingCommandType::Stop, source });
-        _destroyedSources.insert(source);
+        return gain;
     }
 
     SPtr<AudioClip> OAAudio::CreateClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples,
@@ -3,7 +3,6 @@
 #include "TeOAPrerequisites.h"
 #include "Audio/TeAudio.h"
 #include "TeOAAudioSource.h"
-#include "Threading/TeTaskScheduler.h"
 #include <AL/alc.h>
 
 namespace te
@@ -44,6 +43,21 @@ namespace te
         /** @copydoc Audio::GetAllDevices */
         const Vector<AudioDevice>& GetAllDevices() const override { return _allDevices; };
 
+        /** @copydoc Audio::SetMaxVoices */
+        void SetMaxVoices(UINT32 count) override { _maxVoices = count; }
+
+        /** @copydoc Audio::GetMaxVoices */
+        UINT32 GetMaxVoices() const override { return _maxVoices; }
+
+        /** Returns the number of audio sources currently owning OpenAL sources. */
+        UINT32 GetNumVoices() const { return _numVoices; }
+
+        /** @copydoc Audio::SetStreamingLookAhead */
+        void SetStreamingLookAhead(float seconds) override { _streamingLookAhead = std::max(seconds, 0.0f); }
+
+        /** @copydoc Audio::GetStreamingLookAhead */
+        float GetStreamingLookAhead() const override { return _streamingLookAhead; }
+
         /** Checks is a specific OpenAL extension supported. */
         bool IsExtensionSupported(const String& extension) const;
 
@@ -80,18 +94,12 @@ namespace te
     private:
         friend class OAAudioSource;
 
-        /** Type of a command that can be queued for a streaming audio source. */
-        enum class StreamingCommandType
+        /** Playing audio source competing for a voice. */
+        struct VoiceCandidate
         {
-            Start,
-            Stop
-        };
-
-        /** Command queued for a streaming audio source. */
-        struct StreamingCommand
-        {
-            StreamingCommandType type;
-            OAAudioSource* source;
+            OAAudioSource* Source;
+            INT32 Priority;
+            float Audibility;
         };
 
         /** @copydoc Audio::CreateClip */
@@ -115,14 +123,35 @@ namespace te
         /** Delete all existing OpenAL contexts. */
         void ClearContexts();
 
-        /** Streams new data to audio sources that require it. */
-        void UpdateStreaming();
+        /**
+         * Starts data streaming for the provided source, from @p position (in samples). Returns the identifier of the
+         * command sent to the streaming service.
+         */
+        UINT64 StartStreaming(OAAudioSource* source, UINT32 position);
 
-        /** Starts data streaming for the provided source. */
-        void StartStreaming(OAAudioSource* source);
+        /** Stops data streaming for the provided source. Returns the identifier of the command sent to the streaming service. */
+        UINT64 StopStreaming(OAAudioSource* source);
 
-        /** Stops data streaming for the provided source. */
-        void StopStreaming(OAAudioSource* source);
+        /** Blocks until the streaming service has processed the command @p id. */
+        void WaitForStreamingCommand(UINT64 id);
+
+        /**
+         * Ranks the playing sources by priority and by how loud they are for the listeners, gives voices to the first
+         * ones and virtualizes the others. Advances the time of virtual sources.
+         */
+        void UpdateVoices();
+
+        /**
+         * Gives a voice to a virtual source if the budget allows it, its playback then continues on OpenAL sources.
+         * Returns true if the source has a voice.
+         */
+        bool AcquireVoice(OAAudioSource* source);
+
+        /** Takes the voice of a source back, its playback continues virtually. */
+        void ReleaseVoice(OAAudioSource* source);
+
+        /** Returns the gain of a source for the closest listener, as computed by the OpenAL distance model. */
+        float GetAudibility(const OAAudioSource* source) const;
 
     private:
         float _volume = 1.0f;
@@ -137,12 +166,20 @@ namespace te
         Vector<ALCcontext*> _contexts;
         UnorderedSet<OAAudioSource*> _sources;
 
-        // Streaming thread
-        Vector<StreamingCommand> _streamingCommandQueue;
-        UnorderedSet<OAAudioSource*> _streamingSources;
-        UnorderedSet<OAAudioSource*> _destroyedSources;
-        SPtr<Task> _streamingTask;
-        mutable Mutex _mutex;
+        // Voices
+        static constexpr UINT32 DEFAULT_MAX_VOICES = 64;
+        static constexpr float MIN_AUDIBILITY = 0.001f; // -60dB, sources below are virtualized even if voices are free
+        static constexpr float VOICE_KEEP_FACTOR = 1.25f; // A source must be that much louder to take a used voice
+
+        UINT32 _maxVoices = DEFAULT_MAX_VOICES;
+        UINT32 _numVoices = 0;
+        Vector<VoiceCandidate> _voiceCandidates;
+
+        // Streaming
+        static constexpr float DEFAULT_STREAMING_LOOK_AHEAD = 1.0f;
+
+        OAStreamingService* _streamingService = nullptr;
+        float _streamingLookAhead = DEFAULT_STREAMING_LOOK_AHEAD;
     };
 
     /** Provides easier access to OAAudio. */
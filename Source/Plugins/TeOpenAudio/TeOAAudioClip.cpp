@@ -48,7 +48,7 @@ namespace te
                 }
 
                 UINT32 bufferSize = info.NumSamples * (info.BitDepth / 8);
-                UINT8* sampleBuffer = (UINT8*)te_allocate(bufferSize);
+                UINT8* sampleBuffer = (UINT8*)te_allocate<MemoryCategory::Audio>(bufferSize);
 
                 // Decompress from Ogg
                 if (_desc.Format == AudioFormat::VORBIS)
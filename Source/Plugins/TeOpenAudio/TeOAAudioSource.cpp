@@ -1,6 +1,7 @@
 #include "TeOAAudioSource.h"
 #include "TeOAAudio.h"
 #include "TeOAAudioClip.h"
+#include "TeOAStreamingService.h"
 #include "AL/al.h"
 
 namespace te
@@ -9,20 +10,26 @@ namespace te
         : _streamBuffers()
         , _busyBuffers()
     { 
+        // Sources are created virtual, they get a voice once they play
         gOAAudio().RegisterSource(this);
-        Rebuild();
     }
 
     OAAudioSource::~OAAudioSource()
     { 
-        Clear();
+        gOAAudio().ReleaseVoice(this);
         gOAAudio().UnregisterSource(this);
+
+        // The streaming thread might still be streaming to this source until it gets the stop command
+        gOAAudio().WaitForStreamingCommand(_streamingCommand);
     }
 
     void OAAudioSource::SetTransform(const Transform& transform)
     {
         AudioSource::SetTransform(transform);
 
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -54,6 +61,9 @@ namespace te
     {
         AudioSource::SetVelocity(velocity);
 
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -72,6 +82,9 @@ namespace te
     {
         AudioSource::SetVolume(volume);
 
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -87,6 +100,9 @@ namespace te
     {
         AudioSource::SetPitch(pitch);
 
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -102,6 +118,9 @@ namespace te
     {
         AudioSource::SetIsLooping(loop);
 
+        if (_isVirtual)
+            return;
+
         // When streaming we handle looping manually
         if (RequiresStreaming())
             loop = false;
@@ -126,6 +145,9 @@ namespace te
     {
         AudioSource::SetMinDistance(distance);
 
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -141,6 +163,9 @@ namespace te
     {
         AudioSource::SetAttenuation(attenuation);
 
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -163,6 +188,12 @@ namespace te
         if (!_audioClip.IsLoaded())
             return;
 
+        if (_isVirtual)
+        {
+            _savedTime = time;
+            return;
+        }
+
         AudioSourceState state = GetState();
         Stop();
 
@@ -200,6 +231,9 @@ namespace te
 
     float OAAudioSource::GetTime() const
     {
+        if (_isVirtual)
+            return _savedTime;
+
         Lock lock(_mutex);
 
         auto& contexts = gOAAudio().GetContexts();
@@ -231,6 +265,18 @@ namespace te
         if (_globallyPaused)
             return;
 
+        if (_isVirtual)
+        {
+            if (_savedState == AudioSourceState::Playing)
+                return;
+
+            _savedState = AudioSourceState::Playing;
+
+            // Starts right away if a voice is free, otherwise the source waits for one in the next update
+            gOAAudio().AcquireVoice(this);
+            return;
+        }
+
         if(GetState() == AudioSourceState::Playing)
             return;
 
@@ -239,10 +285,7 @@ namespace te
             Lock lock(_mutex);
 
             if (!_isStreaming)
-            {
                 StartStreaming();
-                StreamUnlocked(); // Stream first block on this thread to ensure something can play right away
-            }
         }
 
         auto& contexts = gOAAudio().GetContexts();
@@ -265,6 +308,14 @@ namespace te
 
     void OAAudioSource::Pause()
     {
+        if (_isVirtual)
+        {
+            if (_savedState == AudioSourceState::Playing)
+                _savedState = AudioSourceState::Paused;
+
+            return;
+        }
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -278,6 +329,13 @@ namespace te
 
     void OAAudioSource::Stop()
     { 
+        if (_isVirtual)
+        {
+            _savedState = AudioSourceState::Stopped;
+            _savedTime = 0.0f;
+            return;
+        }
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -302,6 +360,9 @@ namespace te
 
     AudioSourceState OAAudioSource::GetState() const
     { 
+        if (_isVirtual)
+            return _savedState;
+
         ALint state;
         alGetSourcei(_sourceIDs[0], AL_SOURCE_STATE, &state);
 
@@ -320,6 +381,9 @@ namespace te
 
     void OAAudioSource::Clear()
     {
+        if (_isVirtual)
+            return;
+
         _savedState = GetState();
         _savedTime = GetTime();
         Stop();
@@ -342,6 +406,9 @@ namespace te
 
     void OAAudioSource::Rebuild()
     {
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
 
@@ -365,6 +432,7 @@ namespace te
             if (contexts.size() > 1)
                 alcMakeContextCurrent(contexts[i]);
 
+            alSourcef(_sourceIDs[i], AL_GAIN, _volume);
             alSourcef(_sourceIDs[i], AL_PITCH, _pitch);
             alSourcef(_sourceIDs[i], AL_REFERENCE_DISTANCE, _minDistance);
             alSourcef(_sourceIDs[i], AL_ROLLOFF_FACTOR, _attenuation);
@@ -415,22 +483,65 @@ namespace te
             Pause();
     }
 
-    void OAAudioSource::Stream()
+    void OAAudioSource::Virtualize()
     {
-        Lock lock(_mutex);
+        Clear();
+        _isVirtual = true;
+    }
 
-        StreamUnlocked();
+    void OAAudioSource::Devirtualize()
+    {
+        _isVirtual = false;
+        Rebuild();
     }
 
-    void OAAudioSource::StreamUnlocked()
+    void OAAudioSource::UpdateVirtual(float delta)
     {
-        AudioDataInfo info;
-        info.BitDepth = _audioClip->GetBitDepth();
-        info.NumChannels = _audioClip->GetNumChannels();
-        info.SampleRate = _audioClip->GetFrequency();
-        info.NumSamples = 0;
+        if (_savedState != AudioSourceState::Playing)
+            return;
 
-        UINT32 totalNumSamples = _audioClip->GetNumSamples();
+        if (!_audioClip.IsLoaded())
+        {
+            _savedState = AudioSourceState::Stopped;
+            _savedTime = 0.0f;
+            return;
+        }
+
+        float length = _audioClip->GetLength();
+        _savedTime += delta * _pitch;
+
+        if (_savedTime >= length)
+        {
+            if (_loop && length > 0.0f)
+                _savedTime = std::fmod(_savedTime, length);
+            else
+            {
+                _savedState = AudioSourceState::Stopped;
+                _savedTime = 0.0f;
+            }
+        }
+    }
+
+    bool OAAudioSource::Stream(OAStream& stream)
+    {
+        // The main thread can hold the lock while it waits for the streaming service to take a command, so the
+        // streaming thread never waits for it, and tries again on its next update instead
+        Lock lock(_mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+            return true;
+
+        // The source may have been stopped, virtualized or restarted after the stream was last updated
+        if (!_isStreaming || stream.Generation != _streamGeneration)
+            return false;
+
+        stream.Loop = _loop;
+
+        return StreamUnlocked(stream);
+    }
+
+    bool OAAudioSource::StreamUnlocked(OAStream& stream)
+    {
+        UINT32 totalNumSamples = stream.Clip->GetNumSamples();
 
         // Note: It is safe to access contexts here only because it is guaranteed by the OAAudio manager that it will always
         // stop all streaming before changing contexts. Otherwise a mutex lock would be needed for every context access.
@@ -478,7 +589,7 @@ namespace te
                 if (bufferBits == 0)
                 {
                     TE_DEBUG("Error decoding stream.");
-                    return;
+                    return true;
                 }
                 else
                 {
@@ -492,8 +603,10 @@ namespace te
 
                     if (!_loop) // Variable used on both threads and not thread safe, but it doesn't matter
                     {
-                        StopStreaming();
-                        return;
+                        // The streaming service drops the stream when this returns false, no need to notify it
+                        _isStreaming = false;
+                        ReleaseStreamBuffers();
+                        return false;
                     }
                 }
             }
@@ -504,16 +617,23 @@ namespace te
             if (_busyBuffers[i] != 0)
                 continue;
 
-            if (FillBuffer(_streamBuffers[i], info, totalNumSamples))
-            {
-                for (auto& source : _sourceIDs)
-                    alSourceQueueBuffers(source, 1, &_streamBuffers[i]);
-
-                _busyBuffers[i] |= 1 << i;
-            }
-            else
+            OAStreamChunk* chunk = stream.GetReadyChunk();
+            if (chunk == nullptr) // Decoders will catch up, the source still has its other buffers to play
                 break;
+
+            AudioDataInfo info = stream.Info;
+            info.NumSamples = chunk->NumSamples;
+
+            gOAAudio().WriteToOpenALBuffer(_streamBuffers[i], chunk->Samples.data(), info);
+            stream.PopReadyChunk();
+
+            for (auto& source : _sourceIDs)
+                alSourceQueueBuffers(source, 1, &_streamBuffers[i]);
+
+            _busyBuffers[i] |= 1 << i;
         }
+
+        return true;
     }
 
     void OAAudioSource::StartStreaming()
@@ -521,10 +641,27 @@ namespace te
         assert(!_isStreaming);
 
         alGenBuffers(_streamBufferCount, _streamBuffers);
-        gOAAudio().StartStreaming(this);
 
         memset(&_busyBuffers, 0, sizeof(_busyBuffers));
         _isStreaming = true;
+        _streamGeneration++;
+
+        AudioDataInfo info;
+        info.BitDepth = _audioClip->GetBitDepth();
+        info.NumChannels = _audioClip->GetNumChannels();
+        info.SampleRate = _audioClip->GetFrequency();
+        info.NumSamples = 0;
+
+        // Stream first block on this thread to ensure something can play right away
+        if (FillBuffer(_streamBuffers[0], info, _audioClip->GetNumSamples()))
+        {
+            for (auto& source : _sourceIDs)
+                alSourceQueueBuffers(source, 1, &_streamBuffers[0]);
+
+            _busyBuffers[0] |= 1;
+        }
+
+        _streamingCommand = gOAAudio().StartStreaming(this, _streamQueuedPosition);
     }
 
     void OAAudioSource::StopStreaming()
@@ -532,8 +669,13 @@ namespace te
         assert(_isStreaming);
 
         _isStreaming = false;
-        gOAAudio().StopStreaming(this);
+        _streamingCommand = gOAAudio().StopStreaming(this);
 
+        ReleaseStreamBuffers();
+    }
+
+    void OAAudioSource::ReleaseStreamBuffers()
+    {
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -559,9 +701,14 @@ namespace te
 
         _globallyPaused = pause;
 
-        if (GetState() == AudioSourceState::Playing)
+        // Virtual sources keep their state, their time doesn't advance while audio is paused
+        if (_isVirtual)
+            return;
+
+        if (pause)
         {
-            if (pause)
+            _playingBeforeGlobalPause = GetState() == AudioSourceState::Playing;
+            if (_playingBeforeGlobalPause)
             {
                 auto& contexts = gOAAudio().GetContexts();
                 UINT32 numContexts = (UINT32)contexts.size();
@@ -573,10 +720,11 @@ namespace te
                     alSourcePause(_sourceIDs[i]);
                 }
             }
-            else
-            {
-                Play();
-            }
+        }
+        else if (_playingBeforeGlobalPause)
+        {
+            _playingBeforeGlobalPause = false;
+            Play();
         }
     }
 
@@ -614,26 +762,28 @@ namespace te
         }
 
         // Read audio data
-        UINT32 numSamples = std::min(numRemainingSamples, info.SampleRate * info.NumChannels); // 1 second of data
+        UINT32 numSamples = std::min(numRemainingSamples, OAStreamingService::GetChunkNumSamples(info));
         UINT32 sampleBufferSize = numSamples * (info.BitDepth / 8);
 
-        UINT8* samples = (UINT8*)te_allocate(sampleBufferSize);
+        if (_streamSamples.size() < sampleBufferSize)
+            _streamSamples.resize(sampleBufferSize);
 
         OAAudioClip* audioClip = static_cast<OAAudioClip*>(_audioClip.Get());
 
-        audioClip->GetSamples(samples, _streamQueuedPosition, numSamples);
+        audioClip->GetSamples(_streamSamples.data(), _streamQueuedPosition, numSamples);
         _streamQueuedPosition += numSamples;
 
         info.NumSamples = numSamples;
-        gOAAudio().WriteToOpenALBuffer(buffer, samples, info);
-
-        te_delete(samples);
+        gOAAudio().WriteToOpenALBuffer(buffer, _streamSamples.data(), info);
 
         return true;
     }
 
     void OAAudioSource::ApplyClip()
     {
+        if (_isVirtual)
+            return;
+
         auto& contexts = gOAAudio().GetContexts();
         UINT32 numContexts = (UINT32)contexts.size();
         for (UINT32 i = 0; i < numContexts; i++)
@@ -63,25 +63,50 @@ namespace te
 
     private:
         friend class OAAudio;
+        friend class OAStreamingService;
 
-        /** Destroys the internal representation of the audio source. */
+        /** Destroys the internal representation of the audio source. Does nothing for virtual sources. */
         void Clear();
 
-        /** Rebuilds the internal representation of an audio source. */
+        /** Rebuilds the internal representation of an audio source. Does nothing for virtual sources. */
         void Rebuild();
 
-        /** Streams new data into the source audio buffer, if needed. */
-        void Stream();
+        /**
+         * Checks if the source has no OpenAL sources (it doesn't have a voice). The playback state and time of a
+         * virtual source are tracked in _savedState and _savedTime.
+         */
+        bool IsVirtual() const { return _isVirtual; }
+
+        /** Saves the playback state and releases the OpenAL sources. */
+        void Virtualize();
+
+        /** Creates the OpenAL sources and resumes the playback from the state and time of the virtual playback. */
+        void Devirtualize();
+
+        /** Advances the time of the virtual playback, as if the clip had been played for @p delta seconds. */
+        void UpdateVirtual(float delta);
+
+        /**
+         * Queues the chunks decoded for @p stream into the free source audio buffers. Called from the streaming thread.
+         * Returns false if the source isn't streaming @p stream anymore.
+         */
+        bool Stream(OAStream& stream);
 
         /** Same as Stream(), but without a mutex lock (up to the caller to lock it). */
-        void StreamUnlocked();
+        bool StreamUnlocked(OAStream& stream);
 
-        /** Starts data streaming from the currently attached audio clip. */
+        /**
+         * Starts data streaming from the currently attached audio clip. The first buffer is filled right away so
+         * something can play, the streaming service decodes the rest.
+         */
         void StartStreaming();
 
         /** Stops streaming data from the currently attached audio clip. */
         void StopStreaming();
 
+        /** Unqueues and deletes the streaming buffers. */
+        void ReleaseStreamBuffers();
+
         /** Pauses or resumes audio playback due to the global pause setting. */
         void SetGlobalPause(bool pause);
 
@@ -91,7 +116,7 @@ namespace te
         /** Returns true if the audio source is receiving audio data from a separate thread (as opposed to loading it all at once). */
         bool RequiresStreaming() const;
 
-        /** Fills the provided buffer with streaming data. */
+        /** Fills the provided buffer with a chunk of streaming data, decoded on the calling thread. */
         bool FillBuffer(UINT32 buffer, AudioDataInfo& info, UINT32 maxNumSamples);
 
         /** Makes the current audio clip active. Should be called whenever the audio clip changes. */
@@ -101,13 +126,18 @@ namespace te
         Vector<UINT32> _sourceIDs;
         float _savedTime = 0.0f;
         AudioSourceState _savedState = AudioSourceState::Stopped;
+        bool _isVirtual = true;
         bool _globallyPaused = false;
+        bool _playingBeforeGlobalPause = false;
 
         static const UINT32 _streamBufferCount = 3; // Maximum 32
         UINT32 _streamBuffers[_streamBufferCount];
         UINT32 _busyBuffers[_streamBufferCount];
         UINT32 _streamProcessedPosition = 0;
         UINT32 _streamQueuedPosition = 0;
+        UINT32 _streamGeneration = 0; // Identifies the current stream, the streaming service ignores the previous ones
+        UINT64 _streamingCommand = 0; // Last command sent to the streaming service
+        Vector<UINT8> _streamSamples; // Samples of the first chunk, reused by every stream
         bool _isStreaming = false;
         mutable Mutex _mutex;
     };
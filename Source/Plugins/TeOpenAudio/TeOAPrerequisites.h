@@ -6,4 +6,6 @@ namespace te
 { 
     class OAAudioListener;
     class OAAudioSource;
+    class OAStreamingService;
+    struct OAStream;
 }
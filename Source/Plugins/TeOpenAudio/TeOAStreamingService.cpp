@@ -0,0 +1,320 @@
+#include "TeOAStreamingService.h"
+#include "TeOAAudioSource.h"
+#include "TeOAAudioClip.h"
+
+#include <cmath>
+
+namespace te
+{
+    void OAStream::PopReadyChunk()
+    {
+        assert(NumReady > 0);
+
+        FirstReady = (FirstReady + 1) % (UINT32)Chunks.size();
+        NumReady--;
+    }
+
+    OAStreamingService::OAStreamingService(UINT32 numDecoders)
+    {
+        numDecoders = std::max(numDecoders, 1U);
+        for (UINT32 i = 0; i < numDecoders; i++)
+        {
+            Decoder* decoder = te_new<Decoder>();
+            decoder->WorkerThread = Thread([this, decoder]() { RunDecoder(*decoder); });
+
+            _decoders.push_back(decoder);
+        }
+
+        _streamingThread = Thread([this]() { RunStreaming(); });
+    }
+
+    OAStreamingService::~OAStreamingService()
+    {
+        _running.store(false);
+
+        Wake(_wakeMutex, _wakeSignal);
+        _streamingThread.join();
+
+        for (auto& decoder : _decoders)
+        {
+            Wake(decoder->WakeMutex, decoder->WakeSignal);
+            decoder->WorkerThread.join();
+
+            te_delete(decoder);
+        }
+
+        for (auto& stream : _streams)
+            te_delete(stream);
+
+        for (auto& stream : _freeStreams)
+            te_delete(stream);
+
+        Update();
+    }
+
+    UINT32 OAStreamingService::GetChunkNumSamples(const AudioDataInfo& info)
+    {
+        UINT32 numFrames = std::max((UINT32)(info.SampleRate * CHUNK_DURATION), 1U);
+        return numFrames * info.NumChannels;
+    }
+
+    UINT64 OAStreamingService::StartStreaming(OAAudioSource* source, UINT32 generation, const SPtr<AudioClip>& clip,
+        UINT32 position, float lookAhead)
+    {
+        return PushCommand({ CommandType::Start, source, generation, clip, position, lookAhead });
+    }
+
+    UINT64 OAStreamingService::StopStreaming(OAAudioSource* source)
+    {
+        return PushCommand({ CommandType::Stop, source, 0, nullptr, 0, 0.0f });
+    }
+
+    void OAStreamingService::WaitForCommand(UINT64 id)
+    {
+        if (_numProcessedCommands.load(std::memory_order_acquire) >= id)
+            return;
+
+        Wake(_wakeMutex, _wakeSignal);
+
+        while (_numProcessedCommands.load(std::memory_order_acquire) < id)
+            std::this_thread::yield();
+    }
+
+    void OAStreamingService::Update()
+    {
+        SPtr<AudioClip> clip;
+        while (_releasedClips.Pop(clip))
+            clip = nullptr;
+    }
+
+    void OAStreamingService::RunStreaming()
+    {
+        while (_running.load())
+        {
+            ProcessCommands();
+            ProcessResults();
+            UpdateStreams();
+
+            Lock lock(_wakeMutex);
+            _wakeSignal.wait_for(lock, std::chrono::milliseconds(UPDATE_PERIOD_MS),
+                [this]() { return !_running.load() || HasPendingWork(); });
+        }
+    }
+
+    void OAStreamingService::RunDecoder(Decoder& decoder)
+    {
+        while (true)
+        {
+            DecodeJob job;
+            if (!decoder.Jobs.Pop(job))
+            {
+                Lock lock(decoder.WakeMutex);
+                decoder.WakeSignal.wait(lock, [this, &decoder]() { return !_running.load() || !decoder.Jobs.IsEmpty(); });
+
+                if (!_running.load())
+                    return;
+
+                continue;
+            }
+
+            // The streaming thread doesn't touch the chunk, the clip or the chunk list of the stream until the job is
+            // back, so they can be used without locking
+            OAStreamChunk& chunk = job.Stream->Chunks[job.Chunk];
+            OAAudioClip* clip = static_cast<OAAudioClip*>(job.Stream->Clip.get());
+            clip->GetSamples(chunk.Samples.data(), job.Position, job.NumSamples);
+
+            // Streams only have one chunk decoding at a time, so results only back up if the streaming thread is late
+            while (!decoder.Results.Push(job))
+            {
+                if (!_running.load())
+                    return;
+
+                Wake(_wakeMutex, _wakeSignal);
+                std::this_thread::yield();
+            }
+
+            Wake(_wakeMutex, _wakeSignal);
+        }
+    }
+
+    void OAStreamingService::ProcessCommands()
+    {
+        Command command;
+        while (_commands.Pop(command))
+        {
+            // A source only has one stream, the previous one is stopped by any command
+            for (auto& stream : _streams)
+            {
+                if (stream->Source == command.Source)
+                    stream->Source = nullptr;
+            }
+
+            if (command.Type == CommandType::Start)
+            {
+                OAStream* stream;
+                if (!_freeStreams.empty())
+                {
+                    stream = _freeStreams.back();
+                    _freeStreams.pop_back();
+                }
+                else
+                    stream = te_new<OAStream>();
+
+                stream->Source = command.Source;
+                stream->Generation = command.Generation;
+                stream->Clip = std::move(command.Clip);
+                stream->Info.BitDepth = stream->Clip->GetBitDepth();
+                stream->Info.NumChannels = stream->Clip->GetNumChannels();
+                stream->Info.SampleRate = stream->Clip->GetFrequency();
+                stream->Info.NumSamples = 0;
+                stream->Loop = false;
+
+                stream->DecodePosition = command.Position;
+                stream->ChunkNumSamples = GetChunkNumSamples(stream->Info);
+                stream->FirstReady = 0;
+                stream->NumReady = 0;
+                stream->IsDecoding = false;
+
+                // Chunk memory of a recycled stream is reused, it only grows for clips with larger chunks
+                UINT32 numChunks = std::max((UINT32)std::ceil(command.LookAhead / CHUNK_DURATION), 1U);
+                stream->Chunks.resize(numChunks);
+
+                for (auto& chunk : stream->Chunks)
+                {
+                    chunk.Samples.resize(stream->ChunkNumSamples * (stream->Info.BitDepth / 8));
+                    chunk.NumSamples = 0;
+                }
+
+                _streams.push_back(stream);
+            }
+
+            _numProcessedCommands.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void OAStreamingService::ProcessResults()
+    {
+        for (auto& decoder : _decoders)
+        {
+            DecodeJob job;
+            while (decoder->Results.Pop(job))
+            {
+                OAStream* stream = job.Stream;
+
+                stream->Chunks[job.Chunk].NumSamples = job.NumSamples;
+                stream->NumReady++;
+                stream->IsDecoding = false;
+            }
+        }
+    }
+
+    void OAStreamingService::UpdateStreams()
+    {
+        for (UINT32 i = 0; i < (UINT32)_streams.size();)
+        {
+            OAStream* stream = _streams[i];
+
+            if (stream->Source != nullptr && !stream->Source->Stream(*stream))
+                stream->Source = nullptr;
+
+            if (stream->Source == nullptr)
+            {
+                // Clips are released on the main thread, and the stream can only be reused once its chunk is decoded
+                if (!stream->IsDecoding && _releasedClips.Push(std::move(stream->Clip)))
+                {
+                    _streams[i] = _streams.back();
+                    _streams.pop_back();
+                    _freeStreams.push_back(stream);
+                    continue;
+                }
+
+                i++;
+                continue;
+            }
+
+            if (!stream->IsDecoding && stream->NumReady < (UINT32)stream->Chunks.size())
+                Decode(*stream);
+
+            i++;
+        }
+    }
+
+    bool OAStreamingService::Decode(OAStream& stream)
+    {
+        UINT32 numClipSamples = stream.Clip->GetNumSamples();
+        if (numClipSamples == 0)
+            return true;
+
+        UINT32 numRemainingSamples = numClipSamples - stream.DecodePosition;
+        if (numRemainingSamples == 0) // Reached the end
+        {
+            if (!stream.Loop)
+                return true;
+
+            stream.DecodePosition = 0;
+            numRemainingSamples = numClipSamples;
+        }
+
+        DecodeJob job;
+        job.Stream = &stream;
+        job.Chunk = (stream.FirstReady + stream.NumReady) % (UINT32)stream.Chunks.size();
+        job.Position = stream.DecodePosition;
+        job.NumSamples = std::min(numRemainingSamples, stream.ChunkNumSamples);
+
+        // Jobs go to the decoders in turn, skipping those with a full queue
+        UINT32 numDecoders = (UINT32)_decoders.size();
+        for (UINT32 i = 0; i < numDecoders; i++)
+        {
+            Decoder* decoder = _decoders[_nextDecoder];
+            _nextDecoder = (_nextDecoder + 1) % numDecoders;
+
+            if (decoder->Jobs.Push(job))
+            {
+                stream.DecodePosition += job.NumSamples;
+                stream.IsDecoding = true;
+
+                Wake(decoder->WakeMutex, decoder->WakeSignal);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    UINT64 OAStreamingService::PushCommand(Command command)
+    {
+        while (!_commands.Push(std::move(command)))
+        {
+            Wake(_wakeMutex, _wakeSignal);
+            std::this_thread::yield();
+        }
+
+        Wake(_wakeMutex, _wakeSignal);
+
+        return ++_numPushedCommands;
+    }
+
+    bool OAStreamingService::HasPendingWork() const
+    {
+        if (!_commands.IsEmpty())
+            return true;
+
+        for (auto& decoder : _decoders)
+        {
+            if (!decoder->Results.IsEmpty())
+                return true;
+        }
+
+        return false;
+    }
+
+    void OAStreamingService::Wake(Mutex& mutex, Signal& signal)
+    {
+        // Locking makes sure the thread is either waiting or will see the new state when checking if it should wait
+        {
+            Lock lock(mutex);
+        }
+
+        signal.notify_one();
+    }
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "TeOAPrerequisites.h"
+#include "Threading/TeThreading.h"
+#include "Threading/TeSPSCQueue.h"
+
+#include <atomic>
+
+namespace te
+{
+    /** Chunk of samples decoded ahead of playback for a streaming source. */
+    struct OAStreamChunk
+    {
+        Vector<UINT8> Samples; // Sized for a full chunk when the stream starts, then reused
+        UINT32 NumSamples = 0;
+    };
+
+    /**
+     * State of a streaming audio source, owned by the streaming service. Decoded chunks are kept in a ring of
+     * look-ahead slots: ready chunks start at FirstReady, and the slot following them is the one being decoded, if any.
+     * Only the streaming thread changes the state, decoder threads only write the samples of the slot they're given.
+     */
+    struct OAStream
+    {
+        /** Returns the first decoded chunk, or null if none is ready. */
+        OAStreamChunk* GetReadyChunk() { return NumReady > 0 ? &Chunks[FirstReady] : nullptr; }
+
+        /** Frees the first decoded chunk, once it was written to an OpenAL buffer. */
+        void PopReadyChunk();
+
+        OAAudioSource* Source = nullptr; // Null once the source stopped streaming, until the stream can be recycled
+        UINT32 Generation = 0;
+        SPtr<AudioClip> Clip;
+        AudioDataInfo Info;
+        bool Loop = false;
+
+        UINT32 DecodePosition = 0;
+        UINT32 ChunkNumSamples = 0;
+        Vector<OAStreamChunk> Chunks;
+        UINT32 FirstReady = 0;
+        UINT32 NumReady = 0;
+        bool IsDecoding = false;
+    };
+
+    /**
+     * Streams audio data to the sources playing clips that aren't loaded in an OpenAL buffer. A dedicated thread queues
+     * decoded chunks on the OpenAL sources, while a small pool of decoder threads decodes a few chunks ahead of playback
+     * for each stream, so a slow decode doesn't starve the other streams.
+     *
+     * Threads only communicate through lock-free single producer single consumer queues: commands from the main thread
+     * to the streaming thread, jobs from the streaming thread to each decoder and decoded chunks back. Mutexes are only
+     * used for sleeping threads to wait on.
+     */
+    class OAStreamingService
+    {
+    public:
+        /** Duration of the audio data decoded at once, in seconds. */
+        static constexpr float CHUNK_DURATION = 0.25f;
+
+        OAStreamingService(UINT32 numDecoders = DEFAULT_NUM_DECODERS);
+        ~OAStreamingService();
+
+        /** Returns the number of samples (including all channels) of a full chunk of audio data in format @p info. */
+        static UINT32 GetChunkNumSamples(const AudioDataInfo& info);
+
+        /**
+         * Starts streaming the current clip of @p source, from @p position (in samples, including all channels). The
+         * stream decodes up to @p lookAhead seconds ahead of the OpenAL buffers. Main thread only.
+         *
+         * @return	Identifier of the command, see WaitForCommand().
+         */
+        UINT64 StartStreaming(OAAudioSource* source, UINT32 generation, const SPtr<AudioClip>& clip, UINT32 position,
+            float lookAhead);
+
+        /**
+         * Stops streaming to @p source. The streaming thread might still be streaming to it until the command is
+         * processed. Main thread only.
+         *
+         * @return	Identifier of the command, see WaitForCommand().
+         */
+        UINT64 StopStreaming(OAAudioSource* source);
+
+        /** Blocks until the streaming thread has processed the command @p id. Main thread only. */
+        void WaitForCommand(UINT64 id);
+
+        /** Releases the clips of the streams that ended. Main thread only, called once per frame. */
+        void Update();
+
+    private:
+        /** Type of a command that can be queued for a streaming audio source. */
+        enum class CommandType
+        {
+            Start,
+            Stop
+        };
+
+        /** Command queued for a streaming audio source. */
+        struct Command
+        {
+            CommandType Type;
+            OAAudioSource* Source;
+            UINT32 Generation;
+            SPtr<AudioClip> Clip;
+            UINT32 Position;
+            float LookAhead;
+        };
+
+        /** Chunk to decode, sent to a decoder and back once decoded. */
+        struct DecodeJob
+        {
+            OAStream* Stream;
+            UINT32 Chunk;
+            UINT32 Position;
+            UINT32 NumSamples;
+        };
+
+        /** Decoder thread, with its own queues. */
+        struct Decoder
+        {
+            Thread WorkerThread;
+            SPSCQueue<DecodeJob, 64> Jobs;
+            SPSCQueue<DecodeJob, 64> Results;
+            Mutex WakeMutex;
+            Signal WakeSignal;
+        };
+
+        /** Loop of the streaming thread. */
+        void RunStreaming();
+
+        /** Loop of a decoder thread. */
+        void RunDecoder(Decoder& decoder);
+
+        /** Applies the commands sent by the main thread. */
+        void ProcessCommands();
+
+        /** Collects the chunks decoded since the last update. */
+        void ProcessResults();
+
+        /** Queues decoded chunks on the sources and sends the next chunks of each stream to the decoders. */
+        void UpdateStreams();
+
+        /** Sends the next chunk of @p stream to a decoder. Returns false if all decoders are busy. */
+        bool Decode(OAStream& stream);
+
+        /** Pushes a command for the streaming thread, waiting if the queue is full. */
+        UINT64 PushCommand(Command command);
+
+        /** Checks if the streaming thread has commands or decoded chunks to process. */
+        bool HasPendingWork() const;
+
+        /** Wakes up a thread sleeping on @p signal. */
+        static void Wake(Mutex& mutex, Signal& signal);
+
+    private:
+        static constexpr UINT32 DEFAULT_NUM_DECODERS = 2;
+        static constexpr UINT32 UPDATE_PERIOD_MS = 10; // Streaming thread also wakes up on commands and decoded chunks
+
+        std::atomic<bool> _running{ true };
+        Thread _streamingThread;
+        Mutex _wakeMutex;
+        Signal _wakeSignal;
+
+        Vector<Decoder*> _decoders;
+        UINT32 _nextDecoder = 0;
+
+        // Main thread to streaming thread
+        SPSCQueue<Command, 256> _commands;
+        UINT64 _numPushedCommands = 0;
+        std::atomic<UINT64> _numProcessedCommands{ 0 };
+
+        // Streaming thread to main thread
+        SPSCQueue<SPtr<AudioClip>, 256> _releasedClips;
+
+        // Streaming thread only
+        Vector<OAStream*> _streams;
+        Vector<OAStream*> _freeStreams;
+    };
+}
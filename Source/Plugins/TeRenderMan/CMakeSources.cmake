@@ -6,7 +6,13 @@ set (TE_RENDERMAN_INC_NOFILTER
     "TeRendererScene.h"
     "TeRendererView.h"
     "TeRendererRenderable.h"
+    "TeRendererObjectBuffer.h"
+    "TeRendererSubMeshBounds.h"
     "TeRendererLight.h"
+    "TeRendererLightGrid.h"
+    "TeRendererOcclusion.h"
+    "TeRendererShadowRendering.h"
+    "TeShadowDepthMat.h"
     "TeRenderCompositor.h"
     "TeRendererDecal.h"
 )
@@ -18,7 +24,13 @@ set (TE_RENDERERMAN_SRC_NOFILTER
     "TeRendererScene.cpp"
     "TeRendererView.cpp"
     "TeRendererRenderable.cpp"
+    "TeRendererObjectBuffer.cpp"
+    "TeRendererSubMeshBounds.cpp"
     "TeRendererLight.cpp"
+    "TeRendererLightGrid.cpp"
+    "TeRendererOcclusion.cpp"
+    "TeRendererShadowRendering.cpp"
+    "TeShadowDepthMat.cpp"
     "TeRenderCompositor.cpp"
     "TeRendererDecal.cpp"
 )
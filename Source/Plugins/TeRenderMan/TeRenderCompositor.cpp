@@ -31,6 +31,7 @@ namespace te
         UINT32 gpuParamsBindFlags = 0;
 
         static const Vector<String> PerLightBuffer = { "PerLightsBuffer" };
+        static const Vector<String> PerShadowBuffer = { "PerShadowsBuffer" };
         static const Vector<String> PerCameraBuffer = { "PerCameraBuffer" };
         static const Vector<String> PerFrameBuffer = { "PerFrameBuffer" };
 
@@ -39,6 +40,11 @@ namespace te
             if(entry.ApplyPass)
                 gRendererUtility().SetPass(entry.RenderElem->MaterialElem, entry.TechniqueIdx, entry.PassIdx);
 
+            // Light grid buffers are bound along with the other buffers of each element, so they are set on all of them
+            view.GetLightGrid().Bind(entry.RenderElem->GpuParamsElem[entry.PassIdx]);
+            view.GetShadows().Bind(entry.RenderElem->GpuParamsElem[entry.PassIdx]);
+            scene.ObjectData.Bind(entry.RenderElem->GpuParamsElem[entry.PassIdx]);
+
             // If Material is the same as the previous object, we only set constant buffer params
             // Instead, we set full gpu params
             // We also set camera buffer view here (because it will set PerCameraBuffer correctly for the current pass on this material only once)
@@ -51,8 +57,8 @@ namespace te
                 {
                     if (view.GetRenderSettings().EnableSkybox)
                     {
-                        Skybox* skybox = scene.SkyboxElem;
-                        SPtr<Texture> skyboxMap = skybox ? skybox->GetIrradiance() : nullptr;
+                        const RendererSkybox* skybox = scene.SkyboxElem;
+                        SPtr<Texture> skyboxMap = skybox ? skybox->Irradiance : nullptr;
                         entry.RenderElem->GpuParamsElem[entry.PassIdx]->SetTexture("IrradianceMap", skyboxMap);
                     } 
                 }
@@ -61,8 +67,8 @@ namespace te
                 {
                     if (view.GetRenderSettings().EnableSkybox)
                     {
-                        Skybox* skybox = scene.SkyboxElem;
-                        SPtr<Texture> skyboxMap = skybox ? skybox->GetTexture() : nullptr;
+                        const RendererSkybox* skybox = scene.SkyboxElem;
+                        SPtr<Texture> skyboxMap = skybox ? skybox->Radiance : nullptr;
                         entry.RenderElem->GpuParamsElem[entry.PassIdx]->SetTexture("EnvironmentMap", skyboxMap);
                     }
                 }
@@ -70,12 +76,12 @@ namespace te
                 gpuParamsBindFlags = GPU_BIND_ALL;
                 lastMaterial = entry.RenderElem->MaterialElem;
 
-                entry.RenderElem->GpuParamsElem[entry.PassIdx]
-                    ->SetParamBlockBuffer("PerLightsBuffer", gPerLightsParamBuffer);
-
                 rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
                     GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, PerLightBuffer);
 
+                rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
+                    GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, PerShadowBuffer);
+
                 entry.RenderElem->GpuParamsElem[entry.PassIdx]
                     ->SetParamBlockBuffer("PerCameraBuffer", view.GetPerViewBuffer());
                 
@@ -102,6 +108,80 @@ namespace te
         }
     }
 
+    SPtr<PooledRenderTexture> RenderCompositorNodeInputs::GetTexture(UINT32 handle) const
+    {
+        if (handle == RCResourceBuilder::INVALID_TEXTURE || TextureSlots == nullptr || SlotTextures == nullptr)
+            return nullptr;
+
+        const UINT32 slot = (*TextureSlots)[handle];
+        if (slot == static_cast<UINT32>(-1))
+            return nullptr;
+
+        return (*SlotTextures)[slot];
+    }
+
+    UINT32 RCResourceBuilder::Create(const String& name, const POOLED_RENDER_TEXTURE_DESC& desc)
+    {
+        UINT32 handle = Find(name);
+        if (handle != INVALID_TEXTURE)
+        {
+            TE_DEBUG("Render compositor texture \"{" + name + "}\" is created twice.");
+            return handle;
+        }
+
+        handle = (UINT32)_textures.size();
+
+        TextureInfo texture;
+        texture.Name = name;
+        texture.Desc = desc;
+        _textures.push_back(texture);
+
+        return handle;
+    }
+
+    UINT32 RCResourceBuilder::Read(const String& name)
+    {
+        const UINT32 handle = Find(name);
+        if (handle != INVALID_TEXTURE)
+            _nodes.back().Reads.push_back(handle);
+
+        return handle;
+    }
+
+    UINT32 RCResourceBuilder::Write(const String& name)
+    {
+        const UINT32 handle = Find(name);
+        if (handle != INVALID_TEXTURE)
+        {
+            _nodes.back().Writes.push_back(handle);
+            _textures[handle].NumWriters++;
+        }
+
+        return handle;
+    }
+
+    UINT32 RCResourceBuilder::GetNumWriters(const String& name) const
+    {
+        const UINT32 handle = Find(name);
+        return handle != INVALID_TEXTURE ? _textures[handle].NumWriters : 0;
+    }
+
+    void RCResourceBuilder::SetSideEffects()
+    {
+        _nodes.back().SideEffects = true;
+    }
+
+    UINT32 RCResourceBuilder::Find(const String& name) const
+    {
+        for (UINT32 i = 0; i < (UINT32)_textures.size(); i++)
+        {
+            if (_textures[i].Name == name)
+                return i;
+        }
+
+        return INVALID_TEXTURE;
+    }
+
     RenderCompositor::~RenderCompositor()
     {
         _nodeBackup.clear();
@@ -218,6 +298,125 @@ namespace te
 
         if (!_isValid)
             Clear();
+        else
+            Compile(view);
+    }
+
+    void RenderCompositor::Compile(const RendererView& view)
+    {
+        const UINT32 numNodes = (UINT32)_nodeInfos.size();
+
+        RCResourceBuilder builder;
+        for (auto& entry : _nodeInfos)
+        {
+            builder._nodes.push_back(RCResourceBuilder::NodeAccesses());
+            entry.Node->DeclareResources(view, builder);
+        }
+
+        const UINT32 numTextures = (UINT32)builder._textures.size();
+
+        // Walking backwards from the nodes with side effects, a node is kept if it writes a texture accessed by a node
+        // kept after it
+        Vector<bool> needed(numTextures, false);
+        for (UINT32 i = numNodes; i-- > 0;)
+        {
+            const RCResourceBuilder::NodeAccesses& accesses = builder._nodes[i];
+
+            bool active = accesses.SideEffects;
+            for (auto handle : accesses.Writes)
+                active |= needed[handle];
+
+            _nodeInfos[i].Active = active;
+            _nodeInfos[i].AcquiredSlots.clear();
+            _nodeInfos[i].ReleasedSlots.clear();
+
+            if (!active)
+                continue;
+
+            for (auto handle : accesses.Reads)
+                needed[handle] = true;
+
+            for (auto handle : accesses.Writes)
+                needed[handle] = true;
+        }
+
+        // Textures live from their first write to their last access by an active node. Textures never written aren't
+        // allocated at all.
+        Vector<UINT32> firstUse(numTextures, static_cast<UINT32>(-1));
+        Vector<UINT32> lastUse(numTextures, 0);
+        for (UINT32 i = 0; i < numNodes; i++)
+        {
+            if (!_nodeInfos[i].Active)
+                continue;
+
+            const RCResourceBuilder::NodeAccesses& accesses = builder._nodes[i];
+            for (auto handle : accesses.Writes)
+                firstUse[handle] = std::min(firstUse[handle], i);
+        }
+
+        for (UINT32 i = 0; i < numNodes; i++)
+        {
+            if (!_nodeInfos[i].Active)
+                continue;
+
+            const RCResourceBuilder::NodeAccesses& accesses = builder._nodes[i];
+            for (auto handle : accesses.Reads)
+                lastUse[handle] = std::max(lastUse[handle], i);
+
+            for (auto handle : accesses.Writes)
+                lastUse[handle] = std::max(lastUse[handle], i);
+        }
+
+        // Textures are assigned in the order they start living, to the first slot with the same description that is
+        // free by then
+        Vector<UINT32> order;
+        for (UINT32 i = 0; i < numTextures; i++)
+        {
+            if (firstUse[i] != static_cast<UINT32>(-1))
+                order.push_back(i);
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&firstUse](UINT32 a, UINT32 b) { return firstUse[a] < firstUse[b]; });
+
+        _textureSlots.assign(numTextures, static_cast<UINT32>(-1));
+        _slotDescs.clear();
+
+        Vector<UINT32> slotFirstUse;
+        Vector<UINT32> slotLastUse;
+        for (auto handle : order)
+        {
+            const POOLED_RENDER_TEXTURE_DESC& desc = builder._textures[handle].Desc;
+
+            UINT32 slot = static_cast<UINT32>(-1);
+            for (UINT32 i = 0; i < (UINT32)_slotDescs.size(); i++)
+            {
+                if (slotLastUse[i] < firstUse[handle] && _slotDescs[i] == desc)
+                {
+                    slot = i;
+                    break;
+                }
+            }
+
+            if (slot == static_cast<UINT32>(-1))
+            {
+                slot = (UINT32)_slotDescs.size();
+                _slotDescs.push_back(desc);
+                slotFirstUse.push_back(firstUse[handle]);
+                slotLastUse.push_back(lastUse[handle]);
+            }
+            else
+                slotLastUse[slot] = lastUse[handle];
+
+            _textureSlots[handle] = slot;
+        }
+
+        // Slots are taken from the pool before their first texture is written, and given back after their last texture
+        // is accessed
+        for (UINT32 i = 0; i < (UINT32)_slotDescs.size(); i++)
+        {
+            _nodeInfos[slotFirstUse[i]].AcquiredSlots.push_back(i);
+            _nodeInfos[slotLastUse[i]].ReleasedSlots.push_back(i);
+        }
     }
 
     void RenderCompositor::Execute(RenderCompositorNodeInputs& inputs) const
@@ -225,6 +424,12 @@ namespace te
         if (!_isValid)
             return;
 
+        GpuResourcePool& resPool = gGpuResourcePool();
+        Vector<SPtr<PooledRenderTexture>> slotTextures(_slotDescs.size());
+
+        inputs.TextureSlots = &_textureSlots;
+        inputs.SlotTextures = &slotTextures;
+
         te_frame_mark();
         {
             FrameVector<const NodeInfo*> activeNodes;
@@ -232,8 +437,18 @@ namespace te
             UINT32 idx = 0;
             for (auto& entry : _nodeInfos)
             {
-                inputs.InputNodes = entry.Inputs;
-                entry.Node->Render(inputs);
+                // Culled nodes are still cleared like the others, they just don't render anything
+                if (entry.Active)
+                {
+                    for (auto slot : entry.AcquiredSlots)
+                        slotTextures[slot] = resPool.Get(_slotDescs[slot]);
+
+                    inputs.InputNodes = entry.Inputs;
+                    entry.Node->Render(inputs);
+
+                    for (auto slot : entry.ReleasedSlots)
+                        slotTextures[slot] = nullptr;
+                }
 
                 activeNodes.push_back(&entry);
 
@@ -256,43 +471,66 @@ namespace te
 
         if (!_nodeInfos.empty())
             _nodeInfos.back().Node->Clear();
+
+        inputs.TextureSlots = nullptr;
+        inputs.SlotTextures = nullptr;
     }
 
     void RenderCompositor::Clear()
     {
         _nodeInfos.clear();
         _isValid = false;
+
+        _textureSlots.clear();
+        _slotDescs.clear();
     }
 
     // ############# GPU INITIALIZATION
 
-    void RCNodeGpuInitializationPass::Render(const RenderCompositorNodeInputs& inputs)
+    void RCNodeGpuInitializationPass::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
     {
-        // Allocate necessary textures & targets
-        GpuResourcePool& resPool = gGpuResourcePool();
-        const RendererViewProperties& viewProps = inputs.View.GetProperties();
+        const RendererViewProperties& viewProps = view.GetProperties();
 
         const UINT32 width = viewProps.Target.ViewRect.width;
         const UINT32 height = viewProps.Target.ViewRect.height;
         const UINT32 numSamples = viewProps.Target.NumSamples;
 
-        bool needsVelocity = inputs.View.RequiresVelocityWrites();
-
         // Note: Consider customizable formats. e.g. for testing if quality can be improved with higher precision normals.
-        SceneTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET,
-            numSamples, true));
-        NormalTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height, TU_RENDERTARGET,
-            numSamples, true));
-        EmissiveTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height, TU_RENDERTARGET,
-            numSamples, true));
-        if (needsVelocity)
+        _sceneTexHandle = builder.Create("SceneColor", POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height,
+            TU_RENDERTARGET, numSamples, true));
+        _normalTexHandle = builder.Create("SceneNormal", POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height,
+            TU_RENDERTARGET, numSamples, true));
+        _emissiveTexHandle = builder.Create("SceneEmissive", POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height,
+            TU_RENDERTARGET, numSamples, true));
+        _depthTexHandle = builder.Create("SceneDepth", POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32_S8X24, width, height,
+            TU_DEPTHSTENCIL, numSamples, false));
+
+        builder.Write("SceneColor");
+        builder.Write("SceneNormal");
+        builder.Write("SceneEmissive");
+        builder.Write("SceneDepth");
+
+        _velocityTexHandle = RCResourceBuilder::INVALID_TEXTURE;
+        if (view.RequiresVelocityWrites())
         {
-            VelocityTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height, TU_RENDERTARGET,
-                numSamples, false));
+            _velocityTexHandle = builder.Create("SceneVelocity", POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width,
+                height, TU_RENDERTARGET, numSamples, false));
+            builder.Write("SceneVelocity");
         }
+    }
 
-        DepthTex = gGpuResourcePool().Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL,
-            numSamples, false));
+    void RCNodeGpuInitializationPass::Render(const RenderCompositorNodeInputs& inputs)
+    {
+        // Textures are allocated by the compositor
+        bool needsVelocity = inputs.View.RequiresVelocityWrites();
+
+        SceneTex = inputs.GetTexture(_sceneTexHandle);
+        NormalTex = inputs.GetTexture(_normalTexHandle);
+        EmissiveTex = inputs.GetTexture(_emissiveTexHandle);
+        if (needsVelocity)
+            VelocityTex = inputs.GetTexture(_velocityTexHandle);
+
+        DepthTex = inputs.GetTexture(_depthTexHandle);
 
         bool rebuildRT = false;
         if (RenderTargetTex != nullptr)
@@ -346,21 +584,6 @@ namespace te
 
             RenderTargetTex = RenderTexture::Create(gbufferDesc);
         }
-
-        Vector3I lightCounts;
-        const LightData* lights[STANDARD_FORWARD_MAX_NUM_LIGHTS];
-        const auto numRenderables = (UINT32)inputs.Scene.Renderables.size();
-        for (UINT32 i = 0; i < numRenderables; i++)
-        {
-            if (!inputs.Scene.Renderables[i]->RenderablePtr->GetCastLights())
-                continue;
-
-            // Compute list of lights that influence renderables
-            const Bounds& bounds = inputs.Scene.RenderableCullInfos[i].Boundaries;
-            inputs.ViewGroup.GetVisibleLightData().GatherInfluencingLights(bounds, lights, lightCounts);
-        }
-
-        PerLightsBuffer::UpdatePerLights(lights, lightCounts.x + lightCounts.y + lightCounts.z);
     }
 
     void RCNodeGpuInitializationPass::Clear()
@@ -379,6 +602,15 @@ namespace te
 
     // ############# FORWARD PASS
 
+    void RCNodeForwardPass::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        builder.Write("SceneColor");
+        builder.Write("SceneNormal");
+        builder.Write("SceneEmissive");
+        builder.Write("SceneVelocity");
+        builder.Write("SceneDepth");
+    }
+
     void RCNodeForwardPass::Render(const RenderCompositorNodeInputs& inputs)
     { 
         RCNodeGpuInitializationPass* gpuInitializationPassNode = static_cast<RCNodeGpuInitializationPass*>(inputs.InputNodes[0]);
@@ -411,16 +643,25 @@ namespace te
 
     // ############# SKYBOX
 
+    void RCNodeSkybox::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        if (!view.GetRenderSettings().EnableSkybox)
+            return;
+
+        builder.Read("SceneDepth");
+        builder.Write("SceneColor");
+    }
+
     void RCNodeSkybox::Render(const RenderCompositorNodeInputs& inputs)
     { 
-        Skybox* skybox = nullptr;
+        const RendererSkybox* skybox = nullptr;
         if (inputs.View.GetRenderSettings().EnableSkybox)
             skybox = inputs.Scene.SkyboxElem;
         else
             return;
 
-        SPtr<Texture> radiance = skybox ? skybox->GetTexture() : nullptr;
-        float brightness = skybox ? skybox->GetBrightness() : 0.0f;
+        SPtr<Texture> radiance = skybox ? skybox->Radiance : nullptr;
+        float brightness = skybox ? skybox->Brightness : 0.0f;
 
         if (radiance != nullptr)
         {
@@ -467,6 +708,15 @@ namespace te
 
     // ############# FORWARD TRANSPARENT PASS
 
+    void RCNodeForwardTransparentPass::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        builder.Read("SceneDepth");
+        builder.Write("SceneColor");
+        builder.Write("SceneNormal");
+        builder.Write("SceneEmissive");
+        builder.Write("SceneVelocity");
+    }
+
     void RCNodeForwardTransparentPass::Render(const RenderCompositorNodeInputs& inputs)
     {
         RCNodeGpuInitializationPass* gpuInitializationPassNode = static_cast<RCNodeGpuInitializationPass*>(inputs.InputNodes[0]);
@@ -503,18 +753,33 @@ namespace te
 
     // ############# SCREEN SPACE
 
-    void RCNodeResolvedSceneDepth::Render(const RenderCompositorNodeInputs& inputs)
+    void RCNodeResolvedSceneDepth::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
     {
-        const RendererViewProperties& viewProps = inputs.View.GetProperties();
-        RCNodeGpuInitializationPass* gpuInitializationPassNode = static_cast<RCNodeGpuInitializationPass*>(inputs.InputNodes[0]);
+        const RendererViewProperties& viewProps = view.GetProperties();
 
+        // Without multi-sampling, the scene depth is used as is
+        _outputHandle = RCResourceBuilder::INVALID_TEXTURE;
         if (viewProps.Target.NumSamples > 1)
         {
             UINT32 width = viewProps.Target.ViewRect.width;
             UINT32 height = viewProps.Target.ViewRect.height;
 
-            Output = gGpuResourcePool().Get(
+            _outputHandle = builder.Create("ResolvedSceneDepth",
                 POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL, 1, false));
+            builder.Write("ResolvedSceneDepth");
+        }
+
+        builder.Read("SceneDepth");
+    }
+
+    void RCNodeResolvedSceneDepth::Render(const RenderCompositorNodeInputs& inputs)
+    {
+        const RendererViewProperties& viewProps = inputs.View.GetProperties();
+        RCNodeGpuInitializationPass* gpuInitializationPassNode = static_cast<RCNodeGpuInitializationPass*>(inputs.InputNodes[0]);
+
+        if (viewProps.Target.NumSamples > 1)
+        {
+            Output = inputs.GetTexture(_outputHandle);
 
             RenderAPI& rapi = RenderAPI::Instance();
             rapi.SetRenderTarget(Output->RenderTex);
@@ -544,18 +809,11 @@ namespace te
 
     // ############# POST PROCESS
 
-    void RCNodePostProcess::GetAndSwitch(const RendererView& view, SPtr<RenderTexture>& output, SPtr<Texture>& lastFrame) const
+    void RCNodePostProcess::GetAndSwitch(const RenderCompositorNodeInputs& inputs, SPtr<RenderTexture>& output,
+        SPtr<Texture>& lastFrame) const
     {
-        const RendererViewProperties& viewProps = view.GetProperties();
-        UINT32 width = viewProps.Target.ViewRect.width;
-        UINT32 height = viewProps.Target.ViewRect.height;
-        UINT32 samples = viewProps.Target.NumSamples;
-
         if (!_output[_currentIdx])
-        {
-            _output[_currentIdx] = gGpuResourcePool().Get(
-                POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET, samples, false));
-        }
+            _output[_currentIdx] = inputs.GetTexture(_outputHandles[_currentIdx]);
 
         output = _output[_currentIdx]->RenderTex;
 
@@ -575,6 +833,34 @@ namespace te
         return nullptr;
     }
 
+    void RCNodePostProcess::DeclareEffect(RCResourceBuilder& builder)
+    {
+        // Effects write both textures in turn, the first one reads the scene color instead
+        const UINT32 numEffects = builder.GetNumWriters("PostProcess0") + builder.GetNumWriters("PostProcess1");
+
+        if (numEffects == 0)
+            builder.Read("SceneColor");
+        else
+            builder.Read((numEffects % 2) == 1 ? "PostProcess0" : "PostProcess1");
+
+        builder.Write((numEffects % 2) == 0 ? "PostProcess0" : "PostProcess1");
+    }
+
+    void RCNodePostProcess::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        const RendererViewProperties& viewProps = view.GetProperties();
+        UINT32 width = viewProps.Target.ViewRect.width;
+        UINT32 height = viewProps.Target.ViewRect.height;
+        UINT32 samples = viewProps.Target.NumSamples;
+
+        // Only allocated if an effect writes them
+        const POOLED_RENDER_TEXTURE_DESC desc =
+            POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET, samples, false);
+
+        _outputHandles[0] = builder.Create("PostProcess0", desc);
+        _outputHandles[1] = builder.Create("PostProcess1", desc);
+    }
+
     void RCNodePostProcess::Render(const RenderCompositorNodeInputs& inputs)
     { }
 
@@ -596,6 +882,15 @@ namespace te
 
     // ############# TONE MAPPING
 
+    void RCNodeTonemapping::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        const RenderSettings& settings = view.GetRenderSettings();
+        if (!settings.Tonemapping.Enabled || !settings.EnableHDR)
+            return;
+
+        RCNodePostProcess::DeclareEffect(builder);
+    }
+
     void RCNodeTonemapping::Render(const RenderCompositorNodeInputs& inputs)
     {
         const RenderSettings& settings = inputs.View.GetRenderSettings();
@@ -607,7 +902,7 @@ namespace te
 
         SPtr<RenderTexture> ppOutput;
         SPtr<Texture> ppLastFrame;
-        postProcessNode->GetAndSwitch(inputs.View, ppOutput, ppLastFrame);
+        postProcessNode->GetAndSwitch(inputs, ppOutput, ppLastFrame);
 
         ToneMappingMat* toneMapping = ToneMappingMat::Get();
 
@@ -644,6 +939,16 @@ namespace te
 
     // ############# MOTION BLUR
 
+    void RCNodeMotionBlur::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        if (!view.GetRenderSettings().MotionBlur.Enabled)
+            return;
+
+        builder.Read("SceneDepth");
+        builder.Read("SceneVelocity");
+        RCNodePostProcess::DeclareEffect(builder);
+    }
+
     void RCNodeMotionBlur::Render(const RenderCompositorNodeInputs& inputs)
     {
         const MotionBlurSettings& settings = inputs.View.GetRenderSettings().MotionBlur;
@@ -657,7 +962,7 @@ namespace te
         SPtr<Texture> ppLastFrame;
         SPtr<Texture> depth = gpuInitializationPassNode->DepthTex->Tex;
         SPtr<Texture> velocity = gpuInitializationPassNode->VelocityTex->Tex;
-        postProcessNode->GetAndSwitch(inputs.View, ppOutput, ppLastFrame);
+        postProcessNode->GetAndSwitch(inputs, ppOutput, ppLastFrame);
 
         MotionBlurMat* motionBlur = MotionBlurMat::Get();
 
@@ -688,6 +993,9 @@ namespace te
 
     // ############# GAUSSIAN DOF
 
+    void RCNodeGaussianDOF::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    { }
+
     void RCNodeGaussianDOF::Render(const RenderCompositorNodeInputs& inputs)
     { }
 
@@ -706,6 +1014,14 @@ namespace te
 
     // ############# FXAA
 
+    void RCNodeFXAA::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        if (view.GetRenderSettings().AntialiasingAglorithm != AntiAliasingAlgorithm::FXAA)
+            return;
+
+        RCNodePostProcess::DeclareEffect(builder);
+    }
+
     void RCNodeFXAA::Render(const RenderCompositorNodeInputs& inputs)
     {
         const RenderSettings& settings = inputs.View.GetRenderSettings();
@@ -717,7 +1033,7 @@ namespace te
 
         SPtr<RenderTexture> ppOutput;
         SPtr<Texture> ppLastFrame;
-        postProcessNode->GetAndSwitch(inputs.View, ppOutput, ppLastFrame);
+        postProcessNode->GetAndSwitch(inputs, ppOutput, ppLastFrame);
 
         FXAAMat* fxaa = FXAAMat::Get();
 
@@ -743,6 +1059,9 @@ namespace te
 
     // ############# TAA
 
+    void RCNodeTemporalAA::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    { }
+
     void RCNodeTemporalAA::Render(const RenderCompositorNodeInputs& inputs)
     {
         const RenderSettings& settings = inputs.View.GetRenderSettings();
@@ -753,7 +1072,7 @@ namespace te
 
         SPtr<RenderTexture> ppOutput;
         SPtr<Texture> ppLastFrame;
-        postProcessNode->GetAndSwitch(inputs.View, ppOutput, ppLastFrame);*/
+        postProcessNode->GetAndSwitch(inputs, ppOutput, ppLastFrame);*/
 
         // TODO temporal AA
     }
@@ -774,6 +1093,15 @@ namespace te
 
     // ############# SSAO
 
+    void RCNodeSSAO::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        // Output isn't a transient texture, it is handed to the final resolve and the renderer directly
+        builder.SetSideEffects();
+
+        if (view.GetRenderSettings().AmbientOcclusion.Enabled)
+            builder.Read("ResolvedSceneDepth");
+    }
+
     void RCNodeSSAO::Render(const RenderCompositorNodeInputs& inputs)
     { 
         /** Maximum valid depth range within samples in a sample set. In meters. */
@@ -809,6 +1137,52 @@ namespace te
 
     // ############# BLOOM
 
+    /** Returns the size reduction of the blurred emissive texture, and the number of blur samples, for a bloom quality. */
+    static void GetBloomBlurSettings(const BloomSettings& settings, UINT32& blurTextureFactor, UINT32& blurNumSamples)
+    {
+        blurTextureFactor = 1;
+        blurNumSamples = 7;
+
+        // We can reduce blur texture size according to bloom quality
+        if (settings.Quality == BloomQuality::Medium)
+        {
+            blurTextureFactor = 2;
+            blurNumSamples = 7;
+        }
+        else if (settings.Quality == BloomQuality::Low)
+        {
+            blurTextureFactor = 4;
+            blurNumSamples = 5;
+        }
+    }
+
+    void RCNodeBloom::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        const RendererViewProperties& viewProps = view.GetProperties();
+        const RenderSettings& settings = view.GetRenderSettings();
+        if (!settings.Bloom.Enabled)
+            return;
+
+        UINT32 blurTextureFactor;
+        UINT32 blurNumSamples;
+        GetBloomBlurSettings(settings.Bloom, blurTextureFactor, blurNumSamples);
+
+        // Same format as the emissive texture it blurs. Only lives during this node, so its memory is reused by the next
+        // textures of the same kind.
+        _blurTexHandle = builder.Create("BloomBlur", POOLED_RENDER_TEXTURE_DESC::Create2D(
+            PF_RGBA8,
+            viewProps.Target.ViewRect.width / blurTextureFactor,
+            viewProps.Target.ViewRect.height / blurTextureFactor,
+            TU_RENDERTARGET,
+            viewProps.Target.NumSamples
+        ));
+
+        builder.Read("SceneEmissive");
+        builder.Write("BloomBlur");
+        builder.Read("BloomBlur");
+        RCNodePostProcess::DeclareEffect(builder);
+    }
+
     void RCNodeBloom::Render(const RenderCompositorNodeInputs& inputs)
     {
         UINT32 blurTextureFactor = 1;
@@ -826,33 +1200,8 @@ namespace te
         GaussianBlurMat* gaussianBlur = GaussianBlurMat::Get();
         SPtr<PooledRenderTexture> emissiveTex = gpuInitializationPassNode->EmissiveTex;
 
-        // We can reduce blur texture size according to bloom quality
-        if (settings.Bloom.Quality == BloomQuality::Medium)
-        {
-            blurTextureFactor = 2;
-            blurNumSamples = 7;
-        }
-        else if (settings.Bloom.Quality == BloomQuality::Medium)
-        {
-            blurTextureFactor = 3;
-            blurNumSamples = 5;
-        }
-        else if (settings.Bloom.Quality == BloomQuality::Low)
-        {
-            blurTextureFactor = 4;
-            blurNumSamples = 5;
-        }
-
-        const TextureProperties& inputProps = emissiveTex->Tex->GetProperties();
-        SPtr<PooledRenderTexture> blurOutput = gGpuResourcePool().Get(
-            POOLED_RENDER_TEXTURE_DESC::Create2D(
-                inputProps.GetFormat(),
-                inputProps.GetWidth() / blurTextureFactor,
-                inputProps.GetHeight() / blurTextureFactor,
-                TU_RENDERTARGET,
-                viewProps.Target.NumSamples
-            )
-        );
+        GetBloomBlurSettings(settings.Bloom, blurTextureFactor, blurNumSamples);
+        SPtr<PooledRenderTexture> blurOutput = inputs.GetTexture(_blurTexHandle);
 
         gaussianBlur->Execute(emissiveTex->Tex, blurOutput->RenderTex, blurNumSamples, viewProps.Target.NumSamples);
 
@@ -861,7 +1210,7 @@ namespace te
         BloomMat* bloom = BloomMat::Get();
         SPtr<RenderTexture> ppOutput;
         SPtr<Texture> ppLastFrame;
-        postProcessNode->GetAndSwitch(inputs.View, ppOutput, ppLastFrame);
+        postProcessNode->GetAndSwitch(inputs, ppOutput, ppLastFrame);
 
         if (ppLastFrame)
         {
@@ -891,6 +1240,20 @@ namespace te
 
     // ############# FINAL RENDER
 
+    void RCNodeFinalResolve::DeclareResources(const RendererView& view, RCResourceBuilder& builder)
+    {
+        // Writes the view target, and hands every output to the renderer
+        builder.SetSideEffects();
+
+        builder.Read("SceneColor");
+        builder.Read("SceneNormal");
+        builder.Read("SceneEmissive");
+        builder.Read("SceneVelocity");
+        builder.Read("SceneDepth");
+        builder.Read("PostProcess0");
+        builder.Read("PostProcess1");
+    }
+
     void RCNodeFinalResolve::Render(const RenderCompositorNodeInputs& inputs)
     {
         const RendererViewProperties& viewProps = inputs.View.GetProperties();
@@ -904,7 +1267,7 @@ namespace te
         {
             SSAONode = static_cast<RCNodeSSAO*>(inputs.InputNodes[7]);
 
-            switch (inputs.View.GetSceneCamera()->GetRenderSettings()->OutputType)
+            switch (inputs.View.GetRenderSettings().OutputType)
             {
             case RenderOutputType::Final:
                 input = postProcessNode->GetLastOutput();
@@ -959,7 +1322,7 @@ namespace te
         if (sceneCamera != nullptr)
             inputs.View.NotifyCompositorTargetChanged(target);
 
-        if (inputs.View.GetSceneCamera()->IsMain() && GuiAPI::Instance().IsGuiInitialized())
+        if (viewProps.MainView && GuiAPI::Instance().IsGuiInitialized())
             GuiAPI::Instance().EndFrame();
 
         inputs.CurrRenderer.SetLastRenderTexture(RenderOutputType::Final, postProcessNode->GetLastOutput());
@@ -31,8 +31,73 @@ namespace te
         const FrameInfo& FrameInfos;
         const Renderer& CurrRenderer;
 
+        /**
+         * Returns a transient texture declared through RCResourceBuilder, or null if it isn't allocated at this point of
+         * the frame (e.g. no active node writes it).
+         */
+        SPtr<PooledRenderTexture> GetTexture(UINT32 handle) const;
+
         // Callbacks to external systems can hook into the compositor
         Vector<RenderCompositorNode*> InputNodes;
+
+        // Transient textures, set by the compositor while it executes
+        const Vector<UINT32>* TextureSlots = nullptr;
+        const Vector<SPtr<PooledRenderTexture>>* SlotTextures = nullptr;
+    };
+
+    /**
+     * Collects the transient textures created, read and written by the nodes of a render compositor, so the compositor
+     * can cull nodes whose output isn't used, and find how long each texture lives. Nodes are declared in execution
+     * order, so a node can only access textures created by itself or by a node it depends on.
+     */
+    class RCResourceBuilder
+    {
+    public:
+        /**
+         * Declares a texture. It is allocated right before the first active node writing it, and released right after
+         * the last active node accessing it. Returns its handle.
+         */
+        UINT32 Create(const String& name, const POOLED_RENDER_TEXTURE_DESC& desc);
+
+        /** Declares that the current node reads a texture. Returns its handle, or INVALID_TEXTURE if it wasn't created. */
+        UINT32 Read(const String& name);
+
+        /** Declares that the current node writes a texture. Returns its handle, or INVALID_TEXTURE if it wasn't created. */
+        UINT32 Write(const String& name);
+
+        /** Returns the number of nodes declared so far writing a texture. */
+        UINT32 GetNumWriters(const String& name) const;
+
+        /**
+         * Declares that the current node has effects outside of the compositor (e.g. it writes the view target), so it is
+         * never culled.
+         */
+        void SetSideEffects();
+
+        static constexpr UINT32 INVALID_TEXTURE = static_cast<UINT32>(-1);
+
+    private:
+        friend class RenderCompositor;
+
+        /** Returns the handle of a texture, or INVALID_TEXTURE. */
+        UINT32 Find(const String& name) const;
+
+        struct TextureInfo
+        {
+            String Name;
+            POOLED_RENDER_TEXTURE_DESC Desc;
+            UINT32 NumWriters = 0;
+        };
+
+        struct NodeAccesses
+        {
+            Vector<UINT32> Reads;
+            Vector<UINT32> Writes;
+            bool SideEffects = false;
+        };
+
+        Vector<TextureInfo> _textures;
+        Vector<NodeAccesses> _nodes;
     };
 
     /**
@@ -50,6 +115,12 @@ namespace te
     protected:
         friend class RenderCompositor;
 
+        /**
+         * Declares the transient textures the node creates, reads and writes for the provided view. A node writing
+         * nothing used by another node, and without side effects, isn't executed.
+         */
+        virtual void DeclareResources(const RendererView& view, RCResourceBuilder& builder) = 0;
+
         /** Executes the task implemented in the node. */
         virtual void Render(const RenderCompositorNodeInputs& inputs) = 0;
 
@@ -64,6 +135,11 @@ namespace te
      * Performs rendering by iterating over a hierarchy of render nodes. Each node in the hierarchy performs a specific
      * rendering tasks and passes its output to the dependant node. The system takes care of initializing, rendering and
      * cleaning up nodes automatically depending on their dependencies.
+     *
+     * Transient textures are declared by the nodes when the hierarchy is built. Nodes whose output isn't used are culled,
+     * and each texture only lives from its first write to its last access. Textures with the same description whose
+     * lifetimes don't overlap share the same pooled texture, and textures go back to the GPU resource pool as soon as
+     * they aren't needed anymore, so the next views can reuse them.
      */
     class RenderCompositor
     {
@@ -78,6 +154,10 @@ namespace te
             NodeType* Type = nullptr;
             UINT32 LastUseIdx = 0;
             Vector<RenderCompositorNode*> Inputs;
+
+            bool Active = true; // False if culled
+            Vector<UINT32> AcquiredSlots; // Texture slots allocated before the node renders
+            Vector<UINT32> ReleasedSlots; // Texture slots released after the node renders
         };
 
     public:
@@ -97,13 +177,28 @@ namespace te
         /** Performs rendering using the current render node hierarchy. This is expected to be called once per frame. */
         void Execute(RenderCompositorNodeInputs& inputs) const;
 
+        /** Returns the number of transient textures declared by the active nodes. */
+        UINT32 GetNumTextures() const { return (UINT32)_textureSlots.size(); }
+
+        /** Returns the number of pooled textures needed for all transient textures, once aliased. */
+        UINT32 GetNumTextureSlots() const { return (UINT32)_slotDescs.size(); }
+
     private:
         /** Clears the render node hierarchy. */
         void Clear();
 
+        /**
+         * Collects the textures declared by the nodes, culls the nodes whose output isn't used, and assigns textures to
+         * slots according to their lifetime.
+         */
+        void Compile(const RendererView& view);
+
         Vector<NodeInfo> _nodeInfos;
         bool _isValid = false;
 
+        Vector<UINT32> _textureSlots; // Slot of each transient texture, -1 if never allocated
+        Vector<POOLED_RENDER_TEXTURE_DESC> _slotDescs;
+
         // We don't want to always create new node (as they don't change), 
         // so we keep a list of each type of node already created
         UnorderedMap<NodeType*, RenderCompositorNode*> _nodeBackup;
@@ -194,11 +289,21 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
         /** @copydoc RenderCompositorNode::clear */
         void Clear() override;
+
+    private:
+        UINT32 _sceneTexHandle = RCResourceBuilder::INVALID_TEXTURE;
+        UINT32 _normalTexHandle = RCResourceBuilder::INVALID_TEXTURE;
+        UINT32 _emissiveTexHandle = RCResourceBuilder::INVALID_TEXTURE;
+        UINT32 _velocityTexHandle = RCResourceBuilder::INVALID_TEXTURE;
+        UINT32 _depthTexHandle = RCResourceBuilder::INVALID_TEXTURE;
     };
 
     /**
@@ -211,6 +316,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -229,6 +337,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -246,6 +357,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -266,11 +380,17 @@ namespace te
         static String GetNodeId() { return "ResolvedSceneDepth"; }
         static Vector<String> GetDependencies(const RendererView& view);
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
         /** @copydoc RenderCompositorNode::Clear */
         void Clear() override;
+
+    private:
+        UINT32 _outputHandle = RCResourceBuilder::INVALID_TEXTURE;
     };
 
     /************************************************************************/
@@ -288,7 +408,14 @@ namespace te
          * Returns a texture that can be used for rendering a post-process effect, and the result of the previous
          * output. Switches these textures so the next call they are returned in the opposite parameters.
          */
-        void GetAndSwitch(const RendererView& view, SPtr<RenderTexture>& output, SPtr<Texture>& lastFrame) const;
+        void GetAndSwitch(const RenderCompositorNodeInputs& inputs, SPtr<RenderTexture>& output,
+            SPtr<Texture>& lastFrame) const;
+
+        /**
+         * Declares the textures accessed by an effect calling GetAndSwitch() once. Must be called by effects from their
+         * DeclareResources(), in the same conditions they call GetAndSwitch() in.
+         */
+        static void DeclareEffect(RCResourceBuilder& builder);
 
         /** Returns a texture that contains the last rendererd post process output. */
         SPtr<Texture> GetLastOutput() const;
@@ -297,6 +424,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -306,6 +436,7 @@ namespace te
     protected:
         mutable SPtr<PooledRenderTexture> _output[2];
         mutable UINT32 _currentIdx = 0;
+        UINT32 _outputHandles[2] = { RCResourceBuilder::INVALID_TEXTURE, RCResourceBuilder::INVALID_TEXTURE };
     };
 
     /**
@@ -319,6 +450,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -338,6 +472,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -353,6 +490,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -368,6 +508,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -383,6 +526,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -400,6 +546,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -415,11 +564,17 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
         /** @copydoc RenderCompositorNode::Clear */
         void Clear() override;
+
+    private:
+        UINT32 _blurTexHandle = RCResourceBuilder::INVALID_TEXTURE;
     };
 
     /** Moves the contents of the scene color texture into the view's output target. */
@@ -430,6 +585,9 @@ namespace te
         static Vector<String> GetDependencies(const RendererView& view);
 
     protected:
+        /** @copydoc RenderCompositorNode::DeclareResources */
+        void DeclareResources(const RendererView& view, RCResourceBuilder& builder) override;
+
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -3,14 +3,13 @@
 #include "TeRendererScene.h"
 #include "TeRenderManOptions.h"
 #include "TeRenderCompositor.h"
+#include "TeRendererShadowRendering.h"
 #include "Renderer/TeCamera.h"
 #include "Renderer/TeRendererUtility.h"
 #include "Renderer/TeGpuResourcePool.h"
 #include "RenderAPI/TeRenderAPI.h"
 #include "Manager/TeRendererManager.h"
-#include "CoreUtility/TeCoreObjectManager.h"
 #include "Profiling/TeProfilerGPU.h"
-#include "Utility/TeTime.h"
 #include "Gui/TeGuiAPI.h"
 
 namespace te
@@ -44,6 +43,7 @@ namespace te
         _scene = te_shared_ptr_new<RendererScene>(_options);
 
         _mainViewGroup = te_new<RendererViewGroup>(nullptr, 0, _options);
+        _shadowRendering = te_new<ShadowRendering>(_options);
 
         RenderCompositor::RegisterNodeType<RCNodeGpuInitializationPass>();
         RenderCompositor::RegisterNodeType<RCNodeForwardPass>();
@@ -72,17 +72,12 @@ namespace te
             }
         }
 
-        if (gPerLightsParamBuffer)
-        {
-            gPerLightsParamBuffer->Destroy();
-            gPerLightsParamBuffer = nullptr;
-        }
-
         _scene = nullptr;
 
         RenderCompositor::CleanUp();
 
         te_delete(_mainViewGroup);
+        te_delete(_shadowRendering);
 
         if(GpuResourcePool::IsStarted())
             GpuResourcePool::ShutDown();
@@ -107,14 +102,14 @@ namespace te
 
         _renderTextures.Clear();
 
-        CoreObjectManager::Instance().FrameSync();
-
         const SceneInfo& sceneInfo = _scene->GetSceneInfo();
 
+        // Core objects are synced by the caller before this is called, and timings come from the per-frame data as the
+        // simulation might already be running the next frame on another thread
         FrameTimings timings;
-        timings.Time = gTime().GetTime();
-        timings.TimeDelta = gTime().GetFrameDelta();
-        timings.FrameIdx = gTime().GetFrameIdx();
+        timings.Time = perFrameData.Time;
+        timings.TimeDelta = perFrameData.TimeDelta;
+        timings.FrameIdx = perFrameData.FrameIdx;
 
         // Update global per-frame hardware buffers
         _scene->SetParamFrameParams(timings.Time, timings.TimeDelta);
@@ -128,6 +123,12 @@ namespace te
         for (UINT32 i = 0; i < sceneInfo.Renderables.size(); i++)
             _scene->PrepareRenderable(i, frameInfo);
 
+        // Per object data changed since the last frame is uploaded at once, in as few copies as possible
+        _scene->GetSceneInfo().ObjectData.Upload();
+
+        // Bounds of render elements of moved renderables are transformed at once, before views need them
+        _scene->UpdateSubMeshBounds();
+
         // Gather all views
         for (auto& rtInfo : sceneInfo.RenderTargets)
         {
@@ -139,12 +140,13 @@ namespace te
             UINT32 numCameras = (UINT32)cameras.size();
             for (UINT32 i = 0; i < numCameras; i++)
             {
+                UINT32 viewIdx = sceneInfo.CameraToView.at(cameras[i]);
+                RendererView* viewInfo = sceneInfo.Views[viewIdx];
+
                 //If we have a camera without any render target, don't process it at all
-                if (!cameras[i]->GetViewport()->GetTarget())
+                if (!viewInfo->GetProperties().Target.Target)
                     continue;
 
-                UINT32 viewIdx = sceneInfo.CameraToView.at(cameras[i]);
-                RendererView* viewInfo = sceneInfo.Views[viewIdx];
                 views.push_back(viewInfo);
             }
 
@@ -160,13 +162,16 @@ namespace te
                 _mainViewGroup->SetAllObjectsAsVisible(sceneInfo);
             }
 
+            _mainViewGroup->RequestStreamedMips(sceneInfo);
+            _shadowRendering->RenderShadowMaps(*_scene, *_mainViewGroup, frameInfo);
+
             for (auto& view : views)
             {
                 _mainViewGroup->GenerateInstanced(sceneInfo, _options->InstancingMode);
                 _mainViewGroup->GenerateRenderQueue(sceneInfo, *view, _options->InstancingMode);
 
-                _scene->SetParamCameraParams(view->GetSceneCamera()->GetRenderSettings()->SceneLightColor);
-                _scene->SetParamSkyboxParams(view->GetSceneCamera()->GetRenderSettings()->EnableSkybox);
+                _scene->SetParamCameraParams(view->GetRenderSettings().SceneLightColor);
+                _scene->SetParamSkyboxParams(view->GetRenderSettings().EnableSkybox);
 
                 if (RenderSingleView(*_mainViewGroup, *view, frameInfo))
                     anythingDrawn = true;
@@ -245,6 +250,7 @@ namespace te
         SPtr<GpuParamBlockBuffer> perCameraBuffer = view.GetPerViewBuffer();
 
         view.BeginFrame(frameInfo);
+        view.UpdateLightGrid(viewGroup.GetVisibleLightData());
 
         RenderCompositorNodeInputs inputs(viewGroup, view, sceneInfo, *_options, frameInfo, *this);
 
@@ -260,28 +266,26 @@ namespace te
         view.BeginFrame(frameInfo);
 
         auto& viewProps = view.GetProperties();
-        Camera* camera = view.GetSceneCamera();
         SPtr<RenderTarget> target = viewProps.Target.Target;
-        SPtr<Viewport> viewport = camera->GetViewport();
 
-        UINT32 clearFlags = viewport->GetClearFlags();
+        UINT32 clearFlags = viewProps.Target.ClearFlags;
 
         RenderAPI& rapi = RenderAPI::Instance();
         if (clearFlags != 0)
         {
             rapi.SetRenderTarget(target);
-            rapi.ClearViewport(clearFlags, viewport->GetClearColorValue(),
-                viewport->GetClearDepthValue(), viewport->GetClearStencilValue());
+            rapi.ClearViewport(clearFlags, viewProps.Target.ClearColor,
+                viewProps.Target.ClearDepthValue, viewProps.Target.ClearStencilValue);
         }
         else
         {
             rapi.SetRenderTarget(target, 0);
         }
 
-        rapi.SetViewport(viewport->GetArea());
+        rapi.SetViewport(viewProps.Target.NrmViewRect);
 
         // The only overlay we can manage currently
-        if(view.GetSceneCamera()->IsMain() && GuiAPI::Instance().IsGuiInitialized())
+        if(viewProps.MainView && GuiAPI::Instance().IsGuiInitialized())
         {
             GuiAPI::Instance().EndFrame();
         }
@@ -295,6 +299,7 @@ namespace te
     {
         _options = std::static_pointer_cast<RenderManOptions>(options);
         _scene->SetOptions(_options);
+        _shadowRendering->SetOptions(_options);
     }
 
     SPtr<RendererOptions> RenderMan::GetOptions() const
@@ -325,21 +330,50 @@ namespace te
     void RenderMan::NotifyRenderableAdded(Renderable* renderable)
     {
         _scene->RegisterRenderable(renderable);
+
+        const SceneInfo& sceneInfo = _scene->GetSceneInfo();
+        const UINT32 renderableId = renderable->GetRendererId();
+        _shadowRendering->NotifyRenderableAdded(sceneInfo.Renderables[renderableId],
+            sceneInfo.RenderableCullInfos[renderableId].Boundaries.GetBox());
     }
 
     void RenderMan::NotifyRenderableUpdated(Renderable* renderable)
     {
+        const SceneInfo& sceneInfo = _scene->GetSceneInfo();
+        const UINT32 renderableId = renderable->GetRendererId();
+
+        // Merged renderables may not exist on the renderer side anymore
+        if (renderableId >= sceneInfo.Renderables.size() || sceneInfo.Renderables[renderableId]->RenderablePtr != renderable)
+        {
+            _scene->UpdateRenderable(renderable);
+            return;
+        }
+
+        const AABox oldBounds = sceneInfo.RenderableCullInfos[renderableId].Boundaries.GetBox();
         _scene->UpdateRenderable(renderable);
+
+        _shadowRendering->NotifyRenderableUpdated(sceneInfo.Renderables[renderableId], oldBounds,
+            sceneInfo.RenderableCullInfos[renderableId].Boundaries.GetBox());
     }
 
     void RenderMan::NotifyRenderableRemoved(Renderable* renderable)
     {
+        const SceneInfo& sceneInfo = _scene->GetSceneInfo();
+        const UINT32 renderableId = renderable->GetRendererId();
+
+        if (renderableId < sceneInfo.Renderables.size() && sceneInfo.Renderables[renderableId]->RenderablePtr == renderable)
+        {
+            _shadowRendering->NotifyRenderableRemoved(sceneInfo.Renderables[renderableId],
+                sceneInfo.RenderableCullInfos[renderableId].Boundaries.GetBox());
+        }
+
         _scene->UnregisterRenderable(renderable);
     }
 
     void RenderMan::NotifyLightsCleared()
     {
         _scene->ClearLights();
+        _shadowRendering->NotifyLightsCleared();
     }
 
     void RenderMan::NotifyLightAdded(Light* light)
@@ -355,11 +389,13 @@ namespace te
     void RenderMan::NotifyLightRemoved(Light* light)
     {
         _scene->UnregisterLight(light);
+        _shadowRendering->NotifyLightRemoved(light);
     }
 
     void RenderMan::NotifyRenderablesCleared()
     {
         _scene->ClearRenderables();
+        _shadowRendering->NotifyRenderablesCleared();
     }
 
     void RenderMan::NotifySkyboxAdded(Skybox* skybox)
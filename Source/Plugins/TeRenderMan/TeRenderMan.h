@@ -161,6 +161,8 @@ namespace te
         // Helpers to avoid memory allocations
         RendererViewGroup* _mainViewGroup = nullptr;
 
+        ShadowRendering* _shadowRendering = nullptr;
+
         // Keep track of all previously generated render textures
         // This structure is cleared when calling RenderAll()
         mutable RenderTextures _renderTextures;
@@ -4,13 +4,17 @@
 #include "Renderer/TeParamBlocks.h"
 #include "Math/TeMatrix4.h"
 #include "Math/TeVector2.h"
+#include "Math/TeVector4I.h"
 
 #define STANDARD_FORWARD_MIN_INSTANCED_BLOCK_SIZE 2
 #define STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE 128
 
 #define STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER 128
 
-#define STANDARD_FORWARD_MAX_NUM_LIGHTS 24
+// Size in pixels of the screen tiles lights are binned into
+#define STANDARD_FORWARD_LIGHT_GRID_TILE_SIZE 64
+// Number of depth slices lights are binned into
+#define STANDARD_FORWARD_LIGHT_GRID_NUM_SLICES 16
 
 namespace te
 {
@@ -71,7 +75,8 @@ namespace te
         float   BoundsRadius;
         float   LinearAttenuation;
         float   QuadraticAttenuation;
-        Vector2 Padding;
+        float   ShadowIdx; // Index of the first shadow map of the light, negative if it has none
+        float   Padding;
     };
 
     TE_PARAM_BLOCK_BEGIN(PerCameraParamDef)
@@ -149,19 +154,21 @@ namespace te
     extern PerMaterialParamDef gPerMaterialParamDef;
 
     TE_PARAM_BLOCK_BEGIN(PerInstanceParamDef)
-        TE_PARAM_BLOCK_ENTRY_ARRAY(PerInstanceData, gInstances, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE)
+        // Index of each instance in the object data buffer, four per entry
+        TE_PARAM_BLOCK_ENTRY_ARRAY(Vector4I, gInstanceIndices, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE / 4)
     TE_PARAM_BLOCK_END
 
     extern PerInstanceParamDef gPerInstanceParamDef;
     extern SPtr<GpuParamBlockBuffer> gPerInstanceParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER];
 
     TE_PARAM_BLOCK_BEGIN(PerLightsParamDef)
-        TE_PARAM_BLOCK_ENTRY_ARRAY(LightData, gLights, STANDARD_FORWARD_MAX_NUM_LIGHTS)
+        TE_PARAM_BLOCK_ENTRY(Vector4I, gLightGrid)
+        TE_PARAM_BLOCK_ENTRY(Vector4, gLightGridSlicing)
+        TE_PARAM_BLOCK_ENTRY(INT32, gNumDirLights)
         TE_PARAM_BLOCK_ENTRY(INT32, gLightsNumber)
     TE_PARAM_BLOCK_END
 
     extern PerLightsParamDef gPerLightsParamDef;
-    extern SPtr<GpuParamBlockBuffer> gPerLightsParamBuffer;
 
     TE_PARAM_BLOCK_BEGIN(DecalParamDef)
         TE_PARAM_BLOCK_ENTRY(Matrix4, gWorldToDecal)
@@ -250,6 +257,9 @@ namespace te
     class RendererViewGroup;
     struct LightData;
     class RendererLight;
+    class LightGrid;
+    class ShadowRendering;
+    class ObjectDataBuffer;
     class RenderableElement;
     struct RendererRenderable;
     struct SceneInfo;
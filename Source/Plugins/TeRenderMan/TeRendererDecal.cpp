@@ -23,12 +23,14 @@ namespace te
 
     void RendererDecal::UpdatePerObjectBuffer()
     {
+        WorldTfrm = DecalPtr->GetMatrix();
+
         // TODO
     }
 
     void RendererDecal::UpdatePerCallBuffer(const Matrix4& viewProj) const
     {
-        const Matrix4 worldViewProjMatrix = viewProj * DecalPtr->GetMatrix();
+        const Matrix4 worldViewProjMatrix = viewProj * WorldTfrm;
         gPerCallParamDef.gMatWorldViewProj.Set(PerCallParamBuffer, worldViewProjMatrix);
     }
 }
@@ -39,7 +39,10 @@ namespace te
     {
         RendererDecal();
 
-        /** Updates the per-object GPU buffer according to the currently set properties. */
+        /**
+         * Copies the current transform of the decal and updates the per-object GPU buffer according to the currently set
+         * properties. Must only be called at the renderer sync point.
+         */
         void UpdatePerObjectBuffer();
 
         /**
@@ -50,6 +53,7 @@ namespace te
         void UpdatePerCallBuffer(const Matrix4& viewProj) const;
 
         Decal* DecalPtr;
+        Matrix4 WorldTfrm = Matrix4::IDENTITY;
         mutable DecalRenderElement Element;
 
         SPtr<GpuParamBlockBuffer> DecalParamBuffer;
@@ -4,34 +4,37 @@
 
 namespace te
 {
-    PerLightsParamDef gPerLightsParamDef;
-    SPtr<GpuParamBlockBuffer> gPerLightsParamBuffer;
-
-    void PerLightsBuffer::UpdatePerLights(const LightData* (&lights)[STANDARD_FORWARD_MAX_NUM_LIGHTS], UINT32 lightNumber)
-    {
-        if (!gPerLightsParamBuffer)
-            gPerLightsParamBuffer = gPerLightsParamDef.CreateBuffer();
-
-        gPerLightsParamDef.gLightsNumber.Set(gPerLightsParamBuffer, lightNumber);
-
-        for (size_t i = 0; i < lightNumber; i++)
-            gPerLightsParamDef.gLights.Set(gPerLightsParamBuffer, const_cast<LightData&>(*lights[i]), (UINT32)i);
-    }
-
     RendererLight::RendererLight(Light* light)
         : _internal(light)
-    { }
+    {
+        SyncState();
+    }
 
     RendererLight::~RendererLight()
     { }
 
+    void RendererLight::SyncState()
+    {
+        _type = _internal->GetType();
+        _transform = _internal->GetTransform();
+        _bounds = _internal->GetBounds();
+        _color = _internal->GetColor();
+        _intensity = _internal->GetIntensity();
+        _attRadius = _internal->GetAttenuationRadius();
+        _linearAttenuation = _internal->GetLinearAttenuation();
+        _quadraticAttenuation = _internal->GetQuadraticAttenuation();
+        _shadowBias = _internal->GetShadowBias();
+        _spotAngle = _internal->GetSpotAngle();
+        _castShadows = _internal->GetCastShadows();
+    }
+
     void RendererLight::GetParameters(LightData& output) const
     {
-        Radian spotAngle = Math::Clamp(_internal->GetSpotAngle() * 0.5f, Degree(0), Degree(89));
-        Color color = _internal->GetColor();
+        Radian spotAngle = Math::Clamp(_spotAngle * 0.5f, Degree(0), Degree(89));
+        Color color = _color;
 
         float type = 0.0f;
-        switch (_internal->GetType())
+        switch (_type)
         {
         case LightType::Directional:
             type = 0.0;
@@ -46,19 +49,21 @@ namespace te
             break;
         }
 
-        const Transform& tfrm = _internal->GetTransform();
+        const Transform& tfrm = _transform;
         output.Position = tfrm.GetPosition();
         output.Direction = -tfrm.GetRotation().ZAxis();
-        output.Intensity = _internal->GetIntensity();
+        output.Intensity = _intensity;
         output.SpotAngles.x = spotAngle.ValueRadians();
         output.SpotAngles.y = Math::Cos(output.SpotAngles.x);
         output.SpotAngles.z = 1.0f / std::max(1.0f - output.SpotAngles.y, 0.001f);
-        output.AttenuationRadius = _internal->GetAttenuationRadius();
+        output.AttenuationRadius = _attRadius;
         output.Color = Vector3(color.r, color.g, color.b);
-        output.BoundsRadius = _internal->GetBounds().GetRadius();
-        output.LinearAttenuation = _internal->GetLinearAttenuation();
-        output.QuadraticAttenuation = _internal->GetQuadraticAttenuation();
+        output.BoundsRadius = _bounds.GetRadius();
+        output.LinearAttenuation = _linearAttenuation;
+        output.QuadraticAttenuation = _quadraticAttenuation;
         output.Type = type;
+        output.ShadowIdx = -1.0f;
+        output.Padding = 0.0f;
     }
 
     VisibleLightData::VisibleLightData()
@@ -112,7 +117,7 @@ namespace te
             UINT32 first = static_cast<UINT32>(-1);
             for (UINT32 i = 0; i < (UINT32)entries.size(); ++i)
             {
-                if (entries[i]->_internal->GetCastShadows())
+                if (entries[i]->GetCastShadows())
                 {
                     first = i;
                     break;
@@ -125,9 +130,9 @@ namespace te
             {
                 for (UINT32 i = first + 1; i < (UINT32)entries.size(); ++i)
                 {
-                    if (!entries[i]->_internal->GetCastShadows())
+                    if (!entries[i]->GetCastShadows())
                     {
-                        std::swap(entries[i], entries[first]);
+                        std::swap(entries[i], entries[first++]);
                         ++numUnshadowed;
                     }
                 }
@@ -141,125 +146,15 @@ namespace te
 
         // Generate light data to initialize the GPU buffer with
         _visibleLightData.clear();
+        _visibleLightBounds.clear();
         for (auto& lightsPerType : _visibleLights)
         {
             for (auto& entry : lightsPerType)
             {
                 _visibleLightData.push_back(LightData());
                 entry->GetParameters(_visibleLightData.back());
+                _visibleLightBounds.push_back(entry->GetBounds());
             }
         }
     }
-
-    void VisibleLightData::GatherInfluencingLights(const Bounds& bounds,
-        const LightData* (&output)[STANDARD_FORWARD_MAX_NUM_LIGHTS], Vector3I& counts) const
-    {
-        UINT32 outputIndices[STANDARD_FORWARD_MAX_NUM_LIGHTS];
-        UINT32 numInfluencingLights = 0;
-
-        UINT32 numDirLights = GetNumDirLights();
-        for (UINT32 i = 0; i < numDirLights; i++)
-        {
-            if (numInfluencingLights >= STANDARD_FORWARD_MAX_NUM_LIGHTS)
-                return;
-
-            outputIndices[numInfluencingLights] = i;
-            numInfluencingLights++;
-        }
-
-        UINT32 pointLightOffset = numInfluencingLights;
-
-        float distances[STANDARD_FORWARD_MAX_NUM_LIGHTS];
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_NUM_LIGHTS; i++)
-            distances[i] = std::numeric_limits<float>::max();
-
-        // Note: This is an ad-hoc way of evaluating light influence, a better way might be wanted
-        UINT32 numLights = (UINT32)_visibleLightData.size();
-        UINT32 furthestLightIdx = (UINT32)-1;
-        float furthestDistance = 0.0f;
-        for (UINT32 j = numDirLights; j < numLights; j++)
-        {
-            const LightData* lightData = &_visibleLightData[j];
-
-            Sphere lightSphere(lightData->Position, lightData->BoundsRadius);
-            if (bounds.GetSphere().Intersects(lightSphere))
-            {
-                float distance = bounds.GetSphere().GetCenter().SquaredDistance(lightData->Position);
-
-                // See where in the array can we fit the light
-                if (numInfluencingLights < STANDARD_FORWARD_MAX_NUM_LIGHTS)
-                {
-                    outputIndices[numInfluencingLights] = j;
-                    distances[numInfluencingLights] = distance;
-
-                    if (distance > furthestDistance)
-                    {
-                        furthestLightIdx = numInfluencingLights;
-                        furthestDistance = distance;
-                    }
-
-                    numInfluencingLights++;
-                }
-                else if (distance < furthestDistance)
-                {
-                    outputIndices[furthestLightIdx] = j;
-                    distances[furthestLightIdx] = distance;
-
-                    furthestDistance = distance;
-                    for (UINT32 k = 0; k < STANDARD_FORWARD_MAX_NUM_LIGHTS; k++)
-                    {
-                        if (distances[k] > furthestDistance)
-                        {
-                            furthestDistance = distances[k];
-                            furthestLightIdx = k;
-                        }
-                    }
-                }
-            }
-        }
-
-        // Output actual light data, sorted by type
-        counts = Vector3I(0, 0, 0);
-
-        for (UINT32 i = 0; i < pointLightOffset; i++)
-        {
-            output[i] = &_visibleLightData[outputIndices[i]];
-            counts.x += 1;
-        }
-
-        UINT32 outputIdx = pointLightOffset;
-        UINT32 spotLightIdx = GetNumDirLights() + GetNumRadialLights();
-        for (UINT32 i = pointLightOffset; i < numInfluencingLights; i++)
-        {
-            bool isSpot = outputIndices[i] >= spotLightIdx;
-            if (isSpot)
-                continue;
-
-            output[outputIdx++] = &_visibleLightData[outputIndices[i]];
-            counts.y += 1;
-        }
-
-        for (UINT32 i = pointLightOffset; i < numInfluencingLights; i++)
-        {
-            bool isSpot = outputIndices[i] >= spotLightIdx;
-            if (!isSpot)
-                continue;
-
-            output[outputIdx++] = &_visibleLightData[outputIndices[i]];
-            counts.z += 1;
-        }
-    }
-    
-    void VisibleLightData::GatherLights(const LightData* (&output)[STANDARD_FORWARD_MAX_NUM_LIGHTS],
-        Vector3I& counts) const
-    {
-        for (UINT32 i = 0; i < _visibleLightData.size(); i++)
-        {
-            output[i] = &_visibleLightData[i];
-
-            if ((UINT32)_visibleLightData[i].Type == 0) counts.x++;
-            if ((UINT32)_visibleLightData[i].Type == 1) counts.y++;
-            if ((UINT32)_visibleLightData[i].Type == 2) counts.z++;
-        }
-    }
 }
@@ -8,30 +8,54 @@ namespace te
     struct SceneInfo;
     class RendererViewGroup;
 
-    /** Helper class used for manipulating the PerObject parameter buffer. */
-    class PerLightsBuffer
-    {
-    public:
-        /**
-         * Updates the provided buffer with the data from the provided matrices.
-         *
-         *  @param[in]	lightNumber	  Number of lights to be rendered for this pass
-         *  @param[in]	lights  	  Array of lights data
-         */
-        static void UpdatePerLights(const LightData* (&lights)[STANDARD_FORWARD_MAX_NUM_LIGHTS], UINT32 lightNumber);
-    };
-
-    /**	Renderer information specific to a single light. */
+    /**
+     * Renderer information specific to a single light. Keeps a copy of the light properties, taken when the light is
+     * registered or updated, so rendering never reads the light while the main thread modifies it.
+     */
     class RendererLight
     {
     public:
         RendererLight(Light* light);
         ~RendererLight();
 
+        /** Copies the current properties of the light. Must only be called at the renderer sync point. */
+        void SyncState();
+
         /** Populates the structure with light parameters. */
         void GetParameters(LightData& output) const;
 
+        /** @copydoc Light::GetType */
+        LightType GetType() const { return _type; }
+
+        /** @copydoc SceneActor::GetTransform */
+        const Transform& GetTransform() const { return _transform; }
+
+        /** @copydoc Light::GetBounds */
+        const Sphere& GetBounds() const { return _bounds; }
+
+        /** @copydoc Light::GetCastShadows */
+        bool GetCastShadows() const { return _castShadows; }
+
+        /** @copydoc Light::GetShadowBias */
+        float GetShadowBias() const { return _shadowBias; }
+
+        /** @copydoc Light::GetSpotAngle */
+        Degree GetSpotAngle() const { return _spotAngle; }
+
         Light* _internal;
+
+    private:
+        LightType _type;
+        Transform _transform;
+        Sphere _bounds;
+        Color _color;
+        float _intensity;
+        float _attRadius;
+        float _linearAttenuation;
+        float _quadraticAttenuation;
+        float _shadowBias;
+        Degree _spotAngle;
+        bool _castShadows;
     };
 
     /**
@@ -49,33 +73,6 @@ namespace te
          */
         void Update(const SceneInfo& sceneInfo, const RendererViewGroup& viewGroup);
 
-        /**
-         * Scans the list of lights visible in the view frustum to find the ones influencing the object described by
-         * the provided bounds. A maximum number of STANDARD_FORWARD_MAX_NUM_LIGHTS will be output. If there are more
-         * influencing lights, only the most important ones will be returned.
-         *
-         * The lights will be output in the following order: directional, radial, spot. @p counts will contain the number
-         * of directional lights (component 'x'), number of radial lights (component 'y') and number of spot lights
-         * (component 'z');
-         *
-         * Update() must have been called with most recent scene/view information before calling this method.
-         */
-        void GatherInfluencingLights(const Bounds& bounds, const LightData* (&output)[STANDARD_FORWARD_MAX_NUM_LIGHTS],
-            Vector3I& counts) const;
-
-        /**
-         * Scans the list of lights visible in the view frustum. A maximum number of STANDARD_FORWARD_MAX_NUM_LIGHTS will be output. 
-         * If there are more influencing lights, only the most important ones will be returned.
-         *
-         * The lights will be output in the following order: directional, radial, spot. @p counts will contain the number
-         * of directional lights (component 'x'), number of radial lights (component 'y') and number of spot lights
-         * (component 'z');
-         *
-         * Update() must have been called with most recent scene/view information before calling this method.
-         */
-        void GatherLights(const LightData* (&output)[STANDARD_FORWARD_MAX_NUM_LIGHTS],
-            Vector3I& counts) const;
-
         /** Returns the number of directional lights in the lights buffer. */
         UINT32 GetNumDirLights() const { return _numLights[0]; }
 
@@ -97,6 +94,19 @@ namespace te
         /** Returns a list of all visible lights of the specified type. */
         const Vector<const RendererLight*>& GetLights(LightType type) const { return _visibleLights[(UINT32)type]; }
 
+        /** Returns the parameters of all visible lights, in the following order: directional, radial, spot. */
+        const Vector<LightData>& GetLightData() const { return _visibleLightData; }
+
+        /** Returns the world space bounds of all visible lights, in the same order as GetLightData(). */
+        const Vector<Sphere>& GetLightBounds() const { return _visibleLightBounds; }
+
+        /**
+         * Sets the shadow maps of a light, @p lightIdx being its index in GetLightData(). For directional lights,
+         * @p shadowIdx is the index of the light among shadowed directional lights, for other lights it is the index of
+         * its first shadow map. Reset by every call to Update().
+         */
+        void SetShadowIndex(UINT32 lightIdx, INT32 shadowIdx) { _visibleLightData[lightIdx].ShadowIdx = (float)shadowIdx; }
+
     private:
         INT32 _numLights[(UINT32)LightType::Count];
         UINT32 _numShadowedLights[(UINT32)LightType::Count];
@@ -104,5 +114,6 @@ namespace te
         // These are rebuilt every call to update()
         Vector<const RendererLight*> _visibleLights[(UINT32)LightType::Count];
         Vector<LightData> _visibleLightData;
+        Vector<Sphere> _visibleLightBounds;
     };
 }
@@ -0,0 +1,404 @@
+#include "TeRendererLightGrid.h"
+#include "TeRendererLight.h"
+#include "TeRendererView.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "RenderAPI/TeGpuParams.h"
+#include "Threading/TeTaskScheduler.h"
+#include "Math/TeSIMD.h"
+
+namespace te
+{
+    PerLightsParamDef gPerLightsParamDef;
+
+    namespace
+    {
+        /** Number of float4 a LightData takes in the lights buffer. */
+        const UINT32 LIGHT_DATA_STRIDE = sizeof(LightData) / sizeof(Vector4);
+        static_assert(sizeof(LightData) == LIGHT_DATA_STRIDE * sizeof(Vector4), "LightData must be made of float4s");
+
+        /** Below this number of lights, binning isn't worth spreading over the task scheduler. */
+        const UINT32 MIN_PARALLEL_LIGHTS = 64;
+
+        /** Number of slices binned by each task. */
+        const UINT32 SLICES_PER_TASK = 2;
+
+        /** Smallest near plane distance, logarithmic slicing needs it to be strictly positive. */
+        const float MIN_NEAR_PLANE = 0.001f;
+
+        /** Ratio to the near plane of the far plane used when the view doesn't have a usable one. */
+        const float INFINITE_FAR_PLANE_SCALE = 10000.0f;
+    }
+
+    LightGrid::~LightGrid()
+    {
+        if (_paramBuffer)
+            _paramBuffer->Destroy();
+    }
+
+    void LightGrid::Update(const RendererView& view, const VisibleLightData& lightData)
+    {
+        const RendererViewProperties& properties = view.GetProperties();
+        UpdateClusterBounds(properties);
+
+        const Vector<LightData>& lights = lightData.GetLightData();
+        const Vector<Sphere>& bounds = lightData.GetLightBounds();
+        const UINT32 numLights = (UINT32)lights.size();
+        const UINT32 numDirLights = lightData.GetNumDirLights();
+        const UINT32 numClusters = (UINT32)(_gridSize.x * _gridSize.y * _gridSize.z);
+
+        // Directional lights touch every cluster, they are evaluated separately. Others are culled against the depth
+        // range of the grid before being binned.
+        _lights.clear();
+        for (UINT32 i = numDirLights; i < numLights; i++)
+        {
+            const Vector3 center = properties.ViewTransform.MultiplyAffine(bounds[i].GetCenter());
+            const float radius = bounds[i].GetRadius();
+
+            if (-center.z + radius < _near || -center.z - radius > _far)
+                continue;
+
+            _lights.push_back({ Sphere(center, radius), i });
+        }
+
+        // Bin slices independently, then gather the pairs cluster by cluster
+        const UINT32 rangeSize = _lights.size() >= MIN_PARALLEL_LIGHTS ? SLICES_PER_TASK : (UINT32)_gridSize.z;
+        const UINT32 numRanges = ((UINT32)_gridSize.z + rangeSize - 1) / rangeSize;
+
+        Vector<Vector<std::pair<UINT32, UINT32>>> rangePairs(numRanges);
+        ParallelFor("LightGrid", (UINT32)_gridSize.z, rangeSize, [&](UINT32 begin, UINT32 end)
+        {
+            BinLights(begin, end, rangePairs[begin / rangeSize]);
+        });
+
+        _clusterCounts.assign(numClusters, 0);
+        for (const auto& pairs : rangePairs)
+        {
+            for (const auto& pair : pairs)
+                _clusterCounts[pair.first]++;
+        }
+
+        _clusterOffsets.resize(numClusters);
+        _numLightIndices = 0;
+        for (UINT32 i = 0; i < numClusters; i++)
+        {
+            _clusterOffsets[i] = _numLightIndices;
+            _numLightIndices += _clusterCounts[i];
+        }
+
+        _lightIndices.resize(std::max(_numLightIndices, 1U));
+        {
+            Vector<UINT32> writeOffsets = _clusterOffsets;
+            for (const auto& pairs : rangePairs)
+            {
+                for (const auto& pair : pairs)
+                    _lightIndices[writeOffsets[pair.first]++] = pair.second;
+            }
+        }
+
+        // Upload
+        if (!_paramBuffer)
+            _paramBuffer = gPerLightsParamDef.CreateBuffer();
+
+        gPerLightsParamDef.gLightGrid.Set(_paramBuffer,
+            Vector4I(_gridSize.x, _gridSize.y, _gridSize.z, STANDARD_FORWARD_LIGHT_GRID_TILE_SIZE));
+        gPerLightsParamDef.gLightGridSlicing.Set(_paramBuffer,
+            Vector4(_sliceScale, _sliceBias, _logSlicing ? 1.0f : 0.0f, 0.0f));
+        gPerLightsParamDef.gNumDirLights.Set(_paramBuffer, (INT32)numDirLights);
+        gPerLightsParamDef.gLightsNumber.Set(_paramBuffer, (INT32)numLights);
+
+        const UINT32 numLightElements = std::max(numLights, 1U) * LIGHT_DATA_STRIDE;
+        Reserve(_lightsBuffer, numLightElements, BF_32X4F);
+        if (numLights > 0)
+            _lightsBuffer->WriteData(0, numLights * sizeof(LightData), lights.data(), BWT_DISCARD);
+
+        Reserve(_clusterRangesBuffer, numClusters, BF_32X2U);
+        UINT32* ranges = (UINT32*)_clusterRangesBuffer->Lock(0, numClusters * 2 * sizeof(UINT32), GBL_WRITE_ONLY_DISCARD);
+        for (UINT32 i = 0; i < numClusters; i++)
+        {
+            ranges[i * 2 + 0] = _clusterOffsets[i];
+            ranges[i * 2 + 1] = _clusterCounts[i];
+        }
+        _clusterRangesBuffer->Unlock();
+
+        Reserve(_clusterIndicesBuffer, (UINT32)_lightIndices.size(), BF_32X1U);
+        _clusterIndicesBuffer->WriteData(0, (UINT32)_lightIndices.size() * sizeof(UINT32), _lightIndices.data(),
+            BWT_DISCARD);
+    }
+
+    void LightGrid::Bind(const SPtr<GpuParams>& params) const
+    {
+        if (!_paramBuffer)
+            return;
+
+        params->SetParamBlockBuffer("PerLightsBuffer", _paramBuffer);
+
+        if (params->HasBuffer(GPT_PIXEL_PROGRAM, "LightsBuffer"))
+            params->SetBuffer(GPT_PIXEL_PROGRAM, "LightsBuffer", _lightsBuffer);
+
+        if (params->HasBuffer(GPT_PIXEL_PROGRAM, "ClusterLightRanges"))
+            params->SetBuffer(GPT_PIXEL_PROGRAM, "ClusterLightRanges", _clusterRangesBuffer);
+
+        if (params->HasBuffer(GPT_PIXEL_PROGRAM, "ClusterLightIndices"))
+            params->SetBuffer(GPT_PIXEL_PROGRAM, "ClusterLightIndices", _clusterIndicesBuffer);
+    }
+
+    void LightGrid::UpdateClusterBounds(const RendererViewProperties& properties)
+    {
+        const Matrix4& proj = properties.ProjTransformNoAA;
+        const UINT32 width = std::max(properties.Target.ViewRect.width, 1U);
+        const UINT32 height = std::max(properties.Target.ViewRect.height, 1U);
+        const bool perspective = properties.ProjType == ProjectionType::PT_PERSPECTIVE;
+
+        float nearPlane = properties.NearPlane;
+        float farPlane = properties.FarPlane;
+
+        if (perspective)
+            nearPlane = std::max(nearPlane, MIN_NEAR_PLANE);
+        if (farPlane <= nearPlane)
+            farPlane = std::max(nearPlane, 1.0f) * INFINITE_FAR_PLANE_SCALE;
+
+        if (proj == _proj && width == _width && height == _height && nearPlane == _near && farPlane == _far)
+            return;
+
+        _proj = proj;
+        _width = width;
+        _height = height;
+        _near = nearPlane;
+        _far = farPlane;
+
+        const UINT32 tileSize = STANDARD_FORWARD_LIGHT_GRID_TILE_SIZE;
+        const UINT32 numSlices = STANDARD_FORWARD_LIGHT_GRID_NUM_SLICES;
+
+        _gridSize.x = (INT32)((width + tileSize - 1) / tileSize);
+        _gridSize.y = (INT32)((height + tileSize - 1) / tileSize);
+        _gridSize.z = (INT32)numSlices;
+        _rowStride = ((UINT32)_gridSize.x + 3) & ~3U;
+
+        // Slices are exponentially distributed for perspective projections, so clusters keep roughly the same
+        // proportions at all depths: slice = log2(depth) * scale + bias
+        _logSlicing = perspective;
+        if (_logSlicing)
+        {
+            const float logDepthRange = Math::Log2(farPlane / nearPlane);
+            _sliceScale = numSlices / logDepthRange;
+            _sliceBias = -(float)numSlices * Math::Log2(nearPlane) / logDepthRange;
+        }
+        else
+        {
+            _sliceScale = numSlices / (farPlane - nearPlane);
+            _sliceBias = -nearPlane * _sliceScale;
+        }
+
+        auto getSliceDepth = [&](UINT32 slice)
+        {
+            const float t = slice / (float)numSlices;
+            return _logSlicing ? nearPlane * Math::Pow(farPlane / nearPlane, t) : nearPlane + (farPlane - nearPlane) * t;
+        };
+
+        // View space position of a NDC coordinate, at the provided depth
+        auto unprojectX = [&](float ndc, float depth)
+        {
+            return perspective ? depth * (ndc + proj[0][2]) / proj[0][0] : (ndc - proj[0][3]) / proj[0][0];
+        };
+
+        auto unprojectY = [&](float ndc, float depth)
+        {
+            return perspective ? depth * (ndc + proj[1][2]) / proj[1][1] : (ndc - proj[1][3]) / proj[1][1];
+        };
+
+        const UINT32 numEntries = numSlices * (UINT32)_gridSize.y * _rowStride;
+        for (UINT32 i = 0; i < 3; i++)
+        {
+            // Padding entries get empty bounds, so they never pass the intersection test
+            _clusterMin[i].assign(numEntries, std::numeric_limits<float>::max());
+            _clusterMax[i].assign(numEntries, -std::numeric_limits<float>::max());
+        }
+
+        for (UINT32 z = 0; z < numSlices; z++)
+        {
+            const float depths[2] = { getSliceDepth(z), getSliceDepth(z + 1) };
+
+            for (UINT32 y = 0; y < (UINT32)_gridSize.y; y++)
+            {
+                const float ndcY[2] = {
+                    1.0f - 2.0f * std::min((y + 1) * tileSize, height) / height,
+                    1.0f - 2.0f * (y * tileSize) / height
+                };
+
+                for (UINT32 x = 0; x < (UINT32)_gridSize.x; x++)
+                {
+                    const float ndcX[2] = {
+                        2.0f * (x * tileSize) / width - 1.0f,
+                        2.0f * std::min((x + 1) * tileSize, width) / width - 1.0f
+                    };
+
+                    Vector3 min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), -depths[1]);
+                    Vector3 max(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -depths[0]);
+
+                    for (UINT32 i = 0; i < 2; i++)
+                    {
+                        for (UINT32 j = 0; j < 2; j++)
+                        {
+                            const float viewX = unprojectX(ndcX[j], depths[i]);
+                            const float viewY = unprojectY(ndcY[j], depths[i]);
+
+                            min.x = std::min(min.x, viewX);
+                            max.x = std::max(max.x, viewX);
+                            min.y = std::min(min.y, viewY);
+                            max.y = std::max(max.y, viewY);
+                        }
+                    }
+
+                    const UINT32 entry = (z * (UINT32)_gridSize.y + y) * _rowStride + x;
+                    for (UINT32 i = 0; i < 3; i++)
+                    {
+                        _clusterMin[i][entry] = min[i];
+                        _clusterMax[i][entry] = max[i];
+                    }
+                }
+            }
+        }
+    }
+
+    void LightGrid::BinLights(UINT32 begin, UINT32 end, Vector<std::pair<UINT32, UINT32>>& output) const
+    {
+        const bool perspective = _logSlicing;
+        const UINT32 tileSize = STANDARD_FORWARD_LIGHT_GRID_TILE_SIZE;
+        const INT32 lastSlice = _gridSize.z - 1;
+
+        auto getSlice = [&](float depth)
+        {
+            const float slice = _logSlicing
+                ? Math::Log2(std::max(depth, _near)) * _sliceScale + _sliceBias
+                : depth * _sliceScale + _sliceBias;
+
+            return Math::Clamp((INT32)Math::Floor(slice), 0, lastSlice);
+        };
+
+        // Pixel coordinates of a view space position
+        auto project = [&](const Vector3& position, float& px, float& py)
+        {
+            float ndcX, ndcY;
+            if (perspective)
+            {
+                ndcX = _proj[0][0] * position.x / -position.z - _proj[0][2];
+                ndcY = _proj[1][1] * position.y / -position.z - _proj[1][2];
+            }
+            else
+            {
+                ndcX = _proj[0][0] * position.x + _proj[0][3];
+                ndcY = _proj[1][1] * position.y + _proj[1][3];
+            }
+
+            px = (ndcX * 0.5f + 0.5f) * _width;
+            py = (0.5f - ndcY * 0.5f) * _height;
+        };
+
+        for (const auto& light : _lights)
+        {
+            const Vector3& center = light.Bounds.GetCenter();
+            const float radius = light.Bounds.GetRadius();
+            const float depth = -center.z;
+
+            const INT32 firstSlice = std::max(getSlice(depth - radius), (INT32)begin);
+            const INT32 lastLightSlice = std::min(getSlice(depth + radius), (INT32)end - 1);
+            if (firstSlice > lastLightSlice)
+                continue;
+
+            // Screen rectangle covered by the corners of the box around the sphere, unless it crosses the near plane
+            INT32 tileMin[2] = { 0, 0 };
+            INT32 tileMax[2] = { _gridSize.x - 1, _gridSize.y - 1 };
+
+            if (!perspective || depth - radius > _near)
+            {
+                float min[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+                float max[2] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+                for (UINT32 i = 0; i < 8; i++)
+                {
+                    const Vector3 corner(
+                        center.x + ((i & 1) ? radius : -radius),
+                        center.y + ((i & 2) ? radius : -radius),
+                        center.z + ((i & 4) ? radius : -radius));
+
+                    float px, py;
+                    project(corner, px, py);
+
+                    min[0] = std::min(min[0], px);
+                    max[0] = std::max(max[0], px);
+                    min[1] = std::min(min[1], py);
+                    max[1] = std::max(max[1], py);
+                }
+
+                for (UINT32 i = 0; i < 2; i++)
+                {
+                    const INT32 last = (i == 0 ? _gridSize.x : _gridSize.y) - 1;
+                    tileMin[i] = Math::Clamp((INT32)Math::Floor(min[i] / tileSize), 0, last);
+                    tileMax[i] = Math::Clamp((INT32)Math::Floor(max[i] / tileSize), 0, last);
+                }
+
+                if (max[0] < 0.0f || max[1] < 0.0f || min[0] >= _width || min[1] >= _height)
+                    continue;
+            }
+
+            // Exact sphere/box test, four clusters of a row at a time
+            const SIMD::Float4 centerX = SIMD::Splat(center.x);
+            const SIMD::Float4 centerY = SIMD::Splat(center.y);
+            const SIMD::Float4 centerZ = SIMD::Splat(center.z);
+            const SIMD::Float4 radius2 = SIMD::Splat(radius * radius);
+
+            const UINT32 firstX = (UINT32)tileMin[0] & ~3U;
+
+            for (INT32 z = firstSlice; z <= lastLightSlice; z++)
+            {
+                for (INT32 y = tileMin[1]; y <= tileMax[1]; y++)
+                {
+                    const UINT32 row = (UINT32)(z * _gridSize.y + y);
+
+                    for (UINT32 x = firstX; x <= (UINT32)tileMax[0]; x += 4)
+                    {
+                        const UINT32 entry = row * _rowStride + x;
+
+                        auto distance = [&](UINT32 axis, SIMD::Float4 value)
+                        {
+                            const SIMD::Float4 closest = SIMD::Max(SIMD::Load(&_clusterMin[axis][entry]),
+                                SIMD::Min(value, SIMD::Load(&_clusterMax[axis][entry])));
+
+                            return SIMD::Sub(closest, value);
+                        };
+
+                        const SIMD::Float4 dx = distance(0, centerX);
+                        const SIMD::Float4 dy = distance(1, centerY);
+                        const SIMD::Float4 dz = distance(2, centerZ);
+                        const SIMD::Float4 distance2 = SIMD::MulAdd(dx, dx, SIMD::MulAdd(dy, dy, SIMD::Mul(dz, dz)));
+
+                        const int outside = SIMD::MoveMask(SIMD::Greater(distance2, radius2));
+                        for (UINT32 i = 0; i < 4; i++)
+                        {
+                            const UINT32 tileX = x + i;
+                            if ((outside & (1 << i)) || tileX < (UINT32)tileMin[0] || tileX > (UINT32)tileMax[0])
+                                continue;
+
+                            output.push_back(std::make_pair(row * (UINT32)_gridSize.x + tileX, light.LightIdx));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LightGrid::Reserve(SPtr<GpuBuffer>& buffer, UINT32 count, GpuBufferFormat format)
+    {
+        if (buffer != nullptr && buffer->GetProperties().GetElementCount() >= count)
+            return;
+
+        GPU_BUFFER_DESC desc;
+        desc.ElementCount = std::max(count, buffer != nullptr ? buffer->GetProperties().GetElementCount() * 2 : 0U);
+        desc.ElementSize = 0;
+        desc.Type = GBT_STANDARD;
+        desc.Format = format;
+        desc.Usage = GBU_DYNAMIC;
+
+        buffer = GpuBuffer::Create(desc);
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeSphere.h"
+#include "Math/TeVector3I.h"
+
+namespace te
+{
+    class VisibleLightData;
+    struct RendererViewProperties;
+
+    /**
+     * Divides the frustum of a view into clusters (screen tiles of STANDARD_FORWARD_LIGHT_GRID_TILE_SIZE pixels times
+     * STANDARD_FORWARD_LIGHT_GRID_NUM_SLICES depth slices, exponentially distributed between the near and far planes)
+     * and finds the radial and spot lights touching each of them. The forward pass then only evaluates, for each pixel,
+     * the lights of its cluster, which removes any limit on the number of visible lights.
+     *
+     * Lights are binned on the CPU: light bounds are brought to view space, clipped to the range of clusters they cover
+     * and then tested against the bounds of each of these clusters, four at a time. Slices are spread over the task
+     * scheduler when there are enough lights.
+     *
+     * The result is exposed to shaders through the PerLightsBuffer param block and three buffers:
+     *  - LightsBuffer: LightData of all visible lights, directional first, as 5 float4 per light.
+     *  - ClusterLightRanges: offset and number of the lights of each cluster in ClusterLightIndices.
+     *  - ClusterLightIndices: indices in LightsBuffer of the lights of all clusters.
+     */
+    class LightGrid
+    {
+    public:
+        LightGrid() = default;
+        ~LightGrid();
+
+        /**
+         * Bins the visible lights into the clusters of @p view and uploads the result. Must be called after light
+         * visibility has been determined for the view group the view is part of.
+         */
+        void Update(const RendererView& view, const VisibleLightData& lightData);
+
+        /** Sets the param block and buffers on @p params, for the ones its pixel program uses. */
+        void Bind(const SPtr<GpuParams>& params) const;
+
+        /** Returns the param block describing the grid. */
+        const SPtr<GpuParamBlockBuffer>& GetParamBuffer() const { return _paramBuffer; }
+
+        /** Returns the number of clusters in each dimension. */
+        const Vector3I& GetGridSize() const { return _gridSize; }
+
+        /** Returns the number of light indices, summed over all clusters, after the last Update(). */
+        UINT32 GetNumLightIndices() const { return _numLightIndices; }
+
+        /** Makes sure @p buffer can hold @p count elements of @p format, recreating it with more room if needed. */
+        static void Reserve(SPtr<GpuBuffer>& buffer, UINT32 count, GpuBufferFormat format);
+
+    private:
+        /** Computes the view space bounds of each cluster. Only needed once the projection or viewport changes. */
+        void UpdateClusterBounds(const RendererViewProperties& properties);
+
+        /** Appends (cluster, light) pairs for the lights touching the clusters of slices [@p begin, @p end). */
+        void BinLights(UINT32 begin, UINT32 end, Vector<std::pair<UINT32, UINT32>>& output) const;
+
+    private:
+        /** Light bounds in view space. */
+        struct LightBounds
+        {
+            Sphere Bounds;
+            UINT32 LightIdx;
+        };
+
+        Vector3I _gridSize = Vector3I(0, 0, 0);
+        UINT32 _rowStride = 0; // Multiple of 4 greater or equal to _gridSize.x
+
+        // Cached to detect when cluster bounds are out of date
+        Matrix4 _proj = Matrix4::ZERO;
+        UINT32 _width = 0;
+        UINT32 _height = 0;
+        float _near = 0.0f;
+        float _far = 0.0f;
+
+        bool _logSlicing = true;
+        float _sliceScale = 0.0f;
+        float _sliceBias = 0.0f;
+
+        // Cluster bounds, split per component. Indexed by (slice * _gridSize.y + y) * _rowStride + x
+        Vector<float> _clusterMin[3];
+        Vector<float> _clusterMax[3];
+
+        // Per frame data
+        Vector<LightBounds> _lights;
+        Vector<UINT32> _clusterCounts;
+        Vector<UINT32> _clusterOffsets;
+        Vector<UINT32> _lightIndices;
+        UINT32 _numLightIndices = 0;
+
+        SPtr<GpuParamBlockBuffer> _paramBuffer;
+        SPtr<GpuBuffer> _lightsBuffer;
+        SPtr<GpuBuffer> _clusterRangesBuffer;
+        SPtr<GpuBuffer> _clusterIndicesBuffer;
+    };
+}
@@ -0,0 +1,130 @@
+#include "TeRendererObjectBuffer.h"
+#include "RenderAPI/TeGpuParams.h"
+
+namespace te
+{
+    PerObjectIndexParamDef gPerObjectIndexParamDef;
+
+    static_assert(sizeof(PerInstanceData) % sizeof(Vector4) == 0, "PerInstanceData must be made of whole float4");
+
+    void ObjectDataBuffer::Resize(UINT32 count)
+    {
+        const UINT32 oldCount = (UINT32)_data.size();
+
+        _data.resize(count);
+        _dirtyFlags.resize(count, false);
+
+        for (UINT32 i = oldCount; i < count; i++)
+            MarkDirty(i);
+    }
+
+    void ObjectDataBuffer::Update(UINT32 idx, const PerInstanceData& data)
+    {
+        if (idx >= (UINT32)_data.size())
+            Resize(idx + 1);
+
+        _data[idx] = data;
+        MarkDirty(idx);
+    }
+
+    void ObjectDataBuffer::Clear()
+    {
+        _data.clear();
+        _dirtyFlags.clear();
+        _dirtyIndices.clear();
+    }
+
+    void ObjectDataBuffer::MarkDirty(UINT32 idx)
+    {
+        if (_dirtyFlags[idx])
+            return;
+
+        _dirtyFlags[idx] = true;
+        _dirtyIndices.push_back(idx);
+    }
+
+    void ObjectDataBuffer::Upload()
+    {
+        _numUploadedObjects = 0;
+        _numUploadedRanges = 0;
+
+        const UINT32 count = (UINT32)_data.size();
+        if (count == 0)
+        {
+            _dirtyIndices.clear();
+            return;
+        }
+
+        // Everything is uploaded again when the buffer grows
+        bool uploadAll = false;
+        if (_buffer == nullptr || _capacity < count)
+        {
+            _capacity = std::max(std::max(count, _capacity * 2), MIN_CAPACITY);
+
+            GPU_BUFFER_DESC desc;
+            desc.ElementCount = _capacity * OBJECT_DATA_STRIDE;
+            desc.ElementSize = 0;
+            desc.Type = GBT_STANDARD;
+            desc.Format = BF_32X4F;
+            desc.Usage = GBU_STATIC;
+
+            _buffer = GpuBuffer::Create(desc);
+            uploadAll = true;
+        }
+
+        Vector<std::pair<UINT32, UINT32>> ranges; // [first, last]
+        if (!uploadAll && !_dirtyIndices.empty())
+        {
+            std::sort(_dirtyIndices.begin(), _dirtyIndices.end());
+
+            for (auto idx : _dirtyIndices)
+            {
+                // Slots removed since they were marked dirty don't need to be uploaded
+                if (idx >= count)
+                    break;
+
+                if (!ranges.empty() && idx <= ranges.back().second + MAX_RANGE_GAP + 1)
+                    ranges.back().second = idx;
+                else
+                    ranges.push_back(std::make_pair(idx, idx));
+            }
+
+            if (ranges.size() > MAX_RANGES)
+            {
+                const UINT32 first = ranges.front().first;
+                const UINT32 last = ranges.back().second;
+
+                ranges.clear();
+                ranges.push_back(std::make_pair(first, last));
+            }
+        }
+        else if (uploadAll)
+            ranges.push_back(std::make_pair(0U, count - 1));
+
+        for (auto& range : ranges)
+        {
+            const UINT32 numObjects = range.second - range.first + 1;
+
+            _buffer->WriteData(range.first * sizeof(PerInstanceData), numObjects * sizeof(PerInstanceData),
+                &_data[range.first], BWT_NORMAL);
+
+            _numUploadedObjects += numObjects;
+        }
+
+        _numUploadedRanges = (UINT32)ranges.size();
+
+        for (auto idx : _dirtyIndices)
+        {
+            if (idx < count)
+                _dirtyFlags[idx] = false;
+        }
+
+        _dirtyIndices.clear();
+    }
+
+    void ObjectDataBuffer::Bind(const SPtr<GpuParams>& params) const
+    {
+        if (_buffer != nullptr && params->HasBuffer(GPT_VERTEX_PROGRAM, "ObjectsBuffer"))
+            params->SetBuffer(GPT_VERTEX_PROGRAM, "ObjectsBuffer", _buffer);
+    }
+}
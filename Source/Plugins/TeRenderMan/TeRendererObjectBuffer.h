@@ -0,0 +1,81 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "RenderAPI/TeGpuBuffer.h"
+
+namespace te
+{
+    TE_PARAM_BLOCK_BEGIN(PerObjectIndexParamDef)
+        TE_PARAM_BLOCK_ENTRY(INT32, gObjectIdx)
+    TE_PARAM_BLOCK_END
+
+    extern PerObjectIndexParamDef gPerObjectIndexParamDef;
+
+    /**
+     * Keeps the per object data (PerInstanceData) of all renderables of the scene in a single GPU buffer, at the index of
+     * their renderer id, so it doesn't need to be written again for each draw. Shaders read it through the ObjectsBuffer
+     * buffer (OBJECT_DATA_STRIDE float4 per object), draws only provide the index of their object.
+     *
+     * Data is kept on the CPU too. Changed objects are marked dirty and uploaded once per frame by Upload(): dirty slots
+     * are sorted and merged in ranges, with small gaps between them uploaded along, so most frames only need a few
+     * copies. The buffer is never mapped, it lives in GPU memory and only dirty ranges are updated.
+     */
+    class ObjectDataBuffer
+    {
+    public:
+        ObjectDataBuffer() = default;
+        ~ObjectDataBuffer() = default;
+
+        /** Changes the number of objects in the buffer. New slots are dirty. */
+        void Resize(UINT32 count);
+
+        /** Changes the data of the object @p idx, and marks it dirty. */
+        void Update(UINT32 idx, const PerInstanceData& data);
+
+        /** Returns the data of the object @p idx. */
+        const PerInstanceData& Get(UINT32 idx) const { return _data[idx]; }
+
+        /** Returns the number of objects in the buffer. */
+        UINT32 GetCount() const { return (UINT32)_data.size(); }
+
+        /** Removes all the objects. */
+        void Clear();
+
+        /**
+         * Uploads the dirty ranges to the GPU buffer, creating it again first if it is too small (all objects are then
+         * uploaded). Must be called once per frame, before anything using the buffer is rendered.
+         */
+        void Upload();
+
+        /** Sets the buffer on @p params, if its vertex program uses it. */
+        void Bind(const SPtr<GpuParams>& params) const;
+
+        /** Returns the number of objects uploaded by the last call to Upload(). */
+        UINT32 GetNumUploadedObjects() const { return _numUploadedObjects; }
+
+        /** Returns the number of copies issued by the last call to Upload(). */
+        UINT32 GetNumUploadedRanges() const { return _numUploadedRanges; }
+
+        static constexpr UINT32 OBJECT_DATA_STRIDE = sizeof(PerInstanceData) / sizeof(Vector4);
+
+    private:
+        /** Marks the object @p idx dirty. */
+        void MarkDirty(UINT32 idx);
+
+    private:
+        Vector<PerInstanceData> _data;
+        Vector<bool> _dirtyFlags;
+        Vector<UINT32> _dirtyIndices;
+        SPtr<GpuBuffer> _buffer;
+        UINT32 _capacity = 0;
+
+        UINT32 _numUploadedObjects = 0;
+        UINT32 _numUploadedRanges = 0;
+
+        /** Dirty ranges separated by at most this many clean objects are uploaded in a single copy. */
+        static constexpr UINT32 MAX_RANGE_GAP = 4;
+        /** Past this many ranges, the whole span between the first and the last dirty objects is uploaded at once. */
+        static constexpr UINT32 MAX_RANGES = 32;
+        static constexpr UINT32 MIN_CAPACITY = 256;
+    };
+}
@@ -0,0 +1,103 @@
+#include "TeRendererOcclusion.h"
+#include "TeRendererView.h"
+#include "TeRendererRenderable.h"
+#include "Renderer/TeRenderable.h"
+#include "Mesh/TeMesh.h"
+#include "Mesh/TeMeshUtility.h"
+
+namespace te
+{
+    void OcclusionCuller::Cull(const RendererViewProperties& properties, OcclusionBuffer& buffer,
+        const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
+        Vector<RenderableVisibility>& visibility)
+    {
+        _numCulled = 0;
+
+        // Keep the pixels of the buffer square, so occluders are rasterized with the same precision in both directions
+        const Rect2I& viewRect = properties.Target.ViewRect;
+        if (viewRect.width > 0 && viewRect.height > 0)
+        {
+            const UINT32 height = std::max(OcclusionBuffer::TILE_SIZE,
+                (UINT32)(OcclusionBuffer::DEFAULT_WIDTH * viewRect.height / viewRect.width));
+            buffer.SetResolution(OcclusionBuffer::DEFAULT_WIDTH, std::min(height, OcclusionBuffer::DEFAULT_WIDTH));
+        }
+
+        buffer.Clear(properties.ProjTransformNoAA * properties.ViewTransform);
+
+        // Only occluders visible in the view can hide something
+        Vector<UINT32> occluders;
+        for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
+        {
+            if (!visibility[i].Visible)
+                continue;
+
+            const RendererRenderable* renderable = renderables[i];
+            if (!renderable->Properties.Occluder || renderable->IsAnimated())
+                continue;
+
+            const SPtr<Mesh>& mesh = renderable->MeshElem;
+            if (mesh == nullptr)
+                continue;
+
+            SPtr<OccluderMesh> occluderMesh = GetOccluderMesh(mesh);
+            if (occluderMesh == nullptr)
+                continue;
+
+            buffer.AddOccluder(occluderMesh->Positions.data(), (UINT32)occluderMesh->Positions.size(),
+                occluderMesh->Indices.data(), (UINT32)occluderMesh->Indices.size(), renderable->WorldTfrm);
+
+            occluders.push_back(i);
+        }
+
+        if (occluders.empty())
+            return;
+
+        buffer.Rasterize();
+
+        // An occluder can't hide itself, skip them
+        UINT32 nextOccluder = 0;
+        for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
+        {
+            if (nextOccluder < (UINT32)occluders.size() && occluders[nextOccluder] == i)
+            {
+                nextOccluder++;
+                continue;
+            }
+
+            if (!visibility[i].Visible)
+                continue;
+
+            if (!buffer.IsVisible(cullInfos[i].Boundaries.GetBox()))
+            {
+                visibility[i].Visible = false;
+                _numCulled++;
+            }
+        }
+
+        // Forget meshes that have been destroyed
+        for (auto iter = _meshes.begin(); iter != _meshes.end();)
+        {
+            if (iter->second->MeshElem.expired())
+                iter = _meshes.erase(iter);
+            else
+                ++iter;
+        }
+    }
+
+    SPtr<OcclusionCuller::OccluderMesh> OcclusionCuller::GetOccluderMesh(const SPtr<Mesh>& mesh)
+    {
+        auto iterFind = _meshes.find(mesh.get());
+        if (iterFind != _meshes.end() && !iterFind->second->MeshElem.expired())
+            return iterFind->second->Indices.empty() ? nullptr : iterFind->second;
+
+        SPtr<OccluderMesh> occluderMesh = te_shared_ptr_new<OccluderMesh>();
+        occluderMesh->MeshElem = mesh;
+        _meshes[mesh.get()] = occluderMesh;
+
+        // Meshes without CPU data are remembered as well, so we don't look at them again every frame
+        if (!MeshUtility::GetTriangles(mesh, occluderMesh->Positions, occluderMesh->Indices))
+            return nullptr;
+
+        return occluderMesh->Indices.empty() ? nullptr : occluderMesh;
+    }
+}
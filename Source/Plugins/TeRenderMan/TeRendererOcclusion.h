@@ -0,0 +1,58 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Renderer/TeOcclusionBuffer.h"
+
+namespace te
+{
+    struct RendererViewProperties;
+    struct RenderableVisibility;
+    struct CullInfo;
+
+    /**
+     * Hides renderables that are behind occluders, renderables flagged with Renderable::SetOccluder(), from the point of
+     * view of a view. Occluders visible in the view are rasterized into a low resolution OcclusionBuffer, then the
+     * bounds of all other visible renderables are tested against it.
+     *
+     * Occluder triangles are read from the CPU cached data of their mesh and kept until the mesh is destroyed.
+     */
+    class OcclusionCuller
+    {
+    public:
+        OcclusionCuller() = default;
+        ~OcclusionCuller() = default;
+
+        /**
+         * Sets Visible to false for each entry of @p visibility whose renderable is hidden by occluders. Entries must
+         * already contain the result of frustum culling for the view.
+         *
+         * @param[in]		properties		Properties of the view to cull for.
+         * @param[in, out]	buffer			Buffer to rasterize occluders into. Resized to the aspect ratio of the view.
+         * @param[in]		renderables		Renderables to cull.
+         * @param[in]		cullInfos		World bounds of each entry of @p renderables.
+         * @param[in, out]	visibility		Frustum visibility of each entry of @p renderables, for the view.
+         */
+        void Cull(const RendererViewProperties& properties, OcclusionBuffer& buffer,
+            const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
+            Vector<RenderableVisibility>& visibility);
+
+        /** Returns the number of renderables hidden by the last call to Cull(). */
+        UINT32 GetNumCulled() const { return _numCulled; }
+
+    private:
+        /** Triangles of a mesh, usable as an occluder. */
+        struct OccluderMesh
+        {
+            WPtr<Mesh> MeshElem;
+            Vector<Vector3> Positions;
+            Vector<UINT32> Indices;
+        };
+
+        /** Returns the triangles of @p mesh, reading them from its cached data if needed. Null if there isn't any. */
+        SPtr<OccluderMesh> GetOccluderMesh(const SPtr<Mesh>& mesh);
+
+    private:
+        UnorderedMap<const Mesh*, SPtr<OccluderMesh>> _meshes;
+        UINT32 _numCulled = 0;
+    };
+}
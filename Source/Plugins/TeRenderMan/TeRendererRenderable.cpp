@@ -1,7 +1,10 @@
 #include "TeRendererRenderable.h"
+#include "TeRendererObjectBuffer.h"
 #include "Renderer/TeRendererUtility.h"
 #include "Utility/TeBitwise.h"
 #include "Mesh/TeMesh.h"
+#include "Animation/TeAnimationManager.h"
+#include "RenderAPI/TeGpuBuffer.h"
 
 namespace te
 { 
@@ -9,28 +12,38 @@ namespace te
     PerMaterialParamDef gPerMaterialParamDef;
     PerObjectParamDef gPerObjectParamDef;
 
-    void PerObjectBuffer::UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm,
-        const Matrix4& prevTfrm, Renderable* renderable)
+    void PerObjectBuffer::UpdatePerObject(ObjectDataBuffer& objectData, UINT32 objectIdx,
+        const RendererRenderable& renderable)
     {
-        const Matrix4& tfrmNoScale = renderable->GetMatrixNoScale();
-        const UINT32 layer = Bitwise::MostSignificantBit(renderable->GetLayer());
-
-        gPerObjectParamDef.gMatWorld.Set(buffer, tfrm);
-        gPerObjectParamDef.gMatInvWorld.Set(buffer, tfrm.InverseAffine());
-        gPerObjectParamDef.gMatWorldNoScale.Set(buffer, tfrmNoScale);
-        gPerObjectParamDef.gMatInvWorldNoScale.Set(buffer, tfrmNoScale.InverseAffine());
-        gPerObjectParamDef.gMatPrevWorld.Set(buffer, prevTfrm);
-        gPerObjectParamDef.gLayer.Set(buffer, (INT32)layer);
-        gPerObjectParamDef.gHasAnimation.Set(buffer, (UINT32)renderable->IsAnimated() ? 1 : 0);
-        gPerObjectParamDef.gWriteVelocity.Set(buffer, (UINT32)renderable->GetWriteVelocity() ? 1 : 0);
-        gPerObjectParamDef.gCastLights.Set(buffer, (UINT32)renderable->GetCastLights() ? 1 : 0);
+        const Matrix4& tfrm = renderable.WorldTfrm;
+        const Matrix4& tfrmNoScale = renderable.WorldTfrmNoScale;
+        const UINT32 layer = Bitwise::MostSignificantBit(renderable.Layer);
+
+        PerInstanceData data;
+        data.gMatWorld = tfrm;
+        data.gMatInvWorld = tfrm.InverseAffine();
+        data.gMatWorldNoScale = tfrmNoScale;
+        data.gMatInvWorldNoScale = tfrmNoScale.InverseAffine();
+        data.gMatPrevWorld = renderable.PrevWorldTfrm;
+        data.gLayer = layer;
+        data.gHasAnimation = renderable.Animated ? 1 : 0;
+        data.gWriteVelocity = renderable.Properties.WriteVelocity ? 1 : 0;
+        data.gCastLights = renderable.Properties.CastLights ? 1 : 0;
+
+        objectData.Update(objectIdx, data);
     }
 
-    void PerObjectBuffer::UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perObjectBuffer, 
-        SPtr<GpuParamBlockBuffer>& perInstanceBuffer, PerInstanceData* instanceData, UINT32 instanceCounter)
+    void PerObjectBuffer::UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perInstanceBuffer, const UINT32* objectIndices,
+        UINT32 instanceCounter)
     {
-        for (size_t i = 0; i < instanceCounter; i++)
-            gPerInstanceParamDef.gInstances.Set(perInstanceBuffer, instanceData[i], (UINT32)i);
+        Vector4I indices;
+        for (UINT32 i = 0; i < instanceCounter; i += 4)
+        {
+            for (UINT32 j = 0; j < 4; j++)
+                indices[j] = (i + j < instanceCounter) ? (INT32)objectIndices[i + j] : 0;
+
+            gPerInstanceParamDef.gInstanceIndices.Set(perInstanceBuffer, indices, i / 4);
+        }
     }
 
     void PerObjectBuffer::UpdatePerMaterial(SPtr<GpuParamBlockBuffer>& perMaterialBuffer, const MaterialProperties& properties)
@@ -116,19 +129,83 @@ namespace te
 
     RendererRenderable::RendererRenderable()
     {
-        PerObjectParamBuffer = gPerObjectParamDef.CreateBuffer();
+        PerObjectParamBuffer = gPerObjectIndexParamDef.CreateBuffer();
     }
 
     RendererRenderable::~RendererRenderable()
     { }
 
-    void RendererRenderable::UpdatePerObjectBuffer()
+    void RendererRenderable::SyncState()
+    {
+        WorldTfrm = RenderablePtr->GetMatrix();
+        WorldTfrmNoScale = RenderablePtr->GetMatrixNoScale();
+        Layer = RenderablePtr->GetLayer();
+        Mobility = RenderablePtr->GetMobility();
+        Properties = RenderablePtr->GetProperties();
+        Animated = RenderablePtr->IsAnimated();
+        MeshElem = RenderablePtr->GetMesh();
+        Materials.assign(RenderablePtr->GetMaterialsPtr(), RenderablePtr->GetMaterialsPtr() + RenderablePtr->GetNumMaterials());
+    }
+
+    void RendererRenderable::SyncAnimationBuffers()
+    {
+        AnimationId = RenderablePtr->GetAnimationId();
+        AnimType = RenderablePtr->GetAnimType();
+        BoneMatrixBuffer = RenderablePtr->GetBoneMatrixBuffer();
+        BonePrevMatrixBuffer = RenderablePtr->GetBonePrevMatrixBuffer();
+    }
+
+    void RendererRenderable::UpdateAnimationBuffers(const EvaluatedAnimationData& animData)
+    {
+        if (AnimationId == (UINT64)-1)
+            return;
+
+        auto iterFind = animData.Infos.find(AnimationId);
+        if (iterFind == animData.Infos.end())
+            return;
+
+        if (AnimType == RenderableAnimType::Skinned && BoneMatrixBuffer != nullptr)
+        {
+            AnimationManager::Instance().SetAnimDataDirty();
+            const EvaluatedAnimationData::PoseInfo& poseInfo = iterFind->second.PoseInfos;
+
+            if (Properties.WriteVelocity && BonePrevMatrixBuffer != nullptr)
+                std::swap(BoneMatrixBuffer, BonePrevMatrixBuffer);
+
+            UINT8* dest = (UINT8*)BoneMatrixBuffer->Lock(0, poseInfo.NumBones * 4 * sizeof(Vector4), GBL_WRITE_ONLY_DISCARD);
+            for (UINT32 j = 0; j < poseInfo.NumBones; j++)
+            {
+                const Matrix4& transform = animData.Transforms[poseInfo.StartIdx + j];
+                memcpy(dest, &transform, 16 * sizeof(float)); // Assuming row-major format
+
+                dest += 16 * sizeof(float);
+            }
+
+            BoneMatrixBuffer->Unlock();
+        }
+    }
+
+    void RendererRenderable::UpdatePrevFrameAnimationBuffers()
     {
-        PerObjectBuffer::UpdatePerObject(PerObjectParamBuffer, WorldTfrm, PrevWorldTfrm, RenderablePtr);
+        if (AnimType == RenderableAnimType::Skinned && BonePrevMatrixBuffer != nullptr)
+            std::swap(BoneMatrixBuffer, BonePrevMatrixBuffer);
+    }
+
+    void RendererRenderable::UpdatePerObjectBuffer(ObjectDataBuffer& objectData)
+    {
+        const UINT32 objectIdx = RenderablePtr->GetRendererId();
+        PerObjectBuffer::UpdatePerObject(objectData, objectIdx, *this);
+
+        // Renderer ids only change when another renderable is removed
+        if (ObjectIdx != objectIdx)
+        {
+            gPerObjectIndexParamDef.gObjectIdx.Set(PerObjectParamBuffer, (INT32)objectIdx);
+            ObjectIdx = objectIdx;
+        }
     }
 
-    void RendererRenderable::UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId)
+    void RendererRenderable::UpdatePerInstanceBuffer(const UINT32* objectIndices, UINT32 instanceCounter, UINT32 blockId)
     {
-        PerObjectBuffer::UpdatePerInstance(PerObjectParamBuffer, gPerInstanceParamBuffer[blockId], instanceData, instanceCounter);
+        PerObjectBuffer::UpdatePerInstance(gPerInstanceParamBuffer[blockId], objectIndices, instanceCounter);
     }
 }
@@ -11,25 +11,24 @@ namespace te
     {
     public:
         /** 
-         * Updates the provided buffer with the data from the provided matrices. 
+         * Writes the data of a renderable in the object data buffer.
          *
-         *  @param[in]	buffer	      Buffer which will be filled with data
-         *  @param[in]	tfrm	      World matrix of current object
-         *  @param[in]	prevTfrm	  Previous World matrix of current object
-         *  @param[in]	RenderablePtr Pointer to the current Renderable we want to update
+         *  @param[in]	objectData	  Object data buffer which will be filled with data
+         *  @param[in]	objectIdx	  Index of the renderable in the object data buffer
+         *  @param[in]	renderable	  Renderer copy of the renderable we want to update
          */
-        static void UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm,
-            const Matrix4& prevTfrm, Renderable* RenderablePtr);
+        static void UpdatePerObject(ObjectDataBuffer& objectData, UINT32 objectIdx,
+            const RendererRenderable& renderable);
 
         /** 
          * Update the provided instance buffer
          * 
-         *  @param[in]	perObjectBuffer	    Per object Buffer which will be filled with data
          *  @param[in]	perInstanceBuffer	Per instance Buffer which will be filled with data
-         *  @param[in]	instanceData	    data list we want to store inside instance buffer
+         *  @param[in]	objectIndices	    Index in the object data buffer of each instance
+         *  @param[in]	instanceCounter	    Number of instances
          */
-        static void UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perObjectBuffer,
-            SPtr<GpuParamBlockBuffer>& perInstanceBuffer, PerInstanceData* instanceData, UINT32 instanceCounter);
+        static void UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perInstanceBuffer, const UINT32* objectIndices,
+            UINT32 instanceCounter);
 
         /**
          * Update the provided material buffer
@@ -66,23 +65,54 @@ namespace te
         SPtr<GpuBuffer> BonePrevMatrixBuffer;
     };
 
-    /** Contains information about a Renderable, used by the Renderer. */
+    /**
+     * Contains information about a Renderable, used by the Renderer. Keeps a copy of the renderable properties, taken
+     * when the renderable is registered or updated, so rendering never reads the renderable while the main thread
+     * modifies it.
+     */
     struct RendererRenderable
     {
         RendererRenderable();
         ~RendererRenderable();
 
-        /** Updates the per-object GPU buffer according to the currently set properties. */
-        void UpdatePerObjectBuffer();
+        /** 
+         * Copies the current transform and properties of the renderable. Animation buffers are only copied by
+         * SyncAnimationBuffers(). Must only be called at the renderer sync point.
+         */
+        void SyncState();
+
+        /** Copies the current animation buffers of the renderable. Must only be called at the renderer sync point. */
+        void SyncAnimationBuffers();
+
+        /** Returns true if the renderable is animated using skeleton animation. */
+        bool IsAnimated() const { return Animated; }
+
+        /**
+         * Updates the animation buffers from the contents of the provided animation data object. Does nothing if the
+         * renderable is not affected by animation.
+         */
+        void UpdateAnimationBuffers(const EvaluatedAnimationData& animData);
+
+        /**
+         * Records information about previous frame's animation buffer data. Should be called once per frame, before the
+         * call to UpdateAnimationBuffers().
+         */
+        void UpdatePrevFrameAnimationBuffers();
+
+        /**
+         * Updates the data of the renderable in the object data buffer according to the currently set properties. The
+         * per-object GPU buffer only holds the index of the renderable in it, and is only written when it changes.
+         */
+        void UpdatePerObjectBuffer(ObjectDataBuffer& objectData);
 
         /** 
          * Updates the per-instance GPU buffer according to the currently set properties. 
          *
-         * @param[in]	instanceData	Array with max with of 64
+         * @param[in]	objectIndices	Index in the object data buffer of each instance, at most 128
          * @param[in]	instanceCounter	Number of valid element to store in array
-         * @param[in]	blockId	        We create only 8 instance buffer, we need to know in which we want to register data
+         * @param[in]	blockId	        We create only 128 instance buffer, we need to know in which we want to register data
          */
-        void UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId);
+        void UpdatePerInstanceBuffer(const UINT32* objectIndices, UINT32 instanceCounter, UINT32 blockId);
 
         Matrix4 WorldTfrm = Matrix4::IDENTITY;
         Matrix4 PrevWorldTfrm = Matrix4::IDENTITY;
@@ -91,6 +121,21 @@ namespace te
         Renderable* RenderablePtr;
         Vector<RenderableElement> Elements;
 
+        // Copy of the renderable state
+        Matrix4 WorldTfrmNoScale = Matrix4::IDENTITY;
+        UINT64 Layer = 0;
+        ObjectMobility Mobility = ObjectMobility::Movable;
+        RenderableProperties Properties;
+        bool Animated = false;
+        SPtr<Mesh> MeshElem;
+        Vector<SPtr<Material>> Materials;
+
+        UINT64 AnimationId = (UINT64)-1;
+        RenderableAnimType AnimType = RenderableAnimType::None;
+        SPtr<GpuBuffer> BoneMatrixBuffer;
+        SPtr<GpuBuffer> BonePrevMatrixBuffer;
+
         SPtr<GpuParamBlockBuffer> PerObjectParamBuffer;
+        UINT32 ObjectIdx = std::numeric_limits<UINT32>::max(); // Index written in PerObjectParamBuffer
     };
 }
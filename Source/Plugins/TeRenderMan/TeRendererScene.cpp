@@ -84,6 +84,8 @@ namespace te
 
         for (auto& entry : _info.Views)
             te_delete(entry);
+
+        ClearSkybox();
     }
 
     void RendererScene::RegisterCamera(Camera* camera)
@@ -221,22 +223,37 @@ namespace te
     {
         UINT32 lightId = light->GetRendererId();
 
-        if (light->GetType() == LightType::Radial)
+        if (light->GetType() == LightType::Directional)
+            _info.DirectionalLights[lightId].SyncState();
+        else if (light->GetType() == LightType::Radial)
+        {
+            _info.RadialLights[lightId].SyncState();
             _info.RadialLightWorldBounds[lightId] = light->GetBounds();
+        }
         else if (light->GetType() == LightType::Spot)
+        {
+            _info.SpotLights[lightId].SyncState();
             _info.SpotLightWorldBounds[lightId] = light->GetBounds();
+        }
     }
 
     void RendererScene::UnregisterLight(Light* light)
     {
         UINT32 lightId = light->GetRendererId();
-        if (light->GetType() == LightType::Directional)
-        {
-            if (_info.DirectionalLights.size() <= lightId)
-                return;
-            if (_info.DirectionalLights[lightId]._internal != light)
-                return;
 
+        // The light type might have changed since it was registered, look for it in the list it was registered in
+        LightType type;
+        if (lightId < _info.DirectionalLights.size() && _info.DirectionalLights[lightId]._internal == light)
+            type = LightType::Directional;
+        else if (lightId < _info.RadialLights.size() && _info.RadialLights[lightId]._internal == light)
+            type = LightType::Radial;
+        else if (lightId < _info.SpotLights.size() && _info.SpotLights[lightId]._internal == light)
+            type = LightType::Spot;
+        else
+            return;
+
+        if (type == LightType::Directional)
+        {
             Light* lastLight = _info.DirectionalLights.back()._internal;
             UINT32 lastLightId = lastLight->GetRendererId();
 
@@ -252,13 +269,8 @@ namespace te
         }
         else
         {
-            if (light->GetType() == LightType::Radial)
+            if (type == LightType::Radial)
             {
-                if (_info.RadialLights.size() <= lightId)
-                    return;
-                if (_info.DirectionalLights[lightId]._internal != light)
-                    return;
-
                 Light* lastLight = _info.RadialLights.back()._internal;
                 UINT32 lastLightId = lastLight->GetRendererId();
 
@@ -277,11 +289,6 @@ namespace te
             }
             else
             {
-                if (_info.SpotLights.size() <= lightId)
-                    return;
-                if (_info.DirectionalLights[lightId]._internal != light)
-                    return;
-
                 Light* lastLight = _info.SpotLights.back()._internal;
                 UINT32 lastLightId = lastLight->GetRendererId();
 
@@ -320,12 +327,13 @@ namespace te
 
         RendererRenderable* rendererRenderable = _info.Renderables.back();
         rendererRenderable->RenderablePtr = renderable;
-        rendererRenderable->WorldTfrm = renderable->GetMatrix();
+        rendererRenderable->SyncState();
         rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
-        rendererRenderable->UpdatePerObjectBuffer();
+        rendererRenderable->UpdatePerObjectBuffer(_info.ObjectData);
 
         SetMeshData(rendererRenderable, renderable);
+        _info.SubMeshBounds.SetLayoutDirty();
 
         if (_options->InstancingMode == RenderManInstancing::Manual)
         {
@@ -355,13 +363,14 @@ namespace te
         if(rendererRenderable->PreviousFrameDirtyState != PrevFrameDirtyState::Updated)
             rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
 
-        rendererRenderable->WorldTfrm = renderable->GetMatrix();
+        rendererRenderable->SyncState();
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Updated;
 
-        _info.Renderables[renderableId]->UpdatePerObjectBuffer();
+        _info.Renderables[renderableId]->UpdatePerObjectBuffer(_info.ObjectData);
         _info.RenderableCullInfos[renderableId].Layer = renderable->GetLayer();
         _info.RenderableCullInfos[renderableId].Boundaries = renderable->GetBounds();
         _info.RenderableCullInfos[renderableId].CullDistanceFactor = renderable->GetCullDistanceFactor();
+        _info.SubMeshBounds.MarkDirty(renderableId);
 
         if (_options->InstancingMode == RenderManInstancing::Manual)
         {
@@ -374,7 +383,10 @@ namespace te
 
         UINT32 dirtyFlag = renderable->GetCoreDirtyFlags();
         if (dirtyFlag & (UINT32)ActorDirtyFlag::GpuParams)
+        {
             SetMeshData(rendererRenderable, renderable);
+            _info.SubMeshBounds.SetLayoutDirty();
+        }
     }
 
     void RendererScene::UnregisterRenderable(Renderable* renderable)
@@ -405,6 +417,9 @@ namespace te
             std::swap(_info.RenderableCullInfos[renderableId], _info.RenderableCullInfos[lastRenderableId]);
 
             lastRenderable->SetRendererId(renderableId);
+
+            // The last renderable now lives in the slot of the removed one
+            _info.Renderables[renderableId]->UpdatePerObjectBuffer(_info.ObjectData);
         }
 
         if (_options->InstancingMode == RenderManInstancing::Manual)
@@ -417,6 +432,8 @@ namespace te
         // Last element is the one we want to erase
         _info.Renderables.erase(_info.Renderables.end() - 1);
         _info.RenderableCullInfos.erase(_info.RenderableCullInfos.end() - 1);
+        _info.ObjectData.Resize((UINT32)_info.Renderables.size());
+        _info.SubMeshBounds.SetLayoutDirty();
 
         te_delete(rendererRenderable);
     }
@@ -431,6 +448,8 @@ namespace te
         _info.Renderables.clear();
         _info.RenderablesInstanced.clear();
         _info.RenderableCullInfos.clear();
+        _info.ObjectData.Clear();
+        _info.SubMeshBounds.Clear();
     }
 
     void RendererScene::RegisterDecal(Decal* decal)
@@ -514,6 +533,8 @@ namespace te
 
     void RendererScene::SetMeshData(RendererRenderable* rendererRenderable, Renderable* renderable)
     {
+        rendererRenderable->SyncAnimationBuffers();
+
         SPtr<Mesh> mesh = renderable->GetMesh();
         if (mesh != nullptr)
         {
@@ -532,10 +553,10 @@ namespace te
                 renElement->Type = (UINT32)RenderElementType::Renderable;
                 renElement->MeshElem = mesh;
                 renElement->SubMeshElem = meshProps.GetSubMeshPtr(i);
-                renElement->BoneMatrixBuffer = renderable->GetBoneMatrixBuffer();
-                renElement->BonePrevMatrixBuffer = renderable->GetBonePrevMatrixBuffer();
-                renElement->AnimType = renderable->GetAnimType();
-                renElement->AnimationId = renderable->GetAnimationId();
+                renElement->BoneMatrixBuffer = rendererRenderable->BoneMatrixBuffer;
+                renElement->BonePrevMatrixBuffer = rendererRenderable->BonePrevMatrixBuffer;
+                renElement->AnimType = rendererRenderable->AnimType;
+                renElement->AnimationId = rendererRenderable->AnimationId;
 
                 renElement->MaterialElem = renderable->GetMaterial(i);
                 if (renElement->MaterialElem == nullptr)
@@ -558,7 +579,7 @@ namespace te
                 PerObjectBuffer::UpdatePerMaterial(renElement->PerMaterialParamBuffer, renElement->MaterialElem->GetProperties());
 
                 // Set renderable properties to renderElement
-                renElement->Properties = &renderable->GetProperties();
+                renElement->Properties = &rendererRenderable->Properties;
 
 #if TE_DEBUG_MODE
                 ValidateBasePassMaterial(*renElement->MaterialElem, renElement->DefaultTechniqueIdx, *vertexDecl);
@@ -592,17 +613,26 @@ namespace te
 
     void RendererScene::RegisterSkybox(Skybox* skybox)
     {
-        _info.SkyboxElem = skybox;
+        if (_info.SkyboxElem == nullptr)
+            _info.SkyboxElem = te_new<RendererSkybox>();
+
+        _info.SkyboxElem->SkyboxPtr = skybox;
+        _info.SkyboxElem->Radiance = skybox->GetTexture();
+        _info.SkyboxElem->Irradiance = skybox->GetIrradiance();
+        _info.SkyboxElem->Brightness = skybox->GetBrightness();
     }
 
     void RendererScene::UnregisterSkybox(Skybox* skybox)
     {
-        if (_info.SkyboxElem == skybox)
-            _info.SkyboxElem = nullptr;
+        if (_info.SkyboxElem != nullptr && _info.SkyboxElem->SkyboxPtr == skybox)
+            ClearSkybox();
     }
 
     void RendererScene::ClearSkybox()
     {
+        if (_info.SkyboxElem != nullptr)
+            te_delete(_info.SkyboxElem);
+
         _info.SkyboxElem = nullptr;
     }
 
@@ -629,9 +659,9 @@ namespace te
     {
         if(_info.SkyboxElem != nullptr && enabled)
         {
-            gPerFrameParamDef.gSkyboxBrightness.Set(_info.PerFrameParamBuffer, _info.SkyboxElem->GetBrightness());
-            gPerFrameParamDef.gUseSkyboxMap.Set(_info.PerFrameParamBuffer, _info.SkyboxElem->GetTexture() ? 1 : 0);
-            gPerFrameParamDef.gUseSkyboxIrradianceMap.Set(_info.PerFrameParamBuffer, _info.SkyboxElem->GetIrradiance() ? 1 : 0);
+            gPerFrameParamDef.gSkyboxBrightness.Set(_info.PerFrameParamBuffer, _info.SkyboxElem->Brightness);
+            gPerFrameParamDef.gUseSkyboxMap.Set(_info.PerFrameParamBuffer, _info.SkyboxElem->Radiance ? 1 : 0);
+            gPerFrameParamDef.gUseSkyboxIrradianceMap.Set(_info.PerFrameParamBuffer, _info.SkyboxElem->Irradiance ? 1 : 0);
         }
         else
         {
@@ -646,7 +676,7 @@ namespace te
         RendererRenderable* rendererRenderable = _info.Renderables[idx];
 
         if (frameInfo.PerFrameDatas.Animation != nullptr)
-            rendererRenderable->RenderablePtr->UpdatePrevFrameAnimationBuffers();
+            rendererRenderable->UpdatePrevFrameAnimationBuffers();
 
         if (rendererRenderable->PreviousFrameDirtyState != PrevFrameDirtyState::Clean)
         {
@@ -656,11 +686,16 @@ namespace te
             {
                 rendererRenderable->PrevWorldTfrm = _info.Renderables[idx]->WorldTfrm;
                 rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
-                rendererRenderable->UpdatePerObjectBuffer();
+                rendererRenderable->UpdatePerObjectBuffer(_info.ObjectData);
             }
         }
     }
 
+    void RendererScene::UpdateSubMeshBounds()
+    {
+        _info.SubMeshBounds.Update(_info.Renderables);
+    }
+
     void RendererScene::PrepareVisibleRenderable(UINT32 idx, const FrameInfo& frameInfo)
     {
         if (_info.RenderableReady[idx])
@@ -669,7 +704,7 @@ namespace te
         RendererRenderable* rendererRenderable = _info.Renderables[idx];
 
         if(frameInfo.PerFrameDatas.Animation != nullptr)
-            rendererRenderable->RenderablePtr->UpdateAnimationBuffers(*frameInfo.PerFrameDatas.Animation);
+            rendererRenderable->UpdateAnimationBuffers(*frameInfo.PerFrameDatas.Animation);
 
         _info.RenderableReady[idx] = true;
     }
@@ -2,11 +2,22 @@
 
 #include "TeRenderManPrerequisites.h"
 #include "TeRendererView.h"
+#include "TeRendererObjectBuffer.h"
+#include "TeRendererSubMeshBounds.h"
 
 namespace te
 {
     struct FrameInfo;
 
+    /** Copy of the properties of the scene skybox, taken when it is registered. */
+    struct RendererSkybox
+    {
+        Skybox* SkyboxPtr = nullptr;
+        SPtr<Texture> Radiance;
+        SPtr<Texture> Irradiance;
+        float Brightness = 1.0f;
+    };
+
     /** Contains most scene objects relevant to the renderer. */
     struct SceneInfo
     {
@@ -19,6 +30,8 @@ namespace te
         Vector<RendererRenderable*> Renderables;
         Vector<RendererRenderable*> RenderablesInstanced;
         Vector<CullInfo> RenderableCullInfos;
+        ObjectDataBuffer ObjectData; // Per renderer id
+        SubMeshBoundsArray SubMeshBounds; // World bounds of render elements
 
         // Lights
         Vector<RendererLight> DirectionalLights;
@@ -32,7 +45,7 @@ namespace te
         Vector<CullInfo> DecalCullInfos;
 
         // Sky
-        Skybox* SkyboxElem = nullptr;
+        RendererSkybox* SkyboxElem = nullptr;
 
         // FrameBuffer data
         SPtr<GpuParamBlockBuffer> PerFrameParamBuffer;
@@ -138,6 +151,12 @@ namespace te
          */
         void PrepareRenderable(UINT32 idx, const FrameInfo& frameInfo);
 
+        /** 
+         * Transforms the sub-mesh bounds of renderables updated since the last call. Must be called once per frame, before
+         * views queue their render elements.
+         */
+        void UpdateSubMeshBounds();
+
         /**
          * Performs necessary steps to make a renderable ready for rendering. This must be called at least once every frame
          * for every renderable that will be drawn. Multiple calls for the same renderable during a single frame will result
@@ -0,0 +1,1008 @@
+#include "TeRendererShadowRendering.h"
+#include "TeRendererLight.h"
+#include "TeRendererLightGrid.h"
+#include "TeRendererView.h"
+#include "TeRendererScene.h"
+#include "TeRenderManOptions.h"
+#include "TeRenderMan.h"
+#include "TeShadowDepthMat.h"
+#include "Renderer/TeRenderable.h"
+#include "Renderer/TeRendererUtility.h"
+#include "Renderer/TeGpuResourcePool.h"
+#include "RenderAPI/TeRenderAPI.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "RenderAPI/TeGpuParams.h"
+#include "RenderAPI/TeSamplerState.h"
+#include "Utility/TeBitwise.h"
+#include "Math/TeMath.h"
+
+namespace te
+{
+    PerShadowsParamDef gPerShadowsParamDef;
+
+    namespace
+    {
+        /** Number of float4 written per shadow map in the shadows buffer, SHADOW_DATA_STRIDE in shaders. */
+        const UINT32 SHADOW_DATA_STRIDE = 6;
+
+        /** Largest atlas, in pixels. */
+        const UINT32 MAX_ATLAS_SIZE = 8192;
+
+        /** Ratio of the largest shadow map to the smallest one. */
+        const UINT32 SHADOW_MAP_SIZE_RANGE = 16;
+
+        /** Smallest shadow map, in pixels. */
+        const UINT32 MIN_SHADOW_MAP_SIZE = 16;
+
+        /** Frames after which the cascades of a view that isn't rendered anymore are released. */
+        const UINT64 CASCADE_EXPIRATION_FRAMES = 120;
+
+        /** Ratio of the near plane to the range of perspective shadow maps. */
+        const float NEAR_PLANE_RATIO = 0.001f;
+
+        /** Smallest near plane distance of perspective shadow maps. */
+        const float MIN_NEAR_PLANE = 0.01f;
+
+        /** Angle added to spot lights, so their shadow map still covers pixels filtered on the edge of the cone. */
+        const Degree SPOT_ANGLE_MARGIN = Degree(5.0f);
+
+        /** Widest angle covered by the shadow map of a spot light. */
+        const Degree MAX_SPOT_ANGLE = Degree(170.0f);
+
+        /** Offset along the normal of sampled positions, in texels, per unit of light shadow bias. */
+        const float NORMAL_OFFSET_SCALE = 2.0f;
+
+        /** Cascade radiuses are rounded up to this step, so they don't change when the camera rotates. */
+        const float CASCADE_RADIUS_STEP = 1.0f / 16.0f;
+
+        /** Faces of the shadow maps of radial lights, in the order shaders expect them. */
+        const Vector3 CUBE_FACE_DIRECTIONS[6] =
+        {
+            Vector3(1.0f, 0.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f),
+            Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f),
+            Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f)
+        };
+    }
+
+    ShadowMapAtlas::ShadowMapAtlas(UINT32 size, UINT32 minSize)
+        : _size(size)
+        , _numLevels(0)
+    {
+        if (_size == 0)
+            return;
+
+        for (UINT32 levelSize = _size; levelSize >= std::max(minSize, 1U); levelSize /= 2)
+            _numLevels++;
+
+        _freeBlocks.resize(_numLevels);
+        _freeBlocks[0].push_back(Vector2I(0, 0));
+    }
+
+    bool ShadowMapAtlas::Allocate(UINT32 size, Rect2I& area)
+    {
+        if (_numLevels == 0 || size > _size)
+            return false;
+
+        const UINT32 level = GetLevel(size);
+
+        // Find the smallest free block that is at least as big as requested, and split it down to the requested size
+        INT32 freeLevel = (INT32)level;
+        while (freeLevel >= 0 && _freeBlocks[freeLevel].empty())
+            freeLevel--;
+
+        if (freeLevel < 0)
+            return false;
+
+        for (UINT32 i = (UINT32)freeLevel; i < level; i++)
+        {
+            const Vector2I block = _freeBlocks[i].back();
+            _freeBlocks[i].pop_back();
+
+            const INT32 childSize = (INT32)(_size >> (i + 1));
+            _freeBlocks[i + 1].push_back(Vector2I(block.x + childSize, block.y + childSize));
+            _freeBlocks[i + 1].push_back(Vector2I(block.x, block.y + childSize));
+            _freeBlocks[i + 1].push_back(Vector2I(block.x + childSize, block.y));
+            _freeBlocks[i + 1].push_back(block);
+        }
+
+        const Vector2I block = _freeBlocks[level].back();
+        _freeBlocks[level].pop_back();
+
+        const UINT32 blockSize = _size >> level;
+        area = Rect2I(block.x, block.y, blockSize, blockSize);
+        return true;
+    }
+
+    void ShadowMapAtlas::Free(const Rect2I& area)
+    {
+        if (_numLevels == 0)
+            return;
+
+        UINT32 level = GetLevel(area.width);
+        Vector2I block(area.x, area.y);
+
+        // Merge the block with its siblings as long as they are all free
+        while (level > 0)
+        {
+            const INT32 parentSize = (INT32)(_size >> (level - 1));
+            const Vector2I parent(block.x - block.x % parentSize, block.y - block.y % parentSize);
+
+            Vector<Vector2I>& freeBlocks = _freeBlocks[level];
+            UINT32 siblingIndices[3];
+            UINT32 numSiblings = 0;
+
+            for (UINT32 i = 0; i < (UINT32)freeBlocks.size() && numSiblings < 3; i++)
+            {
+                const Vector2I& other = freeBlocks[i];
+                if (other.x - other.x % parentSize == parent.x && other.y - other.y % parentSize == parent.y)
+                    siblingIndices[numSiblings++] = i;
+            }
+
+            if (numSiblings < 3)
+                break;
+
+            // Remove from the back, so indices stay valid
+            for (INT32 i = 2; i >= 0; i--)
+            {
+                freeBlocks[siblingIndices[i]] = freeBlocks.back();
+                freeBlocks.pop_back();
+            }
+
+            block = parent;
+            level--;
+        }
+
+        _freeBlocks[level].push_back(block);
+    }
+
+    UINT32 ShadowMapAtlas::GetLevel(UINT32 size) const
+    {
+        UINT32 level = 0;
+        while (level + 1 < _numLevels && (_size >> (level + 1)) >= size)
+            level++;
+
+        return level;
+    }
+
+    ViewShadows::~ViewShadows()
+    {
+        if (_paramBuffer)
+            _paramBuffer->Destroy();
+    }
+
+    void ViewShadows::Bind(const SPtr<GpuParams>& params) const
+    {
+        if (!_paramBuffer)
+            return;
+
+        params->SetParamBlockBuffer("PerShadowsBuffer", _paramBuffer);
+
+        if (params->HasBuffer(GPT_PIXEL_PROGRAM, "ShadowsBuffer"))
+            params->SetBuffer(GPT_PIXEL_PROGRAM, "ShadowsBuffer", _shadowsBuffer);
+
+        if (_atlas && params->HasTexture(GPT_PIXEL_PROGRAM, "ShadowAtlas"))
+            params->SetTexture(GPT_PIXEL_PROGRAM, "ShadowAtlas", _atlas);
+
+        if (_staticAtlas && params->HasTexture(GPT_PIXEL_PROGRAM, "StaticShadowAtlas"))
+            params->SetTexture(GPT_PIXEL_PROGRAM, "StaticShadowAtlas", _staticAtlas);
+
+        if (params->HasSamplerState(GPT_PIXEL_PROGRAM, "ShadowSampler"))
+            params->SetSamplerState(GPT_PIXEL_PROGRAM, "ShadowSampler", _sampler);
+    }
+
+    ShadowRendering::ShadowRendering(const SPtr<RenderManOptions>& options)
+    {
+        SetOptions(options);
+    }
+
+    void ShadowRendering::SetOptions(const SPtr<RenderManOptions>& options)
+    {
+        _options = options;
+    }
+
+    void ShadowRendering::NotifyRenderableAdded(const RendererRenderable* renderable, const AABox& bounds)
+    {
+        _castersDirty = true;
+
+        if (renderable->Properties.CastShadows)
+            _changes.push_back({ bounds, 1U << GetCasterLayer(renderable) });
+    }
+
+    void ShadowRendering::NotifyRenderableUpdated(const RendererRenderable* renderable, const AABox& oldBounds,
+        const AABox& newBounds)
+    {
+        const UINT32 dirtyFlags = renderable->RenderablePtr->GetCoreDirtyFlags();
+        const UINT32 structuralFlags = (UINT32)ActorDirtyFlag::Mobility | (UINT32)ActorDirtyFlag::Active |
+            (UINT32)ActorDirtyFlag::Everything;
+
+        // The caster may have moved to the other layer, or stopped casting shadows
+        UINT32 layerMask = 1U << GetCasterLayer(renderable);
+        if (dirtyFlags & structuralFlags)
+        {
+            layerMask = (1U << StaticLayer) | (1U << DynamicLayer);
+            _castersDirty = true;
+        }
+        else if (!renderable->Properties.CastShadows)
+            return;
+        else if (GetCasterLayer(renderable) == StaticLayer)
+            _castersDirty = true;
+
+        _changes.push_back({ oldBounds, layerMask });
+        _changes.push_back({ newBounds, layerMask });
+    }
+
+    void ShadowRendering::NotifyRenderableRemoved(const RendererRenderable* renderable, const AABox& bounds)
+    {
+        _castersDirty = true;
+
+        if (renderable->Properties.CastShadows)
+            _changes.push_back({ bounds, 1U << GetCasterLayer(renderable) });
+    }
+
+    void ShadowRendering::NotifyRenderablesCleared()
+    {
+        _castersDirty = true;
+        _changes.clear();
+
+        for (auto& entry : _lightShadows)
+        {
+            for (UINT32 i = 0; i < entry.second.NumFaces; i++)
+                entry.second.Faces[i].Dirty[StaticLayer] = entry.second.Faces[i].Dirty[DynamicLayer] = true;
+        }
+
+        for (auto& entry : _cascadeShadows)
+        {
+            for (UINT32 i = 0; i < entry.second.NumCascades; i++)
+                entry.second.Cascades[i].Dirty[StaticLayer] = entry.second.Cascades[i].Dirty[DynamicLayer] = true;
+        }
+    }
+
+    void ShadowRendering::NotifyLightRemoved(const Light* light)
+    {
+        auto iter = _lightShadows.find(light);
+        if (iter != _lightShadows.end())
+            RemoveLightShadows(iter);
+
+        for (auto cascadeIter = _cascadeShadows.begin(); cascadeIter != _cascadeShadows.end();)
+        {
+            auto current = cascadeIter++;
+            if (current->first.second == light)
+                RemoveCascades(current);
+        }
+    }
+
+    void ShadowRendering::NotifyLightsCleared()
+    {
+        _lightShadows.clear();
+        _cascadeShadows.clear();
+        _allocator = ShadowMapAtlas(_atlasSize, _minSize);
+    }
+
+    SPtr<Texture> ShadowRendering::GetAtlas() const
+    {
+        return _atlases[DynamicLayer] ? _atlases[DynamicLayer]->Tex : nullptr;
+    }
+
+    SPtr<Texture> ShadowRendering::GetStaticAtlas() const
+    {
+        return _atlases[StaticLayer] ? _atlases[StaticLayer]->Tex : nullptr;
+    }
+
+    void ShadowRendering::RenderShadowMaps(RendererScene& scene, RendererViewGroup& viewGroup, const FrameInfo& frameInfo)
+    {
+        const SceneInfo& sceneInfo = scene.GetSceneInfo();
+        VisibleLightData& lightData = viewGroup.GetVisibleLightData();
+        const UINT32 numViews = viewGroup.GetNumViews();
+
+        _frameIdx = frameInfo.Timings.FrameIdx;
+        _numRenderedLayers = 0;
+        _shadowData.clear();
+
+        bool anyShadows = false;
+        for (UINT32 i = 0; i < numViews; i++)
+        {
+            const RendererView* view = viewGroup.GetView(i);
+            const RenderSettings& settings = view->GetRenderSettings();
+
+            if (view->ShouldDraw3D() && settings.EnableShadows && settings.EnableLighting)
+                anyShadows = true;
+        }
+
+        const UINT32 numShadowedLights = lightData.GetNumShadowedLights(LightType::Directional) +
+            lightData.GetNumShadowedLights(LightType::Radial) + lightData.GetNumShadowedLights(LightType::Spot);
+
+        if (anyShadows && numShadowedLights > 0)
+        {
+            CreateAtlases();
+            UpdateCasters(sceneInfo);
+
+            // Animated casters change every frame
+            for (UINT32 casterIdx : _dynamicCasters)
+            {
+                if (sceneInfo.Renderables[casterIdx]->IsAnimated())
+                    _changes.push_back({ sceneInfo.RenderableCullInfos[casterIdx].Boundaries.GetBox(), 1U << DynamicLayer });
+            }
+
+            ApplyChanges();
+
+            // Cascades of views that aren't rendered anymore
+            for (auto iter = _cascadeShadows.begin(); iter != _cascadeShadows.end();)
+            {
+                auto current = iter++;
+                if (current->second.LastUsedFrame + CASCADE_EXPIRATION_FRAMES < _frameIdx)
+                    RemoveCascades(current);
+            }
+
+            // Cascades first, they matter most and only depend on the view
+            const UINT32 numDirLights = lightData.GetNumDirLights();
+            const UINT32 firstShadowedDirLight = lightData.GetNumUnshadowedLights(LightType::Directional);
+            const Vector<const RendererLight*>& dirLights = lightData.GetLights(LightType::Directional);
+
+            for (UINT32 i = 0; i < numViews; i++)
+            {
+                const RendererView& view = *viewGroup.GetView(i);
+                const RenderSettings& settings = view.GetRenderSettings();
+
+                if (!view.ShouldDraw3D() || !settings.EnableShadows || !settings.EnableLighting)
+                    continue;
+
+                for (UINT32 j = firstShadowedDirLight; j < numDirLights; j++)
+                {
+                    CascadeShadows* cascades = UpdateCascades(view, dirLights[j]);
+                    if (cascades == nullptr)
+                        continue;
+
+                    for (UINT32 k = 0; k < cascades->NumCascades; k++)
+                        RenderShadowMap(scene, cascades->Cascades[k], frameInfo);
+                }
+            }
+
+            for (UINT32 j = firstShadowedDirLight; j < numDirLights; j++)
+                lightData.SetShadowIndex(j, (INT32)(j - firstShadowedDirLight));
+
+            // Spot and radial lights
+            UINT32 lightIdx = numDirLights;
+            for (LightType type : { LightType::Radial, LightType::Spot })
+            {
+                const Vector<const RendererLight*>& lights = lightData.GetLights(type);
+                const UINT32 numLights = lightData.GetNumLights(type);
+                const UINT32 firstShadowed = lightData.GetNumUnshadowedLights(type);
+
+                for (UINT32 j = firstShadowed; j < numLights; j++)
+                {
+                    const RendererLight* light = lights[j];
+
+                    LightShadows* shadows = UpdateLightShadows(light, GetLocalLightSize(light, viewGroup));
+                    if (shadows == nullptr)
+                        continue;
+
+                    lightData.SetShadowIndex(lightIdx + j, (INT32)(_shadowData.size() / SHADOW_DATA_STRIDE));
+
+                    for (UINT32 k = 0; k < shadows->NumFaces; k++)
+                    {
+                        RenderShadowMap(scene, shadows->Faces[k], frameInfo);
+                        WriteShadowData(shadows->Faces[k], light->GetShadowBias(), 0.0f, _shadowData);
+                    }
+                }
+
+                lightIdx += numLights;
+            }
+
+            RenderAPI& rapi = RenderAPI::Instance();
+            rapi.SetRenderTarget(nullptr);
+            rapi.SetViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
+        }
+        else
+        {
+            // Nothing to render, but changes still need to reach cached shadow maps
+            ApplyChanges();
+        }
+
+        if (_sampler == nullptr)
+        {
+            SAMPLER_STATE_DESC samplerDesc;
+            samplerDesc.AddressMode.u = samplerDesc.AddressMode.v = samplerDesc.AddressMode.w = TAM_CLAMP;
+            samplerDesc.MinFilter = samplerDesc.MagFilter = FO_LINEAR;
+            samplerDesc.MipFilter = FO_POINT;
+            samplerDesc.ComparisonFunc = CMPF_LESS_EQUAL;
+
+            _sampler = SamplerState::Create(samplerDesc);
+        }
+
+        // Upload the shadow maps of each view: local lights are shared, cascades follow
+        const UINT32 numDirLights = lightData.GetNumDirLights();
+        const UINT32 firstShadowedDirLight = lightData.GetNumUnshadowedLights(LightType::Directional);
+        const Vector<const RendererLight*>& dirLights = lightData.GetLights(LightType::Directional);
+        const UINT32 numLocalShadows = (UINT32)(_shadowData.size() / SHADOW_DATA_STRIDE);
+
+        for (UINT32 i = 0; i < numViews; i++)
+        {
+            RendererView& view = *viewGroup.GetView(i);
+            const RenderSettings& settings = view.GetRenderSettings();
+            ViewShadows& viewShadows = view.GetShadows();
+
+            const bool enabled = anyShadows && numShadowedLights > 0 && view.ShouldDraw3D() &&
+                settings.EnableShadows && settings.EnableLighting;
+            const UINT32 numCascades = Math::Clamp(settings.ShadowSettings.NumCascades, 1U, MAX_CASCADES);
+
+            _viewShadowData = _shadowData;
+
+            if (enabled)
+            {
+                for (UINT32 j = firstShadowedDirLight; j < numDirLights; j++)
+                {
+                    const RendererLight* light = dirLights[j];
+                    auto iter = _cascadeShadows.find(std::make_pair((const RendererView*)&view, (const Light*)light->_internal));
+
+                    for (UINT32 k = 0; k < numCascades; k++)
+                    {
+                        if (iter != _cascadeShadows.end() && k < iter->second.NumCascades)
+                        {
+                            WriteShadowData(iter->second.Cascades[k], light->GetShadowBias(), iter->second.SplitDepths[k],
+                                _viewShadowData);
+                        }
+                        else
+                            _viewShadowData.resize(_viewShadowData.size() + SHADOW_DATA_STRIDE, Vector4::ZERO);
+                    }
+                }
+            }
+
+            if (viewShadows._paramBuffer == nullptr)
+                viewShadows._paramBuffer = gPerShadowsParamDef.CreateBuffer();
+
+            const UINT32 numElements = (UINT32)_viewShadowData.size();
+            LightGrid::Reserve(viewShadows._shadowsBuffer, std::max(numElements, SHADOW_DATA_STRIDE), BF_32X4F);
+            if (numElements > 0)
+            {
+                viewShadows._shadowsBuffer->WriteData(0, numElements * sizeof(Vector4), _viewShadowData.data(),
+                    BWT_DISCARD);
+            }
+
+            const float atlasSize = (float)std::max(_atlasSize, 1U);
+            gPerShadowsParamDef.gShadowAtlasSize.Set(viewShadows._paramBuffer,
+                Vector4(atlasSize, atlasSize, 1.0f / atlasSize, 1.0f / atlasSize));
+            gPerShadowsParamDef.gCascadeOffset.Set(viewShadows._paramBuffer, (INT32)numLocalShadows);
+            gPerShadowsParamDef.gNumCascades.Set(viewShadows._paramBuffer, (INT32)numCascades);
+            gPerShadowsParamDef.gShadowFilterQuality.Set(viewShadows._paramBuffer,
+                (INT32)settings.ShadowSettings.ShadowFilteringQuality);
+            gPerShadowsParamDef.gShadowsEnabled.Set(viewShadows._paramBuffer, enabled ? 1 : 0);
+
+            viewShadows._atlas = GetAtlas();
+            viewShadows._staticAtlas = GetStaticAtlas();
+            viewShadows._sampler = _sampler;
+        }
+    }
+
+    void ShadowRendering::CreateAtlases()
+    {
+        const UINT32 maxSize = std::min(Bitwise::NextPow2(std::max(_options->ShadowMapSize, MIN_SHADOW_MAP_SIZE)),
+            MAX_ATLAS_SIZE / 2);
+        const UINT32 atlasSize = maxSize * 2;
+
+        if (atlasSize != _atlasSize)
+        {
+            _atlasSize = atlasSize;
+            _maxSize = maxSize;
+            _minSize = std::max(maxSize / SHADOW_MAP_SIZE_RANGE, MIN_SHADOW_MAP_SIZE);
+
+            _lightShadows.clear();
+            _cascadeShadows.clear();
+            _allocator = ShadowMapAtlas(_atlasSize, _minSize);
+
+            for (UINT32 i = 0; i < LayerCount; i++)
+                _atlases[i] = nullptr;
+        }
+
+        for (UINT32 i = 0; i < LayerCount; i++)
+        {
+            if (_atlases[i] == nullptr)
+            {
+                _atlases[i] = gGpuResourcePool().Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32, _atlasSize, _atlasSize,
+                    TU_DEPTHSTENCIL));
+            }
+        }
+    }
+
+    void ShadowRendering::UpdateCasters(const SceneInfo& sceneInfo)
+    {
+        if (!_castersDirty)
+            return;
+
+        _castersDirty = false;
+        _staticCasters.clear();
+        _dynamicCasters.clear();
+
+        Vector<AABox> staticBounds;
+        for (UINT32 i = 0; i < (UINT32)sceneInfo.Renderables.size(); i++)
+        {
+            const RendererRenderable* renderable = sceneInfo.Renderables[i];
+            if (!renderable->Properties.CastShadows)
+                continue;
+
+            if (GetCasterLayer(renderable) == StaticLayer)
+            {
+                _staticCasters.push_back(i);
+                staticBounds.push_back(sceneInfo.RenderableCullInfos[i].Boundaries.GetBox());
+            }
+            else
+                _dynamicCasters.push_back(i);
+        }
+
+        _staticHierarchy.Build(staticBounds);
+    }
+
+    void ShadowRendering::ApplyChanges()
+    {
+        if (_changes.empty())
+            return;
+
+        auto apply = [this](ShadowMap& shadowMap)
+        {
+            for (const CasterChange& change : _changes)
+            {
+                for (UINT32 layer = 0; layer < LayerCount; layer++)
+                {
+                    if ((change.LayerMask & (1U << layer)) && !shadowMap.Dirty[layer] &&
+                        shadowMap.Volume.Intersects(change.Bounds))
+                    {
+                        shadowMap.Dirty[layer] = true;
+                    }
+                }
+            }
+        };
+
+        for (auto& entry : _lightShadows)
+        {
+            for (UINT32 i = 0; i < entry.second.NumFaces; i++)
+                apply(entry.second.Faces[i]);
+        }
+
+        for (auto& entry : _cascadeShadows)
+        {
+            for (UINT32 i = 0; i < entry.second.NumCascades; i++)
+                apply(entry.second.Cascades[i]);
+        }
+
+        _changes.clear();
+    }
+
+    bool ShadowRendering::Allocate(UINT32 size, Rect2I& area)
+    {
+        while (!_allocator.Allocate(size, area))
+        {
+            // Evict the least recently used shadow maps, as long as they weren't used this frame
+            auto oldestLight = _lightShadows.end();
+            auto oldestCascades = _cascadeShadows.end();
+            UINT64 oldestFrame = _frameIdx;
+
+            for (auto iter = _lightShadows.begin(); iter != _lightShadows.end(); ++iter)
+            {
+                if (iter->second.LastUsedFrame < oldestFrame)
+                {
+                    oldestFrame = iter->second.LastUsedFrame;
+                    oldestLight = iter;
+                }
+            }
+
+            for (auto iter = _cascadeShadows.begin(); iter != _cascadeShadows.end(); ++iter)
+            {
+                if (iter->second.LastUsedFrame < oldestFrame)
+                {
+                    oldestFrame = iter->second.LastUsedFrame;
+                    oldestCascades = iter;
+                    oldestLight = _lightShadows.end();
+                }
+            }
+
+            if (oldestCascades != _cascadeShadows.end())
+                RemoveCascades(oldestCascades);
+            else if (oldestLight != _lightShadows.end())
+                RemoveLightShadows(oldestLight);
+            else
+                return false;
+        }
+
+        return true;
+    }
+
+    void ShadowRendering::RemoveLightShadows(UnorderedMap<const Light*, LightShadows>::iterator iter)
+    {
+        for (UINT32 i = 0; i < iter->second.NumFaces; i++)
+            _allocator.Free(iter->second.Faces[i].Area);
+
+        _lightShadows.erase(iter);
+    }
+
+    void ShadowRendering::RemoveCascades(Map<std::pair<const RendererView*, const Light*>, CascadeShadows>::iterator iter)
+    {
+        for (UINT32 i = 0; i < iter->second.NumCascades; i++)
+            _allocator.Free(iter->second.Cascades[i].Area);
+
+        _cascadeShadows.erase(iter);
+    }
+
+    ShadowRendering::LightShadows* ShadowRendering::UpdateLightShadows(const RendererLight* light, UINT32 size)
+    {
+        const bool radial = light->GetType() == LightType::Radial;
+        const UINT32 numFaces = radial ? 6 : 1;
+
+        // Keep the current shadow maps unless they are too small, or much bigger than needed
+        auto iter = _lightShadows.find(light->_internal);
+        if (iter != _lightShadows.end())
+        {
+            const LightShadows& current = iter->second;
+            if (current.NumFaces != numFaces || size > current.Size || (size * 4 <= current.Size && current.Size > _minSize))
+            {
+                RemoveLightShadows(iter);
+                iter = _lightShadows.end();
+            }
+        }
+
+        if (iter == _lightShadows.end())
+        {
+            LightShadows shadows;
+            shadows.NumFaces = numFaces;
+            shadows.LastUsedFrame = _frameIdx;
+
+            // Fall back to smaller shadow maps while the atlas is full
+            for (UINT32 faceSize = size; faceSize >= _minSize && shadows.Size == 0; faceSize /= 2)
+            {
+                UINT32 numAllocated = 0;
+                for (; numAllocated < numFaces; numAllocated++)
+                {
+                    if (!Allocate(faceSize, shadows.Faces[numAllocated].Area))
+                        break;
+                }
+
+                if (numAllocated == numFaces)
+                    shadows.Size = faceSize;
+                else
+                {
+                    for (UINT32 i = 0; i < numAllocated; i++)
+                        _allocator.Free(shadows.Faces[i].Area);
+                }
+            }
+
+            if (shadows.Size == 0)
+                return nullptr;
+
+            iter = _lightShadows.insert(std::make_pair((const Light*)light->_internal, shadows)).first;
+        }
+
+        LightShadows& shadows = iter->second;
+        shadows.LastUsedFrame = _frameIdx;
+
+        const Transform& transform = light->GetTransform();
+        const Vector3 position = transform.GetPosition();
+        const Sphere& bounds = light->GetBounds();
+
+        float range = bounds.GetRadius();
+        Degree fov = Degree(90.0f);
+
+        if (!radial)
+        {
+            range += position.Distance(bounds.GetCenter());
+            fov = std::min(light->GetSpotAngle() + SPOT_ANGLE_MARGIN, MAX_SPOT_ANGLE);
+        }
+
+        const float farPlane = std::max(range, MIN_NEAR_PLANE * 2.0f);
+        const float nearPlane = std::max(farPlane * NEAR_PLANE_RATIO, MIN_NEAR_PLANE);
+        const Matrix4 proj = Matrix4::ProjectionPerspective(fov, 1.0f, nearPlane, farPlane);
+        const float texelSize = 2.0f * Math::Tan(Radian(fov) * 0.5f) / shadows.Size;
+
+        for (UINT32 i = 0; i < numFaces; i++)
+        {
+            Quaternion rotation = transform.GetRotation();
+            if (radial)
+            {
+                const Vector3& direction = CUBE_FACE_DIRECTIONS[i];
+                rotation.LookRotation(direction, Math::Abs(direction.y) > 0.5f ? Vector3::UNIT_Z : Vector3::UNIT_Y);
+            }
+
+            SetMatrices(shadows.Faces[i], Matrix4::View(position, rotation), proj, true, texelSize);
+        }
+
+        return &shadows;
+    }
+
+    ShadowRendering::CascadeShadows* ShadowRendering::UpdateCascades(const RendererView& view, const RendererLight* light)
+    {
+        const RendererViewProperties& properties = view.GetProperties();
+        const ShadowsSettings& settings = view.GetRenderSettings().ShadowSettings;
+        const bool perspective = properties.ProjType == ProjectionType::PT_PERSPECTIVE;
+
+        const UINT32 numCascades = Math::Clamp(settings.NumCascades, 1U, MAX_CASCADES);
+        const UINT32 size = std::max(_maxSize / 2, _minSize);
+
+        float nearPlane = std::max(properties.NearPlane, perspective ? MIN_NEAR_PLANE : properties.NearPlane);
+        float farPlane = settings.DirectionalShadowDistance;
+        if (properties.FarPlane > nearPlane)
+            farPlane = std::min(farPlane, properties.FarPlane);
+
+        if (farPlane <= nearPlane)
+            return nullptr;
+
+        CascadeShadows& cascades = _cascadeShadows[std::make_pair(&view, (const Light*)light->_internal)];
+        cascades.LastUsedFrame = _frameIdx;
+
+        if (cascades.Size != size || cascades.NumCascades != numCascades)
+        {
+            for (UINT32 i = 0; i < cascades.NumCascades; i++)
+                _allocator.Free(cascades.Cascades[i].Area);
+
+            cascades = CascadeShadows();
+            cascades.LastUsedFrame = _frameIdx;
+
+            UINT32 numAllocated = 0;
+            for (; numAllocated < numCascades; numAllocated++)
+            {
+                if (!Allocate(size, cascades.Cascades[numAllocated].Area))
+                    break;
+            }
+
+            if (numAllocated < numCascades)
+            {
+                for (UINT32 i = 0; i < numAllocated; i++)
+                    _allocator.Free(cascades.Cascades[i].Area);
+
+                _cascadeShadows.erase(std::make_pair(&view, (const Light*)light->_internal));
+                return nullptr;
+            }
+
+            cascades.Size = size;
+            cascades.NumCascades = numCascades;
+        }
+
+        // Splits grow geometrically with the distribution exponent, or linearly if it is one
+        const float exponent = std::max(settings.CascadeDistributionExponent, 1.0f);
+        auto getSplitDepth = [&](UINT32 split)
+        {
+            const float t = exponent > 1.0f ?
+                (Math::Pow(exponent, (float)split) - 1.0f) / (Math::Pow(exponent, (float)numCascades) - 1.0f) :
+                split / (float)numCascades;
+
+            return nearPlane + (farPlane - nearPlane) * t;
+        };
+
+        const Matrix4& proj = properties.ProjTransformNoAA;
+        const Matrix4 invView = properties.ViewTransform.InverseAffine();
+
+        // View space position of a NDC coordinate, at the provided depth
+        auto unproject = [&](float ndcX, float ndcY, float depth)
+        {
+            if (perspective)
+                return Vector3(depth * (ndcX + proj[0][2]) / proj[0][0], depth * (ndcY + proj[1][2]) / proj[1][1], -depth);
+
+            return Vector3((ndcX - proj[0][3]) / proj[0][0], (ndcY - proj[1][3]) / proj[1][1], -depth);
+        };
+
+        const Quaternion& lightRotation = light->GetTransform().GetRotation();
+        const Matrix4 lightView = Matrix4::View(Vector3::ZERO, lightRotation);
+
+        // Depth range of static casters along the light, so casters outside of the cascade still shadow it
+        bool hasCasterBounds = _staticHierarchy.GetNumItems() > 0;
+        float casterMinDepth = 0.0f;
+        if (hasCasterBounds)
+        {
+            const AABox casterBounds = _staticHierarchy.GetBounds();
+            casterMinDepth = std::numeric_limits<float>::max();
+
+            for (UINT32 i = 0; i < 8; i++)
+            {
+                const Vector3 corner = lightView.MultiplyAffine(casterBounds.GetCorner((AABox::Corner)i));
+                casterMinDepth = std::min(casterMinDepth, -corner.z);
+            }
+        }
+
+        for (UINT32 i = 0; i < numCascades; i++)
+        {
+            const float splitNear = getSplitDepth(i);
+            const float splitFar = getSplitDepth(i + 1);
+
+            Vector3 corners[8];
+            Vector3 center = Vector3::ZERO;
+            for (UINT32 j = 0; j < 8; j++)
+            {
+                const float ndcX = (j & 1) ? 1.0f : -1.0f;
+                const float ndcY = (j & 2) ? 1.0f : -1.0f;
+
+                corners[j] = invView.MultiplyAffine(unproject(ndcX, ndcY, (j & 4) ? splitFar : splitNear));
+                center += corners[j];
+            }
+
+            center /= 8.0f;
+
+            float radius = 0.0f;
+            for (UINT32 j = 0; j < 8; j++)
+                radius = std::max(radius, center.Distance(corners[j]));
+
+            radius = std::max(Math::Ceil(radius / CASCADE_RADIUS_STEP) * CASCADE_RADIUS_STEP, CASCADE_RADIUS_STEP);
+
+            // Snap the center to texels, so the cascade doesn't shimmer when the camera moves
+            const float texelSize = 2.0f * radius / cascades.Size;
+            Vector3 lightCenter = lightView.MultiplyAffine(center);
+            lightCenter.x = Math::Floor(lightCenter.x / texelSize) * texelSize;
+            lightCenter.y = Math::Floor(lightCenter.y / texelSize) * texelSize;
+
+            // Same for the depth range, on a coarser step
+            float minDepth = -lightCenter.z - radius;
+            float maxDepth = -lightCenter.z + radius;
+            if (hasCasterBounds)
+                minDepth = std::min(minDepth, casterMinDepth);
+
+            minDepth = Math::Floor(minDepth / radius) * radius;
+            maxDepth = Math::Ceil(maxDepth / radius) * radius;
+
+            // A far plane of zero means an infinite one
+            if (maxDepth == 0.0f)
+                maxDepth = radius;
+
+            const Matrix4 cascadeProj = Matrix4::ProjectionOrthographic(lightCenter.x - radius, lightCenter.x + radius,
+                lightCenter.y + radius, lightCenter.y - radius, minDepth, maxDepth);
+
+            SetMatrices(cascades.Cascades[i], lightView, cascadeProj, false, texelSize);
+            cascades.SplitDepths[i] = splitFar;
+        }
+
+        return &cascades;
+    }
+
+    void ShadowRendering::SetMatrices(ShadowMap& shadowMap, const Matrix4& view, const Matrix4& proj, bool perspective,
+        float texelSize)
+    {
+        const Matrix4 viewProj = proj * view;
+        if (viewProj == shadowMap.ViewProj)
+            return;
+
+        Matrix4 projRS;
+        RenderAPI::Instance().ConvertProjectionMatrix(proj, projRS);
+
+        shadowMap.ViewProj = viewProj;
+        shadowMap.ViewProjRS = projRS * view;
+        shadowMap.Volume = ConvexVolume(viewProj, true);
+        shadowMap.TexelSize = texelSize;
+        shadowMap.Perspective = perspective;
+        shadowMap.Dirty[StaticLayer] = shadowMap.Dirty[DynamicLayer] = true;
+    }
+
+    void ShadowRendering::RenderShadowMap(RendererScene& scene, ShadowMap& shadowMap, const FrameInfo& frameInfo)
+    {
+        const SceneInfo& sceneInfo = scene.GetSceneInfo();
+        RenderAPI& rapi = RenderAPI::Instance();
+
+        for (UINT32 layer = 0; layer < LayerCount; layer++)
+        {
+            if (!shadowMap.Dirty[layer])
+                continue;
+
+            shadowMap.Dirty[layer] = false;
+            _casters.clear();
+
+            auto addCaster = [&](UINT32 casterIdx)
+            {
+                if (shadowMap.Volume.Intersects(sceneInfo.RenderableCullInfos[casterIdx].Boundaries.GetBox()))
+                    _casters.push_back(casterIdx);
+            };
+
+            if (layer == StaticLayer)
+            {
+                _staticHierarchy.Query(
+                    [&](const AABox& box) { return shadowMap.Volume.Intersects(box); },
+                    [&](UINT32 item) { addCaster(_staticCasters[item]); });
+            }
+            else
+            {
+                for (UINT32 casterIdx : _dynamicCasters)
+                    addCaster(casterIdx);
+            }
+
+            shadowMap.HasCasters[layer] = !_casters.empty();
+            if (_casters.empty())
+                continue;
+
+            const float invAtlasSize = 1.0f / _atlasSize;
+            const Rect2I& area = shadowMap.Area;
+
+            rapi.SetRenderTarget(_atlases[layer]->RenderTex);
+            rapi.SetViewport(Rect2(area.x * invAtlasSize, area.y * invAtlasSize, area.width * invAtlasSize,
+                area.height * invAtlasSize));
+
+            ShadowDepthClearMat::Get()->Execute();
+
+            ShadowDepthMat* depthMat = ShadowDepthMat::Get();
+            depthMat->BindShadow(shadowMap.ViewProjRS);
+
+            for (UINT32 casterIdx : _casters)
+            {
+                scene.PrepareVisibleRenderable(casterIdx, frameInfo);
+
+                const RendererRenderable* caster = sceneInfo.Renderables[casterIdx];
+                depthMat->BindRenderable(caster);
+                depthMat->Bind();
+
+                for (const RenderableElement& element : caster->Elements)
+                {
+                    if (element.MeshElem != nullptr && element.SubMeshElem != nullptr)
+                        gRendererUtility().Draw(element.MeshElem, *element.SubMeshElem);
+                }
+            }
+
+            _numRenderedLayers++;
+        }
+    }
+
+    void ShadowRendering::WriteShadowData(const ShadowMap& shadowMap, float shadowBias, float splitDepth,
+        Vector<Vector4>& output) const
+    {
+        static const RenderAPICapabilities& caps = gCaps();
+
+        for (UINT32 i = 0; i < 4; i++)
+        {
+            output.push_back(Vector4(shadowMap.ViewProjRS[i][0], shadowMap.ViewProjRS[i][1], shadowMap.ViewProjRS[i][2],
+                shadowMap.ViewProjRS[i][3]));
+        }
+
+        const float invAtlasSize = 1.0f / _atlasSize;
+        const float halfWidth = shadowMap.Area.width * 0.5f * invAtlasSize;
+        const float halfHeight = shadowMap.Area.height * 0.5f * invAtlasSize;
+
+        Vector4 ndcToUV(halfWidth, -halfHeight, shadowMap.Area.x * invAtlasSize + halfWidth,
+            shadowMap.Area.y * invAtlasSize + halfHeight);
+
+        // Either of these flips the Y axis, but if they're both true they cancel out
+        if ((caps.Convention.UV_YAxis == Conventions::Axis::Up) ^ (caps.Convention.NDC_YAxis == Conventions::Axis::Down))
+            ndcToUV.y = -ndcToUV.y;
+
+        output.push_back(ndcToUV);
+
+        const UINT32 layers = (shadowMap.HasCasters[StaticLayer] ? 1 : 0) | (shadowMap.HasCasters[DynamicLayer] ? 2 : 0);
+        output.push_back(Vector4(shadowBias * shadowMap.TexelSize * NORMAL_OFFSET_SCALE, (float)layers,
+            shadowMap.Perspective ? 1.0f : 0.0f, splitDepth));
+    }
+
+    UINT32 ShadowRendering::GetLocalLightSize(const RendererLight* light, const RendererViewGroup& viewGroup) const
+    {
+        const Sphere& bounds = light->GetBounds();
+        const float radius = bounds.GetRadius();
+        float coverage = 0.0f;
+
+        // Diameter of the light bounds on screen, in pixels, for the view that sees it the biggest
+        for (UINT32 i = 0; i < viewGroup.GetNumViews(); i++)
+        {
+            const RendererView& view = *viewGroup.GetView(i);
+            if (!view.ShouldDraw3D())
+                continue;
+
+            const RendererViewProperties& properties = view.GetProperties();
+            const float scale = properties.ProjTransformNoAA[1][1] * properties.Target.ViewRect.height;
+
+            if (properties.ProjType == ProjectionType::PT_PERSPECTIVE)
+            {
+                const float distance = properties.ViewOrigin.Distance(bounds.GetCenter());
+                if (distance <= radius)
+                    return light->GetType() == LightType::Radial ? _maxSize / 2 : _maxSize;
+
+                coverage = std::max(coverage, radius / Math::Sqrt(distance * distance - radius * radius) * scale);
+            }
+            else
+                coverage = std::max(coverage, radius * scale);
+        }
+
+        UINT32 size = Bitwise::NextPow2((UINT32)std::min(coverage, (float)_maxSize) + 1);
+        size = Math::Clamp(size, _minSize, _maxSize);
+
+        // Each face of a radial light only covers a quarter of its bounds
+        if (light->GetType() == LightType::Radial)
+            size = std::max(size / 2, _minSize);
+
+        return size;
+    }
+
+    ShadowRendering::Layer ShadowRendering::GetCasterLayer(const RendererRenderable* renderable)
+    {
+        if (renderable->Mobility == ObjectMobility::Movable || renderable->IsAnimated())
+            return DynamicLayer;
+
+        return StaticLayer;
+    }
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Renderer/TeLight.h"
+#include "Math/TeBVH.h"
+#include "Math/TeConvexVolume.h"
+#include "Math/TeRect2I.h"
+#include "Math/TeAABox.h"
+
+namespace te
+{
+    class RendererScene;
+    struct PooledRenderTexture;
+
+    TE_PARAM_BLOCK_BEGIN(PerShadowsParamDef)
+        TE_PARAM_BLOCK_ENTRY(Vector4, gShadowAtlasSize)
+        TE_PARAM_BLOCK_ENTRY(INT32, gCascadeOffset)
+        TE_PARAM_BLOCK_ENTRY(INT32, gNumCascades)
+        TE_PARAM_BLOCK_ENTRY(INT32, gShadowFilterQuality)
+        TE_PARAM_BLOCK_ENTRY(INT32, gShadowsEnabled)
+    TE_PARAM_BLOCK_END
+
+    extern PerShadowsParamDef gPerShadowsParamDef;
+
+    /**
+     * Hands out square areas of a square, power of two sized, shadow atlas. Areas are power of two sized too, and are
+     * allocated with a buddy allocator: each free block can be split in four, and four free siblings are merged back
+     * when released.
+     */
+    class ShadowMapAtlas
+    {
+    public:
+        /** Creates an allocator for an atlas of @p size pixels, handing out areas of at least @p minSize pixels. */
+        ShadowMapAtlas(UINT32 size = 0, UINT32 minSize = 1);
+
+        /** Allocates an area of @p size x @p size pixels. Returns false if there is no room left for it. */
+        bool Allocate(UINT32 size, Rect2I& area);
+
+        /** Releases an area returned by Allocate(). */
+        void Free(const Rect2I& area);
+
+        /** Returns the width and height of the atlas, in pixels. */
+        UINT32 GetSize() const { return _size; }
+
+    private:
+        /** Returns the level of blocks of @p size pixels, 0 being the whole atlas. */
+        UINT32 GetLevel(UINT32 size) const;
+
+    private:
+        UINT32 _size;
+        UINT32 _numLevels;
+        Vector<Vector<Vector2I>> _freeBlocks; // Top left corner of the free blocks of each level
+    };
+
+    /**
+     * Shadow maps to sample by the forward pass of a view. Bound next to the light grid, and exposed to shaders through
+     * the PerShadowsBuffer param block, the ShadowsBuffer buffer (SHADOW_DATA_STRIDE float4 per shadow map) and both
+     * layers of the shadow atlas.
+     */
+    class ViewShadows
+    {
+    public:
+        ViewShadows() = default;
+        ~ViewShadows();
+
+        /** Sets the param block, buffer and textures on @p params, for the ones its pixel program uses. */
+        void Bind(const SPtr<GpuParams>& params) const;
+
+        /** Returns the param block describing the shadows of the view. */
+        const SPtr<GpuParamBlockBuffer>& GetParamBuffer() const { return _paramBuffer; }
+
+    private:
+        friend class ShadowRendering;
+
+        SPtr<GpuParamBlockBuffer> _paramBuffer;
+        SPtr<GpuBuffer> _shadowsBuffer;
+        SPtr<Texture> _atlas;
+        SPtr<Texture> _staticAtlas;
+        SPtr<SamplerState> _sampler;
+    };
+
+    /**
+     * Renders the shadow maps of shadowed lights into a shadow atlas, and keeps them from one frame to the next.
+     *
+     * Each shadow map is made of two layers, living at the same place in two atlases: casters that can't move are
+     * rendered in the static layer, the others (and animated ones) in the dynamic layer, and shaders keep the closest
+     * of both. A layer is only rendered again when a caster whose bounds overlap the volume of the shadow map has
+     * changed (or the shadow map itself moved), so shadows of static geometry cost nothing once rendered, and shadows
+     * of moving objects only pay for the dynamic layer. Static casters are found through a bounding volume hierarchy,
+     * rebuilt only when one of them is added, removed or moved.
+     *
+     *  - Spot lights use one perspective shadow map, radial lights one per cube face. Their size is picked from the
+     *    screen coverage of the light bounds, and they are evicted least recently used first when the atlas is full.
+     *  - Directional lights use a set of cascades per view, splitting the view frustum up to the shadow distance.
+     *    Cascades are fitted to the bounding sphere of their part of the frustum, and snapped to their texels, so they
+     *    don't shimmer when the camera moves or rotates, and stay cached while it doesn't.
+     */
+    class ShadowRendering
+    {
+    public:
+        ShadowRendering(const SPtr<RenderManOptions>& options);
+        ~ShadowRendering() = default;
+
+        /** Updates the internal resources according to the newly provided renderer options. */
+        void SetOptions(const SPtr<RenderManOptions>& options);
+
+        /** Records a renderable added to the scene, with bounds @p bounds. */
+        void NotifyRenderableAdded(const RendererRenderable* renderable, const AABox& bounds);
+
+        /**
+         * Records a change of a renderable, from @p oldBounds to @p newBounds. Layers of the shadow maps overlapping any
+         * of them are rendered again.
+         */
+        void NotifyRenderableUpdated(const RendererRenderable* renderable, const AABox& oldBounds, const AABox& newBounds);
+
+        /** Records the removal of a renderable whose bounds were @p bounds. */
+        void NotifyRenderableRemoved(const RendererRenderable* renderable, const AABox& bounds);
+
+        /** Forgets the content of all shadow maps. */
+        void NotifyRenderablesCleared();
+
+        /**
+         * Forgets the shadow maps of a removed light. Changes of a light don't need to be notified, shadow maps are
+         * rendered again whenever their matrices change.
+         */
+        void NotifyLightRemoved(const Light* light);
+
+        /** Forgets the shadow maps of all lights. */
+        void NotifyLightsCleared();
+
+        /**
+         * Renders the shadow maps needed by the views of @p viewGroup, assigns them to the visible lights and uploads
+         * the per view shadow data. Must be called after visibility has been determined for the view group, and before
+         * its views are rendered.
+         */
+        void RenderShadowMaps(RendererScene& scene, RendererViewGroup& viewGroup, const FrameInfo& frameInfo);
+
+        /** Returns the number of shadow map layers rendered by the last call to RenderShadowMaps(). */
+        UINT32 GetNumRenderedLayers() const { return _numRenderedLayers; }
+
+        /** Returns the atlas holding the dynamic layer of all shadow maps. */
+        SPtr<Texture> GetAtlas() const;
+
+        /** Returns the atlas holding the static layer of all shadow maps. */
+        SPtr<Texture> GetStaticAtlas() const;
+
+        /** Layers of a shadow map. */
+        enum Layer
+        {
+            StaticLayer = 0,
+            DynamicLayer = 1,
+            LayerCount = 2
+        };
+
+        static constexpr UINT32 MAX_CASCADES = 6;
+
+    private:
+        /** Single shadow map, an area of both atlases. */
+        struct ShadowMap
+        {
+            Rect2I Area;
+            Matrix4 ViewProj = Matrix4::ZERO; // Standard convention, used for culling
+            Matrix4 ViewProjRS = Matrix4::ZERO; // Converted for the render API, used for rendering and sampling
+            ConvexVolume Volume;
+            float TexelSize = 0.0f; // World size of a texel, at a distance of one from the light if perspective
+            bool Perspective = true;
+            bool Dirty[LayerCount] = { true, true };
+            bool HasCasters[LayerCount] = { false, false };
+        };
+
+        /** Shadow maps of a spot or radial light. */
+        struct LightShadows
+        {
+            UINT32 Size = 0;
+            UINT32 NumFaces = 0;
+            ShadowMap Faces[6];
+            UINT64 LastUsedFrame = 0;
+        };
+
+        /** Cascades of a directional light, for a single view. */
+        struct CascadeShadows
+        {
+            UINT32 Size = 0;
+            UINT32 NumCascades = 0;
+            ShadowMap Cascades[MAX_CASCADES];
+            float SplitDepths[MAX_CASCADES];
+            UINT64 LastUsedFrame = 0;
+        };
+
+        /** Change of a renderable, to be checked against the volume of shadow maps. */
+        struct CasterChange
+        {
+            AABox Bounds;
+            UINT32 LayerMask;
+        };
+
+        /** Creates the atlases, if they don't exist yet or their size changed. */
+        void CreateAtlases();
+
+        /** Sorts shadow casting renderables per layer, and builds the hierarchy of static ones, if the scene changed. */
+        void UpdateCasters(const SceneInfo& sceneInfo);
+
+        /** Marks the layers of the shadow maps touched by the changes recorded since the last frame as dirty. */
+        void ApplyChanges();
+
+        /**
+         * Allocates an area of the atlas of @p size pixels, evicting the least recently used shadow maps not used this
+         * frame if needed. Returns false if there is no room for it.
+         */
+        bool Allocate(UINT32 size, Rect2I& area);
+
+        /** Releases the atlas areas of a light and removes it. */
+        void RemoveLightShadows(UnorderedMap<const Light*, LightShadows>::iterator iter);
+
+        /** Releases the atlas areas of a set of cascades and removes it. */
+        void RemoveCascades(Map<std::pair<const RendererView*, const Light*>, CascadeShadows>::iterator iter);
+
+        /**
+         * Finds or creates the shadow maps of a shadowed spot or radial light, with @p size pixels per face if possible,
+         * and updates their matrices. Returns null if there is no room left for them.
+         */
+        LightShadows* UpdateLightShadows(const RendererLight* light, UINT32 size);
+
+        /**
+         * Finds or creates the cascades of a shadowed directional light for the provided view, and updates their
+         * matrices. Returns null if there is no room left for them.
+         */
+        CascadeShadows* UpdateCascades(const RendererView& view, const RendererLight* light);
+
+        /** Sets the matrices of a shadow map, marking it as dirty if they changed. */
+        static void SetMatrices(ShadowMap& shadowMap, const Matrix4& view, const Matrix4& proj, bool perspective,
+            float texelSize);
+
+        /** Renders the dirty layers of a shadow map. */
+        void RenderShadowMap(RendererScene& scene, ShadowMap& shadowMap, const FrameInfo& frameInfo);
+
+        /** Appends the GPU data of a shadow map to @p output. */
+        void WriteShadowData(const ShadowMap& shadowMap, float shadowBias, float splitDepth,
+            Vector<Vector4>& output) const;
+
+        /** Returns the size of the shadow maps of a local light, from the screen coverage of its bounds. */
+        UINT32 GetLocalLightSize(const RendererLight* light, const RendererViewGroup& viewGroup) const;
+
+        /** Returns the layer a caster is rendered in. */
+        static Layer GetCasterLayer(const RendererRenderable* renderable);
+
+    private:
+        SPtr<RenderManOptions> _options;
+
+        UINT32 _atlasSize = 0;
+        UINT32 _maxSize = 0; // Largest shadow map
+        UINT32 _minSize = 0; // Smallest shadow map
+        ShadowMapAtlas _allocator;
+        SPtr<PooledRenderTexture> _atlases[LayerCount];
+
+        UnorderedMap<const Light*, LightShadows> _lightShadows;
+        Map<std::pair<const RendererView*, const Light*>, CascadeShadows> _cascadeShadows;
+
+        Vector<CasterChange> _changes;
+        bool _castersDirty = true;
+        Vector<UINT32> _staticCasters; // Renderer ids, in the order of the items of _staticHierarchy
+        Vector<UINT32> _dynamicCasters;
+        BVH _staticHierarchy;
+        Vector<UINT32> _casters; // Per shadow map
+
+        UINT64 _frameIdx = 0;
+        UINT32 _numRenderedLayers = 0;
+
+        Vector<Vector4> _shadowData; // Per frame, local lights only
+        Vector<Vector4> _viewShadowData;
+        SPtr<SamplerState> _sampler;
+    };
+}
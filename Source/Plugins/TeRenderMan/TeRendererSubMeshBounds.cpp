@@ -0,0 +1,229 @@
+#include "TeRendererSubMeshBounds.h"
+#include "TeRendererRenderable.h"
+#include "RenderAPI/TeSubMesh.h"
+#include "Math/TeSIMD.h"
+
+namespace te
+{
+    void SubMeshBoundsArray::BoundsArrays::Resize(UINT32 count)
+    {
+        for (UINT32 i = 0; i < 3; i++)
+        {
+            BoxCenter[i].resize(count);
+            BoxHalfSize[i].resize(count);
+            SphereCenter[i].resize(count);
+        }
+
+        SphereRadius.resize(count);
+    }
+
+    void SubMeshBoundsArray::BoundsArrays::Set(UINT32 slot, const Bounds& bounds)
+    {
+        const Vector3 boxCenter = bounds.GetBox().GetCenter();
+        const Vector3 boxHalfSize = bounds.GetBox().GetHalfSize();
+        const Vector3& sphereCenter = bounds.GetSphere().GetCenter();
+
+        for (UINT32 i = 0; i < 3; i++)
+        {
+            BoxCenter[i][slot] = boxCenter[i];
+            BoxHalfSize[i][slot] = boxHalfSize[i];
+            SphereCenter[i][slot] = sphereCenter[i];
+        }
+
+        SphereRadius[slot] = bounds.GetSphere().GetRadius();
+    }
+
+    void SubMeshBoundsArray::MarkDirty(UINT32 renderableIdx)
+    {
+        // Everything is transformed again after a layout change
+        if (_layoutDirty || renderableIdx >= (UINT32)_dirtyFlags.size() || _dirtyFlags[renderableIdx])
+            return;
+
+        _dirtyFlags[renderableIdx] = true;
+        _dirtyRenderables.push_back(renderableIdx);
+    }
+
+    void SubMeshBoundsArray::Update(const Vector<RendererRenderable*>& renderables)
+    {
+        const UINT32 numRenderables = (UINT32)renderables.size();
+        _slotsToTransform.clear();
+
+        if (_layoutDirty)
+        {
+            UINT32 count = 0;
+            _firstSlots.resize(numRenderables);
+
+            for (UINT32 i = 0; i < numRenderables; i++)
+            {
+                _firstSlots[i] = count;
+                count += (UINT32)renderables[i]->Elements.size();
+            }
+
+            _local.Resize(count);
+            _world.Resize(count);
+            _owners.resize(count);
+
+            for (UINT32 i = 0; i < numRenderables; i++)
+            {
+                UINT32 slot = _firstSlots[i];
+                for (auto& element : renderables[i]->Elements)
+                {
+                    _local.Set(slot, (element.SubMeshElem != nullptr) ? element.SubMeshElem->SubMeshBounds : Bounds());
+                    _owners[slot] = i;
+                    _slotsToTransform.push_back(slot);
+                    slot++;
+                }
+            }
+
+            _dirtyFlags.assign(numRenderables, false);
+            _dirtyRenderables.clear();
+            _layoutDirty = false;
+        }
+        else
+        {
+            for (auto renderableIdx : _dirtyRenderables)
+            {
+                _dirtyFlags[renderableIdx] = false;
+
+                const UINT32 firstSlot = _firstSlots[renderableIdx];
+                const UINT32 numSlots = (UINT32)renderables[renderableIdx]->Elements.size();
+
+                for (UINT32 i = 0; i < numSlots; i++)
+                    _slotsToTransform.push_back(firstSlot + i);
+            }
+
+            _dirtyRenderables.clear();
+        }
+
+        if (!_slotsToTransform.empty())
+            Transform(renderables, _slotsToTransform);
+    }
+
+    void SubMeshBoundsArray::Transform(const Vector<RendererRenderable*>& renderables, const Vector<UINT32>& slots)
+    {
+        const UINT32 count = (UINT32)slots.size();
+
+        for (UINT32 i = 0; i < count; i += 4)
+        {
+            // Last group repeats its last slot in unused lanes
+            const UINT32 numLanes = std::min(4U, count - i);
+            UINT32 lanes[4];
+            for (UINT32 l = 0; l < 4; l++)
+                lanes[l] = slots[i + std::min(l, numLanes - 1)];
+
+            auto gather = [&lanes](const Vector<float>& data)
+            {
+                return SIMD::Set(data[lanes[0]], data[lanes[1]], data[lanes[2]], data[lanes[3]]);
+            };
+
+            auto scatter = [&lanes, numLanes](Vector<float>& data, SIMD::Float4 value)
+            {
+                float values[4];
+                SIMD::Store(values, value);
+
+                for (UINT32 l = 0; l < numLanes; l++)
+                    data[lanes[l]] = values[l];
+            };
+
+            // m[r][c] holds the element (r, c) of the world matrix of each lane
+            SIMD::Float4 m[3][4];
+            for (UINT32 r = 0; r < 3; r++)
+            {
+                m[r][0] = SIMD::Load(&renderables[_owners[lanes[0]]]->WorldTfrm[r].x);
+                m[r][1] = SIMD::Load(&renderables[_owners[lanes[1]]]->WorldTfrm[r].x);
+                m[r][2] = SIMD::Load(&renderables[_owners[lanes[2]]]->WorldTfrm[r].x);
+                m[r][3] = SIMD::Load(&renderables[_owners[lanes[3]]]->WorldTfrm[r].x);
+
+                SIMD::Transpose(m[r][0], m[r][1], m[r][2], m[r][3]);
+            }
+
+            const SIMD::Float4 boxCenter[3] = { gather(_local.BoxCenter[0]), gather(_local.BoxCenter[1]), gather(_local.BoxCenter[2]) };
+            const SIMD::Float4 boxHalfSize[3] = { gather(_local.BoxHalfSize[0]), gather(_local.BoxHalfSize[1]), gather(_local.BoxHalfSize[2]) };
+            const SIMD::Float4 sphereCenter[3] = { gather(_local.SphereCenter[0]), gather(_local.SphereCenter[1]), gather(_local.SphereCenter[2]) };
+
+            for (UINT32 r = 0; r < 3; r++)
+            {
+                // Box center is transformed as a point, half size by the absolute value of the matrix (same result as
+                // AABox::TransformAffine)
+                SIMD::Float4 center = SIMD::MulAdd(m[r][0], boxCenter[0], m[r][3]);
+                center = SIMD::MulAdd(m[r][1], boxCenter[1], center);
+                center = SIMD::MulAdd(m[r][2], boxCenter[2], center);
+
+                SIMD::Float4 halfSize = SIMD::Mul(SIMD::Abs(m[r][0]), boxHalfSize[0]);
+                halfSize = SIMD::MulAdd(SIMD::Abs(m[r][1]), boxHalfSize[1], halfSize);
+                halfSize = SIMD::MulAdd(SIMD::Abs(m[r][2]), boxHalfSize[2], halfSize);
+
+                SIMD::Float4 sphere = SIMD::MulAdd(m[r][0], sphereCenter[0], m[r][3]);
+                sphere = SIMD::MulAdd(m[r][1], sphereCenter[1], sphere);
+                sphere = SIMD::MulAdd(m[r][2], sphereCenter[2], sphere);
+
+                scatter(_world.BoxCenter[r], center);
+                scatter(_world.BoxHalfSize[r], halfSize);
+                scatter(_world.SphereCenter[r], sphere);
+            }
+
+            // Sphere radius is scaled by the largest axis scale (same result as Sphere::Transform)
+            SIMD::Float4 maxScaleSqrd = SIMD::Zero();
+            for (UINT32 c = 0; c < 3; c++)
+            {
+                SIMD::Float4 scaleSqrd = SIMD::Mul(m[0][c], m[0][c]);
+                scaleSqrd = SIMD::MulAdd(m[1][c], m[1][c], scaleSqrd);
+                scaleSqrd = SIMD::MulAdd(m[2][c], m[2][c], scaleSqrd);
+                maxScaleSqrd = SIMD::Max(maxScaleSqrd, scaleSqrd);
+            }
+
+            scatter(_world.SphereRadius, SIMD::Mul(gather(_local.SphereRadius), SIMD::Sqrt(maxScaleSqrd)));
+        }
+    }
+
+    void SubMeshBoundsArray::Clear()
+    {
+        _local.Resize(0);
+        _world.Resize(0);
+        _owners.clear();
+        _firstSlots.clear();
+        _dirtyFlags.clear();
+        _dirtyRenderables.clear();
+        _layoutDirty = true;
+    }
+
+    AABox SubMeshBoundsArray::GetBox(UINT32 slot) const
+    {
+        const Vector3 center(_world.BoxCenter[0][slot], _world.BoxCenter[1][slot], _world.BoxCenter[2][slot]);
+        const Vector3 halfSize(_world.BoxHalfSize[0][slot], _world.BoxHalfSize[1][slot], _world.BoxHalfSize[2][slot]);
+
+        return AABox(center - halfSize, center + halfSize);
+    }
+
+    Vector3 SubMeshBoundsArray::GetSphereCenter(UINT32 slot) const
+    {
+        return Vector3(_world.SphereCenter[0][slot], _world.SphereCenter[1][slot], _world.SphereCenter[2][slot]);
+    }
+
+    void SubMeshBoundsArray::CalculateDistances(const Vector3& origin, Vector<float>& distances) const
+    {
+        const UINT32 count = GetCount();
+        distances.resize(count);
+
+        const SIMD::Float4 originX = SIMD::Splat(origin.x);
+        const SIMD::Float4 originY = SIMD::Splat(origin.y);
+        const SIMD::Float4 originZ = SIMD::Splat(origin.z);
+
+        UINT32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const SIMD::Float4 x = SIMD::Sub(SIMD::Load(&_world.SphereCenter[0][i]), originX);
+            const SIMD::Float4 y = SIMD::Sub(SIMD::Load(&_world.SphereCenter[1][i]), originY);
+            const SIMD::Float4 z = SIMD::Sub(SIMD::Load(&_world.SphereCenter[2][i]), originZ);
+
+            SIMD::Float4 distanceSqrd = SIMD::Mul(x, x);
+            distanceSqrd = SIMD::MulAdd(y, y, distanceSqrd);
+            distanceSqrd = SIMD::MulAdd(z, z, distanceSqrd);
+
+            SIMD::Store(&distances[i], SIMD::Sqrt(distanceSqrd));
+        }
+
+        for (; i < count; i++)
+            distances[i] = origin.Distance(GetSphereCenter(i));
+    }
+}
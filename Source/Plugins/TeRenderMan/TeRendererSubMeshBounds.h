@@ -0,0 +1,78 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Math/TeAABox.h"
+#include "Math/TeBounds.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    /**
+     * World bounds of the sub-meshes of all renderables, stored as separate arrays of floats (box center and half size,
+     * sphere center and radius). Render elements of a renderable use consecutive slots, starting at GetFirstSlot().
+     *
+     * Local bounds are read from the mesh (SubMesh::SubMeshBounds, computed once when the mesh is created) when slots
+     * are assigned. World bounds are only transformed again for renderables marked dirty, all at once in Update(), four
+     * sub-meshes at a time.
+     */
+    class SubMeshBoundsArray
+    {
+    public:
+        SubMeshBoundsArray() = default;
+        ~SubMeshBoundsArray() = default;
+
+        /** Slots must be assigned again, because renderables have been added, removed or their mesh changed. */
+        void SetLayoutDirty() { _layoutDirty = true; }
+
+        /** Marks the renderable @p renderableIdx dirty, its world bounds will be transformed again. */
+        void MarkDirty(UINT32 renderableIdx);
+
+        /** Assigns slots if needed and transforms the bounds of dirty renderables with their world matrix. */
+        void Update(const Vector<RendererRenderable*>& renderables);
+
+        /** Removes all the slots. */
+        void Clear();
+
+        /** Returns the slot of the first render element of the renderable @p renderableIdx. */
+        UINT32 GetFirstSlot(UINT32 renderableIdx) const { return _firstSlots[renderableIdx]; }
+
+        /** Returns the number of slots. */
+        UINT32 GetCount() const { return (UINT32)_owners.size(); }
+
+        /** Returns the world box of @p slot. */
+        AABox GetBox(UINT32 slot) const;
+
+        /** Returns the center of the world sphere of @p slot. */
+        Vector3 GetSphereCenter(UINT32 slot) const;
+
+        /** Writes the distance between @p origin and the center of the world sphere of each slot in @p distances. */
+        void CalculateDistances(const Vector3& origin, Vector<float>& distances) const;
+
+    private:
+        /** Bounds in SoA form. */
+        struct BoundsArrays
+        {
+            Vector<float> BoxCenter[3];
+            Vector<float> BoxHalfSize[3];
+            Vector<float> SphereCenter[3];
+            Vector<float> SphereRadius;
+
+            void Resize(UINT32 count);
+            void Set(UINT32 slot, const Bounds& bounds);
+        };
+
+        /** Transforms the local bounds of @p slots to world space. */
+        void Transform(const Vector<RendererRenderable*>& renderables, const Vector<UINT32>& slots);
+
+    private:
+        BoundsArrays _local;
+        BoundsArrays _world;
+        Vector<UINT32> _owners; // Renderable of each slot
+        Vector<UINT32> _firstSlots; // Per renderable
+
+        Vector<bool> _dirtyFlags; // Per renderable
+        Vector<UINT32> _dirtyRenderables;
+        Vector<UINT32> _slotsToTransform;
+        bool _layoutDirty = true;
+    };
+}
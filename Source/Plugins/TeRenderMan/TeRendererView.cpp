@@ -10,12 +10,13 @@
 #include "Material/TeMaterial.h"
 #include "Material/TeShader.h"
 #include "Mesh/TeMesh.h"
+#include "Image/TeTextureStreaming.h"
 
 namespace te
 {
     PerCameraParamDef gPerCameraParamDef;
 
-    PerInstanceData RendererView::_instanceDataPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
+    UINT32 RendererView::_instanceIndicesPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
     Vector<InstancedBuffer> RendererView::_instancedBuffersPool(8);
 
     /** Struct used to compare two instanced buffer */
@@ -134,26 +135,25 @@ namespace te
         bool perViewBufferDirty = false;
         if (_camera)
         {
-            const SPtr<Viewport>& viewport = _camera->GetViewport();
-            if (viewport)
+            // Viewport of the camera might be changed by the main thread, its normalized area was copied when synced
+            UINT32 newTargetWidth = 0;
+            UINT32 newTargetHeight = 0;
+            if (_properties.Target.Target != nullptr)
             {
-                UINT32 newTargetWidth = 0;
-                UINT32 newTargetHeight = 0;
-                if (_properties.Target.Target != nullptr)
-                {
-                    newTargetWidth = _properties.Target.Target->GetProperties().Width;
-                    newTargetHeight = _properties.Target.Target->GetProperties().Height;
-                }
+                newTargetWidth = _properties.Target.Target->GetProperties().Width;
+                newTargetHeight = _properties.Target.Target->GetProperties().Height;
+            }
 
-                if (newTargetWidth != _properties.Target.TargetWidth ||
-                    newTargetHeight != _properties.Target.TargetHeight)
-                {
-                    _properties.Target.ViewRect = viewport->GetPixelArea();
-                    _properties.Target.TargetWidth = newTargetWidth;
-                    _properties.Target.TargetHeight = newTargetHeight;
+            if (newTargetWidth != _properties.Target.TargetWidth ||
+                newTargetHeight != _properties.Target.TargetHeight)
+            {
+                const Rect2& area = _properties.Target.NrmViewRect;
+                _properties.Target.ViewRect = Rect2I((INT32)(area.x * newTargetWidth), (INT32)(area.y * newTargetHeight),
+                    (UINT32)(area.width * newTargetWidth), (UINT32)(area.height * newTargetHeight));
+                _properties.Target.TargetWidth = newTargetWidth;
+                _properties.Target.TargetHeight = newTargetHeight;
 
-                    perViewBufferDirty = true;
-                }
+                perViewBufferDirty = true;
             }
         }
 
@@ -162,8 +162,13 @@ namespace te
         _properties.ViewProjTransform = _properties.ProjTransform * _properties.ViewTransform;
 
         if (perViewBufferDirty)
+        {
             UpdatePerViewBuffer();
 
+            // Transient textures are sized from the view
+            _compositor->Build(*this, RCNodeFinalResolve::GetNodeId());
+        }
+
         // Note: inverse view-projection can be cached, it doesn't change every frame
         Matrix4 viewProj = _properties.ProjTransform * _properties.ViewTransform;
         Matrix4 invViewProj = viewProj.Inverse();
@@ -211,7 +216,7 @@ namespace te
     }
 
     void RendererView::DetermineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-        Vector<RenderableVisibility>* visibility)
+        Vector<RenderableVisibility>* visibility, OcclusionCuller* occlusionCuller)
     {
         _visibility.Renderables.clear();
         _visibility.Renderables.resize(renderables.size(), RenderableVisibility());
@@ -221,6 +226,9 @@ namespace te
 
         CalculateVisibility(cullInfos, _visibility.Renderables);
 
+        if (occlusionCuller != nullptr)
+            occlusionCuller->Cull(_properties, _occlusionBuffer, renderables, cullInfos, _visibility.Renderables);
+
         if (visibility != nullptr)
         {
             for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
@@ -284,39 +292,8 @@ namespace te
 
     void RendererView::CalculateVisibility(const Vector<CullInfo>& cullInfos, Vector<RenderableVisibility>& visibility) const
     {
-        UINT64 cameraLayers = _properties.VisibleLayers;
-        const ConvexVolume& worldFrustum = _properties.CullFrustum;
-        const Vector3& worldCameraPosition = _properties.ViewOrigin;
-        float baseCullDistance = _renderSettings->CullDistance;
-
-        for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
-        {
-            if ((cullInfos[i].Layer & cameraLayers) == 0)
-                continue;
-
-            // Do distance culling
-            const Sphere& boundingSphere = cullInfos[i].Boundaries.GetSphere();
-            const Vector3& worldRenderablePosition = boundingSphere.GetCenter();
-
-            float distanceToCameraSq = worldCameraPosition.SquaredDistance(worldRenderablePosition);
-            float correctedCullDistance = cullInfos[i].CullDistanceFactor * baseCullDistance;
-            float maxDistanceToCamera = correctedCullDistance + boundingSphere.GetRadius();
-
-            if (distanceToCameraSq > maxDistanceToCamera* maxDistanceToCamera)
-                continue;
-
-            // Do frustum culling
-            // Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-            // operations, as it is trivial to update them. Also consider spatial partitioning.
-            if (worldFrustum.Intersects(boundingSphere))
-            {
-                // More precise with the box
-                const AABox& boundingBox = cullInfos[i].Boundaries.GetBox();
-
-                if (worldFrustum.Intersects(boundingBox))
-                    visibility[i].Visible = true;
-            }
-        }
+        RendererCulling::CalculateVisibility(cullInfos, _properties.VisibleLayers, _properties.CullFrustum,
+            _properties.ViewOrigin, _renderSettings->CullDistance, visibility);
     }
 
     void RendererView::CalculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
@@ -350,6 +327,10 @@ namespace te
     void RendererView::QueueRenderElements(const SceneInfo& sceneInfo)
     {
         const ConvexVolume& worldFrustum = _properties.CullFrustum;
+        const SubMeshBoundsArray& subMeshBounds = sceneInfo.SubMeshBounds;
+
+        // World bounds of render elements are already up to date, only distances to this view are computed here
+        subMeshBounds.CalculateDistances(_properties.ViewOrigin, _subMeshDistances);
 
         // Queue renderables
         for (UINT32 i = 0; i < (UINT32)sceneInfo.Renderables.size(); i++)
@@ -357,12 +338,11 @@ namespace te
             if (!_visibility.Renderables[i].Visible)
                 continue;
 
-            UINT32 j = 0;
+            UINT32 slot = subMeshBounds.GetFirstSlot(i);
             for (auto& renderElem : sceneInfo.Renderables[i]->Elements)
             {
-                Bounds bounds = sceneInfo.Renderables[i]->RenderablePtr->GetSubMeshBounds(j);
-                const float distanceToCamera = (_properties.ViewOrigin - bounds.GetSphere().GetCenter()).Length();
-                j++;
+                const UINT32 elementSlot = slot++;
+                const float distanceToCamera = _subMeshDistances[elementSlot];
 
                 // Renderable are culled in a previous step. However, it could be a good idea
                 // to do a small distance filtering on subMeshes for renderable which have more
@@ -370,7 +350,7 @@ namespace te
                 // and gpu bindings
                 if (renderElem.MeshElem->GetProperties().GetNumSubMeshes() > 4)
                 {
-                    if (!worldFrustum.Intersects(bounds.GetBox()))
+                    if (!worldFrustum.Intersects(subMeshBounds.GetBox(elementSlot)))
                         continue;
                 }
 
@@ -424,36 +404,18 @@ namespace te
             const AABox& boundingBox = sceneInfo.RenderableCullInfos[idx].Boundaries.GetBox();
             const float distanceToCamera = (_properties.ViewOrigin - boundingBox.GetCenter()).Length();
 
-            PerInstanceData data;
-
             for (auto subElemIdx = lowerBlockBound; subElemIdx < upperBlockBound; subElemIdx++)
             {
-                UINT32 elemId = instancedBuffer.Idx[subElemIdx];
-                const Renderable* renderable = sceneInfo.Renderables[elemId]->RenderablePtr;
-                const Matrix4& tfrmNoScale = renderable->GetMatrixNoScale();
-
-                //Once all this stuff is done, we need to write into perinstance buffer
-                //GpuParamBlockBuffer* buffer = sceneInfo.Renderables[elemId]->PerObjectParamBuffer.get();
-
-                data.gMatWorld = sceneInfo.Renderables[elemId]->WorldTfrm;
-                data.gMatInvWorld = sceneInfo.Renderables[elemId]->WorldTfrm.InverseAffine();
-                data.gMatWorldNoScale = tfrmNoScale;
-                data.gMatInvWorldNoScale = tfrmNoScale.InverseAffine();
-                data.gMatPrevWorld = sceneInfo.Renderables[elemId]->PrevWorldTfrm;
-                data.gLayer = (UINT32)renderable->GetLayer();
-                data.gHasAnimation = (renderable->IsAnimated()) ? 1 : 0;
-                data.gWriteVelocity = (renderable->GetWriteVelocity()) ? 1 : 0;
-                data.gCastLights = (renderable->GetCastLights()) ? 1 : 0;
-
-                _instanceDataPool[currInstBlock][subElemIdx - lowerBlockBound] = data;
+                // Per object data already lives in the object data buffer, instances only need its index
+                _instanceIndicesPool[currInstBlock][subElemIdx - lowerBlockBound] = instancedBuffer.Idx[subElemIdx];
                 instancedObjectCounter++;
 
                 if (instancedObjectCounter > STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE* STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
                     break;
             }
 
-            // We update per object and per instance buffer
-            sceneInfo.Renderables[idx]->UpdatePerInstanceBuffer(_instanceDataPool[currInstBlock], upperBlockBound - lowerBlockBound, currInstBlock);
+            // We update per instance buffer
+            sceneInfo.Renderables[idx]->UpdatePerInstanceBuffer(_instanceIndicesPool[currInstBlock], upperBlockBound - lowerBlockBound, currInstBlock);
 
             // We create all instanced render element using first RendererRenderable data
             for (auto& renderElem : sceneInfo.Renderables[idx]->Elements)
@@ -539,8 +501,8 @@ namespace te
         gPerCameraParamDef.gViewDir.Set(_paramBuffer, _properties.ViewDirection);
         gPerCameraParamDef.gViewOrigin.Set(_paramBuffer, _properties.ViewOrigin);
 
-        gPerCameraParamDef.gViewportX.Set(_paramBuffer, static_cast<UINT32>(_camera->GetViewport()->GetArea().x));
-        gPerCameraParamDef.gViewportY.Set(_paramBuffer, static_cast<UINT32>(_camera->GetViewport()->GetArea().y));
+        gPerCameraParamDef.gViewportX.Set(_paramBuffer, static_cast<UINT32>(_properties.Target.NrmViewRect.x));
+        gPerCameraParamDef.gViewportY.Set(_paramBuffer, static_cast<UINT32>(_properties.Target.NrmViewRect.y));
 
         Vector4 ndcToUV = GetNDCToUV();
         gPerCameraParamDef.gClipToUVScaleOffset.Set(_paramBuffer, ndcToUV);
@@ -660,9 +622,14 @@ namespace te
         _visibility.Renderables.resize(sceneInfo.Renderables.size(), RenderableVisibility());
         _visibility.Renderables.assign(sceneInfo.Renderables.size(), RenderableVisibility());
 
+        OcclusionCuller* occlusionCuller = nullptr;
+        if (_options->CullingFlags & (UINT32)RenderManCulling::Occlusion)
+            occlusionCuller = &_occlusionCuller;
+
         for (UINT32 i = 0; i < numViews; i++)
         {
-            _views[i]->DetermineVisible(sceneInfo.Renderables, sceneInfo.RenderableCullInfos, &_visibility.Renderables);
+            _views[i]->DetermineVisible(sceneInfo.Renderables, sceneInfo.RenderableCullInfos, &_visibility.Renderables,
+                occlusionCuller);
         }
 
         // Calculate light visibility for all views
@@ -729,18 +696,81 @@ namespace te
         }
     }
 
+    void RendererViewGroup::RequestStreamedMips(const SceneInfo& sceneInfo)
+    {
+        if (gTextureStreaming().GetNumStreamedTextures() == 0)
+            return;
+
+        Vector<Texture*> textures;
+        const auto numRenderables = (UINT32)std::min(sceneInfo.Renderables.size(), _visibility.Renderables.size());
+
+        for (auto& view : _views)
+        {
+            if (!view->ShouldDraw3D())
+                continue;
+
+            const RendererViewProperties& viewProps = view->GetProperties();
+            const bool perspective = viewProps.ProjType == ProjectionType::PT_PERSPECTIVE;
+
+            // Size in pixels of one world unit, at a distance of one unit for perspective views
+            const float pixelsPerUnit = viewProps.ProjTransform[1][1] * 0.5f * (float)viewProps.Target.ViewRect.height;
+
+            for (UINT32 i = 0; i < numRenderables; i++)
+            {
+                if (!_visibility.Renderables[i].Visible)
+                    continue;
+
+                const Sphere& bounds = sceneInfo.RenderableCullInfos[i].Boundaries.GetSphere();
+                const float distance = viewProps.ViewOrigin.Distance(bounds.GetCenter());
+
+                // Camera inside the bounds, the renderable may cover the whole view
+                float boundsPixels = std::numeric_limits<float>::max();
+                if (!perspective)
+                    boundsPixels = 2.0f * bounds.GetRadius() * pixelsPerUnit;
+                else if (distance > bounds.GetRadius())
+                    boundsPixels = 2.0f * bounds.GetRadius() * pixelsPerUnit / distance;
+
+                boundsPixels = std::max(boundsPixels, 1.0f);
+
+                for (auto& element : sceneInfo.Renderables[i]->Elements)
+                {
+                    if (element.MaterialElem == nullptr)
+                        continue;
+
+                    const MaterialProperties& materialProps = element.MaterialElem->GetProperties();
+                    const float repeat = std::max(materialProps.TextureRepeat.x, materialProps.TextureRepeat.y);
+
+                    textures.clear();
+                    element.MaterialElem->GetTextures(textures);
+
+                    for (auto& texture : textures)
+                    {
+                        if (!texture->IsStreamed())
+                            continue;
+
+                        const TextureProperties& textureProps = texture->GetProperties();
+                        const float texels = (float)std::max(textureProps.GetWidth(), textureProps.GetHeight()) * repeat;
+
+                        const float mip = Math::Log2(texels / boundsPixels);
+                        texture->RequestMip(mip > 0.0f ? (UINT32)mip : 0);
+                    }
+                }
+            }
+        }
+    }
+
     void RendererViewGroup::GenerateInstanced(const SceneInfo& sceneInfo, RenderManInstancing instancingMode)
     {
         InstancedBuffer key;
 
-        auto PopulateInstanceBuffer = [&](Renderable* renderable, UINT32 current)
+        auto PopulateInstanceBuffer = [&](const RendererRenderable* renderable, UINT32 current)
         {
-            if (!renderable->GetInstancing())
+            if (!renderable->Properties.Instancing)
                 return;
 
-            key.MeshElem = renderable->GetMesh().get();
-            key.Materials = renderable->GetMaterialsPtr();
-            key.MaterialCount = renderable->GetNumMaterials();
+            key.MeshElem = renderable->MeshElem.get();
+            key.Materials = renderable->Materials.data();
+            key.MaterialCount = (UINT32)renderable->Materials.size();
             if(key.Idx.size() > 0) key.Idx.clear();
 
             auto iter = find(RendererView::_instancedBuffersPool.begin(), RendererView::_instancedBuffersPool.end(), key);
@@ -773,7 +803,7 @@ namespace te
                     continue;
                 }
 
-                PopulateInstanceBuffer(sceneInfo.Renderables[i]->RenderablePtr, i);
+                PopulateInstanceBuffer(sceneInfo.Renderables[i], i);
             }
         }
         else if (instancingMode == RenderManInstancing::Manual)
@@ -793,7 +823,7 @@ namespace te
                     continue;
                 }
 
-                PopulateInstanceBuffer(renderable->RenderablePtr, renderable->RenderablePtr->GetRendererId());
+                PopulateInstanceBuffer(renderable, renderable->RenderablePtr->GetRendererId());
             }
         }
     }
@@ -2,10 +2,14 @@
 
 #include "TeRenderManPrerequisites.h"
 #include "TeRendererLight.h"
+#include "TeRendererLightGrid.h"
+#include "TeRendererShadowRendering.h"
+#include "TeRendererOcclusion.h"
 #include "TeRendererDecal.h"
 #include "TeRendererRenderable.h"
 #include "Renderer/TeRenderer.h"
 #include "Renderer/TeRenderQueue.h"
+#include "Renderer/TeRendererCulling.h"
 #include "Math/TeBounds.h"
 #include "Math/TeRect2I.h"
 #include "Math/TeRect2.h"
@@ -90,12 +94,6 @@ namespace te
         RendererViewTargetData Target;
     };
 
-    struct RenderableVisibility
-    {
-        bool Visible = false;
-        bool Instanced = false;
-    };
-
     struct VisibilityInfo
     {
         /* Say if a renderable is currently visible or not */
@@ -121,20 +119,6 @@ namespace te
         Vector<UINT32> Idx;
     };
 
-    /** Information used for culling an object against a view. */
-    struct CullInfo
-    {
-        CullInfo(const Bounds& bounds, UINT64 layer = -1, float cullDistanceFactor = 1.0f)
-            : Layer(layer)
-            , Boundaries(bounds)
-            , CullDistanceFactor(cullDistanceFactor)
-        { }
-
-        UINT64 Layer;
-        Bounds Boundaries;
-        float CullDistanceFactor;
-    };
-
     /** Contains information about a single view into the scene, used by the renderer. */
     class RendererView
     {
@@ -198,9 +182,10 @@ namespace te
          *									object. If the bit for an object is already set to true, the method will never
          *									change it to false which allows the same bitfield to be provided to multiple
          *									renderer views. Must be the same size as the @p renderables array.
+         * @param[in]	occlusionCuller		If not null, renderables hidden behind occluders in this view are culled too.
          */
         void DetermineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-            Vector<RenderableVisibility>* visibility = nullptr);
+            Vector<RenderableVisibility>* visibility = nullptr, OcclusionCuller* occlusionCuller = nullptr);
 
         /**
          * Calculates the visibility masks for all the lights of the provided type.
@@ -269,6 +254,18 @@ namespace te
         /** Returns a buffer that stores per-view parameters. */
         SPtr<GpuParamBlockBuffer> GetPerViewBuffer() const { return _paramBuffer; }
 
+        /** Bins the provided lights into the clusters of the view. To be called before rendering the view. */
+        void UpdateLightGrid(const VisibleLightData& lightData) { _lightGrid.Update(*this, lightData); }
+
+        /** Returns the lights binned into the clusters of the view by the last call to UpdateLightGrid(). */
+        const LightGrid& GetLightGrid() const { return _lightGrid; }
+
+        /** Returns the shadow maps sampled by the view, set up by ShadowRendering. */
+        const ViewShadows& GetShadows() const { return _shadows; }
+
+        /** @copydoc GetShadows */
+        ViewShadows& GetShadows() { return _shadows; }
+
         /** Assigns a view index to the view. To be called by the parent view group when the view is added to it. */
         void SetViewIdx(UINT32 viewIdx) { _viewIdx = viewIdx; }
 
@@ -318,6 +315,9 @@ namespace te
         UPtr<RenderCompositor> _compositor;
         SPtr<RenderSettings> _renderSettings;
         SPtr<GpuParamBlockBuffer> _paramBuffer;
+        LightGrid _lightGrid;
+        ViewShadows _shadows;
+        OcclusionBuffer _occlusionBuffer;
 
         VisibilityInfo _visibility;
         UINT32 _viewIdx = 0;
@@ -337,8 +337,9 @@ namespace te
         SPtr<RenderQueue> _forwardTransparentQueue;
 
         Vector<RenderableElement*> _instancedElements; //Elements are updated every frame
+        Vector<float> _subMeshDistances; // Distance to each render element, rebuilt every frame
 
-        static PerInstanceData _instanceDataPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
+        static UINT32 _instanceIndicesPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
         static Vector<InstancedBuffer> _instancedBuffersPool;
 
         // Exposure
@@ -377,6 +378,9 @@ namespace te
          */
         const VisibleLightData& GetVisibleLightData() const { return _visibleLightData; }
 
+        /** @copydoc GetVisibleLightData */
+        VisibleLightData& GetVisibleLightData() { return _visibleLightData; }
+
         /**
          * Updates visibility information for the provided scene objects, from the perspective of all views in this group,
          * and updates the render queues of each individual view. Use getVisibilityInfo() to retrieve the calculated
@@ -389,6 +393,13 @@ namespace te
          */
         void SetAllObjectsAsVisible(const SceneInfo& sceneInfo);
 
+        /**
+         * Requests the mip levels of streamed textures needed by visible renderables. The mip is estimated per view from
+         * the screen space size of the renderable bounds, assuming its texture coordinates cover the bounds once (times
+         * the material texture repeat). Must be called after visibility has been determined.
+         */
+        void RequestStreamedMips(const SceneInfo& sceneInfo);
+
         /**
         * Before creating render queue, we look for all possibly instanced elements
         */
@@ -408,6 +419,7 @@ namespace te
         VisibilityInfo _visibility;
 
         VisibleLightData _visibleLightData;
+        OcclusionCuller _occlusionCuller;
     };
 
     IMPLEMENT_GLOBAL_POOL(RenderableElement, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE)
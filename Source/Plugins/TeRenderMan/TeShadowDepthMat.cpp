@@ -0,0 +1,58 @@
+#include "TeShadowDepthMat.h"
+#include "TeRendererRenderable.h"
+#include "Renderer/TeRendererUtility.h"
+
+namespace te
+{
+    PerShadowParamDef gPerShadowParamDef;
+    PerShadowObjectParamDef gPerShadowObjectParamDef;
+
+    ShadowDepthMat::ShadowDepthMat()
+    {
+        _perShadowParamBuffer = gPerShadowParamDef.CreateBuffer();
+        _perObjectParamBuffer = gPerShadowObjectParamDef.CreateBuffer();
+
+        _params->SetParamBlockBuffer("PerShadowBuffer", _perShadowParamBuffer);
+        _params->SetParamBlockBuffer("PerObjectBuffer", _perObjectParamBuffer);
+    }
+
+    void ShadowDepthMat::BindShadow(const Matrix4& viewProj)
+    {
+        gPerShadowParamDef.gMatViewProj.Set(_perShadowParamBuffer, viewProj);
+    }
+
+    void ShadowDepthMat::BindRenderable(const RendererRenderable* renderable)
+    {
+        gPerShadowObjectParamDef.gMatWorld.Set(_perObjectParamBuffer, renderable->WorldTfrm);
+        gPerShadowObjectParamDef.gHasAnimation.Set(_perObjectParamBuffer, renderable->IsAnimated() ? 1 : 0);
+
+        if (_params->HasBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices"))
+            _params->SetBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices", renderable->BoneMatrixBuffer);
+    }
+
+    ShadowDepthClearMat::ShadowDepthClearMat()
+    {
+        _perShadowParamBuffer = gPerShadowParamDef.CreateBuffer();
+        _perObjectParamBuffer = gPerShadowObjectParamDef.CreateBuffer();
+
+        _params->SetParamBlockBuffer("PerShadowBuffer", _perShadowParamBuffer);
+        _params->SetParamBlockBuffer("PerObjectBuffer", _perObjectParamBuffer);
+
+        // Keeps x and y of the screen quad, and outputs a depth of 1 for all its vertices
+        const Matrix4 toFarPlane(
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f,
+            0.0f, 0.0f, 0.0f, 1.0f);
+
+        gPerShadowParamDef.gMatViewProj.Set(_perShadowParamBuffer, toFarPlane);
+        gPerShadowObjectParamDef.gMatWorld.Set(_perObjectParamBuffer, Matrix4::IDENTITY);
+        gPerShadowObjectParamDef.gHasAnimation.Set(_perObjectParamBuffer, 0);
+    }
+
+    void ShadowDepthClearMat::Execute()
+    {
+        Bind();
+        gRendererUtility().DrawScreenQuad();
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Renderer/TeParamBlocks.h"
+#include "Renderer/TeRendererMaterial.h"
+
+namespace te
+{
+    TE_PARAM_BLOCK_BEGIN(PerShadowParamDef)
+        TE_PARAM_BLOCK_ENTRY(Matrix4, gMatViewProj)
+    TE_PARAM_BLOCK_END
+
+    extern PerShadowParamDef gPerShadowParamDef;
+
+    TE_PARAM_BLOCK_BEGIN(PerShadowObjectParamDef)
+        TE_PARAM_BLOCK_ENTRY(Matrix4, gMatWorld)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gHasAnimation)
+    TE_PARAM_BLOCK_END
+
+    extern PerShadowObjectParamDef gPerShadowObjectParamDef;
+
+    /** Shader that renders the depth of shadow casters into a shadow map. */
+    class ShadowDepthMat : public RendererMaterial<ShadowDepthMat>
+    {
+        RMAT_DEF(BuiltinShader::ShadowDepth);
+
+    public:
+        ShadowDepthMat();
+
+        /** Sets the view-projection matrix of the shadow map, already converted for the render API. */
+        void BindShadow(const Matrix4& viewProj);
+
+        /** Sets the transform and bones of a caster. To be followed by Bind() and drawing its elements. */
+        void BindRenderable(const RendererRenderable* renderable);
+
+    private:
+        SPtr<GpuParamBlockBuffer> _perShadowParamBuffer;
+        SPtr<GpuParamBlockBuffer> _perObjectParamBuffer;
+    };
+
+    /**
+     * Shader that resets an area of a shadow map to the farthest depth. Render APIs don't all clear only the viewport,
+     * so shadow maps sharing an atlas are cleared by drawing a quad over them.
+     */
+    class ShadowDepthClearMat : public RendererMaterial<ShadowDepthClearMat>
+    {
+        RMAT_DEF(BuiltinShader::ShadowDepthClear);
+
+    public:
+        ShadowDepthClearMat();
+
+        /** Clears the area of the currently bound depth target covered by the viewport. */
+        void Execute();
+
+    private:
+        SPtr<GpuParamBlockBuffer> _perShadowParamBuffer;
+        SPtr<GpuParamBlockBuffer> _perObjectParamBuffer;
+    };
+}